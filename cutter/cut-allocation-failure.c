@@ -0,0 +1,313 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/* for dladdr() */
+#define _GNU_SOURCE
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <errno.h>
+#include <math.h>
+#include <sys/types.h>
+
+#ifdef HAVE_SYS_WAIT_H
+#  include <sys/wait.h>
+#endif
+
+#ifdef HAVE_DLADDR
+#  include <dlfcn.h>
+#endif
+
+#include <glib.h>
+
+#ifndef G_OS_WIN32
+#  include <unistd.h>
+#endif
+
+#include "cut-allocation-failure.h"
+#include "cut-malloc-hook.h"
+#include "cut-utils.h"
+#include "cut-logger.h"
+
+typedef struct _Report
+{
+    gint64 heap_growth;
+    gint n_allocations;
+} Report;
+
+typedef struct _Child
+{
+    guint nth;
+    gint pid;
+    gint fd;
+} Child;
+
+static gboolean armed = FALSE;
+static volatile gint n_allocations = 0;
+static gint failing_allocation = 0;
+static gpointer glib_base = NULL;
+
+#ifdef __GNUC__
+#  define INCREMENT_AND_FETCH(variable) __sync_add_and_fetch(&(variable), 1)
+#else
+#  define INCREMENT_AND_FETCH(variable) (++(variable))
+#endif
+
+static gboolean
+is_glib_allocation (gconstpointer caller)
+{
+#ifdef HAVE_DLADDR
+    Dl_info info;
+
+    if (!dladdr(caller, &info))
+        return FALSE;
+    return info.dli_fbase == glib_base;
+#else
+    return TRUE;
+#endif
+}
+
+gboolean
+cut_allocation_failure_should_fail (gconstpointer caller)
+{
+    if (!armed)
+        return FALSE;
+    if (is_glib_allocation(caller))
+        return FALSE;
+
+    return INCREMENT_AND_FETCH(n_allocations) == failing_allocation;
+}
+
+gboolean
+cut_allocation_failure_is_available (void)
+{
+#if defined(HAVE_DLADDR) && !defined(G_OS_WIN32)
+    return cut_malloc_hook_is_installed();
+#else
+    return FALSE;
+#endif
+}
+
+void
+cut_allocation_failure_start (void)
+{
+#ifdef HAVE_DLADDR
+    Dl_info info;
+
+    if (!glib_base && dladdr((gpointer)g_malloc, &info))
+        glib_base = info.dli_fbase;
+#endif
+    cut_malloc_hook_enable();
+    n_allocations = 0;
+    armed = TRUE;
+}
+
+void
+cut_allocation_failure_stop (void)
+{
+    armed = FALSE;
+}
+
+#ifndef G_OS_WIN32
+static gboolean
+start_child (Child *child, guint nth,
+             CutAllocationFailureRunFunction run_function, gpointer user_data,
+             gdouble timeout)
+{
+    gint fds[2];
+    Report report;
+
+    if (pipe(fds) < 0) {
+        cut_log_warning("[allocation-failure][pipe][fail] %s",
+                        g_strerror(errno));
+        return FALSE;
+    }
+
+    fflush(stdout);
+    fflush(stderr);
+    child->nth = nth;
+    child->pid = fork();
+    if (child->pid == -1) {
+        cut_log_warning("[allocation-failure][fork][fail] %s",
+                        g_strerror(errno));
+        cut_utils_close_pipe(fds, CUT_READ);
+        cut_utils_close_pipe(fds, CUT_WRITE);
+        return FALSE;
+    }
+
+    if (child->pid == 0) {
+        cut_utils_close_pipe(fds, CUT_READ);
+
+        /* A crash and a hang must kill only this process. */
+        signal(SIGSEGV, SIG_DFL);
+        signal(SIGABRT, SIG_DFL);
+        signal(SIGTERM, SIG_DFL);
+        signal(SIGBUS, SIG_DFL);
+        signal(SIGALRM, SIG_DFL);
+        signal(SIGINT, SIG_IGN);
+        alarm((guint)ceil(timeout));
+
+        failing_allocation = nth;
+        report.heap_growth = run_function(user_data);
+        report.n_allocations = n_allocations;
+        if (write(fds[CUT_WRITE], &report, sizeof(report)) != sizeof(report))
+            _exit(EXIT_FAILURE);
+        _exit(EXIT_SUCCESS);
+    }
+
+    cut_utils_close_pipe(fds, CUT_WRITE);
+    child->fd = fds[CUT_READ];
+
+    return TRUE;
+}
+
+/* Returns a description of an unhandled failure or NULL. */
+static gchar *
+wait_child (Child *child, Report *report)
+{
+    gint status;
+    gssize size;
+
+    size = read(child->fd, report, sizeof(*report));
+    close(child->fd);
+    while (waitpid(child->pid, &status, 0) == -1) {
+        if (errno != EINTR)
+            return g_strdup_printf("lost: %s", g_strerror(errno));
+    }
+
+    if (WIFSIGNALED(status)) {
+        if (WTERMSIG(status) == SIGALRM)
+            return g_strdup("timed out");
+        return g_strdup_printf("crashed by signal %d (%s)",
+                               WTERMSIG(status),
+                               g_strsignal(WTERMSIG(status)));
+    }
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS)
+        return g_strdup_printf("exited with %d", WEXITSTATUS(status));
+    if (size != sizeof(*report))
+        return g_strdup("exited without report");
+
+    return NULL;
+}
+#endif
+
+gchar *
+cut_allocation_failure_check (CutAllocationFailureRunFunction run_function,
+                              gpointer user_data,
+                              guint max_allocations,
+                              gint n_processes,
+                              gdouble timeout)
+{
+#ifndef G_OS_WIN32
+    Child reference_child;
+    Report reference_report;
+    GQueue *children;
+    GString *failures;
+    gchar *failure, *message;
+    guint nth, n_checks, n_failures = 0;
+
+    if (!cut_allocation_failure_is_available()) {
+        cut_log_trace("[allocation-failure][unavailable]");
+        return NULL;
+    }
+    if (timeout <= 0.0)
+        timeout = CUT_ALLOCATION_FAILURE_DEFAULT_TIMEOUT;
+    n_processes = MAX(n_processes, 1);
+
+    /* The reference run counts allocations and measures the heap
+     * growth that isn't a leak, e.g. caches. */
+    if (!start_child(&reference_child, 0, run_function, user_data, timeout))
+        return NULL;
+    failure = wait_child(&reference_child, &reference_report);
+    if (failure) {
+        cut_log_warning("[allocation-failure][reference][fail] %s", failure);
+        g_free(failure);
+        return NULL;
+    }
+
+    n_checks = MIN((guint)reference_report.n_allocations, max_allocations);
+    cut_log_trace("[allocation-failure][check] <%u>", n_checks);
+
+    children = g_queue_new();
+    failures = g_string_new(NULL);
+    nth = 1;
+    while (nth <= n_checks || !g_queue_is_empty(children)) {
+        Child *child;
+        Report report;
+
+        while (nth <= n_checks &&
+               (gint)g_queue_get_length(children) < n_processes) {
+            child = g_new(Child, 1);
+            if (!start_child(child, nth, run_function, user_data, timeout)) {
+                g_free(child);
+                n_checks = nth - 1;
+                break;
+            }
+            g_queue_push_tail(children, child);
+            nth++;
+        }
+
+        child = g_queue_pop_head(children);
+        if (!child)
+            break;
+        failure = wait_child(child, &report);
+        if (!failure && report.heap_growth > reference_report.heap_growth)
+            failure = g_strdup_printf("leaked %" G_GINT64_FORMAT " bytes",
+                                      report.heap_growth -
+                                      reference_report.heap_growth);
+        if (failure) {
+            n_failures++;
+            if (n_failures <= CUT_ALLOCATION_FAILURE_MAX_REPORTED_FAILURES)
+                g_string_append_printf(failures,
+                                       "\n  allocation #%u: %s",
+                                       child->nth, failure);
+            g_free(failure);
+        }
+        g_free(child);
+    }
+    g_queue_free(children);
+
+    if (n_failures == 0) {
+        g_string_free(failures, TRUE);
+        return NULL;
+    }
+
+    if (n_failures > CUT_ALLOCATION_FAILURE_MAX_REPORTED_FAILURES)
+        g_string_append_printf(failures, "\n  ... and %u more",
+                               n_failures -
+                               CUT_ALLOCATION_FAILURE_MAX_REPORTED_FAILURES);
+    message = g_strdup_printf("%u of %u allocation failures aren't handled:%s",
+                              n_failures, n_checks, failures->str);
+    g_string_free(failures, TRUE);
+
+    return message;
+#else
+    return NULL;
+#endif
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
@@ -0,0 +1,73 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CUT_ALLOCATION_FAILURE_H__
+#define __CUT_ALLOCATION_FAILURE_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/*
+ * An allocation failure check runs a test in forked processes
+ * like failmalloc. The Nth process makes the Nth allocation of
+ * the test fail. A crash, a hang or a leak in a process means
+ * that the test code doesn't handle the failure.
+ *
+ * Allocations are failed by the malloc() interposer of the
+ * cutter command. Allocations by GLib are never failed because
+ * GLib aborts on them by design.
+ */
+
+#define CUT_ALLOCATION_FAILURE_DEFAULT_TIMEOUT 60.0
+#define CUT_ALLOCATION_FAILURE_MAX_REPORTED_FAILURES 10
+
+/* It's called in a forked process. It runs the test between
+ * cut_allocation_failure_start() and
+ * cut_allocation_failure_stop(), and returns the heap growth
+ * in bytes by the run. */
+typedef gint64 (*CutAllocationFailureRunFunction) (gpointer user_data);
+
+gboolean cut_allocation_failure_is_available (void);
+
+void     cut_allocation_failure_start        (void);
+void     cut_allocation_failure_stop         (void);
+
+/* Returns a message that describes unhandled allocation
+ * failures or NULL. Only the first max_allocations allocations
+ * are failed. Up to n_processes processes run at once. A
+ * process that runs longer than timeout seconds is killed. The
+ * caller owns the message. */
+gchar   *cut_allocation_failure_check        (CutAllocationFailureRunFunction run_function,
+                                              gpointer     user_data,
+                                              guint        max_allocations,
+                                              gint         n_processes,
+                                              gdouble      timeout);
+
+/* For a malloc() interposer. caller is the return address of
+ * the allocation function. It must not allocate memory. */
+gboolean cut_allocation_failure_should_fail  (gconstpointer caller);
+
+G_END_DECLS
+
+#endif /* __CUT_ALLOCATION_FAILURE_H__ */
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
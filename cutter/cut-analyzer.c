@@ -1,6 +1,6 @@
 /* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
 /*
- *  Copyright (C) 2008-2019  Sutou Kouhei <kou@clear-code.com>
+ *  Copyright (C) 2008-2026  Sutou Kouhei <kou@clear-code.com>
  *
  *  This library is free software: you can redistribute it and/or modify
  *  it under the terms of the GNU Lesser General Public License as published by
@@ -22,10 +22,13 @@
 #endif /* HAVE_CONFIG_H */
 
 #include <glib.h>
+#include <glib/gstdio.h>
 #include <glib-compatible/glib-compatible.h>
 
 #include "cut-analyzer.h"
-#include "cut-file-stream-reader.h"
+#include "cut-log-index.h"
+#include "cut-stream-reader.h"
+#include "cut-logger.h"
 
 #define CUT_ANALYZER_GET_PRIVATE(obj)                           \
     ((CutAnalyzerPrivate *)                                     \
@@ -34,7 +37,21 @@
 typedef struct _CutAnalyzerPrivate	CutAnalyzerPrivate;
 struct _CutAnalyzerPrivate
 {
-    GList *run_contexts;
+    GList *summaries;
+};
+
+typedef struct _ParseJob ParseJob;
+struct _ParseJob
+{
+    gchar *file_name;
+    gchar *log_name;
+    gint64 size;
+    gint64 modified_time;
+    CutLogSummary *summary;
+    gboolean parsed;
+    gboolean completed;
+    gboolean success;
+    GError *error;
 };
 
 G_DEFINE_TYPE_WITH_PRIVATE(CutAnalyzer, cut_analyzer, G_TYPE_OBJECT)
@@ -56,19 +73,23 @@ cut_analyzer_init (CutAnalyzer *analyzer)
 {
     CutAnalyzerPrivate *priv = CUT_ANALYZER_GET_PRIVATE(analyzer);
 
-    priv->run_contexts = FALSE;
+    priv->summaries = NULL;
 }
 
 static void
-dispose (GObject *object)
+free_summaries (CutAnalyzerPrivate *priv)
 {
-    CutAnalyzerPrivate *priv = CUT_ANALYZER_GET_PRIVATE(object);
-
-    if (priv->run_contexts) {
-        g_list_foreach(priv->run_contexts, (GFunc)g_object_unref, NULL);
-        g_list_free(priv->run_contexts);
-        priv->run_contexts = NULL;
+    if (priv->summaries) {
+        g_list_foreach(priv->summaries, (GFunc)cut_log_summary_free, NULL);
+        g_list_free(priv->summaries);
+        priv->summaries = NULL;
     }
+}
+
+static void
+dispose (GObject *object)
+{
+    free_summaries(CUT_ANALYZER_GET_PRIVATE(object));
 
     G_OBJECT_CLASS(cut_analyzer_parent_class)->dispose(object);
 }
@@ -79,12 +100,182 @@ cut_analyzer_new (void)
     return g_object_new(CUT_TYPE_ANALYZER, NULL);
 }
 
+static ParseJob *
+parse_job_new (const gchar *log_directory, const gchar *log_name)
+{
+    ParseJob *job;
+
+    job = g_new0(ParseJob, 1);
+    job->file_name = g_build_filename(log_directory, log_name, NULL);
+    job->log_name = g_strdup(log_name);
+    job->summary = NULL;
+    job->parsed = FALSE;
+    job->completed = FALSE;
+    job->success = FALSE;
+    job->error = NULL;
+
+    return job;
+}
+
 static void
-error_cb (CutRunContext *context, GError *error, gpointer user_data)
+parse_job_free (ParseJob *job)
 {
-    GError **user_error = user_data;
+    g_free(job->file_name);
+    g_free(job->log_name);
+    if (job->summary)
+        cut_log_summary_free(job->summary);
+    if (job->error)
+        g_error_free(job->error);
+    g_free(job);
+}
 
-    *user_error = g_error_copy(error);
+static void
+cb_error (CutRunContext *context, GError *error, gpointer user_data)
+{
+    ParseJob *job = user_data;
+
+    if (!job->error)
+        job->error = g_error_copy(error);
+}
+
+static void
+cb_complete_run (CutRunContext *context, gboolean success, gpointer user_data)
+{
+    ParseJob *job = user_data;
+
+    job->completed = TRUE;
+    job->success = success;
+}
+
+/* This is run in a worker thread. A log is read synchronously
+ * without the main loop and only its summary is kept. */
+static void
+parse_log (gpointer data, gpointer user_data)
+{
+    ParseJob *job = data;
+    CutRunContext *reader;
+    GIOChannel *channel;
+    CutLogSummary *summary;
+
+    channel = g_io_channel_new_file(job->file_name, "r", &(job->error));
+    if (!channel)
+        return;
+    g_io_channel_set_encoding(channel, NULL, NULL);
+
+    reader = cut_stream_reader_new();
+    cut_run_context_set_result_retention(reader, CUT_RESULT_RETENTION_NONE);
+    g_signal_connect(reader, "error", G_CALLBACK(cb_error), job);
+    g_signal_connect(reader, "complete-run", G_CALLBACK(cb_complete_run), job);
+    cut_stream_reader_read_from_io_channel_to_end(CUT_STREAM_READER(reader),
+                                                  channel);
+    g_io_channel_unref(channel);
+
+    if (!job->error) {
+        summary = cut_log_summary_new(job->log_name);
+        summary->success = job->completed && job->success;
+        summary->crashed = cut_run_context_is_crashed(reader);
+        summary->elapsed = cut_run_context_get_elapsed(reader);
+        summary->n_tests = cut_run_context_get_n_tests(reader);
+        summary->n_assertions = cut_run_context_get_n_assertions(reader);
+        summary->n_successes = cut_run_context_get_n_successes(reader);
+        summary->n_failures = cut_run_context_get_n_failures(reader);
+        summary->n_errors = cut_run_context_get_n_errors(reader);
+        summary->n_pendings = cut_run_context_get_n_pendings(reader);
+        summary->n_notifications = cut_run_context_get_n_notifications(reader);
+        summary->n_omissions = cut_run_context_get_n_omissions(reader);
+        job->summary = summary;
+        job->parsed = TRUE;
+    }
+    g_object_unref(reader);
+}
+
+static gint
+get_n_parse_threads (guint n_jobs)
+{
+    gint n_threads = 1;
+
+#if GLIB_CHECK_VERSION(2, 36, 0)
+    n_threads = g_get_num_processors();
+#endif
+    return CLAMP((gint)n_jobs, 1, MAX(n_threads, 1));
+}
+
+static gboolean
+parse_logs (GList *jobs, GError **error)
+{
+    GThreadPool *pool;
+    GList *node;
+    guint n_jobs;
+
+    n_jobs = g_list_length(jobs);
+    if (n_jobs == 1) {
+        parse_log(jobs->data, NULL);
+        return TRUE;
+    }
+
+    pool = g_thread_pool_new(parse_log, NULL, get_n_parse_threads(n_jobs),
+                             FALSE, error);
+    if (!pool)
+        return FALSE;
+    for (node = jobs; node; node = g_list_next(node)) {
+        g_thread_pool_push(pool, node->data, NULL);
+    }
+    g_thread_pool_free(pool, FALSE, TRUE);
+
+    return TRUE;
+}
+
+static CutLogIndex *
+load_index (const gchar *log_directory)
+{
+    CutLogIndex *log_index;
+    gchar *filename;
+    GError *error = NULL;
+
+    filename = cut_log_index_build_filename(log_directory);
+    log_index = cut_log_index_new(filename);
+    if (!cut_log_index_load(log_index, &error)) {
+        /* A broken index is rebuilt from logs. */
+        cut_log_warning("[analyzer][index][load][fail] <%s>: %s",
+                        filename, error->message);
+        g_error_free(error);
+        cut_log_index_free(log_index);
+        log_index = cut_log_index_new(filename);
+    }
+    g_free(filename);
+
+    return log_index;
+}
+
+static void
+update_index (CutLogIndex *log_index, GList *log_names)
+{
+    GHashTable *existing_names;
+    GList *node;
+    gchar **indexed_names, **name;
+
+    existing_names = g_hash_table_new(g_str_hash, g_str_equal);
+    for (node = log_names; node; node = g_list_next(node)) {
+        g_hash_table_insert(existing_names, node->data, node->data);
+    }
+    indexed_names = cut_log_index_get_log_names(log_index);
+    for (name = indexed_names; *name; name++) {
+        if (!g_hash_table_lookup(existing_names, *name))
+            cut_log_index_remove(log_index, *name);
+    }
+    g_strfreev(indexed_names);
+    g_hash_table_unref(existing_names);
+
+    if (cut_log_index_is_modified(log_index)) {
+        GError *error = NULL;
+
+        if (!cut_log_index_save(log_index, &error)) {
+            cut_log_warning("[analyzer][index][save][fail] <%s>: %s",
+                            cut_log_index_get_filename(log_index),
+                            error->message);
+            g_error_free(error);
+        }
+    }
 }
 
 gboolean
@@ -92,56 +283,100 @@ cut_analyzer_analyze (CutAnalyzer *analyzer, const gchar *log_directory,
                       GError **error)
 {
     CutAnalyzerPrivate *priv;
+    CutLogIndex *log_index;
     GDir *log_dir;
     const gchar *name;
-    GList *names = NULL;
+    GList *names = NULL, *jobs = NULL, *parse_jobs = NULL;
     GList *node;
-    gboolean success =TRUE;
+    gboolean success = TRUE;
 
     priv = CUT_ANALYZER_GET_PRIVATE(analyzer);
+    free_summaries(priv);
 
     log_dir = g_dir_open(log_directory, 0, error);
     if (!log_dir)
         return FALSE;
 
     while ((name = g_dir_read_name(log_dir))) {
-        if (g_regex_match_simple("^\\d{4}(?:-\\d{2}){5}\\.xml$", name, 0, 0)) {
-            gchar *file_name;
-
-            file_name = g_build_filename(log_directory, name, NULL);
-            names = g_list_prepend(names, file_name);
-        }
+        if (g_regex_match_simple("^\\d{4}(?:-\\d{2}){5}\\.xml$", name, 0, 0))
+            names = g_list_prepend(names, g_strdup(name));
     }
     g_dir_close(log_dir);
 
     names = g_list_reverse(g_list_sort(names, (GCompareFunc)g_utf8_collate));
-    for (node = names; node && success; node = g_list_next(node)) {
-        gchar *file_name = node->data;
-        CutRunContext *reader;
-        GError *local_error = NULL;
-
-        reader = cut_file_stream_reader_new(file_name);
-        g_signal_connect(reader, "error", G_CALLBACK(error_cb), &local_error);
-        priv->run_contexts = g_list_append(priv->run_contexts, reader);
-        cut_run_context_start(reader);
-        if (local_error) {
-            success = FALSE;
-            g_propagate_error(error, local_error);
+
+    log_index = load_index(log_directory);
+    for (node = names; node; node = g_list_next(node)) {
+        ParseJob *job;
+        GStatBuf stat_buffer;
+
+        job = parse_job_new(log_directory, node->data);
+        jobs = g_list_prepend(jobs, job);
+        if (g_stat(job->file_name, &stat_buffer) == 0) {
+            job->size = stat_buffer.st_size;
+            job->modified_time = stat_buffer.st_mtime;
+            job->summary = cut_log_index_lookup(log_index,
+                                                job->log_name,
+                                                job->size,
+                                                job->modified_time);
         }
+        if (!job->summary)
+            parse_jobs = g_list_prepend(parse_jobs, job);
     }
+    jobs = g_list_reverse(jobs);
+    parse_jobs = g_list_reverse(parse_jobs);
 
-    if (names) {
-        g_list_foreach(names, (GFunc)g_free, NULL);
-        g_list_free(names);
+    cut_log_trace("[analyzer][analyze] <%s>: <%u/%u> logs are parsed",
+                  log_directory,
+                  g_list_length(parse_jobs), g_list_length(jobs));
+    if (parse_jobs)
+        success = parse_logs(parse_jobs, error);
+    g_list_free(parse_jobs);
+
+    /* The first error in the order of logs is reported but
+     * summaries of other logs are still indexed. */
+    for (node = jobs; node; node = g_list_next(node)) {
+        ParseJob *job = node->data;
+
+        if (job->error) {
+            if (success) {
+                success = FALSE;
+                g_propagate_error(error, job->error);
+                job->error = NULL;
+            }
+            continue;
+        }
+        if (!job->summary)
+            continue;
+        if (job->parsed)
+            cut_log_index_record(log_index, job->summary,
+                                 job->size, job->modified_time);
+        priv->summaries = g_list_prepend(priv->summaries, job->summary);
+        job->summary = NULL;
     }
+    priv->summaries = g_list_reverse(priv->summaries);
+
+    update_index(log_index, names);
+    cut_log_index_free(log_index);
+
+    g_list_foreach(jobs, (GFunc)parse_job_free, NULL);
+    g_list_free(jobs);
+    g_list_foreach(names, (GFunc)g_free, NULL);
+    g_list_free(names);
 
     return success;
 }
 
+const GList *
+cut_analyzer_get_summaries (CutAnalyzer *analyzer)
+{
+    return CUT_ANALYZER_GET_PRIVATE(analyzer)->summaries;
+}
+
 const GList *
 cut_analyzer_get_run_contexts (CutAnalyzer *analyzer)
 {
-    return CUT_ANALYZER_GET_PRIVATE(analyzer)->run_contexts;
+    return NULL;
 }
 
 
@@ -52,9 +52,16 @@ gboolean       cut_analyzer_analyze   (CutAnalyzer  *analyzer,
                                        const gchar  *log_directory,
                                        GError      **error);
 
-const GList   *cut_analyzer_get_run_contexts
+/* Returns a list of CutLogSummary in newest first order. */
+const GList   *cut_analyzer_get_summaries
                                       (CutAnalyzer  *analyzer);
 
+/* Deprecated: Run contexts of logs aren't kept. This always
+ * returns NULL. Use cut_analyzer_get_summaries() instead. */
+const GList   *cut_analyzer_get_run_contexts
+                                      (CutAnalyzer  *analyzer)
+                                      G_GNUC_DEPRECATED;
+
 G_END_DECLS
 
 #endif /* __CUT_ANALYZER_H__ */
@@ -0,0 +1,201 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <string.h>
+#include <glib.h>
+#include <glib/gprintf.h>
+
+#include "cut-arena.h"
+
+#define CHUNK_SIZE 4096
+/* A larger allocation uses its own chunk. It doesn't waste the
+ * rest of the current chunk. */
+#define MAX_SHARED_ALLOCATION_SIZE (CHUNK_SIZE / 4)
+#define ALIGNMENT (2 * sizeof(gpointer))
+#define ALIGN(size) (((size) + ALIGNMENT - 1) & ~(ALIGNMENT - 1))
+#define CHUNK_HEADER_SIZE ALIGN(sizeof(Chunk))
+#define PRINTF_BUFFER_SIZE 256
+
+typedef struct _Chunk Chunk;
+struct _Chunk
+{
+    Chunk *next;
+    gsize size;
+    gsize used;
+};
+
+struct _CutArena
+{
+    /* The head is the current chunk. */
+    Chunk *chunks;
+    gsize allocated_size;
+};
+
+static Chunk *
+chunk_new (gsize size)
+{
+    Chunk *chunk;
+
+    chunk = g_malloc(CHUNK_HEADER_SIZE + size);
+    chunk->next = NULL;
+    chunk->size = size;
+    chunk->used = 0;
+
+    return chunk;
+}
+
+static void
+free_chunks (Chunk *chunk)
+{
+    while (chunk) {
+        Chunk *next = chunk->next;
+
+        g_free(chunk);
+        chunk = next;
+    }
+}
+
+CutArena *
+cut_arena_new (void)
+{
+    CutArena *arena;
+
+    arena = g_new0(CutArena, 1);
+    arena->chunks = NULL;
+    arena->allocated_size = 0;
+
+    return arena;
+}
+
+void
+cut_arena_free (CutArena *arena)
+{
+    free_chunks(arena->chunks);
+    g_free(arena);
+}
+
+gpointer
+cut_arena_alloc (CutArena *arena, gsize size)
+{
+    Chunk *chunk;
+    gpointer memory;
+
+    size = ALIGN(MAX(size, 1));
+    if (size > MAX_SHARED_ALLOCATION_SIZE) {
+        chunk = chunk_new(size);
+        chunk->used = size;
+        if (arena->chunks) {
+            chunk->next = arena->chunks->next;
+            arena->chunks->next = chunk;
+        } else {
+            arena->chunks = chunk;
+        }
+        arena->allocated_size += size;
+        return (gchar *)chunk + CHUNK_HEADER_SIZE;
+    }
+
+    chunk = arena->chunks;
+    if (!chunk || chunk->size != CHUNK_SIZE || chunk->size - chunk->used < size) {
+        chunk = chunk_new(CHUNK_SIZE);
+        chunk->next = arena->chunks;
+        arena->chunks = chunk;
+    }
+
+    memory = (gchar *)chunk + CHUNK_HEADER_SIZE + chunk->used;
+    chunk->used += size;
+    arena->allocated_size += size;
+
+    return memory;
+}
+
+gchar *
+cut_arena_strdup (CutArena *arena, const gchar *string)
+{
+    if (!string)
+        return NULL;
+
+    return cut_arena_memdup(arena, string, strlen(string) + 1);
+}
+
+gchar *
+cut_arena_strndup (CutArena *arena, const gchar *string, gsize size)
+{
+    gchar *duplicated;
+
+    if (!string)
+        return NULL;
+
+    /* The same as g_strndup(). The rest is filled with '\0'. */
+    duplicated = cut_arena_alloc(arena, size + 1);
+    strncpy(duplicated, string, size);
+    duplicated[size] = '\0';
+
+    return duplicated;
+}
+
+gpointer
+cut_arena_memdup (CutArena *arena, gconstpointer memory, gsize size)
+{
+    gpointer duplicated;
+
+    if (!memory || size == 0)
+        return NULL;
+
+    duplicated = cut_arena_alloc(arena, size);
+    memcpy(duplicated, memory, size);
+
+    return duplicated;
+}
+
+gchar *
+cut_arena_vprintf (CutArena *arena, const gchar *format, va_list args)
+{
+    gchar buffer[PRINTF_BUFFER_SIZE];
+    gchar *formatted_string;
+    gint length;
+    va_list copied_args;
+
+    G_VA_COPY(copied_args, args);
+    length = g_vsnprintf(buffer, sizeof(buffer), format, copied_args);
+    va_end(copied_args);
+    if (length < 0)
+        return NULL;
+
+    if (length < PRINTF_BUFFER_SIZE)
+        return cut_arena_memdup(arena, buffer, length + 1);
+
+    formatted_string = cut_arena_alloc(arena, length + 1);
+    g_vsnprintf(formatted_string, length + 1, format, args);
+
+    return formatted_string;
+}
+
+gsize
+cut_arena_get_allocated_size (CutArena *arena)
+{
+    return arena->allocated_size;
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
@@ -0,0 +1,62 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CUT_ARENA_H__
+#define __CUT_ARENA_H__
+
+#include <stdarg.h>
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/*
+ * CutArena is a bump pointer allocator. Memory allocated from
+ * an arena can't be freed one by one. All of them are released
+ * at once by cut_arena_free(). It isn't thread safe.
+ */
+typedef struct _CutArena CutArena;
+
+CutArena *cut_arena_new      (void);
+void      cut_arena_free     (CutArena    *arena);
+
+gpointer  cut_arena_alloc    (CutArena    *arena,
+                              gsize        size);
+gchar    *cut_arena_strdup   (CutArena    *arena,
+                              const gchar *string);
+gchar    *cut_arena_strndup  (CutArena    *arena,
+                              const gchar *string,
+                              gsize        size);
+gpointer  cut_arena_memdup   (CutArena    *arena,
+                              gconstpointer memory,
+                              gsize        size);
+gchar    *cut_arena_vprintf  (CutArena    *arena,
+                              const gchar *format,
+                              va_list      args);
+
+gsize     cut_arena_get_allocated_size
+                             (CutArena    *arena);
+
+G_END_DECLS
+
+#endif /* __CUT_ARENA_H__ */
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
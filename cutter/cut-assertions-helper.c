@@ -23,6 +23,9 @@
 
 #include <string.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
 #ifdef HAVE_UNISTD_H
 #  include <unistd.h>
 #endif
@@ -1568,104 +1571,247 @@ cut_assert_equal_fixture_data_string_helper (const char     *expected,
                                    full_path);
 }
 
-void
-cut_assert_equal_file_raw_helper (const char     *expected,
-                                  const char     *actual,
-                                  const char     *expression_expected,
-                                  const char     *expression_actual)
+#define FILE_COMPARE_CHUNK_SIZE (64 * 1024)
+
+#ifndef S_ISREG
+#  define S_ISREG(mode) (((mode) & S_IFMT) == S_IFREG)
+#endif
+
+/*
+ * A regular file is mapped instead of read into memory. So a
+ * large file isn't copied and only compared pages are loaded.
+ * Other files, e.g. files in /proc, pipes and devices, can't be
+ * mapped or have no size. They are read by chunk only until
+ * the first difference.
+ */
+typedef struct _FileContent
 {
-    GError *error = NULL;
-    gchar *expected_data = NULL;
-    gchar *actual_data = NULL;
-    gsize expected_size;
-    gsize actual_size;
+    GMappedFile *mapped_file;
+    int fd;
+    GString *buffer;
+    cut_boolean eof;
+} FileContent;
 
-    g_file_get_contents(expected, &expected_data, &expected_size, &error);
-    gcut_assert_error_helper(error, expression_expected);
-    cut_take_string(expected_data);
+static cut_boolean
+file_content_open (FileContent *content, const char *path, GError **error)
+{
+    struct stat status;
 
-    g_file_get_contents(actual, &actual_data, &actual_size, &error);
-    gcut_assert_error_helper(error, expression_actual);
-    cut_take_string(actual_data);
+    content->mapped_file = NULL;
+    content->fd = g_open(path, O_RDONLY, 0);
+    content->buffer = NULL;
+    content->eof = CUT_FALSE;
+    if (content->fd == -1) {
+        int open_errno = errno;
+        g_set_error(error, G_FILE_ERROR, g_file_error_from_errno(open_errno),
+                    "failed to open file: <%s>: %s",
+                    path, g_strerror(open_errno));
+        return CUT_FALSE;
+    }
 
-    if ((expected_size == actual_size) &&
-        memcmp(expected_data, actual_data, expected_size) == 0) {
-        cut_test_pass();
-    } else {
-        const char *message;
-        const char *inspected_expected;
-        const char *inspected_actual;
+    if (fstat(content->fd, &status) == 0 && S_ISREG(status.st_mode)) {
+        close(content->fd);
+        content->fd = -1;
+        content->mapped_file = g_mapped_file_new(path, FALSE, error);
+        return content->mapped_file != NULL;
+    }
 
-        inspected_expected =
-            cut_take_string(cut_utils_inspect_memory(expected_data,
-                                                     expected_size));
-        inspected_actual =
-            cut_take_string(cut_utils_inspect_memory(actual_data, actual_size));
-        message = cut_take_printf("<content(%s) == content(%s)>",
-                                  expression_expected,
-                                  expression_actual);
-        cut_set_expected(cut_take_printf("path: <%s>\n"
-                                         "%s (size: %" G_GSIZE_FORMAT ")",
-                                         expected,
-                                         inspected_expected,
-                                         expected_size));
-        cut_set_actual(cut_take_printf("path: <%s>\n"
-                                       "%s (size: %" G_GSIZE_FORMAT ")",
-                                       actual,
-                                       inspected_actual,
-                                       actual_size));
-        cut_test_fail(message);
+    content->buffer = g_string_new(NULL);
+    return CUT_TRUE;
+}
+
+static void
+file_content_close (FileContent *content)
+{
+    if (content->mapped_file) {
+#if GLIB_CHECK_VERSION(2, 22, 0)
+        g_mapped_file_unref(content->mapped_file);
+#else
+        g_mapped_file_free(content->mapped_file);
+#endif
     }
+    if (content->fd != -1)
+        close(content->fd);
+    if (content->buffer)
+        g_string_free(content->buffer, TRUE);
 }
 
-void
-cut_assert_not_equal_file_raw_helper (const char     *expected,
-                                      const char     *actual,
-                                      const char     *expression_expected,
-                                      const char     *expression_actual)
+/* Reads until size bytes are available or the end of file. */
+static void
+file_content_fill (FileContent *content, gsize size)
+{
+    gchar chunk[4096];
+
+    if (content->mapped_file)
+        return;
+
+    while (!content->eof && content->buffer->len < size) {
+        gssize read_size;
+
+        read_size = read(content->fd, chunk, sizeof(chunk));
+        if (read_size == -1 && errno == EINTR)
+            continue;
+        if (read_size <= 0) {
+            content->eof = CUT_TRUE;
+            break;
+        }
+        g_string_append_len(content->buffer, chunk, read_size);
+    }
+}
+
+static const gchar *
+file_content_get_data (FileContent *content)
+{
+    if (content->mapped_file)
+        return g_mapped_file_get_contents(content->mapped_file);
+    else
+        return content->buffer->str;
+}
+
+static gsize
+file_content_get_size (FileContent *content)
+{
+    if (content->mapped_file)
+        return g_mapped_file_get_length(content->mapped_file);
+    else
+        return content->buffer->len;
+}
+
+static cut_boolean
+find_first_different_offset (FileContent *expected,
+                             FileContent *actual,
+                             gsize       *offset)
+{
+    gsize i = 0;
+
+    while (CUT_TRUE) {
+        const gchar *expected_data, *actual_data;
+        gsize expected_size, actual_size, size, j;
+
+        file_content_fill(expected, i + FILE_COMPARE_CHUNK_SIZE);
+        file_content_fill(actual, i + FILE_COMPARE_CHUNK_SIZE);
+        expected_data = file_content_get_data(expected);
+        expected_size = file_content_get_size(expected);
+        actual_data = file_content_get_data(actual);
+        actual_size = file_content_get_size(actual);
+
+        size = MIN(MIN(expected_size, actual_size),
+                   i + FILE_COMPARE_CHUNK_SIZE);
+        if (size > i &&
+            memcmp(expected_data + i, actual_data + i, size - i) != 0) {
+            for (j = i; expected_data[j] == actual_data[j]; j++) {
+            }
+            *offset = j;
+            return CUT_TRUE;
+        }
+
+        /* At least one of them reaches the end. */
+        if (size < i + FILE_COMPARE_CHUNK_SIZE) {
+            if (expected_size != actual_size) {
+                *offset = size;
+                return CUT_TRUE;
+            }
+            return CUT_FALSE;
+        }
+
+        i = size;
+    }
+}
+
+static const char *
+inspect_file_content (const char  *path,
+                      FileContent *content,
+                      cut_boolean  different,
+                      gsize        offset)
+{
+    const char *hexdump, *size_label;
+    gsize size;
+
+    size = file_content_get_size(content);
+    hexdump = cut_take_string(
+        cut_utils_hexdump_around(file_content_get_data(content),
+                                 size, offset));
+    /* Only the compared part of a file that isn't mapped is read. */
+    size_label = content->mapped_file ? "size" : "read size";
+    if (different)
+        return cut_take_printf("path: <%s>\n"
+                               "%s: <%" G_GSIZE_FORMAT ">\n"
+                               "first difference at: <%" G_GSIZE_FORMAT ">\n"
+                               "%s",
+                               path, size_label, size, offset, hexdump);
+    else
+        return cut_take_printf("path: <%s>\n"
+                               "%s: <%" G_GSIZE_FORMAT ">\n"
+                               "%s",
+                               path, size_label, size, hexdump);
+}
+
+static void
+assert_file_raw (const char  *expected,
+                 const char  *actual,
+                 const char  *expression_expected,
+                 const char  *expression_actual,
+                 cut_boolean  need_equal)
 {
     GError *error = NULL;
-    gchar *expected_data = NULL;
-    gchar *actual_data = NULL;
-    gsize expected_size;
-    gsize actual_size;
+    FileContent expected_content, actual_content;
+    const char *inspected_expected, *inspected_actual;
+    cut_boolean different;
+    gsize offset = 0;
 
-    g_file_get_contents(expected, &expected_data, &expected_size, &error);
+    if (!file_content_open(&expected_content, expected, &error))
+        file_content_close(&expected_content);
     gcut_assert_error_helper(error, expression_expected);
-    cut_take_string(expected_data);
 
-    g_file_get_contents(actual, &actual_data, &actual_size, &error);
+    if (!file_content_open(&actual_content, actual, &error)) {
+        file_content_close(&expected_content);
+        file_content_close(&actual_content);
+    }
     gcut_assert_error_helper(error, expression_actual);
-    cut_take_string(actual_data);
 
-    if ((expected_size != actual_size) ||
-        memcmp(expected_data, actual_data, expected_size) != 0) {
+    different = find_first_different_offset(&expected_content,
+                                            &actual_content,
+                                            &offset);
+    if (different != need_equal) {
+        file_content_close(&expected_content);
+        file_content_close(&actual_content);
         cut_test_pass();
-    } else {
-        const char *message;
-        const char *inspected_expected;
-        const char *inspected_actual;
+        return;
+    }
 
-        inspected_expected =
-            cut_take_string(cut_utils_inspect_memory(expected_data,
-                                                     expected_size));
-        inspected_actual =
-            cut_take_string(cut_utils_inspect_memory(actual_data, actual_size));
-        message = cut_take_printf("<content(%s) != content(%s)>",
+    inspected_expected = inspect_file_content(expected, &expected_content,
+                                              different, offset);
+    inspected_actual = inspect_file_content(actual, &actual_content,
+                                            different, offset);
+    file_content_close(&expected_content);
+    file_content_close(&actual_content);
+
+    cut_set_expected(inspected_expected);
+    cut_set_actual(inspected_actual);
+    cut_test_fail(cut_take_printf("<content(%s) %s content(%s)>",
                                   expression_expected,
-                                  expression_actual);
-        cut_set_expected(cut_take_printf("path: <%s>\n"
-                                         "%s (size: %" G_GSIZE_FORMAT ")",
-                                         expected,
-                                         inspected_expected,
-                                         expected_size));
-        cut_set_actual(cut_take_printf("path: <%s>\n"
-                                       "%s (size: %" G_GSIZE_FORMAT ")",
-                                       actual,
-                                       inspected_actual,
-                                       actual_size));
-        cut_test_fail(message);
-    }
+                                  need_equal ? "==" : "!=",
+                                  expression_actual));
+}
+
+void
+cut_assert_equal_file_raw_helper (const char     *expected,
+                                  const char     *actual,
+                                  const char     *expression_expected,
+                                  const char     *expression_actual)
+{
+    assert_file_raw(expected, actual, expression_expected, expression_actual,
+                    CUT_TRUE);
+}
+
+void
+cut_assert_not_equal_file_raw_helper (const char     *expected,
+                                      const char     *actual,
+                                      const char     *expression_expected,
+                                      const char     *expression_actual)
+{
+    assert_file_raw(expected, actual, expression_expected, expression_actual,
+                    CUT_FALSE);
 }
 
 #ifndef CUT_DISABLE_SOCKET_SUPPORT
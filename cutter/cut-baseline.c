@@ -0,0 +1,256 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <errno.h>
+#include <math.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+
+#include "cut-baseline.h"
+#include "cut-logger.h"
+
+#define TEST_KEY_PREFIX "Test."
+/* A list of the mean, the standard deviation and the number of
+ * samples. */
+#define BENCHMARK_KEY_PREFIX "Benchmark."
+#define N_BENCHMARK_VALUES 3
+
+struct _CutBaseline
+{
+    gchar *filename;
+    GKeyFile *key_file;
+};
+
+CutBaseline *
+cut_baseline_new (const gchar *filename)
+{
+    CutBaseline *baseline;
+
+    baseline = g_new0(CutBaseline, 1);
+    baseline->filename = g_strdup(filename);
+    baseline->key_file = g_key_file_new();
+
+    return baseline;
+}
+
+void
+cut_baseline_free (CutBaseline *baseline)
+{
+    g_free(baseline->filename);
+    g_key_file_free(baseline->key_file);
+    g_free(baseline);
+}
+
+const gchar *
+cut_baseline_get_filename (CutBaseline *baseline)
+{
+    return baseline->filename;
+}
+
+gboolean
+cut_baseline_load (CutBaseline *baseline, GError **error)
+{
+    if (!g_key_file_load_from_file(baseline->key_file, baseline->filename,
+                                   G_KEY_FILE_NONE, error))
+        return FALSE;
+
+    cut_log_trace("[baseline][load] <%s>", baseline->filename);
+    return TRUE;
+}
+
+gboolean
+cut_baseline_save (CutBaseline *baseline, GError **error)
+{
+    gchar *data, *directory;
+    gsize length;
+    gboolean success;
+
+    directory = g_path_get_dirname(baseline->filename);
+    if (g_mkdir_with_parents(directory, 0755) == -1) {
+        g_set_error(error,
+                    G_FILE_ERROR,
+                    g_file_error_from_errno(errno),
+                    "failed to create baseline directory: %s: %s",
+                    directory, g_strerror(errno));
+        g_free(directory);
+        return FALSE;
+    }
+    g_free(directory);
+
+    data = g_key_file_to_data(baseline->key_file, &length, NULL);
+    success = g_file_set_contents(baseline->filename, data, length, error);
+    g_free(data);
+
+    if (success)
+        cut_log_trace("[baseline][save] <%s>", baseline->filename);
+    return success;
+}
+
+void
+cut_baseline_record_test (CutBaseline *baseline,
+                          const gchar *test_case_name,
+                          const gchar *test_name,
+                          gdouble elapsed)
+{
+    gchar *key;
+
+    key = g_strconcat(TEST_KEY_PREFIX, test_name, NULL);
+    g_key_file_set_double(baseline->key_file, test_case_name, key, elapsed);
+    g_free(key);
+}
+
+void
+cut_baseline_record_benchmark (CutBaseline *baseline,
+                               const gchar *test_case_name,
+                               const gchar *test_name,
+                               CutBenchmarkResult *result)
+{
+    gchar *key;
+    gdouble values[N_BENCHMARK_VALUES];
+
+    values[0] = cut_benchmark_result_get_mean(result);
+    values[1] = cut_benchmark_result_get_standard_deviation(result);
+    values[2] = cut_benchmark_result_get_n_samples(result);
+
+    key = g_strconcat(BENCHMARK_KEY_PREFIX, test_name, NULL);
+    g_key_file_set_double_list(baseline->key_file, test_case_name, key,
+                               values, N_BENCHMARK_VALUES);
+    g_free(key);
+}
+
+gdouble
+cut_baseline_get_test_elapsed (CutBaseline *baseline,
+                               const gchar *test_case_name,
+                               const gchar *test_name)
+{
+    gchar *key;
+    gdouble elapsed;
+    GError *error = NULL;
+
+    key = g_strconcat(TEST_KEY_PREFIX, test_name, NULL);
+    elapsed = g_key_file_get_double(baseline->key_file, test_case_name, key,
+                                    &error);
+    g_free(key);
+    if (error) {
+        g_error_free(error);
+        return -1.0;
+    }
+
+    return elapsed;
+}
+
+CutBenchmarkResult *
+cut_baseline_get_benchmark (CutBaseline *baseline,
+                            const gchar *test_case_name,
+                            const gchar *test_name)
+{
+    CutBenchmarkResult *result;
+    gchar *key;
+    gdouble *values;
+    gsize length;
+
+    key = g_strconcat(BENCHMARK_KEY_PREFIX, test_name, NULL);
+    values = g_key_file_get_double_list(baseline->key_file, test_case_name,
+                                        key, &length, NULL);
+    g_free(key);
+    if (!values)
+        return NULL;
+    if (length != N_BENCHMARK_VALUES || values[2] < 1.0) {
+        g_free(values);
+        return NULL;
+    }
+
+    result = cut_benchmark_result_new_empty();
+    cut_benchmark_result_set_mean(result, values[0]);
+    cut_benchmark_result_set_standard_deviation(result, values[1]);
+    cut_benchmark_result_set_n_samples(result, values[2]);
+    g_free(values);
+
+    return result;
+}
+
+gboolean
+cut_baseline_has_benchmark (CutBaseline *baseline,
+                            const gchar *test_case_name,
+                            const gchar *test_name)
+{
+    gchar *key;
+    gboolean exist;
+
+    key = g_strconcat(BENCHMARK_KEY_PREFIX, test_name, NULL);
+    exist = g_key_file_has_key(baseline->key_file, test_case_name, key, NULL);
+    g_free(key);
+
+    return exist;
+}
+
+gboolean
+cut_baseline_is_regressed_test (gdouble baseline_elapsed, gdouble elapsed,
+                                gdouble threshold)
+{
+    if (baseline_elapsed < 0.0)
+        return FALSE;
+
+    if (elapsed - baseline_elapsed < CUT_BASELINE_MIN_REGRESSION_ELAPSED)
+        return FALSE;
+
+    return elapsed > baseline_elapsed * (1.0 + threshold / 100.0);
+}
+
+gboolean
+cut_baseline_is_regressed_benchmark (CutBenchmarkResult *baseline_result,
+                                     CutBenchmarkResult *result,
+                                     gdouble threshold)
+{
+    gdouble baseline_mean, mean, baseline_deviation, deviation;
+    gdouble standard_error;
+    guint baseline_n_samples, n_samples;
+
+    baseline_mean = cut_benchmark_result_get_mean(baseline_result);
+    mean = cut_benchmark_result_get_mean(result);
+    if (mean <= baseline_mean * (1.0 + threshold / 100.0))
+        return FALSE;
+
+    baseline_n_samples = cut_benchmark_result_get_n_samples(baseline_result);
+    n_samples = cut_benchmark_result_get_n_samples(result);
+    if (baseline_n_samples == 0 || n_samples == 0)
+        return FALSE;
+
+    baseline_deviation =
+        cut_benchmark_result_get_standard_deviation(baseline_result);
+    deviation = cut_benchmark_result_get_standard_deviation(result);
+    standard_error =
+        sqrt(baseline_deviation * baseline_deviation / baseline_n_samples +
+             deviation * deviation / n_samples);
+    /* Both are stable. The threshold is enough. */
+    if (standard_error == 0.0)
+        return TRUE;
+
+    return (mean - baseline_mean) / standard_error >=
+        CUT_BASELINE_SIGNIFICANCE_T_VALUE;
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
@@ -0,0 +1,97 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef __CUT_BASELINE_H__
+#define __CUT_BASELINE_H__
+
+#include <glib.h>
+
+#include <cutter/cut-benchmark-result.h>
+
+G_BEGIN_DECLS
+
+/*
+ * CutBaseline keeps elapsed times of tests and statistics of
+ * benchmarks measured by a run. A later run is compared with
+ * it to find performance regressions. Unlike CutTimingHistory,
+ * a recorded value replaces the previous one.
+ */
+typedef struct _CutBaseline CutBaseline;
+
+#define CUT_BASELINE_DEFAULT_REGRESSION_THRESHOLD 20.0
+/* A test that is slower only by this many seconds isn't
+ * regressed. Elapsed times of short tests are noisy. */
+#define CUT_BASELINE_MIN_REGRESSION_ELAPSED 0.01
+/* About 95% confidence with CUT_BENCHMARK_N_SAMPLES samples. */
+#define CUT_BASELINE_SIGNIFICANCE_T_VALUE 2.0
+
+CutBaseline        *cut_baseline_new           (const gchar        *filename);
+void                cut_baseline_free          (CutBaseline        *baseline);
+
+const gchar        *cut_baseline_get_filename  (CutBaseline        *baseline);
+gboolean            cut_baseline_load          (CutBaseline        *baseline,
+                                                GError            **error);
+gboolean            cut_baseline_save          (CutBaseline        *baseline,
+                                                GError            **error);
+
+void                cut_baseline_record_test   (CutBaseline        *baseline,
+                                                const gchar        *test_case_name,
+                                                const gchar        *test_name,
+                                                gdouble             elapsed);
+void                cut_baseline_record_benchmark
+                                               (CutBaseline        *baseline,
+                                                const gchar        *test_case_name,
+                                                const gchar        *test_name,
+                                                CutBenchmarkResult *result);
+
+/* Returns a negative value for an unknown test. */
+gdouble             cut_baseline_get_test_elapsed
+                                               (CutBaseline        *baseline,
+                                                const gchar        *test_case_name,
+                                                const gchar        *test_name);
+/* Returns NULL for an unknown benchmark. Only the mean, the
+ * standard deviation and the number of samples are set. */
+CutBenchmarkResult *cut_baseline_get_benchmark (CutBaseline        *baseline,
+                                                const gchar        *test_case_name,
+                                                const gchar        *test_name);
+gboolean            cut_baseline_has_benchmark (CutBaseline        *baseline,
+                                                const gchar        *test_case_name,
+                                                const gchar        *test_name);
+
+/* threshold is a percentage of the baseline value. */
+gboolean            cut_baseline_is_regressed_test
+                                               (gdouble             baseline_elapsed,
+                                                gdouble             elapsed,
+                                                gdouble             threshold);
+/* A benchmark is regressed only when its mean is over the
+ * threshold and the difference is significant by Welch's
+ * t-test. */
+gboolean            cut_baseline_is_regressed_benchmark
+                                               (CutBenchmarkResult *baseline_result,
+                                                CutBenchmarkResult *result,
+                                                gdouble             threshold);
+
+G_END_DECLS
+
+#endif /* __CUT_BASELINE_H__ */
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
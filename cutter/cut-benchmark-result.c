@@ -0,0 +1,475 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <glib.h>
+
+#include "cut-benchmark-result.h"
+#include "cut-utils.h"
+
+#define CUT_BENCHMARK_RESULT_GET_PRIVATE(obj) \
+    ((CutBenchmarkResultPrivate *) \
+     cut_benchmark_result_get_instance_private(CUT_BENCHMARK_RESULT(obj)))
+
+typedef struct _CutBenchmarkResultPrivate CutBenchmarkResultPrivate;
+struct _CutBenchmarkResultPrivate
+{
+    guint n_iterations;
+    guint n_samples;
+    gdouble mean;
+    gdouble median;
+    gdouble standard_deviation;
+    gdouble minimum;
+    gdouble maximum;
+};
+
+enum
+{
+    PROP_0,
+    PROP_N_ITERATIONS,
+    PROP_N_SAMPLES,
+    PROP_MEAN,
+    PROP_MEDIAN,
+    PROP_STANDARD_DEVIATION,
+    PROP_MINIMUM,
+    PROP_MAXIMUM
+};
+
+G_DEFINE_TYPE_WITH_PRIVATE(CutBenchmarkResult,
+                           cut_benchmark_result,
+                           G_TYPE_OBJECT)
+
+static void set_property   (GObject         *object,
+                            guint            prop_id,
+                            const GValue    *value,
+                            GParamSpec      *pspec);
+static void get_property   (GObject         *object,
+                            guint            prop_id,
+                            GValue          *value,
+                            GParamSpec      *pspec);
+
+static void
+install_double_property (GObjectClass *gobject_class, guint prop_id,
+                         const gchar *name, const gchar *nick,
+                         const gchar *blurb)
+{
+    GParamSpec *spec;
+
+    spec = g_param_spec_double(name, nick, blurb,
+                               0.0, G_MAXDOUBLE, 0.0,
+                               G_PARAM_READWRITE);
+    g_object_class_install_property(gobject_class, prop_id, spec);
+}
+
+static void
+cut_benchmark_result_class_init (CutBenchmarkResultClass *klass)
+{
+    GObjectClass *gobject_class;
+    GParamSpec *spec;
+
+    gobject_class = G_OBJECT_CLASS(klass);
+
+    gobject_class->set_property = set_property;
+    gobject_class->get_property = get_property;
+
+    spec = g_param_spec_uint("n-iterations",
+                             "Number of iterations",
+                             "The number of calls in a sample",
+                             0, G_MAXUINT32, 0,
+                             G_PARAM_READWRITE);
+    g_object_class_install_property(gobject_class, PROP_N_ITERATIONS, spec);
+
+    spec = g_param_spec_uint("n-samples",
+                             "Number of samples",
+                             "The number of samples",
+                             0, G_MAXUINT32, 0,
+                             G_PARAM_READWRITE);
+    g_object_class_install_property(gobject_class, PROP_N_SAMPLES, spec);
+
+    install_double_property(gobject_class, PROP_MEAN,
+                            "mean", "Mean",
+                            "The mean of samples in seconds");
+    install_double_property(gobject_class, PROP_MEDIAN,
+                            "median", "Median",
+                            "The median of samples in seconds");
+    install_double_property(gobject_class, PROP_STANDARD_DEVIATION,
+                            "standard-deviation", "Standard deviation",
+                            "The standard deviation of samples in seconds");
+    install_double_property(gobject_class, PROP_MINIMUM,
+                            "minimum", "Minimum",
+                            "The minimum sample in seconds");
+    install_double_property(gobject_class, PROP_MAXIMUM,
+                            "maximum", "Maximum",
+                            "The maximum sample in seconds");
+}
+
+static void
+cut_benchmark_result_init (CutBenchmarkResult *result)
+{
+    CutBenchmarkResultPrivate *priv;
+
+    priv = CUT_BENCHMARK_RESULT_GET_PRIVATE(result);
+    priv->n_iterations = 0;
+    priv->n_samples = 0;
+    priv->mean = 0.0;
+    priv->median = 0.0;
+    priv->standard_deviation = 0.0;
+    priv->minimum = 0.0;
+    priv->maximum = 0.0;
+}
+
+static void
+set_property (GObject      *object,
+              guint         prop_id,
+              const GValue *value,
+              GParamSpec   *pspec)
+{
+    CutBenchmarkResultPrivate *priv;
+
+    priv = CUT_BENCHMARK_RESULT_GET_PRIVATE(object);
+    switch (prop_id) {
+      case PROP_N_ITERATIONS:
+        priv->n_iterations = g_value_get_uint(value);
+        break;
+      case PROP_N_SAMPLES:
+        priv->n_samples = g_value_get_uint(value);
+        break;
+      case PROP_MEAN:
+        priv->mean = g_value_get_double(value);
+        break;
+      case PROP_MEDIAN:
+        priv->median = g_value_get_double(value);
+        break;
+      case PROP_STANDARD_DEVIATION:
+        priv->standard_deviation = g_value_get_double(value);
+        break;
+      case PROP_MINIMUM:
+        priv->minimum = g_value_get_double(value);
+        break;
+      case PROP_MAXIMUM:
+        priv->maximum = g_value_get_double(value);
+        break;
+      default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+}
+
+static void
+get_property (GObject    *object,
+              guint       prop_id,
+              GValue     *value,
+              GParamSpec *pspec)
+{
+    CutBenchmarkResultPrivate *priv;
+
+    priv = CUT_BENCHMARK_RESULT_GET_PRIVATE(object);
+    switch (prop_id) {
+      case PROP_N_ITERATIONS:
+        g_value_set_uint(value, priv->n_iterations);
+        break;
+      case PROP_N_SAMPLES:
+        g_value_set_uint(value, priv->n_samples);
+        break;
+      case PROP_MEAN:
+        g_value_set_double(value, priv->mean);
+        break;
+      case PROP_MEDIAN:
+        g_value_set_double(value, priv->median);
+        break;
+      case PROP_STANDARD_DEVIATION:
+        g_value_set_double(value, priv->standard_deviation);
+        break;
+      case PROP_MINIMUM:
+        g_value_set_double(value, priv->minimum);
+        break;
+      case PROP_MAXIMUM:
+        g_value_set_double(value, priv->maximum);
+        break;
+      default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+}
+
+static gint
+compare_double (gconstpointer a, gconstpointer b)
+{
+    gdouble double_a = *((const gdouble *)a);
+    gdouble double_b = *((const gdouble *)b);
+
+    if (double_a < double_b)
+        return -1;
+    if (double_a > double_b)
+        return 1;
+    return 0;
+}
+
+static void
+compute_statistics (CutBenchmarkResultPrivate *priv,
+                    const gdouble *samples, guint n_samples)
+{
+    gdouble *sorted_samples;
+    gdouble sum = 0.0, squared_sum = 0.0;
+    guint i;
+
+    if (n_samples == 0)
+        return;
+
+    sorted_samples = g_new(gdouble, n_samples);
+    memcpy(sorted_samples, samples, sizeof(gdouble) * n_samples);
+    qsort(sorted_samples, n_samples, sizeof(gdouble), compare_double);
+
+    for (i = 0; i < n_samples; i++) {
+        sum += sorted_samples[i];
+    }
+    priv->mean = sum / n_samples;
+
+    if (n_samples % 2 == 0)
+        priv->median = (sorted_samples[n_samples / 2 - 1] +
+                        sorted_samples[n_samples / 2]) / 2.0;
+    else
+        priv->median = sorted_samples[n_samples / 2];
+
+    /* Sample standard deviation. A sample is a part of the
+     * infinite calls of the benchmark. */
+    if (n_samples > 1) {
+        for (i = 0; i < n_samples; i++) {
+            gdouble deviation = sorted_samples[i] - priv->mean;
+            squared_sum += deviation * deviation;
+        }
+        priv->standard_deviation = sqrt(squared_sum / (n_samples - 1));
+    }
+
+    priv->minimum = sorted_samples[0];
+    priv->maximum = sorted_samples[n_samples - 1];
+
+    g_free(sorted_samples);
+}
+
+CutBenchmarkResult *
+cut_benchmark_result_new (guint n_iterations,
+                          const gdouble *samples, guint n_samples)
+{
+    CutBenchmarkResult *result;
+    CutBenchmarkResultPrivate *priv;
+
+    result = g_object_new(CUT_TYPE_BENCHMARK_RESULT,
+                          "n-iterations", n_iterations,
+                          "n-samples", n_samples,
+                          NULL);
+    priv = CUT_BENCHMARK_RESULT_GET_PRIVATE(result);
+    compute_statistics(priv, samples, n_samples);
+
+    return result;
+}
+
+CutBenchmarkResult *
+cut_benchmark_result_new_empty (void)
+{
+    return cut_benchmark_result_new(0, NULL, 0);
+}
+
+guint
+cut_benchmark_result_get_n_iterations (CutBenchmarkResult *result)
+{
+    return CUT_BENCHMARK_RESULT_GET_PRIVATE(result)->n_iterations;
+}
+
+void
+cut_benchmark_result_set_n_iterations (CutBenchmarkResult *result,
+                                       guint n_iterations)
+{
+    CUT_BENCHMARK_RESULT_GET_PRIVATE(result)->n_iterations = n_iterations;
+}
+
+guint
+cut_benchmark_result_get_n_samples (CutBenchmarkResult *result)
+{
+    return CUT_BENCHMARK_RESULT_GET_PRIVATE(result)->n_samples;
+}
+
+void
+cut_benchmark_result_set_n_samples (CutBenchmarkResult *result,
+                                    guint n_samples)
+{
+    CUT_BENCHMARK_RESULT_GET_PRIVATE(result)->n_samples = n_samples;
+}
+
+gdouble
+cut_benchmark_result_get_mean (CutBenchmarkResult *result)
+{
+    return CUT_BENCHMARK_RESULT_GET_PRIVATE(result)->mean;
+}
+
+void
+cut_benchmark_result_set_mean (CutBenchmarkResult *result, gdouble mean)
+{
+    CUT_BENCHMARK_RESULT_GET_PRIVATE(result)->mean = mean;
+}
+
+gdouble
+cut_benchmark_result_get_median (CutBenchmarkResult *result)
+{
+    return CUT_BENCHMARK_RESULT_GET_PRIVATE(result)->median;
+}
+
+void
+cut_benchmark_result_set_median (CutBenchmarkResult *result, gdouble median)
+{
+    CUT_BENCHMARK_RESULT_GET_PRIVATE(result)->median = median;
+}
+
+gdouble
+cut_benchmark_result_get_standard_deviation (CutBenchmarkResult *result)
+{
+    return CUT_BENCHMARK_RESULT_GET_PRIVATE(result)->standard_deviation;
+}
+
+void
+cut_benchmark_result_set_standard_deviation (CutBenchmarkResult *result,
+                                             gdouble standard_deviation)
+{
+    CUT_BENCHMARK_RESULT_GET_PRIVATE(result)->standard_deviation =
+        standard_deviation;
+}
+
+gdouble
+cut_benchmark_result_get_minimum (CutBenchmarkResult *result)
+{
+    return CUT_BENCHMARK_RESULT_GET_PRIVATE(result)->minimum;
+}
+
+void
+cut_benchmark_result_set_minimum (CutBenchmarkResult *result, gdouble minimum)
+{
+    CUT_BENCHMARK_RESULT_GET_PRIVATE(result)->minimum = minimum;
+}
+
+gdouble
+cut_benchmark_result_get_maximum (CutBenchmarkResult *result)
+{
+    return CUT_BENCHMARK_RESULT_GET_PRIVATE(result)->maximum;
+}
+
+void
+cut_benchmark_result_set_maximum (CutBenchmarkResult *result, gdouble maximum)
+{
+    CUT_BENCHMARK_RESULT_GET_PRIVATE(result)->maximum = maximum;
+}
+
+gdouble
+cut_benchmark_result_get_operations_per_second (CutBenchmarkResult *result)
+{
+    gdouble mean;
+
+    mean = CUT_BENCHMARK_RESULT_GET_PRIVATE(result)->mean;
+    if (mean <= 0.0)
+        return 0.0;
+    return 1.0 / mean;
+}
+
+gchar *
+cut_benchmark_result_to_xml (CutBenchmarkResult *result)
+{
+    GString *string;
+
+    string = g_string_new(NULL);
+    cut_benchmark_result_to_xml_string(result, string, 0);
+    return g_string_free(string, FALSE);
+}
+
+static void
+append_xml_element_with_uint (GString *string, guint indent,
+                              const gchar *element_name, guint value)
+{
+    gchar *str;
+
+    str = g_strdup_printf("%u", value);
+    cut_utils_append_xml_element_with_value(string, indent, element_name, str);
+    g_free(str);
+}
+
+static void
+append_xml_element_with_double (GString *string, guint indent,
+                                const gchar *element_name, gdouble value)
+{
+    gchar str[G_ASCII_DTOSTR_BUF_SIZE];
+
+    /* "%f" of cut_utils_double_to_string() loses a sample of a
+     * fast benchmark. */
+    g_ascii_dtostr(str, sizeof(str), value);
+    cut_utils_append_xml_element_with_value(string, indent, element_name, str);
+}
+
+void
+cut_benchmark_result_to_xml_string (CutBenchmarkResult *result,
+                                    GString *string, guint indent)
+{
+    CutBenchmarkResultPrivate *priv;
+
+    priv = CUT_BENCHMARK_RESULT_GET_PRIVATE(result);
+
+    cut_utils_append_indent(string, indent);
+    g_string_append(string, "<benchmark-result>\n");
+    append_xml_element_with_uint(string, indent + 2, "n-iterations",
+                                 priv->n_iterations);
+    append_xml_element_with_uint(string, indent + 2, "n-samples",
+                                 priv->n_samples);
+    append_xml_element_with_double(string, indent + 2, "mean", priv->mean);
+    append_xml_element_with_double(string, indent + 2, "median", priv->median);
+    append_xml_element_with_double(string, indent + 2, "standard-deviation",
+                                   priv->standard_deviation);
+    append_xml_element_with_double(string, indent + 2, "minimum",
+                                   priv->minimum);
+    append_xml_element_with_double(string, indent + 2, "maximum",
+                                   priv->maximum);
+    append_xml_element_with_double(string, indent + 2, "operations-per-second",
+                                   cut_benchmark_result_get_operations_per_second(result));
+    cut_utils_append_indent(string, indent);
+    g_string_append(string, "</benchmark-result>\n");
+}
+
+gchar *
+cut_benchmark_result_format (CutBenchmarkResult *result)
+{
+    CutBenchmarkResultPrivate *priv;
+
+    priv = CUT_BENCHMARK_RESULT_GET_PRIVATE(result);
+    return g_strdup_printf("%.1f ops/sec "
+                           "(mean: %.3gs, median: %.3gs, stddev: %.3gs, "
+                           "%u iterations x %u samples)",
+                           cut_benchmark_result_get_operations_per_second(result),
+                           priv->mean,
+                           priv->median,
+                           priv->standard_deviation,
+                           priv->n_iterations,
+                           priv->n_samples);
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
@@ -0,0 +1,113 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef __CUT_BENCHMARK_RESULT_H__
+#define __CUT_BENCHMARK_RESULT_H__
+
+#include <glib-object.h>
+
+#include <cutter/cut-private.h>
+
+G_BEGIN_DECLS
+
+#define CUT_TYPE_BENCHMARK_RESULT            (cut_benchmark_result_get_type ())
+#define CUT_BENCHMARK_RESULT(obj)            (G_TYPE_CHECK_INSTANCE_CAST ((obj), CUT_TYPE_BENCHMARK_RESULT, CutBenchmarkResult))
+#define CUT_BENCHMARK_RESULT_CLASS(klass)    (G_TYPE_CHECK_CLASS_CAST ((klass), CUT_TYPE_BENCHMARK_RESULT, CutBenchmarkResultClass))
+#define CUT_IS_BENCHMARK_RESULT(obj)         (G_TYPE_CHECK_INSTANCE_TYPE ((obj), CUT_TYPE_BENCHMARK_RESULT))
+#define CUT_IS_BENCHMARK_RESULT_CLASS(klass) (G_TYPE_CHECK_CLASS_TYPE ((klass), CUT_TYPE_BENCHMARK_RESULT))
+#define CUT_BENCHMARK_RESULT_GET_CLASS(obj)  (G_TYPE_INSTANCE_GET_CLASS((obj), CUT_TYPE_BENCHMARK_RESULT, CutBenchmarkResultClass))
+
+typedef struct _CutBenchmarkResultClass CutBenchmarkResultClass;
+
+/*
+ * CutBenchmarkResult keeps statistics of a benchmark. Each
+ * sample is the elapsed time of one call of the benchmark
+ * function in seconds, averaged over n_iterations calls.
+ */
+struct _CutBenchmarkResult
+{
+    GObject object;
+};
+
+struct _CutBenchmarkResultClass
+{
+    GObjectClass parent_class;
+};
+
+GType               cut_benchmark_result_get_type  (void) G_GNUC_CONST;
+
+CutBenchmarkResult *cut_benchmark_result_new       (guint               n_iterations,
+                                                    const gdouble      *samples,
+                                                    guint               n_samples);
+CutBenchmarkResult *cut_benchmark_result_new_empty (void);
+
+guint               cut_benchmark_result_get_n_iterations
+                                                   (CutBenchmarkResult *result);
+void                cut_benchmark_result_set_n_iterations
+                                                   (CutBenchmarkResult *result,
+                                                    guint               n_iterations);
+guint               cut_benchmark_result_get_n_samples
+                                                   (CutBenchmarkResult *result);
+void                cut_benchmark_result_set_n_samples
+                                                   (CutBenchmarkResult *result,
+                                                    guint               n_samples);
+gdouble             cut_benchmark_result_get_mean  (CutBenchmarkResult *result);
+void                cut_benchmark_result_set_mean  (CutBenchmarkResult *result,
+                                                    gdouble             mean);
+gdouble             cut_benchmark_result_get_median
+                                                   (CutBenchmarkResult *result);
+void                cut_benchmark_result_set_median
+                                                   (CutBenchmarkResult *result,
+                                                    gdouble             median);
+gdouble             cut_benchmark_result_get_standard_deviation
+                                                   (CutBenchmarkResult *result);
+void                cut_benchmark_result_set_standard_deviation
+                                                   (CutBenchmarkResult *result,
+                                                    gdouble             standard_deviation);
+gdouble             cut_benchmark_result_get_minimum
+                                                   (CutBenchmarkResult *result);
+void                cut_benchmark_result_set_minimum
+                                                   (CutBenchmarkResult *result,
+                                                    gdouble             minimum);
+gdouble             cut_benchmark_result_get_maximum
+                                                   (CutBenchmarkResult *result);
+void                cut_benchmark_result_set_maximum
+                                                   (CutBenchmarkResult *result,
+                                                    gdouble             maximum);
+/* Returns 0.0 if the mean is 0.0. */
+gdouble             cut_benchmark_result_get_operations_per_second
+                                                   (CutBenchmarkResult *result);
+
+gchar              *cut_benchmark_result_to_xml    (CutBenchmarkResult *result);
+void                cut_benchmark_result_to_xml_string
+                                                   (CutBenchmarkResult *result,
+                                                    GString            *string,
+                                                    guint               indent);
+/* e.g.: "1234.5 ops/sec (mean: 0.00081s, median: 0.00080s,
+ * stddev: 0.00002s, 1000 iterations x 10 samples)" */
+gchar              *cut_benchmark_result_format    (CutBenchmarkResult *result);
+
+G_END_DECLS
+
+#endif /* __CUT_BENCHMARK_RESULT_H__ */
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
@@ -0,0 +1,301 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+
+#include "cut-benchmark.h"
+#include "cut-benchmark-result.h"
+#include "cut-run-context.h"
+#include "cut-test-context.h"
+#include "cut-logger.h"
+
+/* Calibration stops growing the number of calls here to avoid
+ * an overflow with an empty benchmark. */
+#define MAX_N_ITERATIONS (G_MAXUINT32 / 16)
+
+#define CUT_BENCHMARK_GET_PRIVATE(obj) \
+    ((CutBenchmarkPrivate *) \
+     cut_benchmark_get_instance_private(CUT_BENCHMARK(obj)))
+
+typedef struct _CutBenchmarkPrivate CutBenchmarkPrivate;
+struct _CutBenchmarkPrivate
+{
+    CutTestFunction benchmark_function;
+    /* It is kept for a benchmark that jumps out by a failure. */
+    GTimer *timer;
+};
+
+enum
+{
+    PROP_0,
+    PROP_BENCHMARK_FUNCTION
+};
+
+G_DEFINE_TYPE_WITH_PRIVATE(CutBenchmark, cut_benchmark, CUT_TYPE_TEST)
+
+static void dispose        (GObject         *object);
+static void set_property   (GObject         *object,
+                            guint            prop_id,
+                            const GValue    *value,
+                            GParamSpec      *pspec);
+static void get_property   (GObject         *object,
+                            guint            prop_id,
+                            GValue          *value,
+                            GParamSpec      *pspec);
+
+static gboolean     is_available (CutTest        *test,
+                                  CutTestContext *test_context,
+                                  CutRunContext  *run_context);
+static void         invoke       (CutTest        *test,
+                                  CutTestContext *test_context,
+                                  CutRunContext  *run_context);
+
+static void
+cut_benchmark_class_init (CutBenchmarkClass *klass)
+{
+    GObjectClass *gobject_class;
+    CutTestClass *test_class;
+    GParamSpec *spec;
+
+    gobject_class = G_OBJECT_CLASS(klass);
+
+    gobject_class->dispose      = dispose;
+    gobject_class->set_property = set_property;
+    gobject_class->get_property = get_property;
+
+    test_class = CUT_TEST_CLASS(klass);
+    test_class->is_available = is_available;
+    test_class->invoke = invoke;
+
+    spec = g_param_spec_pointer("benchmark-function",
+                                "Benchmark Function",
+                                "The function for benchmark",
+                                G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY);
+    g_object_class_install_property(gobject_class, PROP_BENCHMARK_FUNCTION,
+                                    spec);
+}
+
+static void
+cut_benchmark_init (CutBenchmark *benchmark)
+{
+    CutBenchmarkPrivate *priv = CUT_BENCHMARK_GET_PRIVATE(benchmark);
+
+    priv->benchmark_function = NULL;
+    priv->timer = NULL;
+}
+
+static void
+dispose (GObject *object)
+{
+    CutBenchmarkPrivate *priv = CUT_BENCHMARK_GET_PRIVATE(object);
+
+    priv->benchmark_function = NULL;
+
+    if (priv->timer) {
+        g_timer_destroy(priv->timer);
+        priv->timer = NULL;
+    }
+
+    G_OBJECT_CLASS(cut_benchmark_parent_class)->dispose(object);
+}
+
+static void
+set_property (GObject      *object,
+              guint         prop_id,
+              const GValue *value,
+              GParamSpec   *pspec)
+{
+    CutBenchmarkPrivate *priv = CUT_BENCHMARK_GET_PRIVATE(object);
+
+    switch (prop_id) {
+      case PROP_BENCHMARK_FUNCTION:
+        priv->benchmark_function = g_value_get_pointer(value);
+        break;
+      default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+}
+
+static void
+get_property (GObject    *object,
+              guint       prop_id,
+              GValue     *value,
+              GParamSpec *pspec)
+{
+    CutBenchmarkPrivate *priv = CUT_BENCHMARK_GET_PRIVATE(object);
+
+    switch (prop_id) {
+      case PROP_BENCHMARK_FUNCTION:
+        g_value_set_pointer(value, priv->benchmark_function);
+        break;
+      default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+}
+
+CutBenchmark *
+cut_benchmark_new (const gchar *name, CutTestFunction function)
+{
+    return g_object_new(CUT_TYPE_BENCHMARK,
+                        "element-name", "test",
+                        "name", name,
+                        "benchmark-function", function,
+                        NULL);
+}
+
+CutBenchmark *
+cut_benchmark_new_empty (void)
+{
+    return cut_benchmark_new(NULL, NULL);
+}
+
+gdouble
+cut_benchmark_get_time (CutBenchmark *benchmark)
+{
+    const gchar *value;
+    gchar *end;
+    gdouble time;
+
+    value = cut_test_get_attribute(CUT_TEST(benchmark), "benchmark-time");
+    if (!value)
+        return -1.0;
+
+    time = g_ascii_strtod(value, &end);
+    if (end == value || *end != '\0' || time < 0.0)
+        return -1.0;
+
+    return time;
+}
+
+static gboolean
+is_available (CutTest *test, CutTestContext *test_context,
+              CutRunContext *run_context)
+{
+    return CUT_BENCHMARK_GET_PRIVATE(test)->benchmark_function != NULL;
+}
+
+static gdouble
+run_iterations (CutTestFunction function, guint n_iterations, GTimer *timer)
+{
+    guint i;
+
+    g_timer_start(timer);
+    for (i = 0; i < n_iterations; i++) {
+        function();
+    }
+    g_timer_stop(timer);
+
+    return g_timer_elapsed(timer, NULL);
+}
+
+static guint
+calibrate (CutTestFunction function, gdouble sample_time, GTimer *timer)
+{
+    guint n_iterations = 1;
+
+    while (n_iterations < MAX_N_ITERATIONS) {
+        gdouble elapsed, scale;
+
+        elapsed = run_iterations(function, n_iterations, timer);
+        if (elapsed >= sample_time)
+            break;
+
+        /* Aim a bit over the sample time but don't trust a
+         * too short measurement too much. */
+        if (elapsed > 0.0)
+            scale = CLAMP(sample_time / elapsed * 1.2, 2.0, 10.0);
+        else
+            scale = 10.0;
+        n_iterations = MIN(n_iterations * scale, MAX_N_ITERATIONS);
+    }
+
+    return n_iterations;
+}
+
+static void
+invoke (CutTest *test, CutTestContext *test_context, CutRunContext *run_context)
+{
+    CutBenchmarkPrivate *priv;
+    CutTestFunction function;
+    CutBenchmarkResult *result;
+    gdouble benchmark_time, sample_time;
+    gdouble samples[CUT_BENCHMARK_N_SAMPLES];
+    guint i, n_iterations;
+    gchar *message;
+
+    priv = CUT_BENCHMARK_GET_PRIVATE(test);
+    function = priv->benchmark_function;
+
+    benchmark_time = cut_benchmark_get_time(CUT_BENCHMARK(test));
+    if (benchmark_time < 0.0)
+        benchmark_time = cut_run_context_get_benchmark_time(run_context);
+
+    if (cut_run_context_get_stop_before_test(run_context))
+        G_BREAKPOINT();
+
+    /* 0 means that a benchmark is only checked whether it works. */
+    if (benchmark_time == 0.0) {
+        function();
+        return;
+    }
+
+    /* Calibration and warm up take a share of the benchmark
+     * time. */
+    sample_time = benchmark_time / (CUT_BENCHMARK_N_SAMPLES + 2);
+    if (!priv->timer)
+        priv->timer = g_timer_new();
+    n_iterations = calibrate(function, sample_time, priv->timer);
+    cut_log_trace("[benchmark][calibrate] <%s>: <%u>",
+                  cut_test_get_name(test), n_iterations);
+    run_iterations(function, n_iterations, priv->timer);
+
+    for (i = 0; i < CUT_BENCHMARK_N_SAMPLES; i++) {
+        samples[i] = run_iterations(function, n_iterations, priv->timer) /
+            n_iterations;
+    }
+
+    if (cut_test_context_is_failed(test_context))
+        return;
+
+    result = cut_benchmark_result_new(n_iterations,
+                                      samples, CUT_BENCHMARK_N_SAMPLES);
+    g_signal_emit_by_name(test, "benchmark", test_context, result);
+    message = cut_run_context_check_benchmark_regression(run_context,
+                                                         test, test_context,
+                                                         result);
+    if (message) {
+        cut_test_emit_regression_result(test, test_context, run_context,
+                                        message);
+        g_free(message);
+    }
+    g_object_unref(result);
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
@@ -0,0 +1,1092 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <string.h>
+#include <glib.h>
+
+#include "cut-binary-stream-codec.h"
+#include "cut-test.h"
+#include "cut-test-suite.h"
+#include "cut-test-case.h"
+#include "cut-test-iterator.h"
+#include "cut-iterated-test.h"
+#include "cut-test-result.h"
+#include "cut-benchmark-result.h"
+#include "cut-backtrace-entry.h"
+#include "cut-utils.h"
+
+#define NULL_STRING_LENGTH G_MAXUINT32
+#define FRAME_HEADER_SIZE 4
+#define HEADER_SIZE (CUT_BINARY_STREAM_MAGIC_LENGTH + 1)
+
+typedef enum {
+    TEST_KIND_NONE,
+    TEST_KIND_TEST,
+    TEST_KIND_ITERATED_TEST,
+    TEST_KIND_TEST_CASE,
+    TEST_KIND_TEST_ITERATOR,
+    TEST_KIND_TEST_SUITE
+} TestKind;
+
+struct _CutBinaryStreamDecoder
+{
+    CutBinaryStreamEventFunction function;
+    gpointer user_data;
+    GString *buffer;
+    gboolean header_read;
+};
+
+typedef struct _Reader
+{
+    const guchar *data;
+    gsize length;
+    gsize offset;
+    gboolean truncated;
+} Reader;
+
+GQuark
+cut_binary_stream_error_quark (void)
+{
+    return g_quark_from_static_string("cut-binary-stream-error-quark");
+}
+
+gboolean
+cut_binary_stream_is_binary (const gchar *data, gsize length)
+{
+    return length > 0 && data[0] == CUT_BINARY_STREAM_MAGIC[0];
+}
+
+static void
+append_uint8 (GString *buffer, guint8 value)
+{
+    g_string_append_c(buffer, (gchar)value);
+}
+
+static void
+append_uint32 (GString *buffer, guint32 value)
+{
+    guint32 le_value;
+
+    le_value = GUINT32_TO_LE(value);
+    g_string_append_len(buffer, (const gchar *)&le_value, sizeof(le_value));
+}
+
+static void
+append_int64 (GString *buffer, gint64 value)
+{
+    gint64 le_value;
+
+    le_value = GINT64_TO_LE(value);
+    g_string_append_len(buffer, (const gchar *)&le_value, sizeof(le_value));
+}
+
+static void
+append_double (GString *buffer, gdouble value)
+{
+    guint64 bits;
+
+    memcpy(&bits, &value, sizeof(bits));
+    bits = GUINT64_TO_LE(bits);
+    g_string_append_len(buffer, (const gchar *)&bits, sizeof(bits));
+}
+
+static void
+append_string (GString *buffer, const gchar *value)
+{
+    gsize length;
+
+    if (!value) {
+        append_uint32(buffer, NULL_STRING_LENGTH);
+        return;
+    }
+
+    length = strlen(value);
+    append_uint32(buffer, length);
+    g_string_append_len(buffer, value, length);
+}
+
+static void
+append_time (GString *buffer, GTimeVal *time)
+{
+    append_int64(buffer, time->tv_sec);
+    append_int64(buffer, time->tv_usec);
+}
+
+static TestKind
+test_kind (CutTest *test)
+{
+    if (!test)
+        return TEST_KIND_NONE;
+    else if (CUT_IS_TEST_SUITE(test))
+        return TEST_KIND_TEST_SUITE;
+    else if (CUT_IS_TEST_CASE(test))
+        return TEST_KIND_TEST_CASE;
+    else if (CUT_IS_TEST_ITERATOR(test))
+        return TEST_KIND_TEST_ITERATOR;
+    else if (CUT_IS_ITERATED_TEST(test))
+        return TEST_KIND_ITERATED_TEST;
+    else
+        return TEST_KIND_TEST;
+}
+
+static void
+append_attribute (gpointer key, gpointer value, gpointer user_data)
+{
+    GString *buffer = user_data;
+
+    append_string(buffer, key);
+    append_string(buffer, value);
+}
+
+static void
+append_test (GString *buffer, CutTest *test)
+{
+    GTimeVal start_time;
+    GHashTable *attributes;
+
+    append_uint8(buffer, test_kind(test));
+    if (!test)
+        return;
+
+    append_string(buffer, cut_test_get_name(test));
+    cut_test_get_start_time(test, &start_time);
+    append_time(buffer, &start_time);
+    append_double(buffer, cut_test_get_elapsed(test));
+
+    attributes = cut_test_get_attributes(test);
+    if (attributes) {
+        append_uint32(buffer, g_hash_table_size(attributes));
+        g_hash_table_foreach(attributes, append_attribute, buffer);
+    } else {
+        append_uint32(buffer, 0);
+    }
+}
+
+static void
+append_test_data (GString *buffer, CutTestData *test_data)
+{
+    append_uint8(buffer, test_data != NULL);
+    if (test_data)
+        append_string(buffer, cut_test_data_get_name(test_data));
+}
+
+static void
+append_test_context (GString *buffer, CutTestContext *test_context)
+{
+    CutTestData *test_data = NULL;
+
+    append_uint8(buffer, test_context != NULL);
+    if (!test_context)
+        return;
+
+    append_test(buffer,
+                CUT_TEST(cut_test_context_get_test_suite(test_context)));
+    append_test(buffer,
+                CUT_TEST(cut_test_context_get_test_case(test_context)));
+    append_test(buffer,
+                CUT_TEST(cut_test_context_get_test_iterator(test_context)));
+    append_test(buffer, cut_test_context_get_test(test_context));
+    if (cut_test_context_have_data(test_context))
+        test_data = cut_test_context_get_current_data(test_context);
+    append_test_data(buffer, test_data);
+    append_uint8(buffer, cut_test_context_is_failed(test_context));
+}
+
+static void
+append_test_result (GString *buffer, CutTestResult *result)
+{
+    const GList *node;
+    GTimeVal start_time;
+    gint i;
+
+    append_uint8(buffer, result != NULL);
+    if (!result)
+        return;
+
+    /* A message and diffs aren't computed here. A reader computes
+     * them from the components only when they are needed. */
+    append_uint8(buffer, cut_test_result_get_status(result));
+    append_string(buffer, cut_test_result_get_explicit_message(result));
+    append_string(buffer, cut_test_result_get_user_message(result));
+    append_string(buffer, cut_test_result_get_system_message(result));
+
+    node = cut_test_result_get_backtrace(result);
+    append_uint32(buffer, g_list_length((GList *)node));
+    for (; node; node = g_list_next(node)) {
+        CutBacktraceEntry *entry = node->data;
+
+        append_string(buffer, cut_backtrace_entry_get_file(entry));
+        append_uint32(buffer, cut_backtrace_entry_get_line(entry));
+        append_string(buffer, cut_backtrace_entry_get_function(entry));
+        append_string(buffer, cut_backtrace_entry_get_info(entry));
+    }
+
+    cut_test_result_get_start_time(result, &start_time);
+    append_time(buffer, &start_time);
+    append_double(buffer, cut_test_result_get_elapsed(result));
+    if (cut_test_result_has_performance_counters(result)) {
+        append_uint8(buffer, CUT_PERFORMANCE_COUNTER_N_TYPES);
+        for (i = 0; i < CUT_PERFORMANCE_COUNTER_N_TYPES; i++) {
+            append_int64(buffer,
+                         cut_test_result_get_performance_counter(result, i));
+        }
+    } else {
+        append_uint8(buffer, 0);
+    }
+    if (cut_test_result_has_memory_usage(result)) {
+        append_uint8(buffer, CUT_MEMORY_USAGE_N_TYPES);
+        for (i = 0; i < CUT_MEMORY_USAGE_N_TYPES; i++) {
+            append_int64(buffer, cut_test_result_get_memory_usage(result, i));
+        }
+    } else {
+        append_uint8(buffer, 0);
+    }
+    append_string(buffer, cut_test_result_get_expected(result));
+    append_string(buffer, cut_test_result_get_actual(result));
+    append_string(buffer, cut_test_result_get_explicit_diff(result));
+    append_string(buffer, cut_test_result_get_explicit_folded_diff(result));
+
+    append_test(buffer, CUT_TEST(cut_test_result_get_test_case(result)));
+    append_test(buffer, CUT_TEST(cut_test_result_get_test_iterator(result)));
+    append_test(buffer, cut_test_result_get_test(result));
+    append_test_data(buffer, cut_test_result_get_test_data(result));
+}
+
+static void
+append_benchmark_result (GString *buffer, CutBenchmarkResult *result)
+{
+    append_uint8(buffer, result != NULL);
+    if (!result)
+        return;
+
+    append_uint32(buffer, cut_benchmark_result_get_n_iterations(result));
+    append_uint32(buffer, cut_benchmark_result_get_n_samples(result));
+    append_double(buffer, cut_benchmark_result_get_mean(result));
+    append_double(buffer, cut_benchmark_result_get_median(result));
+    append_double(buffer, cut_benchmark_result_get_standard_deviation(result));
+    append_double(buffer, cut_benchmark_result_get_minimum(result));
+    append_double(buffer, cut_benchmark_result_get_maximum(result));
+}
+
+void
+cut_binary_stream_append_header (GString *buffer)
+{
+    g_string_append_len(buffer,
+                        CUT_BINARY_STREAM_MAGIC,
+                        CUT_BINARY_STREAM_MAGIC_LENGTH);
+    append_uint8(buffer, CUT_BINARY_STREAM_VERSION);
+}
+
+void
+cut_binary_stream_append_event (GString *buffer,
+                                const CutBinaryStreamEvent *event)
+{
+    gsize frame_offset;
+    guint32 frame_length;
+
+    frame_offset = buffer->len;
+    append_uint32(buffer, 0);
+
+    append_uint8(buffer, event->type);
+    switch (event->type) {
+      case CUT_BINARY_STREAM_EVENT_START_RUN:
+        break;
+      case CUT_BINARY_STREAM_EVENT_READY_TEST_SUITE:
+        append_test(buffer, event->test);
+        append_uint32(buffer, event->n_test_cases);
+        append_uint32(buffer, event->n_tests);
+        break;
+      case CUT_BINARY_STREAM_EVENT_READY_TEST_CASE:
+      case CUT_BINARY_STREAM_EVENT_READY_TEST_ITERATOR:
+        append_test(buffer, event->test);
+        append_uint32(buffer, event->n_tests);
+        break;
+      case CUT_BINARY_STREAM_EVENT_START_TEST_SUITE:
+      case CUT_BINARY_STREAM_EVENT_START_TEST_CASE:
+      case CUT_BINARY_STREAM_EVENT_START_TEST_ITERATOR:
+        append_test(buffer, event->test);
+        break;
+      case CUT_BINARY_STREAM_EVENT_START_TEST:
+      case CUT_BINARY_STREAM_EVENT_START_ITERATED_TEST:
+      case CUT_BINARY_STREAM_EVENT_PASS_ASSERTION:
+        append_test(buffer, event->test);
+        append_test_context(buffer, event->test_context);
+        break;
+      case CUT_BINARY_STREAM_EVENT_PASS_ASSERTIONS:
+        append_test(buffer, event->test);
+        append_test_context(buffer, event->test_context);
+        append_uint32(buffer, event->n_assertions);
+        break;
+      case CUT_BINARY_STREAM_EVENT_TEST_RESULT:
+        append_test(buffer, event->test);
+        append_test_context(buffer, event->test_context);
+        append_test_result(buffer, event->result);
+        break;
+      case CUT_BINARY_STREAM_EVENT_BENCHMARK_TEST:
+        append_test(buffer, event->test);
+        append_test_context(buffer, event->test_context);
+        append_benchmark_result(buffer, event->benchmark_result);
+        break;
+      case CUT_BINARY_STREAM_EVENT_TEST_ITERATOR_RESULT:
+      case CUT_BINARY_STREAM_EVENT_TEST_CASE_RESULT:
+        append_test(buffer, event->test);
+        append_test_result(buffer, event->result);
+        break;
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_ITERATED_TEST:
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_TEST:
+        append_test(buffer, event->test);
+        append_test_context(buffer, event->test_context);
+        append_uint8(buffer, event->success);
+        break;
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_TEST_ITERATOR:
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_TEST_CASE:
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_TEST_SUITE:
+        append_test(buffer, event->test);
+        append_uint8(buffer, event->success);
+        break;
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_RUN:
+        append_uint8(buffer, event->success);
+        break;
+    }
+
+    frame_length = GUINT32_TO_LE(buffer->len - frame_offset - FRAME_HEADER_SIZE);
+    memcpy(buffer->str + frame_offset, &frame_length, sizeof(frame_length));
+}
+
+static const guchar *
+read_bytes (Reader *reader, gsize size)
+{
+    const guchar *bytes;
+
+    if (reader->truncated || reader->length - reader->offset < size) {
+        reader->truncated = TRUE;
+        return NULL;
+    }
+
+    bytes = reader->data + reader->offset;
+    reader->offset += size;
+    return bytes;
+}
+
+static guint8
+read_uint8 (Reader *reader)
+{
+    const guchar *bytes;
+
+    bytes = read_bytes(reader, 1);
+    return bytes ? bytes[0] : 0;
+}
+
+static guint32
+read_uint32 (Reader *reader)
+{
+    const guchar *bytes;
+    guint32 value;
+
+    bytes = read_bytes(reader, sizeof(value));
+    if (!bytes)
+        return 0;
+    memcpy(&value, bytes, sizeof(value));
+    return GUINT32_FROM_LE(value);
+}
+
+static gint64
+read_int64 (Reader *reader)
+{
+    const guchar *bytes;
+    gint64 value;
+
+    bytes = read_bytes(reader, sizeof(value));
+    if (!bytes)
+        return 0;
+    memcpy(&value, bytes, sizeof(value));
+    return GINT64_FROM_LE(value);
+}
+
+static gdouble
+read_double (Reader *reader)
+{
+    const guchar *bytes;
+    guint64 bits;
+    gdouble value;
+
+    bytes = read_bytes(reader, sizeof(bits));
+    if (!bytes)
+        return 0.0;
+    memcpy(&bits, bytes, sizeof(bits));
+    bits = GUINT64_FROM_LE(bits);
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static gchar *
+read_string (Reader *reader)
+{
+    const guchar *bytes;
+    guint32 length;
+
+    length = read_uint32(reader);
+    if (reader->truncated || length == NULL_STRING_LENGTH)
+        return NULL;
+
+    bytes = read_bytes(reader, length);
+    if (!bytes)
+        return NULL;
+    return g_strndup((const gchar *)bytes, length);
+}
+
+static void
+read_time (Reader *reader, GTimeVal *time)
+{
+    time->tv_sec = read_int64(reader);
+    time->tv_usec = read_int64(reader);
+}
+
+static CutTest *
+read_test (Reader *reader)
+{
+    CutTest *test;
+    GTimeVal start_time;
+    gchar *name;
+    guint32 i, n_attributes;
+
+    switch (read_uint8(reader)) {
+      case TEST_KIND_TEST:
+        test = cut_test_new_empty();
+        break;
+      case TEST_KIND_ITERATED_TEST:
+        test = CUT_TEST(cut_iterated_test_new_empty());
+        break;
+      case TEST_KIND_TEST_CASE:
+        test = CUT_TEST(cut_test_case_new_empty());
+        break;
+      case TEST_KIND_TEST_ITERATOR:
+        test = CUT_TEST(cut_test_iterator_new_empty());
+        break;
+      case TEST_KIND_TEST_SUITE:
+        test = CUT_TEST(cut_test_suite_new_empty());
+        break;
+      default:
+        return NULL;
+    }
+
+    name = read_string(reader);
+    if (name) {
+        cut_test_set_name(test, name);
+        g_free(name);
+    }
+    read_time(reader, &start_time);
+    cut_test_set_start_time(test, &start_time);
+    cut_test_set_elapsed(test, read_double(reader));
+
+    n_attributes = read_uint32(reader);
+    for (i = 0; i < n_attributes && !reader->truncated; i++) {
+        gchar *key, *value;
+
+        key = read_string(reader);
+        value = read_string(reader);
+        if (key && value)
+            cut_test_set_attribute(test, key, value);
+        g_free(key);
+        g_free(value);
+    }
+
+    return test;
+}
+
+static CutTestData *
+read_test_data (Reader *reader)
+{
+    CutTestData *test_data;
+    gchar *name;
+
+    if (!read_uint8(reader))
+        return NULL;
+
+    test_data = cut_test_data_new_empty();
+    name = read_string(reader);
+    if (name) {
+        cut_test_data_set_name(test_data, name);
+        g_free(name);
+    }
+
+    return test_data;
+}
+
+static CutTestContext *
+read_test_context (Reader *reader)
+{
+    CutTestContext *test_context;
+    CutTest *test;
+    CutTestData *test_data;
+
+    if (!read_uint8(reader))
+        return NULL;
+
+    test_context = cut_test_context_new_empty();
+
+    test = read_test(reader);
+    if (test) {
+        if (CUT_IS_TEST_SUITE(test))
+            cut_test_context_set_test_suite(test_context, CUT_TEST_SUITE(test));
+        g_object_unref(test);
+    }
+    test = read_test(reader);
+    if (test) {
+        if (CUT_IS_TEST_CASE(test))
+            cut_test_context_set_test_case(test_context, CUT_TEST_CASE(test));
+        g_object_unref(test);
+    }
+    test = read_test(reader);
+    if (test) {
+        if (CUT_IS_TEST_ITERATOR(test))
+            cut_test_context_set_test_iterator(test_context,
+                                               CUT_TEST_ITERATOR(test));
+        g_object_unref(test);
+    }
+    test = read_test(reader);
+    if (test) {
+        cut_test_context_set_test(test_context, test);
+        g_object_unref(test);
+    }
+    test_data = read_test_data(reader);
+    if (test_data) {
+        cut_test_context_set_data(test_context, test_data);
+        g_object_unref(test_data);
+    }
+    cut_test_context_set_failed(test_context, read_uint8(reader));
+
+    return test_context;
+}
+
+static CutTestResult *
+read_test_result (Reader *reader)
+{
+    CutTestResult *result;
+    CutTest *test;
+    CutTestData *test_data;
+    GList *backtrace = NULL;
+    GTimeVal start_time;
+    gchar *value, *message;
+    guint32 i, n_entries;
+    guint8 n_counters, n_memory_usage_values;
+
+    if (!read_uint8(reader))
+        return NULL;
+
+    result = cut_test_result_new_empty();
+    cut_test_result_set_status(result, read_uint8(reader));
+    message = read_string(reader);
+    value = read_string(reader);
+    cut_test_result_set_user_message(result, value);
+    g_free(value);
+    value = read_string(reader);
+    cut_test_result_set_system_message(result, value);
+    g_free(value);
+    if (message)
+        cut_test_result_set_message(result, message);
+    g_free(message);
+
+    n_entries = read_uint32(reader);
+    for (i = 0; i < n_entries && !reader->truncated; i++) {
+        CutBacktraceEntry *entry;
+
+        entry = cut_backtrace_entry_new_empty();
+        value = read_string(reader);
+        cut_backtrace_entry_set_file(entry, value);
+        g_free(value);
+        cut_backtrace_entry_set_line(entry, read_uint32(reader));
+        value = read_string(reader);
+        cut_backtrace_entry_set_function(entry, value);
+        g_free(value);
+        value = read_string(reader);
+        cut_backtrace_entry_set_info(entry, value);
+        g_free(value);
+        backtrace = g_list_prepend(backtrace, entry);
+    }
+    if (backtrace) {
+        backtrace = g_list_reverse(backtrace);
+        cut_test_result_set_backtrace(result, backtrace);
+        g_list_foreach(backtrace, (GFunc)g_object_unref, NULL);
+        g_list_free(backtrace);
+    }
+
+    read_time(reader, &start_time);
+    cut_test_result_set_start_time(result, &start_time);
+    cut_test_result_set_elapsed(result, read_double(reader));
+    n_counters = read_uint8(reader);
+    for (i = 0; i < n_counters && !reader->truncated; i++) {
+        gint64 counter;
+
+        counter = read_int64(reader);
+        if (i < CUT_PERFORMANCE_COUNTER_N_TYPES)
+            cut_test_result_set_performance_counter(result, i, counter);
+    }
+    n_memory_usage_values = read_uint8(reader);
+    for (i = 0; i < n_memory_usage_values && !reader->truncated; i++) {
+        gint64 memory_usage;
+
+        memory_usage = read_int64(reader);
+        if (i < CUT_MEMORY_USAGE_N_TYPES)
+            cut_test_result_set_memory_usage(result, i, memory_usage);
+    }
+
+    value = read_string(reader);
+    cut_test_result_set_expected(result, value);
+    g_free(value);
+    value = read_string(reader);
+    cut_test_result_set_actual(result, value);
+    g_free(value);
+    value = read_string(reader);
+    cut_test_result_set_diff(result, value);
+    g_free(value);
+    value = read_string(reader);
+    cut_test_result_set_folded_diff(result, value);
+    g_free(value);
+
+    test = read_test(reader);
+    if (test) {
+        if (CUT_IS_TEST_CASE(test))
+            cut_test_result_set_test_case(result, CUT_TEST_CASE(test));
+        g_object_unref(test);
+    }
+    test = read_test(reader);
+    if (test) {
+        if (CUT_IS_TEST_ITERATOR(test))
+            cut_test_result_set_test_iterator(result, CUT_TEST_ITERATOR(test));
+        g_object_unref(test);
+    }
+    test = read_test(reader);
+    if (test) {
+        cut_test_result_set_test(result, test);
+        g_object_unref(test);
+    }
+    test_data = read_test_data(reader);
+    if (test_data) {
+        cut_test_result_set_test_data(result, test_data);
+        g_object_unref(test_data);
+    }
+
+    return result;
+}
+
+static CutBenchmarkResult *
+read_benchmark_result (Reader *reader)
+{
+    CutBenchmarkResult *result;
+
+    if (!read_uint8(reader))
+        return NULL;
+
+    result = cut_benchmark_result_new_empty();
+    cut_benchmark_result_set_n_iterations(result, read_uint32(reader));
+    cut_benchmark_result_set_n_samples(result, read_uint32(reader));
+    cut_benchmark_result_set_mean(result, read_double(reader));
+    cut_benchmark_result_set_median(result, read_double(reader));
+    cut_benchmark_result_set_standard_deviation(result, read_double(reader));
+    cut_benchmark_result_set_minimum(result, read_double(reader));
+    cut_benchmark_result_set_maximum(result, read_double(reader));
+
+    return result;
+}
+
+static void
+clear_event (CutBinaryStreamEvent *event)
+{
+    if (event->test)
+        g_object_unref(event->test);
+    if (event->test_context)
+        g_object_unref(event->test_context);
+    if (event->result)
+        g_object_unref(event->result);
+    if (event->benchmark_result)
+        g_object_unref(event->benchmark_result);
+}
+
+static gboolean
+decode_event (Reader *reader, CutBinaryStreamEvent *event, GError **error)
+{
+    memset(event, 0, sizeof(*event));
+    event->type = read_uint8(reader);
+
+    switch (event->type) {
+      case CUT_BINARY_STREAM_EVENT_START_RUN:
+        break;
+      case CUT_BINARY_STREAM_EVENT_READY_TEST_SUITE:
+        event->test = read_test(reader);
+        event->n_test_cases = read_uint32(reader);
+        event->n_tests = read_uint32(reader);
+        break;
+      case CUT_BINARY_STREAM_EVENT_READY_TEST_CASE:
+      case CUT_BINARY_STREAM_EVENT_READY_TEST_ITERATOR:
+        event->test = read_test(reader);
+        event->n_tests = read_uint32(reader);
+        break;
+      case CUT_BINARY_STREAM_EVENT_START_TEST_SUITE:
+      case CUT_BINARY_STREAM_EVENT_START_TEST_CASE:
+      case CUT_BINARY_STREAM_EVENT_START_TEST_ITERATOR:
+        event->test = read_test(reader);
+        break;
+      case CUT_BINARY_STREAM_EVENT_START_TEST:
+      case CUT_BINARY_STREAM_EVENT_START_ITERATED_TEST:
+      case CUT_BINARY_STREAM_EVENT_PASS_ASSERTION:
+        event->test = read_test(reader);
+        event->test_context = read_test_context(reader);
+        break;
+      case CUT_BINARY_STREAM_EVENT_PASS_ASSERTIONS:
+        event->test = read_test(reader);
+        event->test_context = read_test_context(reader);
+        event->n_assertions = read_uint32(reader);
+        break;
+      case CUT_BINARY_STREAM_EVENT_TEST_RESULT:
+        event->test = read_test(reader);
+        event->test_context = read_test_context(reader);
+        event->result = read_test_result(reader);
+        break;
+      case CUT_BINARY_STREAM_EVENT_BENCHMARK_TEST:
+        event->test = read_test(reader);
+        event->test_context = read_test_context(reader);
+        event->benchmark_result = read_benchmark_result(reader);
+        break;
+      case CUT_BINARY_STREAM_EVENT_TEST_ITERATOR_RESULT:
+      case CUT_BINARY_STREAM_EVENT_TEST_CASE_RESULT:
+        event->test = read_test(reader);
+        event->result = read_test_result(reader);
+        break;
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_ITERATED_TEST:
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_TEST:
+        event->test = read_test(reader);
+        event->test_context = read_test_context(reader);
+        event->success = read_uint8(reader);
+        break;
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_TEST_ITERATOR:
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_TEST_CASE:
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_TEST_SUITE:
+        event->test = read_test(reader);
+        event->success = read_uint8(reader);
+        break;
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_RUN:
+        event->success = read_uint8(reader);
+        break;
+      default:
+        g_set_error(error,
+                    CUT_BINARY_STREAM_ERROR,
+                    CUT_BINARY_STREAM_ERROR_INVALID_FRAME,
+                    "unknown event type: %u", event->type);
+        return FALSE;
+    }
+
+    if (reader->truncated || reader->offset != reader->length) {
+        g_set_error(error,
+                    CUT_BINARY_STREAM_ERROR,
+                    CUT_BINARY_STREAM_ERROR_INVALID_FRAME,
+                    "broken frame: event type: %u: "
+                    "frame size: %" G_GSIZE_FORMAT ": "
+                    "decoded size: %" G_GSIZE_FORMAT,
+                    event->type, reader->length, reader->offset);
+        clear_event(event);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+CutBinaryStreamDecoder *
+cut_binary_stream_decoder_new (CutBinaryStreamEventFunction function,
+                               gpointer user_data)
+{
+    CutBinaryStreamDecoder *decoder;
+
+    decoder = g_slice_new(CutBinaryStreamDecoder);
+    decoder->function = function;
+    decoder->user_data = user_data;
+    decoder->buffer = g_string_new(NULL);
+    decoder->header_read = FALSE;
+
+    return decoder;
+}
+
+void
+cut_binary_stream_decoder_free (CutBinaryStreamDecoder *decoder)
+{
+    g_string_free(decoder->buffer, TRUE);
+    g_slice_free(CutBinaryStreamDecoder, decoder);
+}
+
+static gboolean
+read_header (CutBinaryStreamDecoder *decoder, gsize *offset, GError **error)
+{
+    const gchar *data;
+    guint8 version;
+
+    if (decoder->buffer->len < HEADER_SIZE)
+        return TRUE;
+
+    data = decoder->buffer->str;
+    if (memcmp(data, CUT_BINARY_STREAM_MAGIC,
+               CUT_BINARY_STREAM_MAGIC_LENGTH) != 0) {
+        g_set_error(error,
+                    CUT_BINARY_STREAM_ERROR,
+                    CUT_BINARY_STREAM_ERROR_INVALID_HEADER,
+                    "invalid binary stream header");
+        return FALSE;
+    }
+
+    version = data[CUT_BINARY_STREAM_MAGIC_LENGTH];
+    if (version != CUT_BINARY_STREAM_VERSION) {
+        g_set_error(error,
+                    CUT_BINARY_STREAM_ERROR,
+                    CUT_BINARY_STREAM_ERROR_UNSUPPORTED_VERSION,
+                    "unsupported binary stream version: %u (expected: %u)",
+                    version, CUT_BINARY_STREAM_VERSION);
+        return FALSE;
+    }
+
+    decoder->header_read = TRUE;
+    *offset = HEADER_SIZE;
+    return TRUE;
+}
+
+gboolean
+cut_binary_stream_decoder_feed (CutBinaryStreamDecoder *decoder,
+                                const gchar *data, gsize length,
+                                GError **error)
+{
+    gsize offset = 0;
+    gboolean success = TRUE;
+
+    g_string_append_len(decoder->buffer, data, length);
+
+    if (!decoder->header_read) {
+        if (!read_header(decoder, &offset, error))
+            return FALSE;
+        if (!decoder->header_read)
+            return TRUE;
+    }
+
+    while (decoder->buffer->len - offset >= FRAME_HEADER_SIZE) {
+        CutBinaryStreamEvent event;
+        Reader reader;
+        guint32 frame_length;
+
+        memcpy(&frame_length, decoder->buffer->str + offset,
+               sizeof(frame_length));
+        frame_length = GUINT32_FROM_LE(frame_length);
+        if (decoder->buffer->len - offset - FRAME_HEADER_SIZE < frame_length)
+            break;
+
+        reader.data = (const guchar *)decoder->buffer->str +
+            offset + FRAME_HEADER_SIZE;
+        reader.length = frame_length;
+        reader.offset = 0;
+        reader.truncated = FALSE;
+        offset += FRAME_HEADER_SIZE + frame_length;
+
+        if (!decode_event(&reader, &event, error)) {
+            success = FALSE;
+            break;
+        }
+        decoder->function(&event, decoder->user_data);
+        clear_event(&event);
+    }
+
+    g_string_erase(decoder->buffer, 0, offset);
+
+    return success;
+}
+
+gboolean
+cut_binary_stream_decoder_end (CutBinaryStreamDecoder *decoder,
+                               GError **error)
+{
+    if (decoder->buffer->len > 0 || !decoder->header_read) {
+        g_set_error(error,
+                    CUT_BINARY_STREAM_ERROR,
+                    CUT_BINARY_STREAM_ERROR_TRUNCATED,
+                    "binary stream is truncated: "
+                    "%" G_GSIZE_FORMAT " byte(s) are left",
+                    decoder->buffer->len);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+static void
+append_xml_element_with_uint (GString *string, guint indent,
+                              const gchar *element_name, guint value)
+{
+    gchar *str;
+
+    str = g_strdup_printf("%d", value);
+    cut_utils_append_xml_element_with_value(string, indent, element_name, str);
+    g_free(str);
+}
+
+void
+cut_binary_stream_event_to_xml_string (const CutBinaryStreamEvent *event,
+                                       GString *string)
+{
+    const gchar *element_name = NULL;
+
+    switch (event->type) {
+      case CUT_BINARY_STREAM_EVENT_START_RUN:
+        g_string_append(string, "<stream>\n");
+        return;
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_RUN:
+        cut_utils_append_xml_element_with_boolean_value(string, 2, "success",
+                                                        event->success);
+        g_string_append(string, "</stream>\n");
+        return;
+      case CUT_BINARY_STREAM_EVENT_READY_TEST_SUITE:
+        element_name = "ready-test-suite";
+        break;
+      case CUT_BINARY_STREAM_EVENT_START_TEST_SUITE:
+        element_name = "start-test-suite";
+        break;
+      case CUT_BINARY_STREAM_EVENT_READY_TEST_CASE:
+        element_name = "ready-test-case";
+        break;
+      case CUT_BINARY_STREAM_EVENT_START_TEST_CASE:
+        element_name = "start-test-case";
+        break;
+      case CUT_BINARY_STREAM_EVENT_READY_TEST_ITERATOR:
+        element_name = "ready-test-iterator";
+        break;
+      case CUT_BINARY_STREAM_EVENT_START_TEST_ITERATOR:
+        element_name = "start-test-iterator";
+        break;
+      case CUT_BINARY_STREAM_EVENT_START_TEST:
+        element_name = "start-test";
+        break;
+      case CUT_BINARY_STREAM_EVENT_START_ITERATED_TEST:
+        element_name = "start-iterated-test";
+        break;
+      case CUT_BINARY_STREAM_EVENT_PASS_ASSERTION:
+        element_name = "pass-assertion";
+        break;
+      case CUT_BINARY_STREAM_EVENT_PASS_ASSERTIONS:
+        element_name = "pass-assertions";
+        break;
+      case CUT_BINARY_STREAM_EVENT_TEST_RESULT:
+        element_name = "test-result";
+        break;
+      case CUT_BINARY_STREAM_EVENT_BENCHMARK_TEST:
+        element_name = "benchmark-test";
+        break;
+      case CUT_BINARY_STREAM_EVENT_TEST_ITERATOR_RESULT:
+        element_name = "test-iterator-result";
+        break;
+      case CUT_BINARY_STREAM_EVENT_TEST_CASE_RESULT:
+        element_name = "test-case-result";
+        break;
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_ITERATED_TEST:
+        element_name = "complete-iterated-test";
+        break;
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_TEST:
+        element_name = "complete-test";
+        break;
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_TEST_ITERATOR:
+        element_name = "complete-test-iterator";
+        break;
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_TEST_CASE:
+        element_name = "complete-test-case";
+        break;
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_TEST_SUITE:
+        element_name = "complete-test-suite";
+        break;
+      default:
+        return;
+    }
+
+    g_string_append_printf(string, "  <%s>\n", element_name);
+    if (event->test)
+        cut_test_to_xml_string(event->test, string, 4);
+    if (event->test_context)
+        cut_test_context_to_xml_string(event->test_context, string, 4);
+    if (event->result)
+        cut_test_result_to_xml_string(event->result, string, 4);
+    if (event->benchmark_result)
+        cut_benchmark_result_to_xml_string(event->benchmark_result,
+                                           string, 4);
+
+    switch (event->type) {
+      case CUT_BINARY_STREAM_EVENT_READY_TEST_SUITE:
+        append_xml_element_with_uint(string, 4, "n-test-cases",
+                                     event->n_test_cases);
+        append_xml_element_with_uint(string, 4, "n-tests", event->n_tests);
+        break;
+      case CUT_BINARY_STREAM_EVENT_READY_TEST_CASE:
+      case CUT_BINARY_STREAM_EVENT_READY_TEST_ITERATOR:
+        append_xml_element_with_uint(string, 4, "n-tests", event->n_tests);
+        break;
+      case CUT_BINARY_STREAM_EVENT_PASS_ASSERTIONS:
+        append_xml_element_with_uint(string, 4, "n-assertions",
+                                     event->n_assertions);
+        break;
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_ITERATED_TEST:
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_TEST:
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_TEST_ITERATOR:
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_TEST_CASE:
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_TEST_SUITE:
+        cut_utils_append_xml_element_with_boolean_value(string, 4, "success",
+                                                        event->success);
+        break;
+      default:
+        break;
+    }
+    g_string_append_printf(string, "  </%s>\n", element_name);
+}
+
+static void
+append_event_as_xml (const CutBinaryStreamEvent *event, gpointer user_data)
+{
+    GString *string = user_data;
+
+    cut_binary_stream_event_to_xml_string(event, string);
+}
+
+gchar *
+cut_binary_stream_to_xml (const gchar *data, gsize length, GError **error)
+{
+    CutBinaryStreamDecoder *decoder;
+    GString *string;
+    gboolean success;
+
+    string = g_string_new(NULL);
+    decoder = cut_binary_stream_decoder_new(append_event_as_xml, string);
+    success = cut_binary_stream_decoder_feed(decoder, data, length, error) &&
+        cut_binary_stream_decoder_end(decoder, error);
+    cut_binary_stream_decoder_free(decoder);
+
+    if (!success) {
+        g_string_free(string, TRUE);
+        return NULL;
+    }
+
+    return g_string_free(string, FALSE);
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
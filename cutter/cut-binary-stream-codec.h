@@ -0,0 +1,125 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CUT_BINARY_STREAM_CODEC_H__
+#define __CUT_BINARY_STREAM_CODEC_H__
+
+#include <glib.h>
+
+#include <cutter/cut-private.h>
+#include <cutter/cut-test-context.h>
+
+G_BEGIN_DECLS
+
+/*
+ * A binary stream starts with a header (CUT_BINARY_STREAM_MAGIC and
+ * a version byte) and is followed by frames. A frame is a 32bit
+ * little endian length and an event type byte followed by the
+ * payload of the event. The first byte of the magic can't start an
+ * XML stream. So a reader can detect a format by the first byte.
+ */
+#define CUT_BINARY_STREAM_MAGIC "\211CUT"
+#define CUT_BINARY_STREAM_MAGIC_LENGTH 4
+#define CUT_BINARY_STREAM_VERSION 5
+
+#define CUT_BINARY_STREAM_ERROR (cut_binary_stream_error_quark())
+
+typedef enum {
+    CUT_BINARY_STREAM_ERROR_INVALID_HEADER,
+    CUT_BINARY_STREAM_ERROR_UNSUPPORTED_VERSION,
+    CUT_BINARY_STREAM_ERROR_INVALID_FRAME,
+    CUT_BINARY_STREAM_ERROR_TRUNCATED
+} CutBinaryStreamError;
+
+typedef enum {
+    CUT_BINARY_STREAM_EVENT_START_RUN = 1,
+    CUT_BINARY_STREAM_EVENT_READY_TEST_SUITE,
+    CUT_BINARY_STREAM_EVENT_START_TEST_SUITE,
+    CUT_BINARY_STREAM_EVENT_READY_TEST_CASE,
+    CUT_BINARY_STREAM_EVENT_START_TEST_CASE,
+    CUT_BINARY_STREAM_EVENT_READY_TEST_ITERATOR,
+    CUT_BINARY_STREAM_EVENT_START_TEST_ITERATOR,
+    CUT_BINARY_STREAM_EVENT_START_TEST,
+    CUT_BINARY_STREAM_EVENT_START_ITERATED_TEST,
+    CUT_BINARY_STREAM_EVENT_PASS_ASSERTION,
+    CUT_BINARY_STREAM_EVENT_TEST_RESULT,
+    CUT_BINARY_STREAM_EVENT_TEST_ITERATOR_RESULT,
+    CUT_BINARY_STREAM_EVENT_TEST_CASE_RESULT,
+    CUT_BINARY_STREAM_EVENT_COMPLETE_ITERATED_TEST,
+    CUT_BINARY_STREAM_EVENT_COMPLETE_TEST,
+    CUT_BINARY_STREAM_EVENT_COMPLETE_TEST_ITERATOR,
+    CUT_BINARY_STREAM_EVENT_COMPLETE_TEST_CASE,
+    CUT_BINARY_STREAM_EVENT_COMPLETE_TEST_SUITE,
+    CUT_BINARY_STREAM_EVENT_COMPLETE_RUN,
+    CUT_BINARY_STREAM_EVENT_PASS_ASSERTIONS,
+    CUT_BINARY_STREAM_EVENT_BENCHMARK_TEST
+} CutBinaryStreamEventType;
+
+typedef struct _CutBinaryStreamEvent CutBinaryStreamEvent;
+struct _CutBinaryStreamEvent
+{
+    CutBinaryStreamEventType type;
+    CutTest *test;
+    CutTestContext *test_context;
+    CutTestResult *result;
+    guint n_test_cases;
+    guint n_tests;
+    gboolean success;
+    guint n_assertions;
+    CutBenchmarkResult *benchmark_result;
+};
+
+typedef struct _CutBinaryStreamDecoder CutBinaryStreamDecoder;
+
+typedef void (*CutBinaryStreamEventFunction) (const CutBinaryStreamEvent *event,
+                                              gpointer                    user_data);
+
+GQuark                  cut_binary_stream_error_quark   (void);
+
+gboolean                cut_binary_stream_is_binary     (const gchar *data,
+                                                         gsize        length);
+
+void                    cut_binary_stream_append_header (GString     *buffer);
+void                    cut_binary_stream_append_event  (GString     *buffer,
+                                                         const CutBinaryStreamEvent *event);
+
+CutBinaryStreamDecoder *cut_binary_stream_decoder_new   (CutBinaryStreamEventFunction function,
+                                                         gpointer     user_data);
+void                    cut_binary_stream_decoder_free  (CutBinaryStreamDecoder *decoder);
+gboolean                cut_binary_stream_decoder_feed  (CutBinaryStreamDecoder *decoder,
+                                                         const gchar *data,
+                                                         gsize        length,
+                                                         GError     **error);
+gboolean                cut_binary_stream_decoder_end   (CutBinaryStreamDecoder *decoder,
+                                                         GError     **error);
+
+void                    cut_binary_stream_event_to_xml_string
+                                                        (const CutBinaryStreamEvent *event,
+                                                         GString     *string);
+gchar                  *cut_binary_stream_to_xml        (const gchar *data,
+                                                         gsize        length,
+                                                         GError     **error);
+
+G_END_DECLS
+
+#endif /* __CUT_BINARY_STREAM_CODEC_H__ */
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
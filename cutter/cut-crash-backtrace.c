@@ -36,6 +36,7 @@
 #include "cut-backtrace-entry.h"
 #include "cut-utils.h"
 #include "cut-crash-backtrace.h"
+#include "cut-logger.h"
 
 static gboolean cut_crash_backtrace_show_on_the_moment = TRUE;
 static gboolean cut_crash_backtrace_signal_received = FALSE;
@@ -82,6 +83,12 @@ cut_crash_backtrace_emit (CutTestSuite    *test_suite,
 {
 }
 
+GList *
+cut_crash_backtrace_collect_process (gint pid)
+{
+    return NULL;
+}
+
 #else
 
 static CutCrashBacktrace *current_crash_backtrace = NULL;
@@ -292,6 +299,42 @@ cut_crash_backtrace_emit (CutTestSuite    *test_suite,
     g_object_unref(result);
 }
 
+GList *
+cut_crash_backtrace_collect_process (gint pid)
+{
+    gchar *argv[8];
+    gchar *pid_string;
+    gchar *gdb_backtrace = NULL;
+    GList *parsed_backtrace = NULL;
+    GError *error = NULL;
+
+    /* The process must be a child process of us. gdb can't attach
+     * to another process when ptrace is restricted. The main
+     * thread is selected after attaching. */
+    pid_string = g_strdup_printf("%d", pid);
+    argv[0] = (gchar *)"gdb";
+    argv[1] = (gchar *)"-batch";
+    argv[2] = (gchar *)"-nx";
+    argv[3] = (gchar *)"-p";
+    argv[4] = pid_string;
+    argv[5] = (gchar *)"-ex";
+    argv[6] = (gchar *)"backtrace";
+    argv[7] = NULL;
+    if (g_spawn_sync(NULL, argv, NULL,
+                     G_SPAWN_SEARCH_PATH | G_SPAWN_STDERR_TO_DEV_NULL,
+                     NULL, NULL, &gdb_backtrace, NULL, NULL, &error)) {
+        parsed_backtrace = cut_utils_parse_gdb_backtrace(gdb_backtrace);
+    } else {
+        cut_log_warning("[crash-backtrace][collect][fail] <%d>: %s",
+                        pid, error->message);
+        g_error_free(error);
+    }
+    g_free(gdb_backtrace);
+    g_free(pid_string);
+
+    return parsed_backtrace;
+}
+
 #endif
 
 
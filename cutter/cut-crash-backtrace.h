@@ -47,6 +47,9 @@ void               cut_crash_backtrace_emit     (CutTestSuite    *test_suite,
                                                  CutTestData     *test_data,
                                                  CutTestContext  *test_context);
 
+GList             *cut_crash_backtrace_collect_process
+                                                (gint             pid);
+
 
 G_END_DECLS
 
@@ -22,6 +22,7 @@
 #endif /* HAVE_CONFIG_H */
 
 #include <stdlib.h>
+#include <string.h>
 
 #include <glib/gi18n.h>
 #include "cut-main.h"
@@ -34,6 +35,7 @@ static gboolean use_color = FALSE;
 static gboolean unified_diff = FALSE;
 static gint context_lines = -1;
 static gchar **labels = NULL;
+static gint algorithm = -1;
 
 static gboolean
 print_version (const gchar *option_name, const gchar *value,
@@ -52,6 +54,23 @@ parse_color_arg (const gchar *option_name, const gchar *value,
                                        &use_color, error);
 }
 
+static gboolean
+parse_algorithm_arg (const gchar *option_name, const gchar *value,
+                     gpointer data, GError **error)
+{
+    if (strcmp(value, "longest-match") == 0) {
+        algorithm = CUT_SEQUENCE_MATCH_ALGORITHM_LONGEST_MATCH;
+    } else if (strcmp(value, "myers") == 0) {
+        algorithm = CUT_SEQUENCE_MATCH_ALGORITHM_MYERS;
+    } else {
+        g_set_error(error, G_OPTION_ERROR, G_OPTION_ERROR_BAD_VALUE,
+                    _("Invalid diff algorithm: %s"), value);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
 static const GOptionEntry option_entries[] =
 {
     {"version", 0, G_OPTION_FLAG_NO_ARG, G_OPTION_ARG_CALLBACK, print_version,
@@ -65,6 +84,9 @@ static const GOptionEntry option_entries[] =
      N_("Use LINES as diff context lines"), "LINES"},
     {"label", 'L', 0, G_OPTION_ARG_STRING_ARRAY, &labels,
      N_("Use LABEL as label"), "LABEL"},
+    {"algorithm", '\0', 0, G_OPTION_ARG_CALLBACK, parse_algorithm_arg,
+     N_("Use ALGORITHM to compute diff (default: auto)"),
+     "[longest-match|myers]"},
     {NULL}
 };
 
@@ -132,6 +154,8 @@ print_diff (const gchar *from, const gchar *to)
     }
     if (context_lines > 0)
         cut_differ_set_context_size(differ, context_lines);
+    if (algorithm >= 0)
+        cut_differ_set_algorithm(differ, algorithm);
     cut_differ_diff(differ, writer);
     g_object_unref(writer);
     g_object_unref(differ);
@@ -265,6 +265,25 @@ cut_differ_get_context_size (CutDiffer *differ)
     return cut_sequence_matcher_get_context_size(matcher);
 }
 
+void
+cut_differ_set_algorithm (CutDiffer *differ,
+                          CutSequenceMatchAlgorithm algorithm)
+{
+    CutSequenceMatcher *matcher;
+
+    matcher = cut_differ_get_sequence_matcher(differ);
+    cut_sequence_matcher_set_algorithm(matcher, algorithm);
+}
+
+CutSequenceMatchAlgorithm
+cut_differ_get_algorithm (CutDiffer *differ)
+{
+    CutSequenceMatcher *matcher;
+
+    matcher = cut_differ_get_sequence_matcher(differ);
+    return cut_sequence_matcher_get_algorithm(matcher);
+}
+
 gboolean
 cut_differ_need_diff (CutDiffer *differ)
 {
@@ -71,6 +71,10 @@ CutSequenceMatcher *
 void          cut_differ_set_context_size (CutDiffer   *differ,
                                            guint        context);
 guint         cut_differ_get_context_size (CutDiffer   *differ);
+void          cut_differ_set_algorithm    (CutDiffer   *differ,
+                                           CutSequenceMatchAlgorithm algorithm);
+CutSequenceMatchAlgorithm
+              cut_differ_get_algorithm    (CutDiffer   *differ);
 
 gboolean      cut_differ_need_diff        (CutDiffer   *differ);
 
@@ -21,6 +21,7 @@
 #  include <config.h>
 #endif /* HAVE_CONFIG_H */
 
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <glib.h>
@@ -33,6 +34,10 @@
 #include "cut-elf-loader.h"
 #include "cut-logger.h"
 
+#ifndef NT_GNU_BUILD_ID
+#  define NT_GNU_BUILD_ID 3
+#endif
+
 #define CUT_ELF_LOADER_GET_PRIVATE(obj) (G_TYPE_INSTANCE_GET_PRIVATE((obj), CUT_TYPE_ELF_LOADER, CutELFLoaderPrivate))
 
 typedef enum {
@@ -464,6 +469,152 @@ cut_elf_loader_collect_symbols (CutELFLoader *loader)
 #endif
 }
 
+#ifdef HAVE_ELF_H
+static gboolean
+read_at (FILE *input, glong offset, gpointer buffer, gsize size)
+{
+    if (fseek(input, offset, SEEK_SET) != 0)
+        return FALSE;
+    return fread(buffer, 1, size, input) == size;
+}
+
+static gchar *
+find_build_id (const guchar *notes, gsize size)
+{
+    gsize offset = 0;
+
+    while (offset + sizeof(Elf32_Nhdr) <= size) {
+        Elf32_Nhdr note;
+        gsize name_offset, description_offset, next_offset;
+
+        memcpy(&note, notes + offset, sizeof(note));
+        name_offset = offset + sizeof(note);
+        description_offset = name_offset + ((note.n_namesz + 3) & ~3);
+        next_offset = description_offset + ((note.n_descsz + 3) & ~3);
+        if (next_offset > size || next_offset <= offset)
+            break;
+
+        if (note.n_type == NT_GNU_BUILD_ID &&
+            note.n_namesz == sizeof("GNU") &&
+            memcmp(notes + name_offset, "GNU", sizeof("GNU")) == 0) {
+            GString *build_id;
+            guint32 i;
+
+            build_id = g_string_new(NULL);
+            for (i = 0; i < note.n_descsz; i++) {
+                g_string_append_printf(build_id, "%02x",
+                                       notes[description_offset + i]);
+            }
+            return g_string_free(build_id, FALSE);
+        }
+
+        offset = next_offset;
+    }
+
+    return NULL;
+}
+
+static gchar *
+read_build_id (FILE *input)
+{
+    unsigned char ident[EI_NIDENT];
+    gchar *build_id = NULL;
+    guint64 program_header_offset;
+    guint16 program_header_size, i, n_program_headers;
+
+    if (!read_at(input, 0, ident, sizeof(ident)))
+        return NULL;
+    if (memcmp(ident, ELFMAG, SELFMAG) != 0)
+        return NULL;
+
+    if (ident[EI_CLASS] == ELFCLASS32) {
+        Elf32_Ehdr header;
+
+        if (!read_at(input, 0, &header, sizeof(header)))
+            return NULL;
+        program_header_offset = header.e_phoff;
+        program_header_size = header.e_phentsize;
+        n_program_headers = header.e_phnum;
+    } else if (ident[EI_CLASS] == ELFCLASS64) {
+        Elf64_Ehdr header;
+
+        if (!read_at(input, 0, &header, sizeof(header)))
+            return NULL;
+        program_header_offset = header.e_phoff;
+        program_header_size = header.e_phentsize;
+        n_program_headers = header.e_phnum;
+    } else {
+        return NULL;
+    }
+
+    for (i = 0; !build_id && i < n_program_headers; i++) {
+        glong offset;
+        guint64 note_offset, note_size;
+        guchar *notes;
+
+        offset = program_header_offset + (i * program_header_size);
+        if (ident[EI_CLASS] == ELFCLASS32) {
+            Elf32_Phdr program_header;
+
+            if (!read_at(input, offset, &program_header,
+                         sizeof(program_header)))
+                break;
+            if (program_header.p_type != PT_NOTE)
+                continue;
+            note_offset = program_header.p_offset;
+            note_size = program_header.p_filesz;
+        } else {
+            Elf64_Phdr program_header;
+
+            if (!read_at(input, offset, &program_header,
+                         sizeof(program_header)))
+                break;
+            if (program_header.p_type != PT_NOTE)
+                continue;
+            note_offset = program_header.p_offset;
+            note_size = program_header.p_filesz;
+        }
+
+        /* Notes are small. Broken headers should not make us
+         * allocate a large buffer. */
+        if (note_size == 0 || note_size > 64 * 1024)
+            continue;
+
+        notes = g_malloc(note_size);
+        if (read_at(input, note_offset, notes, note_size))
+            build_id = find_build_id(notes, note_size);
+        g_free(notes);
+    }
+
+    return build_id;
+}
+#endif
+
+gchar *
+cut_elf_loader_get_build_id (CutELFLoader *loader)
+{
+#ifdef HAVE_ELF_H
+    CutELFLoaderPrivate *priv;
+    FILE *input;
+    gchar *build_id;
+
+    priv = CUT_ELF_LOADER_GET_PRIVATE(loader);
+    input = g_fopen(priv->so_filename, "rb");
+    if (!input)
+        return NULL;
+    build_id = read_build_id(input);
+    fclose(input);
+
+    cut_log_trace("[loader][elf][build-id] <%s>:<%s>",
+                  build_id ? build_id : "none",
+                  priv->so_filename);
+
+    return build_id;
+#else
+    return NULL;
+#endif
+}
+
 /*
 vi:ts=4:nowrap:ai:expandtab:sw=4
 */
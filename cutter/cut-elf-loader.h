@@ -52,6 +52,7 @@ gboolean           cut_elf_loader_is_elf            (CutELFLoader *loader);
 
 gboolean           cut_elf_loader_support_attribute (CutELFLoader *loader);
 GList             *cut_elf_loader_collect_symbols   (CutELFLoader *loader);
+gchar             *cut_elf_loader_get_build_id      (CutELFLoader *loader);
 
 G_END_DECLS
 
@@ -233,6 +233,8 @@ runner_run_async (CutRunner *runner)
         g_io_channel_set_close_on_unref(priv->channel, TRUE);
     }
 
+    /* The stream may be written in the binary format. */
+    g_io_channel_set_encoding(priv->channel, NULL, NULL);
     cut_stream_reader_watch_io_channel(stream_reader, priv->channel);
 }
 
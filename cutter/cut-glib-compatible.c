@@ -23,7 +23,24 @@
 
 #include "cut-glib-compatible.h"
 
-#if GLIB_CHECK_VERSION(2, 32, 0)
+#if !GLIB_CHECK_VERSION(2, 32, 0)
+gboolean
+cut_glib_compatible_cond_wait_until (GCond *cond, GMutex *mutex,
+                                     gint64 end_time)
+{
+    GTimeVal deadline;
+    gint64 rest;
+
+    /* end_time is in the monotonic clock but g_cond_timed_wait()
+     * needs the wall clock. */
+    rest = end_time - g_get_monotonic_time();
+    if (rest <= 0)
+        return FALSE;
+    g_get_current_time(&deadline);
+    g_time_val_add(&deadline, rest);
+    return g_cond_timed_wait(cond, mutex, &deadline);
+}
+#else
 GMutex *
 cut_glib_compatible_mutex_new(void)
 {
@@ -39,6 +56,22 @@ cut_glib_compatible_mutex_free(GMutex *mutex)
     g_mutex_clear(mutex);
     g_free(mutex);
 }
+
+GCond *
+cut_glib_compatible_cond_new(void)
+{
+    GCond *cond;
+    cond = g_new(GCond, 1);
+    g_cond_init(cond);
+    return cond;
+}
+
+void
+cut_glib_compatible_cond_free(GCond *cond)
+{
+    g_cond_clear(cond);
+    g_free(cond);
+}
 #endif
 
 /*
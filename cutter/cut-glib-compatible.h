@@ -31,12 +31,22 @@ G_BEGIN_DECLS
 #  undef g_private_set
 #  define g_private_get(key)        g_static_private_get(key)
 #  define g_private_set(key, value) g_static_private_set(key, value, NULL)
+#  define g_cond_wait_until(cond, mutex, end_time)                      \
+    cut_glib_compatible_cond_wait_until(cond, mutex, end_time)
+
+gboolean cut_glib_compatible_cond_wait_until (GCond  *cond,
+                                              GMutex *mutex,
+                                              gint64  end_time);
 #else
 #  define g_mutex_new()             cut_glib_compatible_mutex_new()
 #  define g_mutex_free(mutex)       cut_glib_compatible_mutex_free(mutex)
+#  define g_cond_new()              cut_glib_compatible_cond_new()
+#  define g_cond_free(cond)         cut_glib_compatible_cond_free(cond)
 
 GMutex *cut_glib_compatible_mutex_new (void);
 void    cut_glib_compatible_mutex_free(GMutex *mutex);
+GCond  *cut_glib_compatible_cond_new  (void);
+void    cut_glib_compatible_cond_free (GCond  *cond);
 
 #endif
 
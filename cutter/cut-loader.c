@@ -24,14 +24,17 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <sys/types.h>
+#include <sys/stat.h>
 #include <glib.h>
 #include <glib-compatible/glib-compatible.h>
+#include <glib/gstdio.h>
 #include <gmodule.h>
 
 #ifdef HAVE_LIBBFD
 #  include <bfd.h>
-#else
-#  include <glib/gstdio.h>
+#elif defined(__SSE2__)
+#  include <emmintrin.h>
 #endif
 
 #include "cut-loader.h"
@@ -39,13 +42,16 @@
 #include "cut-mach-o-loader.h"
 #include "cut-pe-loader.h"
 #include "cut-test-iterator.h"
+#include "cut-benchmark.h"
 #include "cut-experimental.h"
 #include "cut-logger.h"
 
 #define TEST_SUITE_SO_NAME_PREFIX "suite"
 #define TEST_NAME_PREFIX "test_"
+#define BENCHMARK_NAME_PREFIX "bench_"
 #define DATA_SETUP_FUNCTION_NAME_PREFIX "data_"
 #define ATTRIBUTES_SETUP_FUNCTION_NAME_PREFIX "attributes_"
+#define SYMBOL_CACHE_GROUP "Symbols"
 #define CUT_LOADER_GET_PRIVATE(obj) (G_TYPE_INSTANCE_GET_PRIVATE ((obj), CUT_TYPE_LOADER, CutLoaderPrivate))
 
 typedef enum {
@@ -65,6 +71,7 @@ struct _SymbolNames
     gboolean require_data_setup_function;
     gboolean cpp;
     gboolean gcc;
+    gboolean benchmark;
 };
 
 typedef struct _CutLoaderPrivate	CutLoaderPrivate;
@@ -80,6 +87,10 @@ struct _CutLoaderPrivate
     gboolean keep_opening;
     gboolean enable_convenience_attribute_definition;
     gchar *base_directory;
+    gchar *symbol_cache_directory;
+    gboolean symbols_collected;
+    gboolean symbols_from_cache;
+    gboolean cached_support_attribute;
     CutCreateTestFunction create_test_function;
     gpointer create_test_function_user_data;
     CutCreateTestIteratorFunction create_test_iterator_function;
@@ -116,10 +127,20 @@ symbol_names_new (gchar *namespace,
     names->require_data_setup_function = require_data_setup_function;
     names->cpp = cpp;
     names->gcc = gcc;
+    names->benchmark = FALSE;
 
     return names;
 }
 
+static gsize
+symbol_names_get_test_name_prefix_length (SymbolNames *names)
+{
+    if (names->benchmark)
+        return strlen(BENCHMARK_NAME_PREFIX);
+    else
+        return strlen(TEST_NAME_PREFIX);
+}
+
 static void
 symbol_names_free (SymbolNames *names)
 {
@@ -183,6 +204,10 @@ cut_loader_init (CutLoader *loader)
     priv->keep_opening = FALSE;
     priv->enable_convenience_attribute_definition = FALSE;
     priv->base_directory = NULL;
+    priv->symbol_cache_directory = NULL;
+    priv->symbols_collected = FALSE;
+    priv->symbols_from_cache = FALSE;
+    priv->cached_support_attribute = FALSE;
     priv->create_test_function = NULL;
     priv->create_test_function_user_data = NULL;
     priv->create_test_iterator_function = NULL;
@@ -237,6 +262,11 @@ dispose (GObject *object)
         priv->base_directory = NULL;
     }
 
+    if (priv->symbol_cache_directory) {
+        g_free(priv->symbol_cache_directory);
+        priv->symbol_cache_directory = NULL;
+    }
+
     G_OBJECT_CLASS(cut_loader_parent_class)->dispose(object);
 }
 
@@ -333,6 +363,24 @@ cut_loader_set_base_directory (CutLoader *loader, const gchar *base_directory)
     priv->base_directory = g_strdup(base_directory);
 }
 
+const gchar *
+cut_loader_get_symbol_cache_directory (CutLoader *loader)
+{
+    return CUT_LOADER_GET_PRIVATE(loader)->symbol_cache_directory;
+}
+
+void
+cut_loader_set_symbol_cache_directory (CutLoader *loader,
+                                       const gchar *symbol_cache_directory)
+{
+    CutLoaderPrivate *priv;
+
+    priv = CUT_LOADER_GET_PRIVATE(loader);
+    if (priv->symbol_cache_directory)
+        g_free(priv->symbol_cache_directory);
+    priv->symbol_cache_directory = g_strdup(symbol_cache_directory);
+}
+
 void
 cut_loader_set_create_test_function (CutLoader *loader,
                                      CutCreateTestFunction create_test_function,
@@ -682,6 +730,24 @@ detect_test_function_symbol_names (const gchar *name)
                                 FALSE,
                                 FALSE,
                                 FALSE);
+    } else if (g_str_has_prefix(name, BENCHMARK_NAME_PREFIX)) {
+        SymbolNames *names;
+        gchar *attributes_setup_function_name;
+
+        attributes_setup_function_name =
+            g_strconcat(ATTRIBUTES_SETUP_FUNCTION_NAME_PREFIX,
+                        name + strlen(BENCHMARK_NAME_PREFIX),
+                        NULL);
+        names = symbol_names_new(NULL,
+                                 g_strdup(name),
+                                 g_strdup(name),
+                                 NULL,
+                                 attributes_setup_function_name,
+                                 FALSE,
+                                 FALSE,
+                                 FALSE);
+        names->benchmark = TRUE;
+        return names;
     }
 
     return detect_cpp_test_function_symbol_names(name);
@@ -689,6 +755,9 @@ detect_test_function_symbol_names (const gchar *name)
 
 #ifdef HAVE_LIBBFD
 
+/* libbfd isn't thread-safe. */
+G_LOCK_DEFINE_STATIC(bfd);
+
 static gboolean
 cut_loader_support_attribute_bfd (CutLoader *loader)
 {
@@ -784,103 +853,196 @@ guess_binary_type (char *buffer, size_t size)
     return CUT_BINARY_TYPE_UNKNOWN;
 }
 
+#define SYMBOL_NAME_MIN_LENGTH 4
+
+typedef struct _ScanContext
+{
+    const gchar *content;
+    CutBinaryType binary_type;
+    GString *name;
+    GStringChunk *names;
+    GHashTable *name_table;
+} ScanContext;
+
 static inline gboolean
-is_valid_char_for_cutter_symbol (GString *name, char *buffer,
-                                 int i, size_t size, CutBinaryType binary_type)
+is_valid_char_for_cutter_symbol (gchar c)
 {
-    char c;
+    return g_ascii_isalnum(c) || '_' == c;
+}
 
-    c = buffer[i];
-    if (binary_type == CUT_BINARY_TYPE_MACH_O_BUNDLE) {
-        if (name->len == 0 && i > 0 && buffer[i - 1] == '\0' && c == '_')
-            return FALSE;
+static void
+add_symbol_candidate (ScanContext *context, gsize start, gsize end)
+{
+    const gchar *content;
+
+    content = context->content;
+    if (context->binary_type == CUT_BINARY_TYPE_MACH_O_BUNDLE) {
+        if (start > 0 && content[start - 1] == '\0' && content[start] == '_')
+            start++;
     }
 
-    return g_ascii_isalnum(c) || '_' == c;
+    if (end - start < SYMBOL_NAME_MIN_LENGTH)
+        return;
+
+    g_string_truncate(context->name, 0);
+    g_string_append_len(context->name, content + start, end - start);
+    if (g_hash_table_lookup(context->name_table, context->name->str))
+        return;
+
+    cut_log_trace("[loader][scan][collect-symbols][symbol][collect] <%s>",
+                  context->name->str);
+    g_hash_table_insert(context->name_table,
+                        g_string_chunk_insert(context->names,
+                                              context->name->str),
+                        GINT_TO_POINTER(TRUE));
 }
 
-static inline gboolean
-is_valid_symbol_name (GString *name)
+#ifdef __SSE2__
+/* Returns a bit mask of bytes that are [0-9A-Za-z_] in 16 bytes. */
+static inline guint
+symbol_char_mask_sse2 (const gchar *data)
 {
-    return name->len >= 4;
+    __m128i chunk, digit, upper, lower, underscore;
+
+    chunk = _mm_loadu_si128((const __m128i *)data);
+#define IN_RANGE(min, max)                                              \
+    _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8((min) - 1)),      \
+                  _mm_cmplt_epi8(chunk, _mm_set1_epi8((max) + 1)))
+    digit = IN_RANGE('0', '9');
+    upper = IN_RANGE('A', 'Z');
+    lower = IN_RANGE('a', 'z');
+#undef IN_RANGE
+    underscore = _mm_cmpeq_epi8(chunk, _mm_set1_epi8('_'));
+
+    return _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(digit, upper),
+                                          _mm_or_si128(lower, underscore)));
 }
+#endif
 
-static GList *
-collect_symbols_scan (CutLoaderPrivate *priv)
+static void
+scan_symbol_candidates (ScanContext *context, gsize size)
 {
-    FILE *input;
-    GString *name;
-    char buffer[4096];
-    size_t size;
-    GHashTable *symbol_name_table;
-    GList *symbols;
-    gboolean first_buffer = TRUE;
-
-    cut_log_trace("[loader][scan][open] <%s>",
-                  priv->so_filename);
-    input = g_fopen(priv->so_filename, "rb");
-    if (!input)
-        return NULL;
-
-    symbol_name_table = g_hash_table_new(g_str_hash, g_str_equal);
-    name = g_string_new("");
-    while ((size = fread(buffer, sizeof(*buffer), sizeof(buffer), input)) > 0) {
-        size_t i;
-
-        if (first_buffer) {
-            priv->binary_type = guess_binary_type(buffer, size);
-            first_buffer = FALSE;
+    const gchar *content;
+    gsize i = 0;
+    gboolean in_name = FALSE;
+    gsize name_start = 0;
+
+    content = context->content;
+
+#ifdef __SSE2__
+    /* Most bytes of a binary are outside of names or inside of
+     * long names. We check 16 bytes at once for them. */
+    for (; i + 16 <= size; i += 16) {
+        guint mask, j;
+
+        mask = symbol_char_mask_sse2(content + i);
+        if (mask == 0) {
+            if (in_name) {
+                add_symbol_candidate(context, name_start, i);
+                in_name = FALSE;
+            }
+            continue;
+        }
+        if (mask == 0xffff) {
+            if (!in_name) {
+                name_start = i;
+                in_name = TRUE;
+            }
+            continue;
         }
 
-        for (i = 0; i < size; i++) {
-            if (is_valid_char_for_cutter_symbol(name, buffer, i,
-                                                size, priv->binary_type)) {
-                g_string_append_c(name, buffer[i]);
-            } else if (name->len > 0) {
-                cut_log_trace("[loader][scan][collect-symbols][symbol] <%s>",
-                              name->str);
-                if (is_valid_symbol_name(name)) {
-                    cut_log_trace("[loader][scan][collect-symbols][symbol]"
-                                  "[collect] <%s>",
-                                  name->str);
-                    g_hash_table_insert(symbol_name_table,
-                                        g_strdup(name->str), NULL);
+        for (j = 0; j < 16; j++) {
+            if (mask & (1 << j)) {
+                if (!in_name) {
+                    name_start = i + j;
+                    in_name = TRUE;
                 }
-                g_string_truncate(name, 0);
+            } else if (in_name) {
+                add_symbol_candidate(context, name_start, i + j);
+                in_name = FALSE;
+            }
+        }
+    }
+#endif
+
+    for (; i < size; i++) {
+        if (is_valid_char_for_cutter_symbol(content[i])) {
+            if (!in_name) {
+                name_start = i;
+                in_name = TRUE;
             }
+        } else if (in_name) {
+            add_symbol_candidate(context, name_start, i);
+            in_name = FALSE;
         }
     }
 
-    cut_log_trace("[loader][scan][collect-symbols][symbol][last] <%s>",
-                  name->str);
-    if (is_valid_symbol_name(name)) {
-        cut_log_trace("[loader][scan][collect-symbols][symbol][last][collect] "
-                      "<%s>",
-                      name->str);
-        g_hash_table_insert(symbol_name_table, g_strdup(name->str), NULL);
+    if (in_name)
+        add_symbol_candidate(context, name_start, size);
+}
+
+static void
+collect_symbol_name (gpointer key, gpointer value, gpointer user_data)
+{
+    GList **symbols = user_data;
+
+    *symbols = g_list_prepend(*symbols, g_strdup(key));
+}
+
+static GList *
+collect_symbols_scan (CutLoaderPrivate *priv)
+{
+    GMappedFile *mapped_file;
+    GError *error = NULL;
+    ScanContext context;
+    gsize size;
+    GList *symbols = NULL;
+
+    cut_log_trace("[loader][scan][open] <%s>",
+                  priv->so_filename);
+    mapped_file = g_mapped_file_new(priv->so_filename, FALSE, &error);
+    if (!mapped_file) {
+        cut_log_trace("[loader][scan][open][fail] <%s>: %s",
+                      priv->so_filename, error->message);
+        g_error_free(error);
+        return NULL;
     }
-    g_string_free(name, TRUE);
 
-    cut_log_trace("[loader][scan][collect-symbols][n-symbols] <%d>",
-                  g_hash_table_size(symbol_name_table));
-    symbols = g_hash_table_get_keys(symbol_name_table);
-    g_hash_table_unref(symbol_name_table);
+    context.content = g_mapped_file_get_contents(mapped_file);
+    size = g_mapped_file_get_length(mapped_file);
+    priv->binary_type = guess_binary_type((char *)context.content,
+                                          MIN(size, 4096));
+    context.binary_type = priv->binary_type;
+    context.name = g_string_new(NULL);
+    context.names = g_string_chunk_new(4096);
+    context.name_table = g_hash_table_new(g_str_hash, g_str_equal);
+
+    if (context.content)
+        scan_symbol_candidates(&context, size);
 
-    fclose(input);
+    cut_log_trace("[loader][scan][collect-symbols][n-symbols] <%d>",
+                  g_hash_table_size(context.name_table));
+    g_hash_table_foreach(context.name_table, collect_symbol_name, &symbols);
+
+    g_hash_table_unref(context.name_table);
+    g_string_chunk_free(context.names);
+    g_string_free(context.name, TRUE);
+#if GLIB_CHECK_VERSION(2, 22, 0)
+    g_mapped_file_unref(mapped_file);
+#else
+    g_mapped_file_free(mapped_file);
+#endif
 
     return symbols;
 }
 #endif
 
-gboolean
-cut_loader_support_attribute (CutLoader *loader)
+static gboolean
+support_attribute (CutLoader *loader)
 {
     CutLoaderPrivate *priv;
 
     priv = CUT_LOADER_GET_PRIVATE(loader);
-    if (!priv->enable_convenience_attribute_definition)
-        return FALSE;
-
     if (priv->elf_loader) {
         return cut_elf_loader_support_attribute(priv->elf_loader);
     } else if (priv->mach_o_loader) {
@@ -896,6 +1058,20 @@ cut_loader_support_attribute (CutLoader *loader)
     }
 }
 
+gboolean
+cut_loader_support_attribute (CutLoader *loader)
+{
+    CutLoaderPrivate *priv;
+
+    priv = CUT_LOADER_GET_PRIVATE(loader);
+    if (!priv->enable_convenience_attribute_definition)
+        return FALSE;
+
+    if (priv->symbols_from_cache)
+        return priv->cached_support_attribute;
+    return support_attribute(loader);
+}
+
 static GList *
 collect_symbols (CutLoaderPrivate *priv)
 {
@@ -907,13 +1083,261 @@ collect_symbols (CutLoaderPrivate *priv)
         return cut_pe_loader_collect_symbols(priv->pe_loader);
     } else {
 #ifdef HAVE_LIBBFD
-        return collect_symbols_bfd(priv);
+        GList *symbols;
+
+        G_LOCK(bfd);
+        symbols = collect_symbols_bfd(priv);
+        G_UNLOCK(bfd);
+        return symbols;
 #else
         return collect_symbols_scan(priv);
 #endif
     }
 }
 
+static gboolean
+is_symbol_cache_enabled (CutLoaderPrivate *priv)
+{
+    return priv->symbol_cache_directory && priv->symbol_cache_directory[0];
+}
+
+static gchar *
+get_absolute_so_filename (CutLoaderPrivate *priv)
+{
+    gchar *current_directory, *absolute_so_filename;
+
+    if (g_path_is_absolute(priv->so_filename))
+        return g_strdup(priv->so_filename);
+
+    current_directory = g_get_current_dir();
+    absolute_so_filename = g_build_filename(current_directory,
+                                            priv->so_filename,
+                                            NULL);
+    g_free(current_directory);
+
+    return absolute_so_filename;
+}
+
+static gchar *
+get_symbol_cache_filename (CutLoaderPrivate *priv,
+                           const gchar *absolute_so_filename)
+{
+    gchar *base_name, *character, *cache_filename;
+
+    /* The real path is recorded in the cache file. So we don't
+     * need to care about collisions. */
+    base_name = g_strconcat(absolute_so_filename, ".symbols", NULL);
+    for (character = base_name; *character; character++) {
+        if (!g_ascii_isalnum(*character) &&
+            *character != '-' &&
+            *character != '.')
+            *character = '_';
+    }
+    cache_filename = g_build_filename(priv->symbol_cache_directory,
+                                      "symbols",
+                                      base_name,
+                                      NULL);
+    g_free(base_name);
+
+    return cache_filename;
+}
+
+static gchar *
+get_build_id (CutLoaderPrivate *priv)
+{
+    CutELFLoader *elf_loader;
+    gchar *build_id;
+
+    elf_loader = cut_elf_loader_new(priv->so_filename);
+    build_id = cut_elf_loader_get_build_id(elf_loader);
+    g_object_unref(elf_loader);
+
+    if (!build_id)
+        build_id = g_strdup("");
+    return build_id;
+}
+
+static gboolean
+is_valid_symbol_cache (GKeyFile *key_file, const gchar *key,
+                       const gchar *expected)
+{
+    gchar *actual;
+    gboolean valid;
+
+    actual = g_key_file_get_string(key_file, SYMBOL_CACHE_GROUP, key, NULL);
+    valid = actual && g_str_equal(expected, actual);
+    g_free(actual);
+
+    return valid;
+}
+
+static gboolean
+load_cached_symbols (CutLoader *loader)
+{
+    CutLoaderPrivate *priv;
+    struct stat stat_buffer;
+    GKeyFile *key_file;
+    gchar *absolute_so_filename, *cache_filename;
+    gchar *mtime = NULL, *size = NULL, *build_id = NULL;
+    gchar **symbols;
+    gsize i, n_symbols;
+    gboolean loaded = FALSE;
+
+    priv = CUT_LOADER_GET_PRIVATE(loader);
+    if (!is_symbol_cache_enabled(priv))
+        return FALSE;
+
+    if (g_stat(priv->so_filename, &stat_buffer) != 0)
+        return FALSE;
+
+    absolute_so_filename = get_absolute_so_filename(priv);
+    cache_filename = get_symbol_cache_filename(priv, absolute_so_filename);
+    key_file = g_key_file_new();
+    if (!g_key_file_load_from_file(key_file, cache_filename,
+                                   G_KEY_FILE_NONE, NULL))
+        goto done;
+
+    mtime = g_strdup_printf("%" G_GINT64_FORMAT, (gint64)stat_buffer.st_mtime);
+    size = g_strdup_printf("%" G_GINT64_FORMAT, (gint64)stat_buffer.st_size);
+    if (!is_valid_symbol_cache(key_file, "Path", absolute_so_filename) ||
+        !is_valid_symbol_cache(key_file, "MTime", mtime) ||
+        !is_valid_symbol_cache(key_file, "Size", size))
+        goto done;
+
+    /* A rebuilt module may have the same mtime and size. */
+    build_id = get_build_id(priv);
+    if (!is_valid_symbol_cache(key_file, "BuildID", build_id))
+        goto done;
+
+    symbols = g_key_file_get_string_list(key_file, SYMBOL_CACHE_GROUP,
+                                         "Symbols", &n_symbols, NULL);
+    if (!symbols)
+        goto done;
+
+    for (i = 0; i < n_symbols; i++) {
+        priv->symbols = g_list_prepend(priv->symbols, symbols[i]);
+    }
+    g_free(symbols);
+    priv->cached_support_attribute =
+        g_key_file_get_boolean(key_file, SYMBOL_CACHE_GROUP,
+                               "SupportAttribute", NULL);
+    priv->symbols_from_cache = TRUE;
+    loaded = TRUE;
+
+done:
+    cut_log_trace("[loader][symbol-cache][load][%s] <%s>:<%s>",
+                  loaded ? "hit" : "miss",
+                  cache_filename,
+                  priv->so_filename);
+    g_free(mtime);
+    g_free(size);
+    g_free(build_id);
+    g_key_file_free(key_file);
+    g_free(cache_filename);
+    g_free(absolute_so_filename);
+
+    return loaded;
+}
+
+static void
+save_cached_symbols (CutLoader *loader)
+{
+    CutLoaderPrivate *priv;
+    struct stat stat_buffer;
+    GKeyFile *key_file;
+    gchar *absolute_so_filename, *cache_filename, *cache_directory;
+    gchar *value, *data;
+    const gchar **symbols;
+    GList *node;
+    gsize i, length;
+    GError *error = NULL;
+
+    priv = CUT_LOADER_GET_PRIVATE(loader);
+    if (!is_symbol_cache_enabled(priv))
+        return;
+    if (!priv->symbols)
+        return;
+    if (g_stat(priv->so_filename, &stat_buffer) != 0)
+        return;
+
+    absolute_so_filename = get_absolute_so_filename(priv);
+    cache_filename = get_symbol_cache_filename(priv, absolute_so_filename);
+
+    key_file = g_key_file_new();
+    g_key_file_set_string(key_file, SYMBOL_CACHE_GROUP,
+                          "Path", absolute_so_filename);
+    value = g_strdup_printf("%" G_GINT64_FORMAT, (gint64)stat_buffer.st_mtime);
+    g_key_file_set_string(key_file, SYMBOL_CACHE_GROUP, "MTime", value);
+    g_free(value);
+    value = g_strdup_printf("%" G_GINT64_FORMAT, (gint64)stat_buffer.st_size);
+    g_key_file_set_string(key_file, SYMBOL_CACHE_GROUP, "Size", value);
+    g_free(value);
+    value = get_build_id(priv);
+    g_key_file_set_string(key_file, SYMBOL_CACHE_GROUP, "BuildID", value);
+    g_free(value);
+    g_key_file_set_boolean(key_file, SYMBOL_CACHE_GROUP,
+                           "SupportAttribute", support_attribute(loader));
+
+    symbols = g_new0(const gchar *, g_list_length(priv->symbols) + 1);
+    for (node = priv->symbols, i = 0; node; node = g_list_next(node), i++) {
+        symbols[i] = node->data;
+    }
+    g_key_file_set_string_list(key_file, SYMBOL_CACHE_GROUP, "Symbols",
+                               symbols, i);
+    g_free(symbols);
+
+    data = g_key_file_to_data(key_file, &length, NULL);
+    cache_directory = g_path_get_dirname(cache_filename);
+    if (g_mkdir_with_parents(cache_directory, 0755) == -1) {
+        cut_log_warning("[loader][symbol-cache][save][mkdir][fail] <%s>",
+                        cache_directory);
+    } else if (!g_file_set_contents(cache_filename, data, length, &error)) {
+        cut_log_warning("[loader][symbol-cache][save][fail] <%s>: %s",
+                        cache_filename, error->message);
+        g_error_free(error);
+    } else {
+        cut_log_trace("[loader][symbol-cache][save] <%s>:<%s>",
+                      cache_filename,
+                      priv->so_filename);
+    }
+    g_free(cache_directory);
+    g_free(data);
+    g_key_file_free(key_file);
+    g_free(cache_filename);
+    g_free(absolute_so_filename);
+}
+
+static void
+open_binary_loaders (CutLoaderPrivate *priv)
+{
+    priv->elf_loader = cut_elf_loader_new(priv->so_filename);
+    if (!cut_elf_loader_is_elf(priv->elf_loader)) {
+        g_object_unref(priv->elf_loader);
+        priv->elf_loader = NULL;
+    }
+    cut_log_trace("[loader][test-cases][elf][%s] <%s>",
+                  priv->elf_loader ? "yes" : "no",
+                  priv->so_filename);
+
+    priv->mach_o_loader = cut_mach_o_loader_new(priv->so_filename);
+    if (!cut_mach_o_loader_is_mach_o(priv->mach_o_loader)) {
+        g_object_unref(priv->mach_o_loader);
+        priv->mach_o_loader = NULL;
+    }
+    cut_log_trace("[loader][test-cases][mach-o][%s] <%s>",
+                  priv->mach_o_loader ? "yes" : "no",
+                  priv->so_filename);
+
+    priv->pe_loader = cut_pe_loader_new(priv->so_filename);
+    if (!cut_pe_loader_is_dll(priv->pe_loader)) {
+        g_object_unref(priv->pe_loader);
+        priv->pe_loader = NULL;
+    }
+    cut_log_trace("[loader][test-cases][pe][%s] <%s>",
+                  priv->pe_loader ? "yes" : "no",
+                  priv->so_filename);
+}
+
 static GList *
 collect_test_functions (CutLoaderPrivate *priv)
 {
@@ -968,7 +1392,9 @@ is_including_test_name (const gchar *function_name, SymbolNames *names)
     }
 
     suffix = g_string_new("_");
-    g_string_append(suffix, names->test_name + strlen(TEST_NAME_PREFIX));
+    g_string_append(suffix,
+                    names->test_name +
+                    symbol_names_get_test_name_prefix_length(names));
     if (names->cpp)
         g_string_append(suffix, "Ev");
     included = g_str_has_suffix(base_name, suffix->str);
@@ -994,6 +1420,7 @@ is_valid_attribute_function_name (const gchar *function_name, SymbolNames *names
 
     return
         !g_str_has_prefix(base_name, TEST_NAME_PREFIX) &&
+        !g_str_has_prefix(base_name, BENCHMARK_NAME_PREFIX) &&
         !g_str_has_prefix(base_name,
                           ATTRIBUTES_SETUP_FUNCTION_NAME_PREFIX) &&
         !g_str_has_prefix(base_name, DATA_SETUP_FUNCTION_NAME_PREFIX) &&
@@ -1015,8 +1442,10 @@ get_attribute_name (const gchar *attribute_function_name, SymbolNames *names)
         base_name = (gchar *)attribute_function_name;
     }
 
-    test_base_name = g_strrstr(base_name,
-                               names->test_name + strlen(TEST_NAME_PREFIX)) - 1;
+    test_base_name =
+        g_strrstr(base_name,
+                  names->test_name +
+                  symbol_names_get_test_name_prefix_length(names)) - 1;
     return g_strndup(base_name, test_base_name - base_name);
 }
 
@@ -1109,7 +1538,9 @@ register_valid_test (CutLoader *loader, CutTestCase *test_case,
         g_module_symbol(priv->module, names->attributes_setup_function_name,
                         (gpointer)&attributes_setup_function);
 
-    if (data_setup_function) {
+    if (names->benchmark) {
+        test = CUT_TEST(cut_benchmark_new(names->test_name, test_function));
+    } else if (data_setup_function) {
         CutTestIterator *test_iterator;
         test_iterator =
             create_test_iterator(priv,
@@ -1293,6 +1724,30 @@ find_cpp_test_case (gconstpointer value1, gconstpointer value2)
     }
 }
 
+gboolean
+cut_loader_collect_symbols (CutLoader *loader)
+{
+    CutLoaderPrivate *priv;
+
+    priv = CUT_LOADER_GET_PRIVATE(loader);
+    if (priv->symbols_collected)
+        return priv->symbols != NULL;
+    if (!priv->so_filename)
+        return FALSE;
+
+    priv->symbols_collected = TRUE;
+    if (!load_cached_symbols(loader)) {
+        open_binary_loaders(priv);
+        priv->symbols = collect_symbols(priv);
+        save_cached_symbols(loader);
+    }
+    cut_log_trace("[loader][test-cases][collect-symbols] <%d>:<%s>",
+                  g_list_length(priv->symbols),
+                  priv->so_filename);
+
+    return priv->symbols != NULL;
+}
+
 GList *
 cut_loader_load_test_cases (CutLoader *loader)
 {
@@ -1314,38 +1769,7 @@ cut_loader_load_test_cases (CutLoader *loader)
         return NULL;
     }
 
-    priv->elf_loader = cut_elf_loader_new(priv->so_filename);
-    if (!cut_elf_loader_is_elf(priv->elf_loader)) {
-        g_object_unref(priv->elf_loader);
-        priv->elf_loader = NULL;
-    }
-    cut_log_trace("[loader][test-cases][elf][%s] <%s>",
-                  priv->elf_loader ? "yes" : "no",
-                  priv->so_filename);
-
-    priv->mach_o_loader = cut_mach_o_loader_new(priv->so_filename);
-    if (!cut_mach_o_loader_is_mach_o(priv->mach_o_loader)) {
-        g_object_unref(priv->mach_o_loader);
-        priv->mach_o_loader = NULL;
-    }
-    cut_log_trace("[loader][test-cases][mach-o][%s] <%s>",
-                  priv->mach_o_loader ? "yes" : "no",
-                  priv->so_filename);
-
-    priv->pe_loader = cut_pe_loader_new(priv->so_filename);
-    if (!cut_pe_loader_is_dll(priv->pe_loader)) {
-        g_object_unref(priv->pe_loader);
-        priv->pe_loader = NULL;
-    }
-    cut_log_trace("[loader][test-cases][pe][%s] <%s>",
-                  priv->pe_loader ? "yes" : "no",
-                  priv->so_filename);
-
-    priv->symbols = collect_symbols(priv);
-    cut_log_trace("[loader][test-cases][collect-symbols] <%d>:<%s>",
-                  g_list_length(priv->symbols),
-                  priv->so_filename);
-    if (!priv->symbols)
+    if (!cut_loader_collect_symbols(loader))
         return NULL;
 
     test_names = collect_test_functions(priv);
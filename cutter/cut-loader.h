@@ -74,6 +74,11 @@ void          cut_loader_set_enable_convenience_attribute_definition
 const gchar  *cut_loader_get_base_directory(CutLoader *loader);
 void          cut_loader_set_base_directory(CutLoader *loader,
                                             const gchar *base_directory);
+const gchar  *cut_loader_get_symbol_cache_directory
+                                           (CutLoader *loader);
+void          cut_loader_set_symbol_cache_directory
+                                           (CutLoader *loader,
+                                            const gchar *symbol_cache_directory);
 void          cut_loader_set_create_test_function
                                            (CutLoader *loader,
                                             CutCreateTestFunction create_test_function,
@@ -83,6 +88,7 @@ void          cut_loader_set_create_test_iterator_function
                                             CutCreateTestIteratorFunction
                                                        create_test_iterator_function,
                                             gpointer   user_data);
+gboolean      cut_loader_collect_symbols   (CutLoader *loader);
 GList        *cut_loader_load_test_cases   (CutLoader *loader);
 CutTestCase  *cut_loader_load_test_case    (CutLoader *loader);
 CutTestSuite *cut_loader_load_test_suite   (CutLoader *loader);
@@ -0,0 +1,254 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <glib.h>
+
+#include "cut-log-index.h"
+#include "cut-logger.h"
+
+#define SIZE_KEY "Size"
+#define MODIFIED_TIME_KEY "ModifiedTime"
+#define SUCCESS_KEY "Success"
+#define CRASHED_KEY "Crashed"
+#define ELAPSED_KEY "Elapsed"
+#define N_TESTS_KEY "NTests"
+#define N_ASSERTIONS_KEY "NAssertions"
+#define N_SUCCESSES_KEY "NSuccesses"
+#define N_FAILURES_KEY "NFailures"
+#define N_ERRORS_KEY "NErrors"
+#define N_PENDINGS_KEY "NPendings"
+#define N_NOTIFICATIONS_KEY "NNotifications"
+#define N_OMISSIONS_KEY "NOmissions"
+
+struct _CutLogIndex
+{
+    gchar *filename;
+    GKeyFile *key_file;
+    gboolean modified;
+};
+
+CutLogSummary *
+cut_log_summary_new (const gchar *log_name)
+{
+    CutLogSummary *summary;
+
+    summary = g_new0(CutLogSummary, 1);
+    summary->log_name = g_strdup(log_name);
+
+    return summary;
+}
+
+void
+cut_log_summary_free (CutLogSummary *summary)
+{
+    g_free(summary->log_name);
+    g_free(summary);
+}
+
+gchar *
+cut_log_index_build_filename (const gchar *log_directory)
+{
+    return g_build_filename(log_directory, CUT_LOG_INDEX_BASE_NAME, NULL);
+}
+
+CutLogIndex *
+cut_log_index_new (const gchar *filename)
+{
+    CutLogIndex *log_index;
+
+    log_index = g_new0(CutLogIndex, 1);
+    log_index->filename = g_strdup(filename);
+    log_index->key_file = g_key_file_new();
+    log_index->modified = FALSE;
+
+    return log_index;
+}
+
+void
+cut_log_index_free (CutLogIndex *log_index)
+{
+    g_free(log_index->filename);
+    g_key_file_free(log_index->key_file);
+    g_free(log_index);
+}
+
+const gchar *
+cut_log_index_get_filename (CutLogIndex *log_index)
+{
+    return log_index->filename;
+}
+
+gboolean
+cut_log_index_load (CutLogIndex *log_index, GError **error)
+{
+    if (!g_file_test(log_index->filename, G_FILE_TEST_EXISTS))
+        return TRUE;
+
+    if (!g_key_file_load_from_file(log_index->key_file, log_index->filename,
+                                   G_KEY_FILE_NONE, error))
+        return FALSE;
+
+    log_index->modified = FALSE;
+    cut_log_trace("[log-index][load] <%s>", log_index->filename);
+    return TRUE;
+}
+
+gboolean
+cut_log_index_save (CutLogIndex *log_index, GError **error)
+{
+    gchar *data;
+    gsize length;
+    gboolean success;
+
+    data = g_key_file_to_data(log_index->key_file, &length, NULL);
+    success = g_file_set_contents(log_index->filename, data, length, error);
+    g_free(data);
+
+    if (success) {
+        log_index->modified = FALSE;
+        cut_log_trace("[log-index][save] <%s>", log_index->filename);
+    }
+    return success;
+}
+
+gboolean
+cut_log_index_is_modified (CutLogIndex *log_index)
+{
+    return log_index->modified;
+}
+
+static guint
+get_uint (GKeyFile *key_file, const gchar *log_name, const gchar *key,
+          GError **error)
+{
+    gint value;
+
+    if (*error)
+        return 0;
+
+    value = g_key_file_get_integer(key_file, log_name, key, error);
+    return MAX(value, 0);
+}
+
+CutLogSummary *
+cut_log_index_lookup (CutLogIndex *log_index, const gchar *log_name,
+                      gint64 size, gint64 modified_time)
+{
+    GKeyFile *key_file = log_index->key_file;
+    CutLogSummary *summary;
+    GError *error = NULL;
+
+    if (!g_key_file_has_group(key_file, log_name))
+        return NULL;
+
+    if (g_key_file_get_int64(key_file, log_name, SIZE_KEY, &error) != size ||
+        error ||
+        g_key_file_get_int64(key_file, log_name, MODIFIED_TIME_KEY,
+                             &error) != modified_time ||
+        error) {
+        if (error)
+            g_error_free(error);
+        return NULL;
+    }
+
+    summary = cut_log_summary_new(log_name);
+    summary->success = g_key_file_get_boolean(key_file, log_name,
+                                              SUCCESS_KEY, &error);
+    if (!error)
+        summary->crashed = g_key_file_get_boolean(key_file, log_name,
+                                                  CRASHED_KEY, &error);
+    if (!error)
+        summary->elapsed = g_key_file_get_double(key_file, log_name,
+                                                 ELAPSED_KEY, &error);
+    summary->n_tests = get_uint(key_file, log_name, N_TESTS_KEY, &error);
+    summary->n_assertions = get_uint(key_file, log_name, N_ASSERTIONS_KEY,
+                                     &error);
+    summary->n_successes = get_uint(key_file, log_name, N_SUCCESSES_KEY,
+                                    &error);
+    summary->n_failures = get_uint(key_file, log_name, N_FAILURES_KEY, &error);
+    summary->n_errors = get_uint(key_file, log_name, N_ERRORS_KEY, &error);
+    summary->n_pendings = get_uint(key_file, log_name, N_PENDINGS_KEY, &error);
+    summary->n_notifications = get_uint(key_file, log_name,
+                                        N_NOTIFICATIONS_KEY, &error);
+    summary->n_omissions = get_uint(key_file, log_name, N_OMISSIONS_KEY,
+                                    &error);
+
+    if (error) {
+        cut_log_warning("[log-index][lookup][broken] <%s>: <%s>: %s",
+                        log_index->filename, log_name, error->message);
+        g_error_free(error);
+        cut_log_summary_free(summary);
+        return NULL;
+    }
+
+    return summary;
+}
+
+void
+cut_log_index_record (CutLogIndex *log_index, const CutLogSummary *summary,
+                      gint64 size, gint64 modified_time)
+{
+    GKeyFile *key_file = log_index->key_file;
+    const gchar *log_name = summary->log_name;
+
+    g_key_file_set_int64(key_file, log_name, SIZE_KEY, size);
+    g_key_file_set_int64(key_file, log_name, MODIFIED_TIME_KEY,
+                         modified_time);
+    g_key_file_set_boolean(key_file, log_name, SUCCESS_KEY, summary->success);
+    g_key_file_set_boolean(key_file, log_name, CRASHED_KEY, summary->crashed);
+    g_key_file_set_double(key_file, log_name, ELAPSED_KEY, summary->elapsed);
+    g_key_file_set_integer(key_file, log_name, N_TESTS_KEY, summary->n_tests);
+    g_key_file_set_integer(key_file, log_name, N_ASSERTIONS_KEY,
+                           summary->n_assertions);
+    g_key_file_set_integer(key_file, log_name, N_SUCCESSES_KEY,
+                           summary->n_successes);
+    g_key_file_set_integer(key_file, log_name, N_FAILURES_KEY,
+                           summary->n_failures);
+    g_key_file_set_integer(key_file, log_name, N_ERRORS_KEY,
+                           summary->n_errors);
+    g_key_file_set_integer(key_file, log_name, N_PENDINGS_KEY,
+                           summary->n_pendings);
+    g_key_file_set_integer(key_file, log_name, N_NOTIFICATIONS_KEY,
+                           summary->n_notifications);
+    g_key_file_set_integer(key_file, log_name, N_OMISSIONS_KEY,
+                           summary->n_omissions);
+    log_index->modified = TRUE;
+}
+
+void
+cut_log_index_remove (CutLogIndex *log_index, const gchar *log_name)
+{
+    if (g_key_file_remove_group(log_index->key_file, log_name, NULL))
+        log_index->modified = TRUE;
+}
+
+gchar **
+cut_log_index_get_log_names (CutLogIndex *log_index)
+{
+    return g_key_file_get_groups(log_index->key_file, NULL);
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
@@ -0,0 +1,93 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef __CUT_LOG_INDEX_H__
+#define __CUT_LOG_INDEX_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+#define CUT_LOG_INDEX_BASE_NAME "summary.index"
+
+/*
+ * CutLogSummary is the result of a run that is streamed to a
+ * log file. CutLogIndex caches summaries of log files in a log
+ * directory. A cached summary is used while the size and the
+ * modified time of its log file aren't changed.
+ */
+typedef struct _CutLogSummary CutLogSummary;
+typedef struct _CutLogIndex CutLogIndex;
+
+struct _CutLogSummary
+{
+    gchar *log_name;
+    gboolean success;
+    gboolean crashed;
+    gdouble elapsed;
+    guint n_tests;
+    guint n_assertions;
+    guint n_successes;
+    guint n_failures;
+    guint n_errors;
+    guint n_pendings;
+    guint n_notifications;
+    guint n_omissions;
+};
+
+CutLogSummary *cut_log_summary_new        (const gchar    *log_name);
+void           cut_log_summary_free       (CutLogSummary  *summary);
+
+gchar         *cut_log_index_build_filename
+                                          (const gchar    *log_directory);
+
+CutLogIndex   *cut_log_index_new          (const gchar    *filename);
+void           cut_log_index_free         (CutLogIndex    *log_index);
+
+const gchar   *cut_log_index_get_filename (CutLogIndex    *log_index);
+gboolean       cut_log_index_load         (CutLogIndex    *log_index,
+                                           GError        **error);
+gboolean       cut_log_index_save         (CutLogIndex    *log_index,
+                                           GError        **error);
+gboolean       cut_log_index_is_modified  (CutLogIndex    *log_index);
+
+/* Returns NULL for an unknown or changed log file. The caller
+ * owns the returned summary. */
+CutLogSummary *cut_log_index_lookup       (CutLogIndex    *log_index,
+                                           const gchar    *log_name,
+                                           gint64          size,
+                                           gint64          modified_time);
+void           cut_log_index_record       (CutLogIndex    *log_index,
+                                           const CutLogSummary *summary,
+                                           gint64          size,
+                                           gint64          modified_time);
+void           cut_log_index_remove       (CutLogIndex    *log_index,
+                                           const gchar    *log_name);
+/* The caller owns the returned NULL-terminated array. */
+gchar        **cut_log_index_get_log_names
+                                          (CutLogIndex    *log_index);
+
+G_END_DECLS
+
+#endif /* __CUT_LOG_INDEX_H__ */
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
@@ -41,6 +41,10 @@ char **environ = NULL;
 #include "cut-file-stream-reader.h"
 #include "cut-test-runner.h"
 #include "cut-test-suite.h"
+#include "cut-test-result.h"
+#include "cut-benchmark.h"
+#include "cut-baseline.h"
+#include "cut-run-history.h"
 #include "cut-ui.h"
 #include "cut-module-factory.h"
 #include "cut-contractor.h"
@@ -83,7 +87,11 @@ static gchar **exclude_files = NULL;
 static gchar **exclude_directories = NULL;
 static CutOrder test_case_order = CUT_ORDER_NONE_SPECIFIED;
 static gboolean use_multi_thread = FALSE;
+static gboolean split_test_cases = FALSE;
 static gint max_threads = 10;
+static gint n_processes = 0;
+static gchar *shard_listen = NULL;
+static gchar *shard_connect = NULL;
 static gboolean disable_signal_handling = FALSE;
 static GList *listener_factories = NULL;
 static GList *loader_customizer_factories = NULL;
@@ -94,6 +102,21 @@ static gboolean fatal_failures = FALSE;
 static gboolean keep_opening_modules = FALSE;
 static gboolean enable_convenience_attribute_definition = FALSE;
 static gboolean stop_before_test = FALSE;
+static gchar *symbol_cache_directory = NULL;
+static gboolean batch_assertions = FALSE;
+static CutResultRetention result_retention = CUT_RESULT_RETENTION_ALL;
+static gboolean disable_timing_history_update = FALSE;
+static gchar *history_pattern = NULL;
+static gdouble timeout = 0.0;
+static gdouble benchmark_time = CUT_BENCHMARK_DEFAULT_TIME;
+static gchar *save_baseline = NULL;
+static gchar *compare_baseline = NULL;
+static gdouble regression_threshold = CUT_BASELINE_DEFAULT_REGRESSION_THRESHOLD;
+static gboolean fail_on_regression = FALSE;
+static gboolean performance_counters = FALSE;
+static gboolean memory_usage = FALSE;
+static gint allocation_failures = 0;
+static gint max_diff_size = -1;
 
 static gboolean
 print_version (const gchar *option_name, const gchar *value,
@@ -160,6 +183,8 @@ parse_test_case_order (const gchar *option_name, const gchar *value,
         test_case_order = CUT_ORDER_NAME_ASCENDING;
     } else if (g_utf8_collate(value, "name-desc") == 0) {
         test_case_order = CUT_ORDER_NAME_DESCENDING;
+    } else if (g_utf8_collate(value, "duration") == 0) {
+        test_case_order = CUT_ORDER_DURATION_DESCENDING;
     } else {
         g_set_error(error,
                     G_OPTION_ERROR,
@@ -171,6 +196,27 @@ parse_test_case_order (const gchar *option_name, const gchar *value,
     return TRUE;
 }
 
+static gboolean
+parse_keep_results (const gchar *option_name, const gchar *value,
+                    gpointer data, GError **error)
+{
+    if (g_utf8_collate(value, "all") == 0) {
+        result_retention = CUT_RESULT_RETENTION_ALL;
+    } else if (g_utf8_collate(value, "non-success") == 0) {
+        result_retention = CUT_RESULT_RETENTION_NON_SUCCESS;
+    } else if (g_utf8_collate(value, "none") == 0) {
+        result_retention = CUT_RESULT_RETENTION_NONE;
+    } else {
+        g_set_error(error,
+                    G_OPTION_ERROR,
+                    G_OPTION_ERROR_BAD_VALUE,
+                    _("Invalid keep results value: %s"), value);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
 static const GOptionEntry option_entries[] =
 {
     {"version", 0, G_OPTION_FLAG_NO_ARG, G_OPTION_ARG_CALLBACK, print_version,
@@ -190,16 +236,33 @@ static const GOptionEntry option_entries[] =
      N_("Specify test cases"), "TEST_CASE_NAME"},
     {"multi-thread", 'm', 0, G_OPTION_ARG_NONE, &use_multi_thread,
      N_("Run test cases and iterated tests with multi-thread"), NULL},
+    {"split-test-cases", 0, 0, G_OPTION_ARG_NONE, &split_test_cases,
+     N_("Run tests in a test case concurrently with --multi-thread"), NULL},
     {"max-threads", 0, 0, G_OPTION_ARG_INT, &max_threads,
      N_("Run test cases and iterated tests with MAX_THREADS threads "
         "concurrently at a maximum "
         "(default: 10; -1 is no limit)"),
      "MAX_THREADS"},
+    {"processes", 0, 0, G_OPTION_ARG_INT, &n_processes,
+     N_("Run test cases on N worker processes. "
+        "A crashed worker process loses only the running test "
+        "(default: 0; 0 is no worker process)"),
+     "N"},
+    {"shard-listen", 0, 0, G_OPTION_ARG_STRING, &shard_listen,
+     N_("Accept workers started with --shard-connect on [HOST:]PORT "
+        "and run test cases on them and --processes, longest first, "
+        "as one run"),
+     "[HOST:]PORT"},
+    {"shard-connect", 0, 0, G_OPTION_ARG_STRING, &shard_connect,
+     N_("Run test cases for the coordinator started with "
+        "--shard-listen on HOST:PORT"),
+     "HOST:PORT"},
     {"disable-signal-handling", 0, 0, G_OPTION_ARG_NONE,
      &disable_signal_handling,
      N_("Disable signal handling"), NULL},
     {"test-case-order", 0, 0, G_OPTION_ARG_CALLBACK, parse_test_case_order,
-     N_("Sort test case by. Default is 'none'."), "[none|name|name-desc]"},
+     N_("Sort test case by ORDER: none, name, name-desc or duration "
+        "(longest first). Default is 'none'."), "ORDER"},
     {"exclude-file", 0, 0, G_OPTION_ARG_STRING_ARRAY, &exclude_files,
      N_("Skip files"), "FILE"},
     {"exclude-directory", 0, 0, G_OPTION_ARG_STRING_ARRAY, &exclude_directories,
@@ -217,6 +280,63 @@ static const GOptionEntry option_entries[] =
      &stop_before_test,
      N_("Set breakpoints at each line which invokes test. "
         "You can step into a test function with your debugger easily."), NULL},
+    {"symbol-cache-directory", 0, 0, G_OPTION_ARG_STRING,
+     &symbol_cache_directory,
+     N_("Cache symbols of test modules in DIRECTORY "
+        "(default: $XDG_CACHE_HOME/cutter; empty string disables the cache)"),
+     "DIRECTORY"},
+    {"batch-assertions", 0, 0, G_OPTION_ARG_NONE,
+     &batch_assertions,
+     N_("Report passed assertions of a test at once "
+        "instead of one by one"), NULL},
+    {"keep-results", 0, 0, G_OPTION_ARG_CALLBACK, parse_keep_results,
+     N_("Keep test results after reporting them. Default is 'all'."),
+     "[all|non-success|none]"},
+    {"disable-timing-history-update", 0, 0, G_OPTION_ARG_NONE,
+     &disable_timing_history_update,
+     N_("Don't record elapsed times into timing history"), NULL},
+    {"history", 0, 0, G_OPTION_ARG_STRING, &history_pattern,
+     N_("Show when tests whose name is PATTERN or is matched with "
+        "/PATTERN/ started failing or getting slower instead of "
+        "running tests"),
+     "PATTERN"},
+    {"timeout", 0, 0, G_OPTION_ARG_DOUBLE, &timeout,
+     N_("Treat a test that doesn't finish in SECONDS as an error "
+        "(default: 0; 0 disables the timeout)"),
+     "SECONDS"},
+    {"benchmark-time", 0, 0, G_OPTION_ARG_DOUBLE, &benchmark_time,
+     N_("Measure a benchmark for SECONDS "
+        "(default: 1; 0 runs a benchmark only once)"),
+     "SECONDS"},
+    {"save-baseline", 0, 0, G_OPTION_ARG_STRING, &save_baseline,
+     N_("Save elapsed times of tests and benchmarks to FILE"), "FILE"},
+    {"compare-baseline", 0, 0, G_OPTION_ARG_STRING, &compare_baseline,
+     N_("Report tests and benchmarks that are slower than FILE"), "FILE"},
+    {"regression-threshold", 0, 0, G_OPTION_ARG_DOUBLE,
+     &regression_threshold,
+     N_("Report a test that is slower than the baseline by more than "
+        "PERCENT (default: 20)"),
+     "PERCENT"},
+    {"fail-on-regression", 0, 0, G_OPTION_ARG_NONE, &fail_on_regression,
+     N_("Report a regression as a failure instead of a notification"),
+     NULL},
+    {"performance-counters", 0, 0, G_OPTION_ARG_NONE, &performance_counters,
+     N_("Measure CPU cycles, instructions, cache misses, branch misses "
+        "and page faults of each test (Linux only)"),
+     NULL},
+    {"memory-usage", 0, 0, G_OPTION_ARG_NONE, &memory_usage,
+     N_("Measure allocations, allocated bytes and peak heap growth "
+        "of each test (glibc only)"),
+     NULL},
+    {"allocation-failures", 0, 0, G_OPTION_ARG_INT, &allocation_failures,
+     N_("Rerun each passed test in forked processes failing each of "
+        "its first N allocations one by one, and report a crash or "
+        "a leak on them (default: 0; 0 disables it; glibc only)"),
+     "N"},
+    {"max-diff-size", 0, 0, G_OPTION_ARG_INT, &max_diff_size,
+     N_("Show only the first difference instead of a diff "
+        "for values larger than BYTES (default: 8092; 0 disables the limit)"),
+     "BYTES"},
     {NULL}
 };
 
@@ -454,15 +574,28 @@ set_loader_customizers (CutRunContext *run_context)
     }
 }
 
+static gchar *
+build_symbol_cache_directory (void)
+{
+    if (symbol_cache_directory)
+        return g_strdup(symbol_cache_directory);
+
+    return g_build_filename(g_get_user_cache_dir(), "cutter", NULL);
+}
+
 void
 cut_setup_run_context (CutRunContext *run_context)
 {
+    gchar *cache_directory;
+
     cut_run_context_set_test_directory(run_context, test_directory);
     cut_run_context_set_log_directory(run_context, log_directory);
     if (source_directory)
         cut_run_context_set_source_directory(run_context, source_directory);
     cut_run_context_set_multi_thread(run_context, use_multi_thread);
+    cut_run_context_set_split_test_cases(run_context, split_test_cases);
     cut_run_context_set_max_threads(run_context, max_threads);
+    cut_run_context_set_n_processes(run_context, n_processes);
     cut_run_context_set_handle_signals(run_context, !disable_signal_handling);
     cut_run_context_set_exclude_files(run_context,
                                       (const gchar **)exclude_files);
@@ -472,12 +605,40 @@ cut_setup_run_context (CutRunContext *run_context)
                                                (const gchar **)test_case_names);
     cut_run_context_set_target_test_names(run_context,
                                           (const gchar **)test_names);
-    cut_run_context_set_test_case_order(run_context, test_case_order);
+    /* Test cases that take longer are dispatched to workers
+     * earlier to balance shards by the timing history. */
+    if (shard_listen && test_case_order == CUT_ORDER_NONE_SPECIFIED)
+        cut_run_context_set_test_case_order(run_context,
+                                            CUT_ORDER_DURATION_DESCENDING);
+    else
+        cut_run_context_set_test_case_order(run_context, test_case_order);
     cut_run_context_set_fatal_failures(run_context, fatal_failures);
     cut_run_context_set_keep_opening_modules(run_context, keep_opening_modules);
     cut_run_context_set_enable_convenience_attribute_definition(run_context,
                                                                 enable_convenience_attribute_definition);
     cut_run_context_set_stop_before_test(run_context, stop_before_test);
+    cut_run_context_set_batch_pass_assertions(run_context, batch_assertions);
+    cut_run_context_set_result_retention(run_context, result_retention);
+    cut_run_context_set_update_timing_history(run_context,
+                                              !disable_timing_history_update);
+    cut_run_context_set_timeout(run_context, timeout);
+    cut_run_context_set_benchmark_time(run_context, benchmark_time);
+    cut_run_context_set_save_baseline(run_context, save_baseline);
+    cut_run_context_set_compare_baseline(run_context, compare_baseline);
+    cut_run_context_set_regression_threshold(run_context,
+                                             regression_threshold);
+    cut_run_context_set_fail_on_regression(run_context, fail_on_regression);
+    cut_run_context_set_performance_counters(run_context,
+                                             performance_counters);
+    cut_run_context_set_memory_usage(run_context, memory_usage);
+    cut_run_context_set_allocation_failures(run_context, allocation_failures);
+    cut_run_context_set_shard_listen(run_context, shard_listen);
+    cut_run_context_set_shard_connect(run_context, shard_connect);
+    if (max_diff_size >= 0)
+        cut_test_result_set_max_diff_target_size(max_diff_size);
+    cache_directory = build_symbol_cache_directory();
+    cut_run_context_set_symbol_cache_directory(run_context, cache_directory);
+    g_free(cache_directory);
     cut_run_context_set_command_line_args(run_context, original_argv);
     set_loader_customizers(run_context);
 }
@@ -611,6 +772,113 @@ cut_run_in_analyze_mode (void)
     return success;
 }
 
+static gchar *
+format_run_history_time (gint64 time)
+{
+    GDateTime *date_time;
+    gchar *formatted_time;
+
+    date_time = g_date_time_new_from_unix_local(time);
+    formatted_time = g_date_time_format(date_time, "%Y-%m-%d %H:%M:%S");
+    g_date_time_unref(date_time);
+
+    return formatted_time;
+}
+
+static gdouble
+compute_mean_elapsed (CutRunHistoryTest *test, guint start, guint end)
+{
+    gdouble total = 0.0;
+    guint i;
+
+    for (i = start; i < end; i++) {
+        total += g_array_index(test->entries, CutRunHistoryEntry, i).elapsed;
+    }
+
+    return total / (end - start);
+}
+
+static void
+print_run_history_test (CutRunHistoryTest *test)
+{
+    CutRunHistoryEntry *entry;
+    gchar *time;
+    gint since;
+
+    g_print("%s (%s): %u runs\n",
+            test->test_name, test->test_case_name, test->entries->len);
+    if (test->entries->len == 0)
+        return;
+
+    entry = &g_array_index(test->entries, CutRunHistoryEntry,
+                           test->entries->len - 1);
+    time = format_run_history_time(entry->time);
+    g_print("  last: %s: %s: %.4fs\n",
+            time, cut_test_result_status_to_signal_name(entry->status),
+            entry->elapsed);
+    g_free(time);
+
+    since = cut_run_history_test_get_failing_since(test);
+    if (since >= 0) {
+        entry = &g_array_index(test->entries, CutRunHistoryEntry, since);
+        time = format_run_history_time(entry->time);
+        g_print("  failing since: %s (run %u)\n", time, entry->run + 1);
+        g_free(time);
+    }
+
+    since = cut_run_history_test_get_slower_since(test, regression_threshold);
+    if (since >= 0) {
+        entry = &g_array_index(test->entries, CutRunHistoryEntry, since);
+        time = format_run_history_time(entry->time);
+        g_print("  slower since: %s (run %u): %.4fs -> %.4fs\n",
+                time, entry->run + 1,
+                compute_mean_elapsed(test, 0, since),
+                compute_mean_elapsed(test, since, test->entries->len));
+        g_free(time);
+    }
+}
+
+static gboolean
+cut_run_in_history_mode (void)
+{
+    CutRunHistory *history;
+    GList *tests, *node;
+    gchar *cache_directory, *directory;
+    GError *error = NULL;
+
+    cache_directory = build_symbol_cache_directory();
+    if (cache_directory[0] == '\0') {
+        g_warning("run history needs --symbol-cache-directory");
+        g_free(cache_directory);
+        return FALSE;
+    }
+    directory = cut_run_history_build_directory(cache_directory,
+                                                test_directory);
+    history = cut_run_history_new(directory);
+    g_free(directory);
+    g_free(cache_directory);
+
+    if (!cut_run_history_load(history, &error)) {
+        cut_utils_report_error(error);
+        cut_run_history_free(history);
+        return FALSE;
+    }
+
+    tests = cut_run_history_query(history, history_pattern, &error);
+    cut_run_history_free(history);
+    if (error) {
+        cut_utils_report_error(error);
+        return FALSE;
+    }
+
+    for (node = tests; node; node = g_list_next(node)) {
+        print_run_history_test(node->data);
+    }
+    g_list_foreach(tests, (GFunc)cut_run_history_test_free, NULL);
+    g_list_free(tests);
+
+    return TRUE;
+}
 
 static gboolean
 cut_run_in_play_mode (void)
@@ -633,7 +901,10 @@ cut_run (void)
 
     switch (mode) {
     case MODE_TEST:
-        success = cut_run_in_test_mode();
+        if (history_pattern)
+            success = cut_run_in_history_mode();
+        else
+            success = cut_run_in_test_mode();
         break;
     case MODE_ANALYZE:
         success = cut_run_in_analyze_mode();
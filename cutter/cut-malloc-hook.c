@@ -0,0 +1,51 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <glib.h>
+
+#include "cut-malloc-hook.h"
+
+volatile gint cut_malloc_hook_enabled = FALSE;
+static volatile gint installed = FALSE;
+
+void
+cut_malloc_hook_install (void)
+{
+    g_atomic_int_set(&installed, TRUE);
+}
+
+gboolean
+cut_malloc_hook_is_installed (void)
+{
+    return g_atomic_int_get(&installed);
+}
+
+void
+cut_malloc_hook_enable (void)
+{
+    g_atomic_int_set(&cut_malloc_hook_enabled, TRUE);
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
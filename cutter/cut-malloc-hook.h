@@ -0,0 +1,53 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CUT_MALLOC_HOOK_H__
+#define __CUT_MALLOC_HOOK_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/*
+ * State shared with the malloc() interposer of the cutter
+ * command. The interposer passes allocations to glibc without
+ * any other work until the hook is enabled. So a run without
+ * --memory-usage and --allocation-failures doesn't pay for
+ * them. The hook is enabled by the first
+ * cut_memory_usage_start() or cut_allocation_failure_start()
+ * and isn't disabled after that.
+ */
+
+/* Read by the interposer on each allocation. Use
+ * cut_malloc_hook_enable() to set it. */
+extern volatile gint cut_malloc_hook_enabled;
+
+/* Called by the interposer on start-up. */
+void     cut_malloc_hook_install      (void);
+gboolean cut_malloc_hook_is_installed (void);
+
+void     cut_malloc_hook_enable       (void);
+
+G_END_DECLS
+
+#endif /* __CUT_MALLOC_HOOK_H__ */
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
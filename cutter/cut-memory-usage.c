@@ -0,0 +1,234 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <string.h>
+#include <glib.h>
+
+#include "cut-memory-usage.h"
+#include "cut-malloc-hook.h"
+
+/*
+ * Counters are kept per thread. Tests may run in some threads at
+ * once with --multi-thread and a test must not count allocations
+ * of other tests. So allocations in threads created by a test
+ * aren't counted for the test. Only the thread that owns
+ * counters updates them.
+ */
+typedef struct _Counters
+{
+    gint n_running_usages;
+    gint64 n_allocations;
+    gint64 allocated_bytes;
+    gint64 heap_bytes;
+    gint64 peak_heap_bytes;
+} Counters;
+
+struct _CutMemoryUsage
+{
+    gboolean running;
+    Counters *counters;
+    gint64 start_n_allocations;
+    gint64 start_allocated_bytes;
+    gint64 start_heap_bytes;
+    gint64 outer_peak_heap_bytes;
+    gint64 values[CUT_MEMORY_USAGE_N_TYPES];
+    gint64 heap_growth;
+};
+
+static const gchar *type_names[CUT_MEMORY_USAGE_N_TYPES] = {
+    "allocations",
+    "allocated-bytes",
+    "peak-heap-growth"
+};
+
+/* The interposer reports allocations from any thread. So the
+ * counters are updated atomically. */
+/* GPrivate can't be used because it may allocate memory in the
+ * malloc() interposer. */
+#ifdef _MSC_VER
+#  define THREAD_LOCAL __declspec(thread)
+#else
+#  define THREAD_LOCAL __thread
+#endif
+
+static THREAD_LOCAL Counters counters;
+
+const gchar *
+cut_memory_usage_type_to_name (CutMemoryUsageType type)
+{
+    if (type >= CUT_MEMORY_USAGE_N_TYPES)
+        return NULL;
+
+    return type_names[type];
+}
+
+gboolean
+cut_memory_usage_type_from_name (const gchar *name, CutMemoryUsageType *type)
+{
+    gint i;
+
+    for (i = 0; i < CUT_MEMORY_USAGE_N_TYPES; i++) {
+        if (strcmp(type_names[i], name) == 0) {
+            *type = i;
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+void
+cut_memory_usage_track_allocation (gsize requested_size, gsize usable_size)
+{
+    if (!counters.n_running_usages)
+        return;
+
+    counters.n_allocations++;
+    counters.allocated_bytes += requested_size;
+    counters.heap_bytes += usable_size;
+    if (counters.heap_bytes > counters.peak_heap_bytes)
+        counters.peak_heap_bytes = counters.heap_bytes;
+}
+
+void
+cut_memory_usage_track_free (gsize usable_size)
+{
+    if (!counters.n_running_usages)
+        return;
+
+    counters.heap_bytes -= usable_size;
+}
+
+CutMemoryUsage *
+cut_memory_usage_new (void)
+{
+    CutMemoryUsage *usage;
+    gint i;
+
+    usage = g_new0(CutMemoryUsage, 1);
+    usage->running = FALSE;
+    usage->counters = NULL;
+    for (i = 0; i < CUT_MEMORY_USAGE_N_TYPES; i++) {
+        usage->values[i] = -1;
+    }
+    usage->heap_growth = 0;
+
+    return usage;
+}
+
+void
+cut_memory_usage_free (CutMemoryUsage *usage)
+{
+    cut_memory_usage_stop(usage);
+    g_free(usage);
+}
+
+gboolean
+cut_memory_usage_is_available (CutMemoryUsage *usage)
+{
+    return cut_malloc_hook_is_installed();
+}
+
+void
+cut_memory_usage_start (CutMemoryUsage *usage)
+{
+    if (usage->running)
+        return;
+
+    cut_malloc_hook_enable();
+    /* A usage must be stopped in the thread that starts it. */
+    usage->counters = &counters;
+    usage->counters->n_running_usages++;
+    usage->running = TRUE;
+    usage->start_n_allocations = usage->counters->n_allocations;
+    usage->start_allocated_bytes = usage->counters->allocated_bytes;
+    usage->start_heap_bytes = usage->counters->heap_bytes;
+    /* The peak is restored on stop. So a measurement in a
+     * running measurement, e.g. a test of Cutter itself, doesn't
+     * lose the peak of the outer one. */
+    usage->outer_peak_heap_bytes = usage->counters->peak_heap_bytes;
+    usage->counters->peak_heap_bytes = usage->start_heap_bytes;
+}
+
+static gint64
+compute_value (CutMemoryUsage *usage, CutMemoryUsageType type)
+{
+    gint64 growth;
+
+    switch (type) {
+    case CUT_MEMORY_USAGE_ALLOCATIONS:
+        return usage->counters->n_allocations - usage->start_n_allocations;
+    case CUT_MEMORY_USAGE_ALLOCATED_BYTES:
+        return usage->counters->allocated_bytes - usage->start_allocated_bytes;
+    case CUT_MEMORY_USAGE_PEAK_HEAP_GROWTH:
+        growth = usage->counters->peak_heap_bytes - usage->start_heap_bytes;
+        return MAX(growth, 0);
+    default:
+        return -1;
+    }
+}
+
+void
+cut_memory_usage_stop (CutMemoryUsage *usage)
+{
+    gint i;
+
+    if (!usage->running)
+        return;
+
+    for (i = 0; i < CUT_MEMORY_USAGE_N_TYPES; i++) {
+        usage->values[i] = compute_value(usage, i);
+    }
+    usage->heap_growth = usage->counters->heap_bytes - usage->start_heap_bytes;
+    usage->counters->peak_heap_bytes =
+        MAX(usage->counters->peak_heap_bytes, usage->outer_peak_heap_bytes);
+    usage->counters->n_running_usages--;
+    usage->running = FALSE;
+}
+
+gint64
+cut_memory_usage_get_value (CutMemoryUsage *usage, CutMemoryUsageType type)
+{
+    if (!cut_malloc_hook_is_installed())
+        return -1;
+    if (type >= CUT_MEMORY_USAGE_N_TYPES)
+        return -1;
+
+    if (usage->running)
+        return compute_value(usage, type);
+    else
+        return usage->values[type];
+}
+
+gint64
+cut_memory_usage_get_heap_growth (CutMemoryUsage *usage)
+{
+    if (usage->running)
+        return usage->counters->heap_bytes - usage->start_heap_bytes;
+    else
+        return usage->heap_growth;
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
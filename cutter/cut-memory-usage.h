@@ -0,0 +1,82 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CUT_MEMORY_USAGE_H__
+#define __CUT_MEMORY_USAGE_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/*
+ * CutMemoryUsage measures heap allocations while it's
+ * running. Allocations are counted by a malloc() interposer that
+ * reports them with cut_memory_usage_track_allocation() and
+ * cut_memory_usage_track_free(). The cutter command has the
+ * interposer on glibc systems. Nothing is measured without it.
+ *
+ * Allocations are counted in the whole process. Allocations of
+ * other threads are also counted in multi-thread mode.
+ */
+typedef struct _CutMemoryUsage CutMemoryUsage;
+
+typedef enum {
+    CUT_MEMORY_USAGE_ALLOCATIONS,
+    CUT_MEMORY_USAGE_ALLOCATED_BYTES,
+    CUT_MEMORY_USAGE_PEAK_HEAP_GROWTH
+} CutMemoryUsageType;
+
+#define CUT_MEMORY_USAGE_N_TYPES 3
+
+/* e.g.: "allocations", "peak-heap-growth" */
+const gchar    *cut_memory_usage_type_to_name (CutMemoryUsageType  type);
+gboolean        cut_memory_usage_type_from_name
+                                              (const gchar        *name,
+                                               CutMemoryUsageType *type);
+
+CutMemoryUsage *cut_memory_usage_new          (void);
+void            cut_memory_usage_free         (CutMemoryUsage     *usage);
+
+gboolean        cut_memory_usage_is_available (CutMemoryUsage     *usage);
+void            cut_memory_usage_start        (CutMemoryUsage     *usage);
+void            cut_memory_usage_stop         (CutMemoryUsage     *usage);
+/* Returns a negative value when nothing is measured. A
+ * running measurement returns the current value. */
+gint64          cut_memory_usage_get_value    (CutMemoryUsage     *usage,
+                                               CutMemoryUsageType  type);
+/* Returns bytes that are allocated but not freed while
+ * measuring. */
+gint64          cut_memory_usage_get_heap_growth
+                                              (CutMemoryUsage     *usage);
+
+/* For a malloc() interposer. They must not allocate memory.
+ * requested_size is the size passed to malloc() and
+ * usable_size is the size of the allocated block. */
+void            cut_memory_usage_track_allocation
+                                              (gsize               requested_size,
+                                               gsize               usable_size);
+void            cut_memory_usage_track_free   (gsize               usable_size);
+
+G_END_DECLS
+
+#endif /* __CUT_MEMORY_USAGE_H__ */
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
@@ -0,0 +1,209 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <string.h>
+#include <errno.h>
+#include <glib.h>
+
+#ifdef HAVE_LINUX_PERF_EVENT_H
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+#include "cut-performance-counters.h"
+#include "cut-logger.h"
+
+struct _CutPerformanceCounters
+{
+    gint fds[CUT_PERFORMANCE_COUNTER_N_TYPES];
+};
+
+static const gchar *type_names[CUT_PERFORMANCE_COUNTER_N_TYPES] = {
+    "cycles",
+    "instructions",
+    "cache-misses",
+    "branch-misses",
+    "page-faults"
+};
+
+const gchar *
+cut_performance_counter_type_to_name (CutPerformanceCounterType type)
+{
+    if (type >= CUT_PERFORMANCE_COUNTER_N_TYPES)
+        return NULL;
+
+    return type_names[type];
+}
+
+gboolean
+cut_performance_counter_type_from_name (const gchar *name,
+                                        CutPerformanceCounterType *type)
+{
+    gint i;
+
+    for (i = 0; i < CUT_PERFORMANCE_COUNTER_N_TYPES; i++) {
+        if (strcmp(type_names[i], name) == 0) {
+            *type = i;
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
+#ifdef HAVE_LINUX_PERF_EVENT_H
+static const struct {
+    guint32 type;
+    guint64 config;
+} event_specs[CUT_PERFORMANCE_COUNTER_N_TYPES] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS}
+};
+
+static gint
+open_counter (CutPerformanceCounterType type)
+{
+    struct perf_event_attr attribute;
+    gint fd;
+
+    memset(&attribute, 0, sizeof(attribute));
+    attribute.size = sizeof(attribute);
+    attribute.type = event_specs[type].type;
+    attribute.config = event_specs[type].config;
+    attribute.disabled = 1;
+    /* The default perf_event_paranoid setting allows only user
+     * space events of our own process. */
+    attribute.exclude_kernel = 1;
+    attribute.exclude_hv = 1;
+
+    /* The calling thread on any CPU. */
+    fd = syscall(__NR_perf_event_open, &attribute, 0, -1, -1, 0);
+    if (fd == -1)
+        cut_log_trace("[performance-counters][open][fail] <%s>: %s",
+                      type_names[type], g_strerror(errno));
+    return fd;
+}
+#endif
+
+CutPerformanceCounters *
+cut_performance_counters_new (void)
+{
+    CutPerformanceCounters *counters;
+    gint i;
+
+    counters = g_new0(CutPerformanceCounters, 1);
+    for (i = 0; i < CUT_PERFORMANCE_COUNTER_N_TYPES; i++) {
+#ifdef HAVE_LINUX_PERF_EVENT_H
+        counters->fds[i] = open_counter(i);
+#else
+        counters->fds[i] = -1;
+#endif
+    }
+
+    return counters;
+}
+
+void
+cut_performance_counters_free (CutPerformanceCounters *counters)
+{
+#ifdef HAVE_LINUX_PERF_EVENT_H
+    gint i;
+
+    for (i = 0; i < CUT_PERFORMANCE_COUNTER_N_TYPES; i++) {
+        if (counters->fds[i] != -1)
+            close(counters->fds[i]);
+    }
+#endif
+    g_free(counters);
+}
+
+gboolean
+cut_performance_counters_is_available (CutPerformanceCounters *counters)
+{
+    gint i;
+
+    for (i = 0; i < CUT_PERFORMANCE_COUNTER_N_TYPES; i++) {
+        if (counters->fds[i] != -1)
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+void
+cut_performance_counters_start (CutPerformanceCounters *counters)
+{
+#ifdef HAVE_LINUX_PERF_EVENT_H
+    gint i;
+
+    for (i = 0; i < CUT_PERFORMANCE_COUNTER_N_TYPES; i++) {
+        if (counters->fds[i] == -1)
+            continue;
+        ioctl(counters->fds[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(counters->fds[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+void
+cut_performance_counters_stop (CutPerformanceCounters *counters)
+{
+#ifdef HAVE_LINUX_PERF_EVENT_H
+    gint i;
+
+    for (i = 0; i < CUT_PERFORMANCE_COUNTER_N_TYPES; i++) {
+        if (counters->fds[i] != -1)
+            ioctl(counters->fds[i], PERF_EVENT_IOC_DISABLE, 0);
+    }
+#endif
+}
+
+gint64
+cut_performance_counters_get_value (CutPerformanceCounters *counters,
+                                    CutPerformanceCounterType type)
+{
+#ifdef HAVE_LINUX_PERF_EVENT_H
+    guint64 value;
+
+    if (type >= CUT_PERFORMANCE_COUNTER_N_TYPES)
+        return -1;
+    if (counters->fds[type] == -1)
+        return -1;
+    if (read(counters->fds[type], &value, sizeof(value)) != sizeof(value))
+        return -1;
+
+    return value;
+#else
+    return -1;
+#endif
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
@@ -0,0 +1,76 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef __CUT_PERFORMANCE_COUNTERS_H__
+#define __CUT_PERFORMANCE_COUNTERS_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/*
+ * CutPerformanceCounters counts hardware and software events of
+ * the calling thread with perf_event_open(2). It's available
+ * only on Linux. A counter that isn't supported by the system,
+ * e.g. a hardware counter on a virtual machine, has no value.
+ */
+typedef struct _CutPerformanceCounters CutPerformanceCounters;
+
+typedef enum {
+    CUT_PERFORMANCE_COUNTER_CYCLES,
+    CUT_PERFORMANCE_COUNTER_INSTRUCTIONS,
+    CUT_PERFORMANCE_COUNTER_CACHE_MISSES,
+    CUT_PERFORMANCE_COUNTER_BRANCH_MISSES,
+    CUT_PERFORMANCE_COUNTER_PAGE_FAULTS
+} CutPerformanceCounterType;
+
+#define CUT_PERFORMANCE_COUNTER_N_TYPES 5
+
+/* e.g.: "cycles", "cache-misses" */
+const gchar            *cut_performance_counter_type_to_name
+                                        (CutPerformanceCounterType type);
+gboolean                cut_performance_counter_type_from_name
+                                        (const gchar               *name,
+                                         CutPerformanceCounterType *type);
+
+CutPerformanceCounters *cut_performance_counters_new
+                                        (void);
+void                    cut_performance_counters_free
+                                        (CutPerformanceCounters    *counters);
+
+gboolean                cut_performance_counters_is_available
+                                        (CutPerformanceCounters    *counters);
+void                    cut_performance_counters_start
+                                        (CutPerformanceCounters    *counters);
+void                    cut_performance_counters_stop
+                                        (CutPerformanceCounters    *counters);
+/* Returns a negative value for an unavailable counter. A
+ * running counter returns the current value. */
+gint64                  cut_performance_counters_get_value
+                                        (CutPerformanceCounters    *counters,
+                                         CutPerformanceCounterType  type);
+
+G_END_DECLS
+
+#endif /* __CUT_PERFORMANCE_COUNTERS_H__ */
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
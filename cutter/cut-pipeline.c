@@ -32,8 +32,10 @@
 
 #include "cut-pipeline.h"
 #include "cut-test-result.h"
+#include "cut-benchmark.h"
 #include "cut-runner.h"
 #include "cut-experimental.h"
+#include "cut-module-factory.h"
 #include "cut-utils.h"
 
 #ifdef G_OS_WIN32
@@ -151,8 +153,12 @@ cut_pipeline_new_from_run_context (CutRunContext *run_context)
                         cut_run_context_get_test_directory(run_context),
                         "use-multi-thread",
                         cut_run_context_get_multi_thread(run_context),
+                        "split-test-cases",
+                        cut_run_context_get_split_test_cases(run_context),
                         "max-threads",
                         cut_run_context_get_max_threads(run_context),
+                        "n-processes",
+                        cut_run_context_get_n_processes(run_context),
                         "handle-signals",
                         cut_run_context_get_handle_signals(run_context),
                         "exclude-files",
@@ -175,6 +181,30 @@ cut_pipeline_new_from_run_context (CutRunContext *run_context)
                         cut_run_context_get_keep_opening_modules(run_context),
                         "enable-convenience-attribute-definition",
                         cut_run_context_get_enable_convenience_attribute_definition(run_context),
+                        "symbol-cache-directory",
+                        cut_run_context_get_symbol_cache_directory(run_context),
+                        "batch-pass-assertions",
+                        !cut_run_context_need_pass_assertion_events(run_context),
+                        "timeout",
+                        cut_run_context_get_timeout(run_context),
+                        "benchmark-time",
+                        cut_run_context_get_benchmark_time(run_context),
+                        "compare-baseline",
+                        cut_run_context_get_compare_baseline(run_context),
+                        "regression-threshold",
+                        cut_run_context_get_regression_threshold(run_context),
+                        "fail-on-regression",
+                        cut_run_context_get_fail_on_regression(run_context),
+                        "performance-counters",
+                        cut_run_context_get_performance_counters(run_context),
+                        "memory-usage",
+                        cut_run_context_get_memory_usage(run_context),
+                        "allocation-failures",
+                        cut_run_context_get_allocation_failures(run_context),
+                        "shard-listen",
+                        cut_run_context_get_shard_listen(run_context),
+                        "shard-connect",
+                        cut_run_context_get_shard_connect(run_context),
                         NULL);
 }
 
@@ -248,6 +278,8 @@ create_child_out_channel (CutPipeline *pipeline)
     if (!channel)
         return NULL;
 
+    /* The child may stream in the binary format. */
+    g_io_channel_set_encoding(channel, NULL, NULL);
     g_io_channel_set_close_on_unref(channel, TRUE);
 
     reader = CUT_STREAM_READER(pipeline);
@@ -256,6 +288,16 @@ create_child_out_channel (CutPipeline *pipeline)
     return channel;
 }
 
+static const gchar *
+child_stream_name (void)
+{
+    /* The binary stream is cheaper to build and parse than XML. */
+    if (cut_module_factory_exist_module("stream", "binary"))
+        return "binary";
+    else
+        return "xml";
+}
+
 static gchar **
 create_command_line_args_from_argv (CutPipeline *pipeline, const gchar **argv)
 {
@@ -264,7 +306,7 @@ create_command_line_args_from_argv (CutPipeline *pipeline, const gchar **argv)
     gchar **new_argv;
     gchar **copy;
     const gchar *test_directory;
-    gchar *stream_fd;
+    gchar *stream, *stream_fd;
     guint i;
     guint length;
 
@@ -279,6 +321,7 @@ create_command_line_args_from_argv (CutPipeline *pipeline, const gchar **argv)
     }
     copy[i] = NULL;
 
+    stream = g_strdup_printf("--stream=%s", child_stream_name());
     stream_fd = g_strdup_printf("--stream-fd=%d",
                                 priv->child_pipe[CUT_WRITE]);
     test_directory = cut_run_context_get_test_directory(run_context);
@@ -286,10 +329,13 @@ create_command_line_args_from_argv (CutPipeline *pipeline, const gchar **argv)
                                      "--ui=console",
                                      "-v", "s",
                                      "--notify", "no",
-                                     "--stream=xml",
+                                     "--keep-results=none",
+                                     "--disable-timing-history-update",
+                                     stream,
                                      stream_fd,
                                      test_directory,
                                      NULL);
+    g_free(stream);
     g_free(stream_fd);
     g_strfreev(copy);
 
@@ -335,7 +381,7 @@ create_command_line_args_from_parameters (CutPipeline *pipeline)
     append_arg(argv, cut_utils_get_cutter_command_path());
     append_arg(argv, "--verbose=silent");
     append_arg(argv, "--notify=no");
-    append_arg(argv, "--stream=xml");
+    append_arg_printf(argv, "--stream=%s", child_stream_name());
     append_arg_printf(argv, "--stream-fd=%d", priv->child_pipe[CUT_WRITE]);
 
     directory = cut_run_context_get_source_directory(run_context);
@@ -345,10 +391,18 @@ create_command_line_args_from_parameters (CutPipeline *pipeline)
     if (cut_run_context_get_multi_thread(run_context))
         append_arg(argv, "--multi-thread");
 
+    if (cut_run_context_get_split_test_cases(run_context))
+        append_arg(argv, "--split-test-cases");
+
     append_arg_printf(argv,
                       "--max-threads=%d",
                       cut_run_context_get_max_threads(run_context));
 
+    if (cut_run_context_get_n_processes(run_context) > 0)
+        append_arg_printf(argv,
+                          "--processes=%d",
+                          cut_run_context_get_n_processes(run_context));
+
     strings = cut_run_context_get_exclude_files(run_context);
     while (strings && *strings) {
         append_arg_printf(argv, "--exclude-file=%s", *strings);
@@ -373,9 +427,80 @@ create_command_line_args_from_parameters (CutPipeline *pipeline)
         strings++;
     }
 
+    switch (cut_run_context_get_test_case_order(run_context)) {
+      case CUT_ORDER_NAME_ASCENDING:
+        append_arg(argv, "--test-case-order=name");
+        break;
+      case CUT_ORDER_NAME_DESCENDING:
+        append_arg(argv, "--test-case-order=name-desc");
+        break;
+      case CUT_ORDER_DURATION_DESCENDING:
+        append_arg(argv, "--test-case-order=duration");
+        break;
+      default:
+        break;
+    }
+
     if (cut_run_context_get_fatal_failures(run_context))
         append_arg(argv, "--fatal-failures");
 
+    if (!cut_run_context_need_pass_assertion_events(run_context))
+        append_arg(argv, "--batch-assertions");
+
+    if (cut_run_context_get_timeout(run_context) > 0.0) {
+        gchar timeout[G_ASCII_DTOSTR_BUF_SIZE];
+
+        g_ascii_dtostr(timeout, sizeof(timeout),
+                       cut_run_context_get_timeout(run_context));
+        append_arg_printf(argv, "--timeout=%s", timeout);
+    }
+
+    if (cut_run_context_get_benchmark_time(run_context) !=
+        CUT_BENCHMARK_DEFAULT_TIME) {
+        gchar benchmark_time[G_ASCII_DTOSTR_BUF_SIZE];
+
+        g_ascii_dtostr(benchmark_time, sizeof(benchmark_time),
+                       cut_run_context_get_benchmark_time(run_context));
+        append_arg_printf(argv, "--benchmark-time=%s", benchmark_time);
+    }
+
+    if (cut_run_context_get_compare_baseline(run_context)) {
+        gchar threshold[G_ASCII_DTOSTR_BUF_SIZE];
+
+        append_arg_printf(argv, "--compare-baseline=%s",
+                          cut_run_context_get_compare_baseline(run_context));
+        g_ascii_dtostr(threshold, sizeof(threshold),
+                       cut_run_context_get_regression_threshold(run_context));
+        append_arg_printf(argv, "--regression-threshold=%s", threshold);
+        if (cut_run_context_get_fail_on_regression(run_context))
+            append_arg(argv, "--fail-on-regression");
+    }
+
+    if (cut_run_context_get_performance_counters(run_context))
+        append_arg(argv, "--performance-counters");
+    if (cut_run_context_get_memory_usage(run_context))
+        append_arg(argv, "--memory-usage");
+    if (cut_run_context_get_allocation_failures(run_context) > 0)
+        append_arg_printf(argv, "--allocation-failures=%d",
+                          cut_run_context_get_allocation_failures(run_context));
+    if (cut_run_context_get_shard_listen(run_context))
+        append_arg_printf(argv, "--shard-listen=%s",
+                          cut_run_context_get_shard_listen(run_context));
+    if (cut_run_context_get_shard_connect(run_context))
+        append_arg_printf(argv, "--shard-connect=%s",
+                          cut_run_context_get_shard_connect(run_context));
+
+    append_arg_printf(argv, "--max-diff-size=%" G_GSIZE_FORMAT,
+                      cut_test_result_get_max_diff_target_size());
+
+    /* Results and elapsed times are kept by this process. */
+    append_arg(argv, "--keep-results=none");
+    append_arg(argv, "--disable-timing-history-update");
+
+    directory = cut_run_context_get_symbol_cache_directory(run_context);
+    if (directory)
+        append_arg_printf(argv, "--symbol-cache-directory=%s", directory);
+
     append_arg(argv, cut_run_context_get_test_directory(run_context));
 
     return (gchar **)(g_array_free(argv, FALSE));
@@ -32,7 +32,10 @@ typedef struct _CutTestCase        CutTestCase;
 typedef struct _CutTestIterator    CutTestIterator;
 typedef struct _CutTest            CutTest;
 typedef struct _CutIteratedTest    CutIteratedTest;
+typedef struct _CutBenchmark       CutBenchmark;
+typedef struct _CutBenchmarkResult CutBenchmarkResult;
 typedef struct _CutTestResult      CutTestResult;
+typedef struct _CutTestScheduler   CutTestScheduler;
 
 G_END_DECLS
 
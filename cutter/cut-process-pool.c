@@ -0,0 +1,1770 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <errno.h>
+#include <sys/types.h>
+
+#ifdef HAVE_SYS_WAIT_H
+#  include <sys/wait.h>
+#endif
+
+#include <glib.h>
+
+#ifndef G_OS_WIN32
+#  include <unistd.h>
+#  include <sys/socket.h>
+#  include <netinet/in.h>
+#  include <netinet/tcp.h>
+#  include <netdb.h>
+#endif
+
+#include "cut-process-pool.h"
+#include "cut-run-context.h"
+#include "cut-test-case.h"
+#include "cut-test-container.h"
+#include "cut-test-iterator.h"
+#include "cut-test-context.h"
+#include "cut-iterated-test.h"
+#include "cut-test-result.h"
+#include "cut-stream-reader.h"
+#include "cut-crash-backtrace.h"
+#include "cut-listener.h"
+#include "cut-module-factory.h"
+#include "cut-module-factory-utils.h"
+#include "cut-utils.h"
+#include "cut-logger.h"
+
+#include "../gcutter/gcut-error.h"
+
+/*
+ * Worker processes are forked from the process that has the
+ * loaded test suite. The parent process sends an index of a
+ * test case to an idle worker through a pipe. A worker runs
+ * the test case and streams events of it as XML through
+ * another pipe. The parent process parses the stream and
+ * forwards events to the run context.
+ *
+ * If a worker process is crashed, the parent process reports
+ * a crash of the running test, forks a new worker and runs
+ * rest tests in the test case on it.
+ *
+ * A timed out test is reported by the worker process after it
+ * returns. If the test doesn't return, e.g. it loops forever or
+ * is blocked in a system call, the parent process kills the
+ * worker process after a grace period and handles it like a
+ * crash.
+ *
+ * The parent process can also listen on a TCP port as a shard
+ * coordinator. A cutter process on the same or another host
+ * that loads the same test suite connects to it as a remote
+ * worker. A remote worker uses the same protocol on the socket
+ * but it receives a name of a test case instead of an index
+ * because its test cases may be loaded in a different order. A
+ * remote worker can't be forked again. So an idle remote
+ * worker is kept while a test case that may be resumed is
+ * running, and a disconnected remote worker is handled like a
+ * crashed worker process.
+ *
+ * A remote worker sends a handshake line before anything else.
+ * It has a digest of names of the loaded test cases and a token
+ * shared by $CUT_SHARD_TOKEN. The coordinator accepts the worker
+ * only when both of them are the same as its own ones. Anyone
+ * who can connect to the port can run test cases and report
+ * results otherwise. The coordinator listens only on the
+ * loopback addresses by default.
+ */
+
+#define TIMEOUT_GRACE_SECONDS 5.0
+#define CONNECT_RETRY_SECONDS 30.0
+#define CONNECT_RETRY_INTERVAL (G_USEC_PER_SEC / 10)
+#define HANDSHAKE_MAGIC "cutter-shard"
+#define HANDSHAKE_ACCEPTED "accepted"
+#define HANDSHAKE_MAX_SIZE 4096
+#define HANDSHAKE_TOKEN_ENV "CUT_SHARD_TOKEN"
+
+typedef struct _Job
+{
+    guint index;
+    gboolean resumed;
+    GHashTable *finished_test_names;
+    CutTestCase *test_case;
+    CutTestResult *crash_result;
+} Job;
+
+typedef struct _Worker
+{
+    CutProcessPool *pool;
+    gint pid;
+    gchar *address;
+    gint job_fd;
+    gint result_fd;
+    GIOChannel *result_channel;
+    GSource *result_source;
+    CutRunContext *reader;
+    Job *job;
+    CutTest *test;
+    CutTestContext *test_context;
+    CutTestIterator *test_iterator;
+    GTimer *test_timer;
+    gdouble test_timeout;
+    gboolean timed_out;
+    GList *timeout_backtrace;
+} Worker;
+
+typedef struct _Handshake
+{
+    CutProcessPool *pool;
+    gint fd;
+    gchar *address;
+    GString *line;
+    GSource *source;
+} Handshake;
+
+struct _CutProcessPool
+{
+    CutRunContext *run_context;
+    gint n_processes;
+    CutProcessPoolRunTestCaseFunction run_test_case;
+    gpointer user_data;
+    GPtrArray *test_cases;
+    const gchar **test_names;
+    GQueue *jobs;
+    GList *workers;
+    gint listen_fd;
+    gboolean remote;
+    GMainContext *main_context;
+    GMainLoop *main_loop;
+    GSource *timeout_source;
+    GSource *listen_source;
+    GList *handshakes;
+    gboolean success;
+};
+
+static const gchar *
+result_stream_name (void)
+{
+    /* The binary stream is cheaper to build and parse than XML. */
+    if (cut_module_factory_exist_module("stream", "binary"))
+        return "binary";
+    else if (cut_module_factory_exist_module("stream", "xml"))
+        return "xml";
+    else
+        return NULL;
+}
+
+gboolean
+cut_process_pool_is_available (void)
+{
+#ifdef G_OS_WIN32
+    return FALSE;
+#else
+    return result_stream_name() != NULL;
+#endif
+}
+
+static Job *
+job_new (guint index)
+{
+    Job *job;
+
+    job = g_slice_new0(Job);
+    job->index = index;
+    job->resumed = FALSE;
+    job->finished_test_names = g_hash_table_new_full(g_str_hash, g_str_equal,
+                                                     g_free, NULL);
+    job->test_case = NULL;
+    job->crash_result = NULL;
+
+    return job;
+}
+
+static void
+job_free (Job *job)
+{
+    g_hash_table_unref(job->finished_test_names);
+    if (job->test_case)
+        g_object_unref(job->test_case);
+    if (job->crash_result)
+        g_object_unref(job->crash_result);
+    g_slice_free(Job, job);
+}
+
+static void
+job_mark_finished (Job *job, CutTest *test)
+{
+    g_hash_table_insert(job->finished_test_names,
+                        g_strdup(cut_test_get_name(test)),
+                        GINT_TO_POINTER(TRUE));
+}
+
+CutProcessPool *
+cut_process_pool_new (CutRunContext *run_context, gint n_processes,
+                      CutProcessPoolRunTestCaseFunction run_test_case,
+                      gpointer user_data)
+{
+    CutProcessPool *pool;
+
+    pool = g_new0(CutProcessPool, 1);
+    pool->run_context = g_object_ref(run_context);
+    pool->n_processes = MAX(n_processes, 0);
+    pool->run_test_case = run_test_case;
+    pool->user_data = user_data;
+    pool->test_cases = g_ptr_array_new();
+    pool->test_names = NULL;
+    pool->jobs = g_queue_new();
+    pool->workers = NULL;
+    pool->listen_fd = -1;
+    pool->remote = FALSE;
+    pool->main_context = NULL;
+    pool->main_loop = NULL;
+    pool->timeout_source = NULL;
+    pool->listen_source = NULL;
+    pool->handshakes = NULL;
+    pool->success = TRUE;
+
+    return pool;
+}
+
+void
+cut_process_pool_free (CutProcessPool *pool)
+{
+#ifndef G_OS_WIN32
+    if (pool->listen_fd != -1)
+        close(pool->listen_fd);
+#endif
+    g_ptr_array_foreach(pool->test_cases, (GFunc)g_object_unref, NULL);
+    g_ptr_array_free(pool->test_cases, TRUE);
+    g_queue_foreach(pool->jobs, (GFunc)job_free, NULL);
+    g_queue_free(pool->jobs);
+    g_object_unref(pool->run_context);
+    g_free(pool);
+}
+
+void
+cut_process_pool_add_test_case (CutProcessPool *pool, CutTestCase *test_case)
+{
+    g_ptr_array_add(pool->test_cases, g_object_ref(test_case));
+}
+
+static void
+complete_job (CutProcessPool *pool, Job *job, gboolean success)
+{
+    if (job->crash_result) {
+        g_signal_emit_by_name(pool->run_context, "crash-test-case",
+                              job->test_case, job->crash_result);
+        success = FALSE;
+    }
+
+    if (!success)
+        pool->success = FALSE;
+    g_signal_emit_by_name(pool->run_context, "complete-test-case",
+                          job->test_case, success);
+}
+
+#ifndef G_OS_WIN32
+static void spawn_workers (CutProcessPool *pool);
+
+static void
+close_job_fd (Worker *worker)
+{
+    if (worker->job_fd == -1)
+        return;
+
+    /* The result stream of a remote worker shares the socket. */
+    if (worker->address)
+        shutdown(worker->job_fd, SHUT_WR);
+    close(worker->job_fd);
+    worker->job_fd = -1;
+}
+
+static void
+clear_current_test (Worker *worker)
+{
+    if (worker->test) {
+        g_object_unref(worker->test);
+        worker->test = NULL;
+    }
+
+    if (worker->test_context) {
+        g_object_unref(worker->test_context);
+        worker->test_context = NULL;
+    }
+
+    worker->test_timeout = 0.0;
+}
+
+static void
+set_current_test (Worker *worker, CutTest *test, CutTestContext *test_context)
+{
+    clear_current_test(worker);
+    worker->test = g_object_ref(test);
+    if (test_context)
+        worker->test_context = g_object_ref(test_context);
+
+    worker->test_timeout =
+        cut_run_context_get_test_timeout(worker->pool->run_context,
+                                         test, worker->test_iterator);
+    g_timer_start(worker->test_timer);
+}
+
+static void
+clear_current_test_iterator (Worker *worker)
+{
+    if (worker->test_iterator) {
+        g_object_unref(worker->test_iterator);
+        worker->test_iterator = NULL;
+    }
+}
+
+static gboolean
+write_all (gint fd, const gchar *data, gsize length)
+{
+    while (length > 0) {
+        gssize written;
+
+        written = write(fd, data, length);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            return FALSE;
+        }
+        data += written;
+        length -= written;
+    }
+
+    return TRUE;
+}
+
+static void
+append_test_name (gpointer key, gpointer value, gpointer user_data)
+{
+    GString *command = user_data;
+
+    g_string_append_printf(command, "\t%s", (const gchar *)key);
+}
+
+static gboolean
+have_busy_worker (CutProcessPool *pool)
+{
+    GList *node;
+
+    for (node = pool->workers; node; node = g_list_next(node)) {
+        Worker *worker = node->data;
+
+        if (worker->job)
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+static void
+dispatch_job (Worker *worker)
+{
+    CutProcessPool *pool;
+    Job *job;
+    GString *command;
+
+    pool = worker->pool;
+    if (worker->job || worker->job_fd == -1)
+        return;
+
+    if (cut_run_context_is_canceled(pool->run_context)) {
+        close_job_fd(worker);
+        return;
+    }
+
+    if (g_queue_is_empty(pool->jobs)) {
+        /* A running test case may be crashed and resumed. */
+        if (!worker->address || !have_busy_worker(pool))
+            close_job_fd(worker);
+        return;
+    }
+
+    job = g_queue_pop_head(pool->jobs);
+    command = g_string_new(NULL);
+    if (worker->address) {
+        CutTestCase *test_case;
+
+        test_case = g_ptr_array_index(pool->test_cases, job->index);
+        g_string_append(command, cut_test_get_name(CUT_TEST(test_case)));
+    } else {
+        g_string_append_printf(command, "%u", job->index);
+    }
+    if (job->resumed)
+        g_hash_table_foreach(job->finished_test_names,
+                             append_test_name, command);
+    g_string_append_c(command, '\n');
+
+    if (write_all(worker->job_fd, command->str, command->len)) {
+        worker->job = job;
+    } else {
+        if (worker->address)
+            g_warning("failed to send a test case to a remote worker: "
+                      "<%s>: %s",
+                      worker->address, g_strerror(errno));
+        else
+            g_warning("failed to send a test case to a worker process: "
+                      "<%d>: %s",
+                      worker->pid, g_strerror(errno));
+        g_queue_push_head(pool->jobs, job);
+        close_job_fd(worker);
+    }
+    g_string_free(command, TRUE);
+}
+
+static void
+dispatch_jobs (CutProcessPool *pool)
+{
+    GList *node, *workers;
+
+    workers = g_list_copy(pool->workers);
+    for (node = workers; node; node = g_list_next(node)) {
+        dispatch_job(node->data);
+    }
+    g_list_free(workers);
+}
+
+static gboolean
+is_waiting_for_remote_workers (CutProcessPool *pool)
+{
+    return pool->listen_fd != -1 &&
+        !cut_run_context_is_canceled(pool->run_context) &&
+        !g_queue_is_empty(pool->jobs);
+}
+
+static void
+cb_start_test_case (CutRunContext *reader, CutTestCase *test_case,
+                    gpointer data)
+{
+    Worker *worker = data;
+
+    if (worker->job && !worker->job->test_case)
+        worker->job->test_case = g_object_ref(test_case);
+}
+
+static void
+cb_start_test_iterator (CutRunContext *reader, CutTestIterator *test_iterator,
+                        gpointer data)
+{
+    Worker *worker = data;
+
+    clear_current_test_iterator(worker);
+    worker->test_iterator = g_object_ref(test_iterator);
+}
+
+static void
+cb_start_test (CutRunContext *reader, CutTest *test,
+               CutTestContext *test_context, gpointer data)
+{
+    set_current_test(data, test, test_context);
+}
+
+static void
+cb_start_iterated_test (CutRunContext *reader, CutIteratedTest *iterated_test,
+                        CutTestContext *test_context, gpointer data)
+{
+    set_current_test(data, CUT_TEST(iterated_test), test_context);
+}
+
+static void
+cb_complete_iterated_test (CutRunContext *reader,
+                           CutIteratedTest *iterated_test,
+                           CutTestContext *test_context,
+                           gboolean success, gpointer data)
+{
+    clear_current_test(data);
+}
+
+static void
+cb_complete_test (CutRunContext *reader, CutTest *test,
+                  CutTestContext *test_context, gboolean success,
+                  gpointer data)
+{
+    Worker *worker = data;
+
+    if (worker->job)
+        job_mark_finished(worker->job, test);
+    clear_current_test(worker);
+}
+
+static void
+cb_complete_test_iterator (CutRunContext *reader,
+                           CutTestIterator *test_iterator,
+                           gboolean success, gpointer data)
+{
+    Worker *worker = data;
+
+    if (worker->job)
+        job_mark_finished(worker->job, CUT_TEST(test_iterator));
+    clear_current_test_iterator(worker);
+}
+
+static void
+cb_complete_test_case (CutRunContext *reader, CutTestCase *test_case,
+                       gboolean success, gpointer data)
+{
+    Worker *worker = data;
+    Job *job;
+
+    job = worker->job;
+    if (!job)
+        return;
+
+    worker->job = NULL;
+    complete_job(worker->pool, job, success);
+    job_free(job);
+
+    dispatch_job(worker);
+    /* Idle remote workers are released after the last test case. */
+    dispatch_jobs(worker->pool);
+}
+
+static gboolean
+is_forwardable_signal (Worker *worker, const gchar *name)
+{
+    if (!worker->job || !worker->job->resumed)
+        return TRUE;
+
+    /* A resumed test case has been started and its result
+     * is reported on completion. */
+    if (g_str_equal(name, "ready-test-case") ||
+        g_str_equal(name, "start-test-case"))
+        return FALSE;
+    if (g_str_has_suffix(name, "-test-case") &&
+        !g_str_has_suffix(name, "-in-test-case"))
+        return FALSE;
+
+    return TRUE;
+}
+
+static void
+forward_signal_marshal (GClosure *closure, GValue *return_value,
+                        guint n_param_values, const GValue *param_values,
+                        gpointer invocation_hint, gpointer marshal_data)
+{
+    Worker *worker = closure->data;
+    GSignalInvocationHint *hint = invocation_hint;
+    GValue *values;
+    guint i;
+
+    if (!is_forwardable_signal(worker, g_signal_name(hint->signal_id)))
+        return;
+
+    values = g_new0(GValue, n_param_values);
+    g_value_init(&values[0], CUT_TYPE_RUN_CONTEXT);
+    g_value_set_object(&values[0], worker->pool->run_context);
+    for (i = 1; i < n_param_values; i++) {
+        g_value_init(&values[i], G_VALUE_TYPE(&param_values[i]));
+        g_value_copy(&param_values[i], &values[i]);
+    }
+
+    g_signal_emitv(values, hint->signal_id, hint->detail, return_value);
+
+    for (i = 0; i < n_param_values; i++)
+        g_value_unset(&values[i]);
+    g_free(values);
+}
+
+static gboolean
+is_run_level_signal (const gchar *name)
+{
+    static const gchar *run_level_signal_names[] = {
+        "start-run",
+        "ready-test-suite",
+        "start-test-suite",
+        "crash-test-suite",
+        "complete-test-suite",
+        "complete-test-case",
+        "complete-run",
+        NULL
+    };
+    const gchar **signal_name;
+
+    for (signal_name = run_level_signal_names; *signal_name; signal_name++) {
+        if (g_str_equal(*signal_name, name))
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+static void
+connect_to_reader (Worker *worker)
+{
+    guint *signal_ids;
+    guint i, n_signal_ids;
+
+#define CONNECT(name)                                                   \
+    g_signal_connect(worker->reader, #name,                             \
+                     G_CALLBACK(cb_ ## name), worker)
+
+    CONNECT(start_test_case);
+    CONNECT(start_test_iterator);
+    CONNECT(start_test);
+    CONNECT(start_iterated_test);
+    CONNECT(complete_iterated_test);
+    CONNECT(complete_test);
+    CONNECT(complete_test_iterator);
+    CONNECT(complete_test_case);
+#undef CONNECT
+
+    signal_ids = g_signal_list_ids(CUT_TYPE_RUN_CONTEXT, &n_signal_ids);
+    for (i = 0; i < n_signal_ids; i++) {
+        GSignalQuery query;
+        GClosure *closure;
+
+        g_signal_query(signal_ids[i], &query);
+        if (query.return_type != G_TYPE_NONE)
+            continue;
+        if (is_run_level_signal(query.signal_name))
+            continue;
+
+        closure = g_closure_new_simple(sizeof(GClosure), worker);
+        g_closure_set_marshal(closure, forward_signal_marshal);
+        g_signal_connect_closure_by_id(worker->reader, signal_ids[i], 0,
+                                       closure, FALSE);
+    }
+    g_free(signal_ids);
+}
+
+static gboolean
+have_unfinished_tests (CutProcessPool *pool, Job *job)
+{
+    CutTestCase *test_case;
+    GList *tests, *node;
+    gboolean found = FALSE;
+
+    test_case = g_ptr_array_index(pool->test_cases, job->index);
+    tests = cut_test_container_filter_children(CUT_TEST_CONTAINER(test_case),
+                                               pool->test_names);
+    for (node = tests; node; node = g_list_next(node)) {
+        CutTest *test = node->data;
+
+        if (!g_hash_table_lookup(job->finished_test_names,
+                                 cut_test_get_name(test))) {
+            found = TRUE;
+            break;
+        }
+    }
+    g_list_free(tests);
+
+    return found;
+}
+
+static gchar *
+inspect_exit_status (gint pid, gint status)
+{
+    if (WIFSIGNALED(status))
+        return g_strdup_printf("worker process <%d> was terminated "
+                               "by signal %d: %s",
+                               pid, WTERMSIG(status),
+                               g_strsignal(WTERMSIG(status)));
+    else if (WIFEXITED(status))
+        return g_strdup_printf("worker process <%d> exited "
+                               "while running a test case: <%d>",
+                               pid, WEXITSTATUS(status));
+    else
+        return g_strdup_printf("worker process <%d> was terminated "
+                               "unexpectedly",
+                               pid);
+}
+
+static void
+recover_job (Worker *worker, const gchar *message)
+{
+    CutProcessPool *pool;
+    CutRunContext *run_context;
+    CutTestResult *result;
+    CutTestResultStatus status;
+    gchar *signal_name;
+    Job *job;
+    gboolean progressed = FALSE;
+
+    pool = worker->pool;
+    run_context = pool->run_context;
+    job = worker->job;
+    worker->job = NULL;
+    pool->success = FALSE;
+
+    if (!job->test_case) {
+        job->test_case =
+            g_object_ref(g_ptr_array_index(pool->test_cases, job->index));
+        g_signal_emit_by_name(run_context, "start-test-case", job->test_case);
+    }
+
+    /* A test that didn't finish in time is an error of the test
+     * like a test that returns after its timeout. */
+    status = worker->timed_out ? CUT_TEST_RESULT_ERROR : CUT_TEST_RESULT_CRASH;
+
+    if (worker->test) {
+        result = cut_test_result_new(status,
+                                     worker->test, worker->test_iterator,
+                                     job->test_case, NULL, NULL,
+                                     NULL, message, worker->timeout_backtrace);
+        signal_name =
+            g_strdup_printf("%s-test",
+                            cut_test_result_status_to_signal_name(status));
+        g_signal_emit_by_name(run_context, signal_name,
+                              worker->test, worker->test_context, result);
+        g_free(signal_name);
+        g_object_unref(result);
+        if (worker->test_iterator) {
+            g_signal_emit_by_name(run_context, "complete-iterated-test",
+                                  worker->test, worker->test_context, FALSE);
+        } else {
+            g_signal_emit_by_name(run_context, "complete-test",
+                                  worker->test, worker->test_context, FALSE);
+            job_mark_finished(job, worker->test);
+        }
+        clear_current_test(worker);
+        progressed = TRUE;
+    }
+
+    if (worker->test_iterator) {
+        result = cut_test_result_new(status,
+                                     NULL, worker->test_iterator,
+                                     job->test_case, NULL, NULL,
+                                     NULL, message, NULL);
+        signal_name =
+            g_strdup_printf("%s-test-iterator",
+                            cut_test_result_status_to_signal_name(status));
+        g_signal_emit_by_name(run_context, signal_name,
+                              worker->test_iterator, result);
+        g_free(signal_name);
+        g_object_unref(result);
+        g_signal_emit_by_name(run_context, "complete-test-iterator",
+                              worker->test_iterator, FALSE);
+        job_mark_finished(job, CUT_TEST(worker->test_iterator));
+        clear_current_test_iterator(worker);
+        progressed = TRUE;
+    }
+
+    /* The timed out test is already reported as an error. */
+    if (!job->crash_result && !worker->timed_out)
+        job->crash_result = cut_test_result_new(CUT_TEST_RESULT_CRASH,
+                                                NULL, NULL, job->test_case,
+                                                NULL, NULL,
+                                                NULL, message, NULL);
+
+    /* We don't resume a test case that is crashed in
+     * startup/shutdown. It will be crashed again. */
+    if (progressed && have_unfinished_tests(pool, job)) {
+        job->resumed = TRUE;
+        g_queue_push_head(pool->jobs, job);
+    } else {
+        complete_job(pool, job, FALSE);
+        job_free(job);
+    }
+}
+
+static void
+worker_free (Worker *worker)
+{
+    if (worker->result_source) {
+        g_source_destroy(worker->result_source);
+        g_source_unref(worker->result_source);
+    }
+    if (worker->result_channel)
+        g_io_channel_unref(worker->result_channel);
+    close_job_fd(worker);
+    clear_current_test(worker);
+    clear_current_test_iterator(worker);
+    if (worker->job)
+        job_free(worker->job);
+    if (worker->reader)
+        g_object_unref(worker->reader);
+    g_timer_destroy(worker->test_timer);
+    g_list_foreach(worker->timeout_backtrace, (GFunc)g_object_unref, NULL);
+    g_list_free(worker->timeout_backtrace);
+    g_free(worker->address);
+    g_free(worker);
+}
+
+static void
+finish_worker (Worker *worker)
+{
+    CutProcessPool *pool;
+    gint status = 0;
+
+    pool = worker->pool;
+    close_job_fd(worker);
+    if (!worker->address) {
+        while (waitpid(worker->pid, &status, 0) == -1 && errno == EINTR)
+            /* do nothing */;
+    }
+
+    if (worker->job) {
+        gchar *message;
+
+        if (worker->address && worker->timed_out)
+            message = g_strdup_printf("remote worker <%s> was disconnected "
+                                      "because a test didn't finish "
+                                      "in %g second(s)",
+                                      worker->address, worker->test_timeout);
+        else if (worker->address)
+            message = g_strdup_printf("remote worker <%s> was disconnected "
+                                      "while running a test case",
+                                      worker->address);
+        else if (worker->timed_out)
+            message = g_strdup_printf("worker process <%d> was killed "
+                                      "because a test didn't finish "
+                                      "in %g second(s)",
+                                      worker->pid, worker->test_timeout);
+        else
+            message = inspect_exit_status(worker->pid, status);
+        recover_job(worker, message);
+        g_free(message);
+    } else if (worker->address) {
+        cut_log_trace("[process-pool][remote][disconnect] <%s>",
+                      worker->address);
+    } else if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+        gchar *message;
+
+        message = inspect_exit_status(worker->pid, status);
+        g_warning("%s", message);
+        g_free(message);
+        pool->success = FALSE;
+    }
+
+    pool->workers = g_list_remove(pool->workers, worker);
+    worker_free(worker);
+
+    spawn_workers(pool);
+    dispatch_jobs(pool);
+    if (!pool->workers && !is_waiting_for_remote_workers(pool))
+        g_main_loop_quit(pool->main_loop);
+}
+
+static gboolean
+cb_read_result (GIOChannel *channel, GIOCondition condition, gpointer data)
+{
+    Worker *worker = data;
+    gboolean eof = FALSE;
+
+    if (condition & (G_IO_IN | G_IO_PRI)) {
+        GIOStatus status;
+        gchar buffer[4096];
+        gsize bytes_read = 0;
+        GError *error = NULL;
+
+        status = g_io_channel_read_chars(channel, buffer, sizeof(buffer),
+                                         &bytes_read, &error);
+        if (bytes_read > 0)
+            cut_stream_reader_read(CUT_STREAM_READER(worker->reader),
+                                   buffer, bytes_read);
+        if (error) {
+            cut_utils_report_error(error);
+            eof = TRUE;
+        } else if (status == G_IO_STATUS_EOF) {
+            eof = TRUE;
+        }
+    } else {
+        eof = TRUE;
+    }
+
+    if (!eof)
+        return TRUE;
+
+    finish_worker(worker);
+    return FALSE;
+}
+
+static Worker *
+worker_new (CutProcessPool *pool, gint pid, gint job_fd, gint result_fd)
+{
+    Worker *worker;
+    GIOChannel *channel;
+
+    worker = g_new0(Worker, 1);
+    worker->pool = pool;
+    worker->pid = pid;
+    worker->address = NULL;
+    worker->job_fd = job_fd;
+    worker->result_fd = result_fd;
+    worker->job = NULL;
+    worker->test = NULL;
+    worker->test_context = NULL;
+    worker->test_iterator = NULL;
+    worker->test_timer = g_timer_new();
+    worker->test_timeout = 0.0;
+    worker->timed_out = FALSE;
+    worker->timeout_backtrace = NULL;
+
+    worker->reader = cut_stream_reader_new();
+    connect_to_reader(worker);
+
+    channel = g_io_channel_unix_new(result_fd);
+    g_io_channel_set_encoding(channel, NULL, NULL);
+    g_io_channel_set_buffered(channel, FALSE);
+    g_io_channel_set_close_on_unref(channel, TRUE);
+    worker->result_channel = channel;
+
+    worker->result_source =
+        g_io_create_watch(channel, G_IO_IN | G_IO_PRI | G_IO_ERR | G_IO_HUP);
+    g_source_set_callback(worker->result_source,
+                          (GSourceFunc)cb_read_result, worker, NULL);
+    g_source_attach(worker->result_source, pool->main_context);
+
+    return worker;
+}
+
+static void
+remove_test_by_name (CutTestCase *test_case, const gchar *name)
+{
+    CutTestContainer *container;
+    GList *tests, *node;
+
+    container = CUT_TEST_CONTAINER(test_case);
+    tests = g_list_copy(cut_test_container_get_children(container));
+    for (node = tests; node; node = g_list_next(node)) {
+        CutTest *test = node->data;
+
+        if (g_str_equal(cut_test_get_name(test), name))
+            cut_test_container_remove_test(container, test);
+    }
+    g_list_free(tests);
+}
+
+static CutTestCase *
+find_test_case (CutProcessPool *pool, const gchar *name)
+{
+    guint i;
+
+    for (i = 0; i < pool->test_cases->len; i++) {
+        CutTestCase *test_case = g_ptr_array_index(pool->test_cases, i);
+
+        if (g_str_equal(cut_test_get_name(CUT_TEST(test_case)), name))
+            return test_case;
+    }
+
+    return NULL;
+}
+
+static gboolean
+run_job (CutProcessPool *pool, const gchar *command)
+{
+    gchar **fields;
+    guint i;
+    CutTestCase *test_case = NULL;
+
+    fields = g_strsplit(command, "\t", -1);
+    if (!fields[0]) {
+        g_strfreev(fields);
+        return FALSE;
+    }
+
+    if (pool->remote) {
+        test_case = find_test_case(pool, fields[0]);
+        if (!test_case)
+            g_warning("unknown test case is requested by "
+                      "the shard coordinator: <%s>", fields[0]);
+    } else {
+        guint index;
+
+        index = (guint)strtoul(fields[0], NULL, 10);
+        if (index < pool->test_cases->len)
+            test_case = g_ptr_array_index(pool->test_cases, index);
+    }
+    if (!test_case) {
+        g_strfreev(fields);
+        return FALSE;
+    }
+
+    /* This is a copy of the test case in the parent process or a
+     * test case of a process that only works for the shard
+     * coordinator. We can remove finished tests of a resumed test
+     * case safely. */
+    for (i = 1; fields[i]; i++) {
+        remove_test_by_name(test_case, fields[i]);
+    }
+    g_strfreev(fields);
+
+    pool->run_test_case(test_case, pool->run_context, pool->test_names,
+                        pool->user_data);
+    return TRUE;
+}
+
+static gboolean
+serve_jobs (CutProcessPool *pool, gint job_fd, gint result_fd)
+{
+    CutRunContext *run_context;
+    CutModuleFactory *factory;
+    GObject *stream;
+    GIOChannel *channel;
+    gchar *command = NULL;
+    gboolean success = TRUE;
+
+    /* A crash should kill only this process. The parent process
+     * reports it as a crash of the running test. */
+    signal(SIGSEGV, SIG_DFL);
+    signal(SIGABRT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+    signal(SIGBUS, SIG_DFL);
+
+    run_context = pool->run_context;
+    cut_run_context_detach_listeners(run_context);
+    cut_run_context_set_handle_signals(run_context, FALSE);
+    /* Results and elapsed times are kept by the parent process. */
+    cut_run_context_set_result_retention(run_context,
+                                         CUT_RESULT_RETENTION_NONE);
+    cut_run_context_set_update_timing_history(run_context, FALSE);
+    cut_run_context_set_save_baseline(run_context, NULL);
+
+    factory = cut_module_factory_new("stream", result_stream_name(),
+                                     "fd", result_fd, NULL);
+    stream = cut_module_factory_create(factory);
+    g_object_unref(factory);
+    cut_listener_attach_to_run_context(CUT_LISTENER(stream), run_context);
+
+    g_signal_emit_by_name(run_context, "start-run");
+
+    channel = g_io_channel_unix_new(job_fd);
+    g_io_channel_set_close_on_unref(channel, TRUE);
+    while (g_io_channel_read_line(channel, &command, NULL, NULL, NULL) ==
+           G_IO_STATUS_NORMAL) {
+        success = run_job(pool, g_strchomp(command));
+        g_free(command);
+        command = NULL;
+        if (!success)
+            break;
+    }
+    g_io_channel_unref(channel);
+
+    cut_run_context_emit_complete_run(run_context, TRUE);
+    cut_listener_detach_from_run_context(CUT_LISTENER(stream), run_context);
+    g_object_unref(stream);
+
+    return success;
+}
+
+static void
+run_worker (CutProcessPool *pool, gint job_fd, gint result_fd)
+{
+    GList *node;
+
+    for (node = pool->workers; node; node = g_list_next(node)) {
+        Worker *worker = node->data;
+
+        if (worker->job_fd != -1)
+            close(worker->job_fd);
+        close(worker->result_fd);
+    }
+    for (node = pool->handshakes; node; node = g_list_next(node)) {
+        Handshake *handshake = node->data;
+
+        close(handshake->fd);
+    }
+    if (pool->listen_fd != -1)
+        close(pool->listen_fd);
+
+    /* The parent process stops sending test cases on SIGINT. */
+    signal(SIGINT, SIG_IGN);
+
+    serve_jobs(pool, job_fd, result_fd);
+
+    _exit(EXIT_SUCCESS);
+}
+
+static gboolean
+spawn_worker (CutProcessPool *pool)
+{
+    gint job_pipe[2], result_pipe[2];
+    pid_t pid;
+    Worker *worker;
+
+    if (pipe(job_pipe) < 0) {
+        g_warning("failed to create a pipe for a worker process: %s",
+                  g_strerror(errno));
+        return FALSE;
+    }
+    if (pipe(result_pipe) < 0) {
+        g_warning("failed to create a pipe for a worker process: %s",
+                  g_strerror(errno));
+        cut_utils_close_pipe(job_pipe, CUT_READ);
+        cut_utils_close_pipe(job_pipe, CUT_WRITE);
+        return FALSE;
+    }
+
+    fflush(stdout);
+    fflush(stderr);
+    pid = fork();
+    if (pid == -1) {
+        g_warning("failed to fork a worker process: %s", g_strerror(errno));
+        cut_utils_close_pipe(job_pipe, CUT_READ);
+        cut_utils_close_pipe(job_pipe, CUT_WRITE);
+        cut_utils_close_pipe(result_pipe, CUT_READ);
+        cut_utils_close_pipe(result_pipe, CUT_WRITE);
+        return FALSE;
+    }
+
+    if (pid == 0) {
+        cut_utils_close_pipe(job_pipe, CUT_WRITE);
+        cut_utils_close_pipe(result_pipe, CUT_READ);
+        run_worker(pool, job_pipe[CUT_READ], result_pipe[CUT_WRITE]);
+    }
+
+    cut_utils_close_pipe(job_pipe, CUT_READ);
+    cut_utils_close_pipe(result_pipe, CUT_WRITE);
+
+    worker = worker_new(pool, pid, job_pipe[CUT_WRITE], result_pipe[CUT_READ]);
+    pool->workers = g_list_append(pool->workers, worker);
+    dispatch_job(worker);
+
+    return TRUE;
+}
+
+static gint
+count_worker_processes (CutProcessPool *pool)
+{
+    GList *node;
+    gint n_worker_processes = 0;
+
+    for (node = pool->workers; node; node = g_list_next(node)) {
+        Worker *worker = node->data;
+
+        if (!worker->address)
+            n_worker_processes++;
+    }
+
+    return n_worker_processes;
+}
+
+static void
+spawn_workers (CutProcessPool *pool)
+{
+    while (!g_queue_is_empty(pool->jobs) &&
+           !cut_run_context_is_canceled(pool->run_context) &&
+           count_worker_processes(pool) < pool->n_processes) {
+        if (!spawn_worker(pool))
+            break;
+    }
+}
+
+static gboolean
+cb_check_timeout (gpointer data)
+{
+    CutProcessPool *pool = data;
+    GList *node;
+
+    for (node = pool->workers; node; node = g_list_next(node)) {
+        Worker *worker = node->data;
+
+        if (!worker->test || worker->timed_out || worker->test_timeout <= 0.0)
+            continue;
+        if (g_timer_elapsed(worker->test_timer, NULL) <
+            worker->test_timeout + TIMEOUT_GRACE_SECONDS)
+            continue;
+
+        worker->timed_out = TRUE;
+        if (worker->address) {
+            cut_log_warning("[process-pool][timeout][disconnect] "
+                            "<%s>: <%s>: <%g>",
+                            worker->address, cut_test_get_name(worker->test),
+                            worker->test_timeout);
+            shutdown(worker->result_fd, SHUT_RDWR);
+        } else {
+            cut_log_warning("[process-pool][timeout][kill] <%d>: <%s>: <%g>",
+                            worker->pid, cut_test_get_name(worker->test),
+                            worker->test_timeout);
+            worker->timeout_backtrace =
+                cut_crash_backtrace_collect_process(worker->pid);
+            kill(worker->pid, SIGKILL);
+        }
+    }
+
+    return TRUE;
+}
+
+static void
+set_no_delay (gint fd)
+{
+    gint on = 1;
+
+    /* Events are small and should be reported immediately. */
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+}
+
+static gchar *
+inspect_peer (gint fd)
+{
+    struct sockaddr_storage address;
+    socklen_t length = sizeof(address);
+    gchar host[NI_MAXHOST], service[NI_MAXSERV];
+
+    if (getpeername(fd, (struct sockaddr *)&address, &length) == -1 ||
+        getnameinfo((struct sockaddr *)&address, length,
+                    host, sizeof(host), service, sizeof(service),
+                    NI_NUMERICHOST | NI_NUMERICSERV) != 0)
+        return g_strdup_printf("fd:%d", fd);
+
+    if (strchr(host, ':'))
+        return g_strdup_printf("[%s]:%s", host, service);
+    else
+        return g_strdup_printf("%s:%s", host, service);
+}
+
+static gint
+compare_string (gconstpointer a, gconstpointer b)
+{
+    return strcmp(*(const gchar **)a, *(const gchar **)b);
+}
+
+static gchar *
+build_handshake (CutProcessPool *pool)
+{
+    GPtrArray *names;
+    GChecksum *checksum;
+    const gchar *token;
+    gchar *handshake;
+    guint i;
+
+    /* Test cases may be loaded in a different order. */
+    names = g_ptr_array_new();
+    for (i = 0; i < pool->test_cases->len; i++) {
+        CutTestCase *test_case = g_ptr_array_index(pool->test_cases, i);
+        const gchar *name;
+
+        name = cut_test_get_name(CUT_TEST(test_case));
+        g_ptr_array_add(names, (gpointer)name);
+    }
+    g_ptr_array_sort(names, compare_string);
+
+    checksum = g_checksum_new(G_CHECKSUM_SHA256);
+    for (i = 0; i < names->len; i++) {
+        const gchar *name = g_ptr_array_index(names, i);
+
+        g_checksum_update(checksum, (const guchar *)name, strlen(name) + 1);
+    }
+    g_ptr_array_free(names, TRUE);
+
+    token = g_getenv(HANDSHAKE_TOKEN_ENV);
+    handshake = g_strdup_printf("%s\t%s\t%s",
+                                HANDSHAKE_MAGIC,
+                                g_checksum_get_string(checksum),
+                                token ? token : "");
+    g_checksum_free(checksum);
+
+    return handshake;
+}
+
+static gboolean
+is_valid_handshake (CutProcessPool *pool, const GString *line)
+{
+    gchar *expected;
+    gsize i, length;
+    guchar difference = 0;
+
+    expected = build_handshake(pool);
+    length = strlen(expected);
+    /* Don't leak how many bytes of the token are matched. */
+    if (line->len == length) {
+        for (i = 0; i < length; i++) {
+            difference |= (guchar)(expected[i] ^ line->str[i]);
+        }
+    } else {
+        difference = 1;
+    }
+    g_free(expected);
+
+    return difference == 0;
+}
+
+static void
+handshake_free (Handshake *handshake)
+{
+    if (handshake->source) {
+        g_source_destroy(handshake->source);
+        g_source_unref(handshake->source);
+    }
+    if (handshake->fd != -1)
+        close(handshake->fd);
+    g_string_free(handshake->line, TRUE);
+    g_free(handshake->address);
+    g_free(handshake);
+}
+
+static void
+accept_worker (Handshake *handshake)
+{
+    CutProcessPool *pool;
+    Worker *worker;
+    gint fd, job_fd;
+    static const gchar accepted[] = HANDSHAKE_ACCEPTED "\n";
+
+    pool = handshake->pool;
+    fd = handshake->fd;
+    if (!write_all(fd, accepted, strlen(accepted))) {
+        g_warning("failed to accept a remote worker: <%s>: %s",
+                  handshake->address, g_strerror(errno));
+        return;
+    }
+
+    job_fd = dup(fd);
+    if (job_fd == -1) {
+        g_warning("failed to duplicate a socket for a remote worker: "
+                  "<%s>: %s",
+                  handshake->address, g_strerror(errno));
+        return;
+    }
+
+    handshake->fd = -1;
+    worker = worker_new(pool, 0, job_fd, fd);
+    worker->address = g_strdup(handshake->address);
+    cut_log_trace("[process-pool][remote][accept] <%s>", worker->address);
+    pool->workers = g_list_append(pool->workers, worker);
+    dispatch_job(worker);
+}
+
+static gboolean
+cb_read_handshake (GIOChannel *channel, GIOCondition condition, gpointer data)
+{
+    Handshake *handshake = data;
+    CutProcessPool *pool;
+    gboolean finished = FALSE;
+
+    pool = handshake->pool;
+    /* We read byte by byte because the result stream follows the
+     * handshake line. */
+    while (!finished) {
+        gchar character;
+        gssize size;
+
+        size = recv(handshake->fd, &character, 1, MSG_DONTWAIT);
+        if (size == 1) {
+            if (character == '\n') {
+                if (is_valid_handshake(pool, handshake->line))
+                    accept_worker(handshake);
+                else
+                    g_warning("remote worker is refused because it has "
+                              "different test cases or $%s: <%s>",
+                              HANDSHAKE_TOKEN_ENV, handshake->address);
+                finished = TRUE;
+            } else if (handshake->line->len >= HANDSHAKE_MAX_SIZE) {
+                g_warning("remote worker is refused because of "
+                          "too long handshake: <%s>",
+                          handshake->address);
+                finished = TRUE;
+            } else {
+                g_string_append_c(handshake->line, character);
+            }
+        } else if (size == 0) {
+            cut_log_trace("[process-pool][remote][handshake][disconnect] "
+                          "<%s>",
+                          handshake->address);
+            finished = TRUE;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return TRUE;
+        } else if (errno != EINTR) {
+            g_warning("failed to read a handshake from a remote worker: "
+                      "<%s>: %s",
+                      handshake->address, g_strerror(errno));
+            finished = TRUE;
+        }
+    }
+
+    pool->handshakes = g_list_remove(pool->handshakes, handshake);
+    handshake_free(handshake);
+    return FALSE;
+}
+
+static gboolean
+cb_accept_worker (GIOChannel *channel, GIOCondition condition, gpointer data)
+{
+    CutProcessPool *pool = data;
+    Handshake *handshake;
+    GIOChannel *handshake_channel;
+    gint fd;
+
+    fd = accept(pool->listen_fd, NULL, NULL);
+    if (fd == -1) {
+        if (errno != EINTR && errno != EAGAIN && errno != ECONNABORTED)
+            g_warning("failed to accept a remote worker: %s",
+                      g_strerror(errno));
+        return TRUE;
+    }
+    set_no_delay(fd);
+
+    handshake = g_new0(Handshake, 1);
+    handshake->pool = pool;
+    handshake->fd = fd;
+    handshake->address = inspect_peer(fd);
+    handshake->line = g_string_new(NULL);
+    cut_log_trace("[process-pool][remote][handshake] <%s>",
+                  handshake->address);
+
+    handshake_channel = g_io_channel_unix_new(fd);
+    handshake->source =
+        g_io_create_watch(handshake_channel, G_IO_IN | G_IO_ERR | G_IO_HUP);
+    g_io_channel_unref(handshake_channel);
+    g_source_set_callback(handshake->source,
+                          (GSourceFunc)cb_read_handshake, handshake, NULL);
+    g_source_attach(handshake->source, pool->main_context);
+    pool->handshakes = g_list_append(pool->handshakes, handshake);
+
+    return TRUE;
+}
+
+static void
+run_with_workers (CutProcessPool *pool)
+{
+    void (*sigpipe_handler) (int);
+
+    /* A worker process may be crashed before it reads a sent
+     * test case. */
+    sigpipe_handler = signal(SIGPIPE, SIG_IGN);
+
+    pool->main_context = g_main_context_new();
+    pool->main_loop = g_main_loop_new(pool->main_context, FALSE);
+
+    pool->timeout_source = g_timeout_source_new(1000);
+    g_source_set_callback(pool->timeout_source, cb_check_timeout, pool, NULL);
+    g_source_attach(pool->timeout_source, pool->main_context);
+
+    if (pool->listen_fd != -1) {
+        GIOChannel *channel;
+
+        channel = g_io_channel_unix_new(pool->listen_fd);
+        pool->listen_source = g_io_create_watch(channel, G_IO_IN);
+        g_io_channel_unref(channel);
+        g_source_set_callback(pool->listen_source,
+                              (GSourceFunc)cb_accept_worker, pool, NULL);
+        g_source_attach(pool->listen_source, pool->main_context);
+    }
+
+    spawn_workers(pool);
+    if (pool->workers || is_waiting_for_remote_workers(pool))
+        g_main_loop_run(pool->main_loop);
+
+    g_source_destroy(pool->timeout_source);
+    g_source_unref(pool->timeout_source);
+    pool->timeout_source = NULL;
+
+    if (pool->listen_source) {
+        g_source_destroy(pool->listen_source);
+        g_source_unref(pool->listen_source);
+        pool->listen_source = NULL;
+    }
+    g_list_foreach(pool->handshakes, (GFunc)handshake_free, NULL);
+    g_list_free(pool->handshakes);
+    pool->handshakes = NULL;
+    /* Remote workers that connect after this are refused. */
+    if (pool->listen_fd != -1) {
+        close(pool->listen_fd);
+        pool->listen_fd = -1;
+    }
+
+    g_main_loop_unref(pool->main_loop);
+    pool->main_loop = NULL;
+    g_main_context_unref(pool->main_context);
+    pool->main_context = NULL;
+
+    signal(SIGPIPE, sigpipe_handler);
+}
+
+static struct addrinfo *
+resolve_address (const gchar *address, gboolean passive)
+{
+    const gchar *separator;
+    gchar *host = NULL, *port;
+    struct addrinfo hints, *addresses = NULL;
+    gint status;
+
+    /* [HOST:]PORT. An IPv6 address is written as [ADDRESS]. */
+    separator = strrchr(address, ':');
+    if (separator) {
+        host = g_strndup(address, separator - address);
+        port = g_strdup(separator + 1);
+    } else {
+        port = g_strdup(address);
+    }
+    if (host && host[0] == '[' && g_str_has_suffix(host, "]")) {
+        gchar *bracketed_host = host;
+
+        host = g_strndup(bracketed_host + 1, strlen(bracketed_host) - 2);
+        g_free(bracketed_host);
+    }
+    if (host && host[0] == '\0') {
+        g_free(host);
+        host = NULL;
+    }
+
+    if (!host && !passive) {
+        g_warning("host of the shard coordinator is missing: <%s>", address);
+        g_free(port);
+        return NULL;
+    }
+
+    /* We don't use AI_PASSIVE. A coordinator without HOST
+     * listens only on the loopback addresses. A remote host must
+     * be accepted explicitly by e.g. 0.0.0.0 or [::]. */
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    status = getaddrinfo(host, port, &hints, &addresses);
+    if (status != 0) {
+        g_warning("failed to resolve a shard address: <%s>: %s",
+                  address, gai_strerror(status));
+        addresses = NULL;
+    }
+    g_free(host);
+    g_free(port);
+
+    return addresses;
+}
+
+static gint
+connect_to_coordinator (const gchar *address)
+{
+    GTimer *timer;
+    gint fd = -1, error_number = 0;
+
+    timer = g_timer_new();
+    while (TRUE) {
+        struct addrinfo *addresses, *info;
+
+        addresses = resolve_address(address, FALSE);
+        if (!addresses)
+            break;
+
+        for (info = addresses; info; info = info->ai_next) {
+            fd = socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+            if (fd == -1) {
+                error_number = errno;
+                continue;
+            }
+            if (connect(fd, info->ai_addr, info->ai_addrlen) == 0)
+                break;
+            error_number = errno;
+            close(fd);
+            fd = -1;
+        }
+        freeaddrinfo(addresses);
+
+        /* A worker may be started before the coordinator. */
+        if (fd != -1 ||
+            error_number != ECONNREFUSED ||
+            g_timer_elapsed(timer, NULL) > CONNECT_RETRY_SECONDS)
+            break;
+        g_usleep(CONNECT_RETRY_INTERVAL);
+    }
+    g_timer_destroy(timer);
+
+    if (fd == -1 && error_number != 0)
+        g_warning("failed to connect to the shard coordinator: <%s>: %s",
+                  address, g_strerror(error_number));
+
+    return fd;
+}
+
+static gboolean
+send_handshake (CutProcessPool *pool, gint fd, const gchar *address)
+{
+    gchar *handshake;
+    GString *reply;
+    gboolean success;
+
+    handshake = build_handshake(pool);
+    success = write_all(fd, handshake, strlen(handshake)) &&
+        write_all(fd, "\n", 1);
+    g_free(handshake);
+    if (!success) {
+        g_warning("failed to send a handshake to the shard coordinator: "
+                  "<%s>: %s",
+                  address, g_strerror(errno));
+        return FALSE;
+    }
+
+    /* We read byte by byte because test cases follow the reply. */
+    reply = g_string_new(NULL);
+    while (reply->len < HANDSHAKE_MAX_SIZE) {
+        gchar character;
+        gssize size;
+
+        size = read(fd, &character, 1);
+        if (size == -1 && errno == EINTR)
+            continue;
+        if (size != 1 || character == '\n')
+            break;
+        g_string_append_c(reply, character);
+    }
+    success = g_str_equal(reply->str, HANDSHAKE_ACCEPTED);
+    g_string_free(reply, TRUE);
+    if (!success)
+        g_warning("refused by the shard coordinator. "
+                  "Test cases or $%s may be different: <%s>",
+                  HANDSHAKE_TOKEN_ENV, address);
+
+    return success;
+}
+#endif
+
+static void
+run_rest_jobs (CutProcessPool *pool)
+{
+    Job *job;
+
+    while ((job = g_queue_pop_head(pool->jobs))) {
+        if (job->resumed) {
+            /* We can't run rest tests of a crashed test case in
+             * this process because they may crash this process. */
+            complete_job(pool, job, FALSE);
+        } else if (!cut_run_context_is_canceled(pool->run_context)) {
+            CutTestCase *test_case;
+
+            test_case = g_ptr_array_index(pool->test_cases, job->index);
+            if (!pool->run_test_case(test_case, pool->run_context,
+                                     pool->test_names, pool->user_data))
+                pool->success = FALSE;
+        }
+        job_free(job);
+    }
+}
+
+gboolean
+cut_process_pool_run (CutProcessPool *pool, const gchar **test_names)
+{
+    guint i;
+
+    pool->test_names = test_names;
+    pool->success = TRUE;
+    for (i = 0; i < pool->test_cases->len; i++) {
+        g_queue_push_tail(pool->jobs, job_new(i));
+    }
+
+#ifndef G_OS_WIN32
+    if (cut_process_pool_is_available())
+        run_with_workers(pool);
+#endif
+
+    run_rest_jobs(pool);
+
+    return pool->success;
+}
+
+gboolean
+cut_process_pool_listen (CutProcessPool *pool, const gchar *address)
+{
+#ifdef G_OS_WIN32
+    g_warning("shard coordinator isn't supported on Windows: <%s>", address);
+    return FALSE;
+#else
+    struct addrinfo *addresses, *info;
+    gint fd = -1, error_number = 0;
+
+    addresses = resolve_address(address, TRUE);
+    if (!addresses)
+        return FALSE;
+
+    for (info = addresses; info; info = info->ai_next) {
+        gint on = 1;
+
+        fd = socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+        if (fd == -1) {
+            error_number = errno;
+            continue;
+        }
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        if (bind(fd, info->ai_addr, info->ai_addrlen) == 0 &&
+            listen(fd, SOMAXCONN) == 0)
+            break;
+        error_number = errno;
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(addresses);
+
+    if (fd == -1) {
+        g_warning("failed to listen on a shard address: <%s>: %s",
+                  address, g_strerror(error_number));
+        return FALSE;
+    }
+
+    if (pool->listen_fd != -1)
+        close(pool->listen_fd);
+    pool->listen_fd = fd;
+    cut_log_trace("[process-pool][listen] <%s>", address);
+
+    return TRUE;
+#endif
+}
+
+gboolean
+cut_process_pool_run_as_worker (CutProcessPool *pool, const gchar *address,
+                                const gchar **test_names)
+{
+#ifdef G_OS_WIN32
+    g_warning("shard worker isn't supported on Windows: <%s>", address);
+    return FALSE;
+#else
+    void (*sigpipe_handler) (int);
+    gint fd, job_fd;
+    gboolean success;
+
+    if (!cut_process_pool_is_available()) {
+        g_warning("shard worker needs a stream module: <%s>", address);
+        return FALSE;
+    }
+
+    fd = connect_to_coordinator(address);
+    if (fd == -1)
+        return FALSE;
+    set_no_delay(fd);
+
+    /* The coordinator may close the connection at any time. */
+    sigpipe_handler = signal(SIGPIPE, SIG_IGN);
+
+    if (!send_handshake(pool, fd, address)) {
+        signal(SIGPIPE, sigpipe_handler);
+        close(fd);
+        return FALSE;
+    }
+
+    job_fd = dup(fd);
+    if (job_fd == -1) {
+        g_warning("failed to duplicate a socket for the shard coordinator: "
+                  "<%s>: %s",
+                  address, g_strerror(errno));
+        signal(SIGPIPE, sigpipe_handler);
+        close(fd);
+        return FALSE;
+    }
+    cut_log_trace("[process-pool][remote][connect] <%s>", address);
+
+    pool->test_names = test_names;
+    pool->remote = TRUE;
+
+    success = serve_jobs(pool, job_fd, fd);
+    signal(SIGPIPE, sigpipe_handler);
+
+    return success;
+#endif
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
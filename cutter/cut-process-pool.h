@@ -0,0 +1,65 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CUT_PROCESS_POOL_H__
+#define __CUT_PROCESS_POOL_H__
+
+#include <glib.h>
+
+#include <cutter/cut-private.h>
+
+G_BEGIN_DECLS
+
+typedef struct _CutProcessPool CutProcessPool;
+
+typedef gboolean (*CutProcessPoolRunTestCaseFunction) (CutTestCase    *test_case,
+                                                       CutRunContext  *run_context,
+                                                       const gchar   **test_names,
+                                                       gpointer        user_data);
+
+gboolean        cut_process_pool_is_available  (void);
+
+CutProcessPool *cut_process_pool_new           (CutRunContext  *run_context,
+                                                gint            n_processes,
+                                                CutProcessPoolRunTestCaseFunction run_test_case,
+                                                gpointer        user_data);
+void            cut_process_pool_free          (CutProcessPool *pool);
+
+void            cut_process_pool_add_test_case (CutProcessPool *pool,
+                                                CutTestCase    *test_case);
+gboolean        cut_process_pool_run           (CutProcessPool *pool,
+                                                const gchar   **test_names);
+
+/* Accepts remote workers on [HOST:]PORT while the pool runs.
+ * HOST is the loopback addresses by default. */
+gboolean        cut_process_pool_listen        (CutProcessPool *pool,
+                                                const gchar    *address);
+/* Runs test cases requested by the coordinator on HOST:PORT
+ * instead of running them by itself. */
+gboolean        cut_process_pool_run_as_worker (CutProcessPool *pool,
+                                                const gchar    *address,
+                                                const gchar   **test_names);
+
+G_END_DECLS
+
+#endif /* __CUT_PROCESS_POOL_H__ */
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
@@ -139,6 +139,9 @@ const char **cut_test_context_take_string_array
 
 char        *cut_utils_inspect_memory       (const void *memory,
                                              size_t      size);
+char        *cut_utils_hexdump_around       (const void *memory,
+                                             size_t      size,
+                                             size_t      offset);
 
 cut_boolean  cut_utils_equal_string         (const char *string1,
                                              const char *string2);
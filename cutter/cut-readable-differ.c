@@ -27,6 +27,7 @@
 
 #include "cut-readable-differ.h"
 #include "cut-string-diff-writer.h"
+#include "cut-regex-cache.h"
 #include "cut-utils.h"
 
 G_DEFINE_TYPE(CutReadableDiffer, cut_readable_differ, CUT_TYPE_DIFFER)
@@ -401,19 +402,92 @@ cut_diff_readable_folded (const gchar *from, const gchar *to)
     return folded_diff;
 }
 
+#define SUMMARY_CONTEXT_WIDTH 30
+#define SUMMARY_LINE_WIDTH 70
+
+static gchar *
+summarize_line (const gchar *line, guint column)
+{
+    const gchar *line_end, *begin, *end;
+    GString *summary;
+
+    line_end = strchr(line, '\n');
+    if (!line_end)
+        line_end = line + strlen(line);
+    if (line_end > line && line_end[-1] == '\r')
+        line_end--;
+
+    begin = line;
+    if (column > SUMMARY_CONTEXT_WIDTH)
+        begin = g_utf8_offset_to_pointer(line, column - SUMMARY_CONTEXT_WIDTH);
+    for (end = begin;
+         end < line_end && g_utf8_pointer_to_offset(begin, end) <
+             SUMMARY_LINE_WIDTH;
+         end = g_utf8_next_char(end)) {
+    }
+
+    summary = g_string_new(NULL);
+    if (begin > line)
+        g_string_append(summary, "...");
+    g_string_append_len(summary, begin, end - begin);
+    if (end < line_end)
+        g_string_append(summary, "...");
+
+    return g_string_free(summary, FALSE);
+}
+
+/*
+ * Returns the first different line of @from and @to with its
+ * position. It's O(n) and used for large values that are too
+ * expensive to compute a full diff.
+ */
+gchar *
+cut_diff_readable_summary (const gchar *from, const gchar *to)
+{
+    gsize offset = 0, line_offset = 0;
+    guint line = 1, column;
+    gchar *from_line, *to_line, *summary;
+
+    while (from[offset] && from[offset] == to[offset]) {
+        if (from[offset] == '\n') {
+            line++;
+            line_offset = offset + 1;
+        }
+        offset++;
+    }
+    if (!from[offset] && !to[offset])
+        return NULL;
+
+    /* Don't split a multibyte character. */
+    while (offset > line_offset && (from[offset] & 0xc0) == 0x80)
+        offset--;
+
+    column = g_utf8_pointer_to_offset(from + line_offset, from + offset);
+    from_line = summarize_line(from + line_offset, column);
+    to_line = summarize_line(to + line_offset, column);
+    summary = g_strdup_printf("first difference at line %u, column %u\n"
+                              "- %s\n"
+                              "+ %s",
+                              line, column + 1, from_line, to_line);
+    g_free(from_line);
+    g_free(to_line);
+
+    return summary;
+}
+
 gboolean
 cut_diff_readable_is_interested (const gchar *diff)
 {
     if (!diff)
         return FALSE;
 
-    if (!g_regex_match_simple("^[-+]", diff, G_REGEX_MULTILINE, 0))
+    if (!cut_regex_cache_match("^[-+]", G_REGEX_MULTILINE, diff))
         return FALSE;
 
-    if (g_regex_match_simple("^[ ?]", diff, G_REGEX_MULTILINE, 0))
+    if (cut_regex_cache_match("^[ ?]", G_REGEX_MULTILINE, diff))
         return TRUE;
 
-    if (g_regex_match_simple("(?:.*\n){2,}", diff, G_REGEX_MULTILINE, 0))
+    if (cut_regex_cache_match("(?:.*\n){2,}", G_REGEX_MULTILINE, diff))
         return TRUE;
 
     return FALSE;
@@ -425,7 +499,7 @@ cut_diff_readable_need_fold (const gchar *diff)
     if (!diff)
         return FALSE;
 
-    if (g_regex_match_simple("^[-+].{79}", diff, G_REGEX_MULTILINE, 0))
+    if (cut_regex_cache_match("^[-+].{79}", G_REGEX_MULTILINE, diff))
         return TRUE;
 
     return FALSE;
@@ -58,6 +58,8 @@ CutDiffer *cut_readable_differ_new       (const gchar *from,
 gboolean   cut_diff_readable_is_interested
                                          (const gchar *diff);
 gboolean   cut_diff_readable_need_fold   (const gchar *diff);
+gchar     *cut_diff_readable_summary     (const gchar *from,
+                                          const gchar *to);
 
 G_END_DECLS
 
@@ -0,0 +1,202 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <glib.h>
+
+#include "cut-regex-cache.h"
+#include "cut-logger.h"
+
+typedef struct _CacheEntry
+{
+    gchar *key;
+    GRegex *regex;
+} CacheEntry;
+
+G_LOCK_DEFINE_STATIC(regex_cache);
+static GHashTable *entries = NULL;
+/* The head is the most recently used entry. */
+static GQueue lru = G_QUEUE_INIT;
+static guint max_size = CUT_REGEX_CACHE_DEFAULT_MAX_SIZE;
+static gboolean optimize = TRUE;
+
+static void
+cache_entry_free (CacheEntry *entry)
+{
+    g_free(entry->key);
+    g_regex_unref(entry->regex);
+    g_slice_free(CacheEntry, entry);
+}
+
+static void
+drop_least_recently_used_entries (guint size)
+{
+    while (lru.length > size) {
+        CacheEntry *entry;
+
+        entry = g_queue_pop_tail(&lru);
+        g_hash_table_remove(entries, entry->key);
+        cache_entry_free(entry);
+    }
+}
+
+static gchar *
+create_key (const gchar *pattern, GRegexCompileFlags compile_options)
+{
+    return g_strdup_printf("%x:%s", compile_options, pattern);
+}
+
+GRegex *
+cut_regex_cache_get (const gchar *pattern,
+                     GRegexCompileFlags compile_options,
+                     GError **error)
+{
+    GList *node;
+    GRegex *regex;
+    CacheEntry *entry;
+    gchar *key;
+
+    if (optimize)
+        compile_options |= G_REGEX_OPTIMIZE;
+    key = create_key(pattern, compile_options);
+
+    G_LOCK(regex_cache);
+    if (!entries)
+        entries = g_hash_table_new(g_str_hash, g_str_equal);
+    node = g_hash_table_lookup(entries, key);
+    if (node) {
+        entry = node->data;
+        regex = g_regex_ref(entry->regex);
+        g_queue_unlink(&lru, node);
+        g_queue_push_head_link(&lru, node);
+        G_UNLOCK(regex_cache);
+        g_free(key);
+        return regex;
+    }
+    G_UNLOCK(regex_cache);
+
+    /* Compile without the lock. Another thread may compile the
+     * same pattern at the same time but it's harmless. */
+    regex = g_regex_new(pattern, compile_options, 0, error);
+    if (!regex) {
+        g_free(key);
+        return NULL;
+    }
+
+    if (max_size == 0) {
+        g_free(key);
+        return regex;
+    }
+
+    G_LOCK(regex_cache);
+    node = g_hash_table_lookup(entries, key);
+    if (node) {
+        entry = node->data;
+        g_queue_unlink(&lru, node);
+        g_queue_push_head_link(&lru, node);
+        g_regex_unref(regex);
+        regex = g_regex_ref(entry->regex);
+        g_free(key);
+    } else {
+        entry = g_slice_new(CacheEntry);
+        entry->key = key;
+        entry->regex = g_regex_ref(regex);
+        g_queue_push_head(&lru, entry);
+        g_hash_table_insert(entries, entry->key, lru.head);
+        drop_least_recently_used_entries(max_size);
+        cut_log_trace("[regex-cache][add] <%s>", pattern);
+    }
+    G_UNLOCK(regex_cache);
+
+    return regex;
+}
+
+gboolean
+cut_regex_cache_match (const gchar *pattern,
+                       GRegexCompileFlags compile_options,
+                       const gchar *string)
+{
+    GRegex *regex;
+    gboolean matched;
+
+    regex = cut_regex_cache_get(pattern, compile_options, NULL);
+    if (!regex)
+        return FALSE;
+
+    matched = g_regex_match(regex, string, 0, NULL);
+    g_regex_unref(regex);
+
+    return matched;
+}
+
+void
+cut_regex_cache_set_max_size (guint size)
+{
+    G_LOCK(regex_cache);
+    max_size = size;
+    if (entries)
+        drop_least_recently_used_entries(max_size);
+    G_UNLOCK(regex_cache);
+}
+
+guint
+cut_regex_cache_get_max_size (void)
+{
+    return max_size;
+}
+
+guint
+cut_regex_cache_get_size (void)
+{
+    guint size;
+
+    G_LOCK(regex_cache);
+    size = lru.length;
+    G_UNLOCK(regex_cache);
+
+    return size;
+}
+
+void
+cut_regex_cache_set_optimize (gboolean enable)
+{
+    optimize = enable;
+}
+
+gboolean
+cut_regex_cache_get_optimize (void)
+{
+    return optimize;
+}
+
+void
+cut_regex_cache_clear (void)
+{
+    G_LOCK(regex_cache);
+    if (entries)
+        drop_least_recently_used_entries(0);
+    G_UNLOCK(regex_cache);
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
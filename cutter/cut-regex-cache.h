@@ -0,0 +1,57 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CUT_REGEX_CACHE_H__
+#define __CUT_REGEX_CACHE_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/*
+ * The regex cache keeps compiled regular expressions shared by
+ * assertions and test name filters. The least recently used one
+ * is dropped when the cache is full. It's thread safe.
+ */
+#define CUT_REGEX_CACHE_DEFAULT_MAX_SIZE 64
+
+/* Returns a new reference. The caller must unref it. */
+GRegex  *cut_regex_cache_get           (const gchar        *pattern,
+                                        GRegexCompileFlags  compile_options,
+                                        GError            **error);
+gboolean cut_regex_cache_match         (const gchar        *pattern,
+                                        GRegexCompileFlags  compile_options,
+                                        const gchar        *string);
+
+void     cut_regex_cache_set_max_size  (guint               max_size);
+guint    cut_regex_cache_get_max_size  (void);
+guint    cut_regex_cache_get_size      (void);
+/* Regular expressions are compiled with G_REGEX_OPTIMIZE by
+ * default. It uses JIT compilation if it's available. */
+void     cut_regex_cache_set_optimize  (gboolean            optimize);
+gboolean cut_regex_cache_get_optimize  (void);
+void     cut_regex_cache_clear         (void);
+
+G_END_DECLS
+
+#endif /* __CUT_REGEX_CACHE_H__ */
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
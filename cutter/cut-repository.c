@@ -29,6 +29,7 @@
 #include "cut-repository.h"
 #include "cut-loader.h"
 #include "cut-utils.h"
+#include "cut-glib-compatible.h"
 
 #define CUT_REPOSITORY_GET_PRIVATE(obj) (G_TYPE_INSTANCE_GET_PRIVATE ((obj), CUT_TYPE_REPOSITORY, CutRepositoryPrivate))
 
@@ -46,6 +47,8 @@ struct _CutRepositoryPrivate
 
     gboolean keep_opening_modules;
     gboolean enable_convenience_attribute_definition;
+    gchar *symbol_cache_directory;
+    gint max_threads;
 };
 
 enum
@@ -102,6 +105,8 @@ cut_repository_init (CutRepository *repository)
     priv->test_suite_loader = NULL;
     priv->keep_opening_modules = FALSE;
     priv->enable_convenience_attribute_definition = FALSE;
+    priv->symbol_cache_directory = NULL;
+    priv->max_threads = 1;
 }
 
 static void
@@ -148,6 +153,11 @@ dispose (GObject *object)
         priv->test_suite_loader = NULL;
     }
 
+    if (priv->symbol_cache_directory) {
+        g_free(priv->symbol_cache_directory);
+        priv->symbol_cache_directory = NULL;
+    }
+
     G_OBJECT_CLASS(cut_repository_parent_class)->dispose(object);
 }
 
@@ -221,6 +231,35 @@ cut_repository_set_enable_convenience_attribute_definition (CutRepository *repos
     CUT_REPOSITORY_GET_PRIVATE(repository)->enable_convenience_attribute_definition = enable_convenience_attribute_definition;
 }
 
+const gchar *
+cut_repository_get_symbol_cache_directory (CutRepository *repository)
+{
+    return CUT_REPOSITORY_GET_PRIVATE(repository)->symbol_cache_directory;
+}
+
+void
+cut_repository_set_symbol_cache_directory (CutRepository *repository,
+                                           const gchar *directory)
+{
+    CutRepositoryPrivate *priv = CUT_REPOSITORY_GET_PRIVATE(repository);
+
+    if (priv->symbol_cache_directory)
+        g_free(priv->symbol_cache_directory);
+    priv->symbol_cache_directory = g_strdup(directory);
+}
+
+gint
+cut_repository_get_max_threads (CutRepository *repository)
+{
+    return CUT_REPOSITORY_GET_PRIVATE(repository)->max_threads;
+}
+
+void
+cut_repository_set_max_threads (CutRepository *repository, gint max_threads)
+{
+    CUT_REPOSITORY_GET_PRIVATE(repository)->max_threads = max_threads;
+}
+
 static gboolean
 is_test_suite_so_path_name (const gchar *path_name)
 {
@@ -283,64 +322,285 @@ compute_relative_path (GArray *paths)
     return relative_path;
 }
 
+typedef struct _ModuleEntry
+{
+    gchar *path_name;
+    gchar *relative_path;
+    gint deep;
+} ModuleEntry;
+
+typedef struct _CollectContext
+{
+    CutRepositoryPrivate *priv;
+    GThreadPool *thread_pool;
+    GMutex *mutex;
+    GCond *cond;
+    gint n_pending_directories;
+    GList *entries;
+} CollectContext;
+
+typedef struct _DirectoryJob
+{
+    gchar *dir_name;
+    GArray *paths;
+} DirectoryJob;
+
+static void
+module_entry_free (ModuleEntry *entry)
+{
+    g_free(entry->path_name);
+    g_free(entry->relative_path);
+    g_free(entry);
+}
+
+static gint
+compare_module_entry (gconstpointer a, gconstpointer b)
+{
+    const ModuleEntry *entry1 = a;
+    const ModuleEntry *entry2 = b;
+
+    return strcmp(entry1->path_name, entry2->path_name);
+}
+
+static void
+directory_job_free (DirectoryJob *job)
+{
+    guint i;
+
+    for (i = 0; i < job->paths->len; i++) {
+        g_free(g_array_index(job->paths, gchar *, i));
+    }
+    g_array_free(job->paths, TRUE);
+    g_free(job->dir_name);
+    g_free(job);
+}
+
+static gint
+get_n_threads (CutRepositoryPrivate *priv)
+{
+    if (priv->max_threads == 1 || !g_thread_supported())
+        return 1;
+
+    if (priv->max_threads > 0)
+        return priv->max_threads;
+
+#if GLIB_CHECK_VERSION(2, 36, 0)
+    return g_get_num_processors();
+#else
+    return 10;
+#endif
+}
+
+static void collect_directory (DirectoryJob *job, CollectContext *context);
+
+static void
+push_directory (CollectContext *context, const gchar *dir_name,
+                GArray *parent_paths, const gchar *entry)
+{
+    DirectoryJob *job;
+    guint i;
+
+    job = g_new0(DirectoryJob, 1);
+    job->dir_name = g_strdup(dir_name);
+    job->paths = g_array_new(TRUE, TRUE, sizeof(gchar *));
+    for (i = 0; parent_paths && i < parent_paths->len; i++) {
+        gchar *component;
+
+        component = g_strdup(g_array_index(parent_paths, gchar *, i));
+        g_array_append_val(job->paths, component);
+    }
+    if (entry) {
+        gchar *component;
+
+        component = g_strdup(entry);
+        g_array_append_val(job->paths, component);
+    }
+
+    if (context->thread_pool) {
+        GError *error = NULL;
+
+        g_mutex_lock(context->mutex);
+        context->n_pending_directories++;
+        g_mutex_unlock(context->mutex);
+
+        g_thread_pool_push(context->thread_pool, job, &error);
+        if (!error)
+            return;
+
+        cut_utils_report_error(error);
+        g_mutex_lock(context->mutex);
+        context->n_pending_directories--;
+        g_mutex_unlock(context->mutex);
+    }
+
+    collect_directory(job, context);
+}
+
 static void
-cut_repository_collect_loader (CutRepository *repository, const gchar *dir_name,
-                               GArray *paths)
+collect_directory (DirectoryJob *job, CollectContext *context)
 {
-    GDir *dir;
+    CutRepositoryPrivate *priv;
+    GDir *dir = NULL;
     const gchar *entry;
-    CutRepositoryPrivate *priv = CUT_REPOSITORY_GET_PRIVATE(repository);
+    GList *entries = NULL;
 
-    if (is_ignore_directory(dir_name))
-        return;
+    priv = context->priv;
 
-    dir = g_dir_open(dir_name, 0, NULL);
-    if (!dir)
-        return;
+    if (!is_ignore_directory(job->dir_name))
+        dir = g_dir_open(job->dir_name, 0, NULL);
 
-    while ((entry = g_dir_read_name(dir))) {
+    while (dir && (entry = g_dir_read_name(dir))) {
         gchar *path_name;
 
-        path_name = g_build_filename(dir_name, entry, NULL);
+        path_name = g_build_filename(job->dir_name, entry, NULL);
         if (g_file_test(path_name, G_FILE_TEST_IS_DIR)) {
-            if (cut_utils_filter_match(priv->exclude_dirs_regexs, entry)) {
-                g_free(path_name);
-                continue;
-            }
-            g_array_append_val(paths, entry);
-            cut_repository_collect_loader(repository, path_name, paths);
-            g_array_remove_index(paths, paths->len - 1);
+            if (!cut_utils_filter_match(priv->exclude_dirs_regexs, entry))
+                push_directory(context, path_name, job->paths, entry);
+            g_free(path_name);
+        } else if (cut_utils_filter_match(priv->exclude_files_regexs, entry) ||
+                   !g_str_has_suffix(entry, "."G_MODULE_SUFFIX)) {
+            g_free(path_name);
+        } else {
+            ModuleEntry *module_entry;
+
+            module_entry = g_new0(ModuleEntry, 1);
+            module_entry->path_name = path_name;
+            module_entry->relative_path = compute_relative_path(job->paths);
+            module_entry->deep = job->paths->len;
+            entries = g_list_prepend(entries, module_entry);
+        }
+    }
+    if (dir)
+        g_dir_close(dir);
+
+    g_mutex_lock(context->mutex);
+    context->entries = g_list_concat(entries, context->entries);
+    g_mutex_unlock(context->mutex);
+
+    directory_job_free(job);
+}
+
+static void
+run_directory_job (gpointer data, gpointer user_data)
+{
+    CollectContext *context = user_data;
+
+    collect_directory(data, context);
+
+    g_mutex_lock(context->mutex);
+    context->n_pending_directories--;
+    g_cond_broadcast(context->cond);
+    g_mutex_unlock(context->mutex);
+}
+
+static void
+cut_repository_collect_loader (CutRepository *repository, const gchar *dir_name)
+{
+    CutRepositoryPrivate *priv = CUT_REPOSITORY_GET_PRIVATE(repository);
+    CollectContext context;
+    gint n_threads;
+    GList *node;
+
+    context.priv = priv;
+    context.thread_pool = NULL;
+    context.mutex = g_mutex_new();
+    context.cond = g_cond_new();
+    context.n_pending_directories = 0;
+    context.entries = NULL;
+
+    n_threads = get_n_threads(priv);
+    if (n_threads > 1) {
+        GError *error = NULL;
+
+        context.thread_pool = g_thread_pool_new(run_directory_job, &context,
+                                                n_threads, FALSE, &error);
+        if (error) {
+            cut_utils_report_error(error);
+            context.thread_pool = NULL;
+        }
+    }
+
+    push_directory(&context, dir_name, NULL, NULL);
+
+    if (context.thread_pool) {
+        g_mutex_lock(context.mutex);
+        while (context.n_pending_directories > 0) {
+            g_cond_wait(context.cond, context.mutex);
+        }
+        g_mutex_unlock(context.mutex);
+        g_thread_pool_free(context.thread_pool, FALSE, TRUE);
+    }
+    g_mutex_free(context.mutex);
+    g_cond_free(context.cond);
+
+    /* Directories are walked concurrently. We sort found modules
+     * to keep the order of test cases. */
+    context.entries = g_list_sort(context.entries, compare_module_entry);
+    for (node = context.entries; node; node = g_list_next(node)) {
+        ModuleEntry *entry = node->data;
+        CutLoader *loader;
+        GList *customizer_node;
+
+        loader = cut_loader_new(entry->path_name);
+        cut_loader_set_base_directory(loader, entry->relative_path);
+        cut_loader_set_keep_opening(loader, priv->keep_opening_modules);
+        cut_loader_set_enable_convenience_attribute_definition(
+            loader, priv->enable_convenience_attribute_definition);
+        cut_loader_set_symbol_cache_directory(loader,
+                                              priv->symbol_cache_directory);
+        for (customizer_node = priv->loader_customizers;
+             customizer_node;
+             customizer_node = g_list_next(customizer_node)) {
+            CutLoaderCustomizer *customizer = customizer_node->data;
+            cut_loader_customizer_customize(customizer, loader);
+        }
+        if (is_test_suite_so_path_name(entry->path_name)) {
+            update_test_suite_loader(priv, loader, entry->deep);
+            g_object_unref(loader);
         } else {
-            CutLoader *loader;
-            gchar *relative_path;
-            GList *node;
-
-            if (cut_utils_filter_match(priv->exclude_files_regexs, entry) ||
-                !g_str_has_suffix(entry, "."G_MODULE_SUFFIX)) {
-                g_free(path_name);
-                continue;
-            }
-
-            loader = cut_loader_new(path_name);
-            relative_path = compute_relative_path(paths);
-            cut_loader_set_base_directory(loader, relative_path);
-            cut_loader_set_keep_opening(loader, priv->keep_opening_modules);
-            cut_loader_set_enable_convenience_attribute_definition(
-                loader, priv->enable_convenience_attribute_definition);
-            for (node = priv->loader_customizers; node; node = g_list_next(node)) {
-                CutLoaderCustomizer *customizer = node->data;
-                cut_loader_customizer_customize(customizer, loader);
-            }
-            if (is_test_suite_so_path_name(path_name)) {
-                update_test_suite_loader(priv, loader, paths->len);
-            } else {
-                priv->loaders = g_list_prepend(priv->loaders, loader);
-            }
-            g_free(relative_path);
+            priv->loaders = g_list_prepend(priv->loaders, loader);
+        }
+        module_entry_free(entry);
+    }
+    g_list_free(context.entries);
+    priv->loaders = g_list_reverse(priv->loaders);
+}
+
+static void
+run_collect_symbols_job (gpointer data, gpointer user_data)
+{
+    cut_loader_collect_symbols(data);
+}
+
+static void
+collect_symbols (CutRepositoryPrivate *priv)
+{
+    GThreadPool *thread_pool;
+    gint n_threads;
+    GList *node;
+    GError *error = NULL;
+
+    n_threads = get_n_threads(priv);
+    if (n_threads <= 1)
+        return;
+
+    thread_pool = g_thread_pool_new(run_collect_symbols_job, NULL,
+                                    n_threads, FALSE, &error);
+    if (error) {
+        cut_utils_report_error(error);
+        return;
+    }
+
+    for (node = priv->loaders; node; node = g_list_next(node)) {
+        g_thread_pool_push(thread_pool, node->data, &error);
+        if (error) {
+            cut_utils_report_error(error);
+            error = NULL;
+            break;
         }
-        g_free(path_name);
     }
-    g_dir_close(dir);
+    /* Symbols of rest loaders are collected on loading. */
+    g_thread_pool_free(thread_pool, FALSE, TRUE);
 }
 
 CutTestSuite *
@@ -354,12 +614,8 @@ cut_repository_create_test_suite (CutRepository *repository)
         return NULL;
 
     if (!priv->loaders) {
-        GArray *paths;
-
         priv->deep = 0;
-        paths = g_array_new(TRUE, TRUE, sizeof(gchar *));
-        cut_repository_collect_loader(repository, priv->directory, paths);
-        g_array_free(paths, TRUE);
+        cut_repository_collect_loader(repository, priv->directory);
     }
 
     if (priv->test_suite_loader)
@@ -367,6 +623,9 @@ cut_repository_create_test_suite (CutRepository *repository)
     if (!suite)
         suite = cut_test_suite_new_empty();
 
+    /* Symbols are collected in parallel but modules are opened
+     * in this thread. */
+    collect_symbols(priv);
     for (list = priv->loaders; list; list = g_list_next(list)) {
         CutLoader *loader = CUT_LOADER(list->data);
         GList *test_cases, *node;
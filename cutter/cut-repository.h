@@ -61,6 +61,14 @@ gboolean       cut_repository_get_enable_convenience_attribute_definition
 void           cut_repository_set_enable_convenience_attribute_definition
                                                 (CutRepository *repository,
                                                  gboolean       enable_convenience_attribute_definition);
+const gchar   *cut_repository_get_symbol_cache_directory
+                                                (CutRepository *repository);
+void           cut_repository_set_symbol_cache_directory
+                                                (CutRepository *repository,
+                                                 const gchar   *directory);
+gint           cut_repository_get_max_threads   (CutRepository *repository);
+void           cut_repository_set_max_threads   (CutRepository *repository,
+                                                 gint           max_threads);
 CutTestSuite  *cut_repository_create_test_suite (CutRepository *repository);
 void           cut_repository_set_exclude_files (CutRepository *repository,
                                                  const gchar  **filenames);
@@ -31,10 +31,17 @@
 #include "cut-listener.h"
 #include "cut-repository.h"
 #include "cut-test-case.h"
+#include "cut-iterated-test.h"
 #include "cut-test-result.h"
+#include "cut-benchmark.h"
+#include "cut-benchmark-result.h"
 #include "cut-glib-compatible.h"
 
 #include "cut-enum-types.h"
+#include "cut-timing-history.h"
+#include "cut-run-history.h"
+#include "cut-baseline.h"
+#include "cut-logger.h"
 #include <gcutter/gcut-marshalers.h>
 
 #ifdef ERROR
@@ -65,7 +72,9 @@ struct _CutRunContextPrivate
     GList *reversed_results;
     gboolean use_multi_thread;
     gboolean is_multi_thread;
+    gboolean split_test_cases;
     gboolean max_threads;
+    gint n_processes;
     gboolean handle_signals;
     GMutex *mutex;
     gboolean crashed;
@@ -88,6 +97,33 @@ struct _CutRunContextPrivate
     gboolean keep_opening_modules;
     gboolean enable_convenience_attribute_definition;
     gboolean stop_before_test;
+    gchar *symbol_cache_directory;
+    gboolean batch_pass_assertions;
+    gint n_pass_assertion_event_holders;
+    CutResultRetention result_retention;
+    gint n_non_success_result_holders;
+    CutTimingHistory *timing_history;
+    gboolean update_timing_history;
+    gboolean timing_history_updated;
+    CutRunHistory *run_history;
+    gboolean run_history_broken;
+    gboolean run_history_updated;
+    GHashTable *run_history_statuses;
+    gdouble timeout;
+    gdouble benchmark_time;
+    gchar *save_baseline_filename;
+    CutBaseline *saving_baseline;
+    gboolean baseline_updated;
+    gchar *compare_baseline_filename;
+    CutBaseline *comparing_baseline;
+    gboolean comparing_baseline_loaded;
+    gdouble regression_threshold;
+    gboolean fail_on_regression;
+    gboolean performance_counters;
+    gboolean memory_usage;
+    gint allocation_failures;
+    gchar *shard_listen;
+    gchar *shard_connect;
 };
 
 enum
@@ -103,7 +139,9 @@ enum
     PROP_N_OMISSIONS,
     PROP_USE_MULTI_THREAD,
     PROP_IS_MULTI_THREAD,
+    PROP_SPLIT_TEST_CASES,
     PROP_MAX_THREADS,
+    PROP_N_PROCESSES,
     PROP_HANDLE_SIGNALS,
     PROP_TEST_CASE_ORDER,
     PROP_TEST_DIRECTORY,
@@ -117,7 +155,22 @@ enum
     PROP_FATAL_FAILURES,
     PROP_KEEP_OPENING_MODULES,
     PROP_ENABLE_CONVENIENCE_ATTRIBUTE_DEFINITION,
-    PROP_STOP_BEFORE_TEST
+    PROP_STOP_BEFORE_TEST,
+    PROP_SYMBOL_CACHE_DIRECTORY,
+    PROP_BATCH_PASS_ASSERTIONS,
+    PROP_RESULT_RETENTION,
+    PROP_UPDATE_TIMING_HISTORY,
+    PROP_TIMEOUT,
+    PROP_BENCHMARK_TIME,
+    PROP_SAVE_BASELINE,
+    PROP_COMPARE_BASELINE,
+    PROP_REGRESSION_THRESHOLD,
+    PROP_FAIL_ON_REGRESSION,
+    PROP_PERFORMANCE_COUNTERS,
+    PROP_MEMORY_USAGE,
+    PROP_ALLOCATION_FAILURES,
+    PROP_SHARD_LISTEN,
+    PROP_SHARD_CONNECT
 };
 
 enum
@@ -135,6 +188,7 @@ enum
     START_ITERATED_TEST,
 
     PASS_ASSERTION,
+    PASS_ASSERTIONS,
 
     SUCCESS_TEST,
     FAILURE_TEST,
@@ -143,6 +197,7 @@ enum
     NOTIFICATION_TEST,
     OMISSION_TEST,
     CRASH_TEST,
+    BENCHMARK_TEST,
 
     SUCCESS_TEST_ITERATOR,
     FAILURE_TEST_ITERATOR,
@@ -214,6 +269,10 @@ static void start_test     (CutRunContext   *context,
 static void pass_assertion (CutRunContext   *context,
                             CutTest         *test,
                             CutTestContext  *test_context);
+static void pass_assertions(CutRunContext   *context,
+                            CutTest         *test,
+                            CutTestContext  *test_context,
+                            guint            n_assertions);
 static void success_test   (CutRunContext   *context,
                             CutTest         *test,
                             CutTestContext  *test_context,
@@ -247,6 +306,10 @@ static void complete_test  (CutRunContext   *context,
                             CutTest         *test,
                             CutTestContext  *test_context,
                             gboolean         success);
+static void benchmark_test (CutRunContext   *context,
+                            CutTest         *test,
+                            CutTestContext  *test_context,
+                            CutBenchmarkResult *result);
 static void complete_iterated_test
                            (CutRunContext   *context,
                             CutIteratedTest *iterated_test,
@@ -283,6 +346,10 @@ static void crash_test_suite
                             CutTestSuite    *test_suite,
                             CutTestResult   *result);
 
+static void complete_test_case
+                           (CutRunContext   *context,
+                            CutTestCase     *test_case,
+                            gboolean         success);
 static void complete_run   (CutRunContext   *context,
                             gboolean         success);
 
@@ -305,6 +372,7 @@ cut_run_context_class_init (CutRunContextClass *klass)
     klass->start_iterated_test = start_iterated_test;
     klass->start_test        = start_test;
     klass->pass_assertion    = pass_assertion;
+    klass->pass_assertions   = pass_assertions;
     klass->success_test      = success_test;
     klass->failure_test      = failure_test;
     klass->error_test        = error_test;
@@ -313,7 +381,9 @@ cut_run_context_class_init (CutRunContextClass *klass)
     klass->omission_test     = omission_test;
     klass->crash_test        = crash_test;
     klass->complete_test     = complete_test;
+    klass->benchmark_test    = benchmark_test;
     klass->complete_iterated_test = complete_iterated_test;
+    klass->complete_test_case = complete_test_case;
 
     klass->failure_in_test_case = failure_in_test_case;
     klass->error_in_test_case   = error_in_test_case;
@@ -396,6 +466,14 @@ cut_run_context_class_init (CutRunContextClass *klass)
                                 G_PARAM_READWRITE);
     g_object_class_install_property(gobject_class, PROP_IS_MULTI_THREAD, spec);
 
+    spec = g_param_spec_boolean("split-test-cases",
+                                "Split test cases",
+                                "Whether run tests in a test case concurrently "
+                                "with multi thread",
+                                FALSE,
+                                G_PARAM_READWRITE);
+    g_object_class_install_property(gobject_class, PROP_SPLIT_TEST_CASES, spec);
+
     spec = g_param_spec_int("max-threads",
                             "Max number of threads",
                             "How many threads are used concurrently at a maximum",
@@ -403,6 +481,14 @@ cut_run_context_class_init (CutRunContextClass *klass)
                             G_PARAM_READWRITE);
     g_object_class_install_property(gobject_class, PROP_MAX_THREADS, spec);
 
+    spec = g_param_spec_int("n-processes",
+                            "Number of processes",
+                            "How many worker processes run test cases "
+                            "(0 is no worker process)",
+                            0, G_MAXINT32, 0,
+                            G_PARAM_READWRITE);
+    g_object_class_install_property(gobject_class, PROP_N_PROCESSES, spec);
+
     spec = g_param_spec_boolean("handle-signals",
                                 "Whether handle signals",
                                 "Whether the run context handles signals",
@@ -505,6 +591,141 @@ cut_run_context_class_init (CutRunContextClass *klass)
                                     PROP_STOP_BEFORE_TEST,
                                     spec);
 
+    spec = g_param_spec_string("symbol-cache-directory",
+                               "Symbol cache directory",
+                               "The directory name in which symbols of "
+                               "test modules are cached",
+                               NULL,
+                               G_PARAM_READWRITE);
+    g_object_class_install_property(gobject_class,
+                                    PROP_SYMBOL_CACHE_DIRECTORY,
+                                    spec);
+
+    spec = g_param_spec_boolean("batch-pass-assertions",
+                                "Batch pass assertions",
+                                "Report passed assertions of a test at once "
+                                "instead of one by one",
+                                FALSE,
+                                G_PARAM_READWRITE);
+    g_object_class_install_property(gobject_class,
+                                    PROP_BATCH_PASS_ASSERTIONS,
+                                    spec);
+
+    spec = g_param_spec_enum("result-retention",
+                             "Result retention",
+                             "Which test results are kept after they are "
+                             "reported to listeners",
+                             CUT_TYPE_RESULT_RETENTION,
+                             CUT_RESULT_RETENTION_ALL,
+                             G_PARAM_READWRITE);
+    g_object_class_install_property(gobject_class,
+                                    PROP_RESULT_RETENTION,
+                                    spec);
+
+    spec = g_param_spec_boolean("update-timing-history",
+                                "Update timing history",
+                                "Whether elapsed times of the run are "
+                                "recorded into the timing history",
+                                TRUE,
+                                G_PARAM_READWRITE);
+    g_object_class_install_property(gobject_class,
+                                    PROP_UPDATE_TIMING_HISTORY,
+                                    spec);
+
+    spec = g_param_spec_double("timeout",
+                               "Timeout",
+                               "The default timeout of a test in seconds. "
+                               "0 means no timeout.",
+                               0.0, G_MAXDOUBLE, 0.0,
+                               G_PARAM_READWRITE);
+    g_object_class_install_property(gobject_class, PROP_TIMEOUT, spec);
+
+    spec = g_param_spec_double("benchmark-time",
+                               "Benchmark time",
+                               "The time to measure a benchmark in seconds. "
+                               "0 means that a benchmark is called only once.",
+                               0.0, G_MAXDOUBLE, CUT_BENCHMARK_DEFAULT_TIME,
+                               G_PARAM_READWRITE);
+    g_object_class_install_property(gobject_class, PROP_BENCHMARK_TIME, spec);
+
+    spec = g_param_spec_string("save-baseline",
+                               "Save baseline",
+                               "The file name to save elapsed times of "
+                               "the run as a baseline",
+                               NULL,
+                               G_PARAM_READWRITE);
+    g_object_class_install_property(gobject_class, PROP_SAVE_BASELINE, spec);
+
+    spec = g_param_spec_string("compare-baseline",
+                               "Compare baseline",
+                               "The file name of a baseline to which "
+                               "elapsed times of the run are compared",
+                               NULL,
+                               G_PARAM_READWRITE);
+    g_object_class_install_property(gobject_class, PROP_COMPARE_BASELINE,
+                                    spec);
+
+    spec = g_param_spec_double("regression-threshold",
+                               "Regression threshold",
+                               "The percentage by which a test can be "
+                               "slower than the baseline",
+                               0.0, G_MAXDOUBLE,
+                               CUT_BASELINE_DEFAULT_REGRESSION_THRESHOLD,
+                               G_PARAM_READWRITE);
+    g_object_class_install_property(gobject_class, PROP_REGRESSION_THRESHOLD,
+                                    spec);
+
+    spec = g_param_spec_boolean("fail-on-regression",
+                                "Fail on regression",
+                                "Whether a regression is reported as a "
+                                "failure instead of a notification",
+                                FALSE,
+                                G_PARAM_READWRITE);
+    g_object_class_install_property(gobject_class, PROP_FAIL_ON_REGRESSION,
+                                    spec);
+
+    spec = g_param_spec_boolean("performance-counters",
+                                "Performance counters",
+                                "Whether hardware performance counters "
+                                "are measured for each test",
+                                FALSE,
+                                G_PARAM_READWRITE);
+    g_object_class_install_property(gobject_class, PROP_PERFORMANCE_COUNTERS,
+                                    spec);
+
+    spec = g_param_spec_boolean("memory-usage",
+                                "Memory usage",
+                                "Whether heap allocations are measured "
+                                "for each test",
+                                FALSE,
+                                G_PARAM_READWRITE);
+    g_object_class_install_property(gobject_class, PROP_MEMORY_USAGE, spec);
+
+    spec = g_param_spec_int("allocation-failures",
+                            "Allocation failures",
+                            "How many allocations of each test are failed "
+                            "one by one (0 is no allocation failure)",
+                            0, G_MAXINT32, 0,
+                            G_PARAM_READWRITE);
+    g_object_class_install_property(gobject_class, PROP_ALLOCATION_FAILURES,
+                                    spec);
+
+    spec = g_param_spec_string("shard-listen",
+                               "Shard listen",
+                               "The [HOST:]PORT on which remote workers "
+                               "are accepted",
+                               NULL,
+                               G_PARAM_READWRITE);
+    g_object_class_install_property(gobject_class, PROP_SHARD_LISTEN, spec);
+
+    spec = g_param_spec_string("shard-connect",
+                               "Shard connect",
+                               "The HOST:PORT of the shard coordinator "
+                               "for which test cases are run",
+                               NULL,
+                               G_PARAM_READWRITE);
+    g_object_class_install_property(gobject_class, PROP_SHARD_CONNECT, spec);
+
     signals[START_RUN]
         = g_signal_new("start-run",
                        G_TYPE_FROM_CLASS(klass),
@@ -598,6 +819,16 @@ cut_run_context_class_init (CutRunContextClass *klass)
                         _gcut_marshal_VOID__OBJECT_OBJECT,
                         G_TYPE_NONE, 2, CUT_TYPE_TEST, CUT_TYPE_TEST_CONTEXT);
 
+    signals[PASS_ASSERTIONS]
+        = g_signal_new ("pass-assertions",
+                        G_TYPE_FROM_CLASS (klass),
+                        G_SIGNAL_RUN_LAST | G_SIGNAL_DETAILED,
+                        G_STRUCT_OFFSET (CutRunContextClass, pass_assertions),
+                        NULL, NULL,
+                        _gcut_marshal_VOID__OBJECT_OBJECT_UINT,
+                        G_TYPE_NONE, 3,
+                        CUT_TYPE_TEST, CUT_TYPE_TEST_CONTEXT, G_TYPE_UINT);
+
     signals[SUCCESS_TEST]
         = g_signal_new ("success-test",
                         G_TYPE_FROM_CLASS (klass),
@@ -675,6 +906,17 @@ cut_run_context_class_init (CutRunContextClass *klass)
                        CUT_TYPE_TEST, CUT_TYPE_TEST_CONTEXT,
                        CUT_TYPE_TEST_RESULT);
 
+    signals[BENCHMARK_TEST]
+        = g_signal_new("benchmark-test",
+                       G_TYPE_FROM_CLASS(klass),
+                       G_SIGNAL_RUN_LAST | G_SIGNAL_DETAILED,
+                       G_STRUCT_OFFSET(CutRunContextClass, benchmark_test),
+                       NULL, NULL,
+                       _gcut_marshal_VOID__OBJECT_OBJECT_OBJECT,
+                       G_TYPE_NONE, 3,
+                       CUT_TYPE_TEST, CUT_TYPE_TEST_CONTEXT,
+                       CUT_TYPE_BENCHMARK_RESULT);
+
     signals[COMPLETE_ITERATED_TEST]
         = g_signal_new("complete-iterated-test",
                        G_TYPE_FROM_CLASS(klass),
@@ -962,7 +1204,9 @@ cut_run_context_init (CutRunContext *context)
     priv->reversed_results = NULL;
     priv->use_multi_thread = FALSE;
     priv->is_multi_thread = FALSE;
+    priv->split_test_cases = FALSE;
     priv->max_threads = 10;
+    priv->n_processes = 0;
     priv->handle_signals = TRUE;
     priv->mutex = g_mutex_new();
     priv->crashed = FALSE;
@@ -983,6 +1227,34 @@ cut_run_context_init (CutRunContext *context)
     priv->keep_opening_modules = FALSE;
     priv->enable_convenience_attribute_definition = FALSE;
     priv->stop_before_test = FALSE;
+    priv->symbol_cache_directory = NULL;
+    priv->batch_pass_assertions = FALSE;
+    priv->n_pass_assertion_event_holders = 0;
+    priv->result_retention = CUT_RESULT_RETENTION_ALL;
+    priv->n_non_success_result_holders = 0;
+    priv->timing_history = NULL;
+    priv->update_timing_history = TRUE;
+    priv->timing_history_updated = FALSE;
+    priv->run_history = NULL;
+    priv->run_history_broken = FALSE;
+    priv->run_history_updated = FALSE;
+    priv->run_history_statuses =
+        g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+    priv->timeout = 0.0;
+    priv->benchmark_time = CUT_BENCHMARK_DEFAULT_TIME;
+    priv->save_baseline_filename = NULL;
+    priv->saving_baseline = NULL;
+    priv->baseline_updated = FALSE;
+    priv->compare_baseline_filename = NULL;
+    priv->comparing_baseline = NULL;
+    priv->comparing_baseline_loaded = FALSE;
+    priv->regression_threshold = CUT_BASELINE_DEFAULT_REGRESSION_THRESHOLD;
+    priv->fail_on_regression = FALSE;
+    priv->performance_counters = FALSE;
+    priv->memory_usage = FALSE;
+    priv->allocation_failures = 0;
+    priv->shard_listen = NULL;
+    priv->shard_connect = NULL;
 }
 
 static void
@@ -1039,6 +1311,46 @@ dispose (GObject *object)
     g_free(priv->log_directory);
     priv->log_directory = NULL;
 
+    g_free(priv->symbol_cache_directory);
+    priv->symbol_cache_directory = NULL;
+
+    if (priv->timing_history) {
+        cut_timing_history_free(priv->timing_history);
+        priv->timing_history = NULL;
+    }
+
+    if (priv->run_history) {
+        cut_run_history_free(priv->run_history);
+        priv->run_history = NULL;
+    }
+
+    if (priv->run_history_statuses) {
+        g_hash_table_unref(priv->run_history_statuses);
+        priv->run_history_statuses = NULL;
+    }
+
+    g_free(priv->save_baseline_filename);
+    priv->save_baseline_filename = NULL;
+
+    g_free(priv->shard_listen);
+    priv->shard_listen = NULL;
+
+    g_free(priv->shard_connect);
+    priv->shard_connect = NULL;
+
+    if (priv->saving_baseline) {
+        cut_baseline_free(priv->saving_baseline);
+        priv->saving_baseline = NULL;
+    }
+
+    g_free(priv->compare_baseline_filename);
+    priv->compare_baseline_filename = NULL;
+
+    if (priv->comparing_baseline) {
+        cut_baseline_free(priv->comparing_baseline);
+        priv->comparing_baseline = NULL;
+    }
+
     g_free(priv->test_directory);
     priv->test_directory = NULL;
 
@@ -1103,9 +1415,15 @@ set_property (GObject      *object,
       case PROP_IS_MULTI_THREAD:
         priv->is_multi_thread = g_value_get_boolean(value);
         break;
+      case PROP_SPLIT_TEST_CASES:
+        priv->split_test_cases = g_value_get_boolean(value);
+        break;
       case PROP_MAX_THREADS:
         priv->max_threads = g_value_get_int(value);
         break;
+      case PROP_N_PROCESSES:
+        priv->n_processes = g_value_get_int(value);
+        break;
       case PROP_HANDLE_SIGNALS:
         priv->handle_signals = g_value_get_boolean(value);
         break;
@@ -1148,6 +1466,56 @@ set_property (GObject      *object,
       case PROP_STOP_BEFORE_TEST:
         priv->stop_before_test = g_value_get_boolean(value);
         break;
+      case PROP_SYMBOL_CACHE_DIRECTORY:
+        cut_run_context_set_symbol_cache_directory(CUT_RUN_CONTEXT(object),
+                                                   g_value_get_string(value));
+        break;
+      case PROP_BATCH_PASS_ASSERTIONS:
+        priv->batch_pass_assertions = g_value_get_boolean(value);
+        break;
+      case PROP_RESULT_RETENTION:
+        priv->result_retention = g_value_get_enum(value);
+        break;
+      case PROP_UPDATE_TIMING_HISTORY:
+        priv->update_timing_history = g_value_get_boolean(value);
+        break;
+      case PROP_TIMEOUT:
+        priv->timeout = g_value_get_double(value);
+        break;
+      case PROP_BENCHMARK_TIME:
+        priv->benchmark_time = g_value_get_double(value);
+        break;
+      case PROP_SAVE_BASELINE:
+        cut_run_context_set_save_baseline(CUT_RUN_CONTEXT(object),
+                                          g_value_get_string(value));
+        break;
+      case PROP_COMPARE_BASELINE:
+        cut_run_context_set_compare_baseline(CUT_RUN_CONTEXT(object),
+                                             g_value_get_string(value));
+        break;
+      case PROP_REGRESSION_THRESHOLD:
+        priv->regression_threshold = g_value_get_double(value);
+        break;
+      case PROP_FAIL_ON_REGRESSION:
+        priv->fail_on_regression = g_value_get_boolean(value);
+        break;
+      case PROP_PERFORMANCE_COUNTERS:
+        priv->performance_counters = g_value_get_boolean(value);
+        break;
+      case PROP_MEMORY_USAGE:
+        priv->memory_usage = g_value_get_boolean(value);
+        break;
+      case PROP_ALLOCATION_FAILURES:
+        priv->allocation_failures = g_value_get_int(value);
+        break;
+      case PROP_SHARD_LISTEN:
+        cut_run_context_set_shard_listen(CUT_RUN_CONTEXT(object),
+                                         g_value_get_string(value));
+        break;
+      case PROP_SHARD_CONNECT:
+        cut_run_context_set_shard_connect(CUT_RUN_CONTEXT(object),
+                                          g_value_get_string(value));
+        break;
       default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
         break;
@@ -1193,9 +1561,15 @@ get_property (GObject    *object,
       case PROP_IS_MULTI_THREAD:
         g_value_set_boolean(value, priv->is_multi_thread);
         break;
+      case PROP_SPLIT_TEST_CASES:
+        g_value_set_boolean(value, priv->split_test_cases);
+        break;
       case PROP_MAX_THREADS:
         g_value_set_int(value, priv->max_threads);
         break;
+      case PROP_N_PROCESSES:
+        g_value_set_int(value, priv->n_processes);
+        break;
       case PROP_HANDLE_SIGNALS:
         g_value_set_boolean(value, priv->handle_signals);
         break;
@@ -1238,6 +1612,51 @@ get_property (GObject    *object,
       case PROP_STOP_BEFORE_TEST:
         g_value_set_boolean(value, priv->stop_before_test);
         break;
+      case PROP_SYMBOL_CACHE_DIRECTORY:
+        g_value_set_string(value, priv->symbol_cache_directory);
+        break;
+      case PROP_BATCH_PASS_ASSERTIONS:
+        g_value_set_boolean(value, priv->batch_pass_assertions);
+        break;
+      case PROP_RESULT_RETENTION:
+        g_value_set_enum(value, priv->result_retention);
+        break;
+      case PROP_UPDATE_TIMING_HISTORY:
+        g_value_set_boolean(value, priv->update_timing_history);
+        break;
+      case PROP_TIMEOUT:
+        g_value_set_double(value, priv->timeout);
+        break;
+      case PROP_BENCHMARK_TIME:
+        g_value_set_double(value, priv->benchmark_time);
+        break;
+      case PROP_SAVE_BASELINE:
+        g_value_set_string(value, priv->save_baseline_filename);
+        break;
+      case PROP_COMPARE_BASELINE:
+        g_value_set_string(value, priv->compare_baseline_filename);
+        break;
+      case PROP_REGRESSION_THRESHOLD:
+        g_value_set_double(value, priv->regression_threshold);
+        break;
+      case PROP_FAIL_ON_REGRESSION:
+        g_value_set_boolean(value, priv->fail_on_regression);
+        break;
+      case PROP_PERFORMANCE_COUNTERS:
+        g_value_set_boolean(value, priv->performance_counters);
+        break;
+      case PROP_MEMORY_USAGE:
+        g_value_set_boolean(value, priv->memory_usage);
+        break;
+      case PROP_ALLOCATION_FAILURES:
+        g_value_set_int(value, priv->allocation_failures);
+        break;
+      case PROP_SHARD_LISTEN:
+        g_value_set_string(value, priv->shard_listen);
+        break;
+      case PROP_SHARD_CONNECT:
+        g_value_set_string(value, priv->shard_connect);
+        break;
       default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
         break;
@@ -1314,13 +1733,138 @@ pass_assertion (CutRunContext   *context,
 }
 
 static void
-register_success_result (CutRunContext *context, CutTestResult *result)
+pass_assertions (CutRunContext   *context,
+                 CutTest         *test,
+                 CutTestContext  *test_context,
+                 guint            n_assertions)
 {
     CutRunContextPrivate *priv;
 
     priv = CUT_RUN_CONTEXT_GET_PRIVATE(context);
     g_mutex_lock(priv->mutex);
+    priv->n_assertions += n_assertions;
+    g_mutex_unlock(priv->mutex);
+}
+
+/* Must be called with priv->mutex locked. Results that aren't
+ * retained are only counted. Listeners have already received
+ * them by signals. Non-success results are kept while a listener
+ * that reports them on completion holds them. */
+static void
+retain_result (CutRunContextPrivate *priv, CutTestResult *result)
+{
+    switch (priv->result_retention) {
+      case CUT_RESULT_RETENTION_NONE:
+        if (g_atomic_int_get(&(priv->n_non_success_result_holders)) == 0)
+            return;
+        if (cut_test_result_get_status(result) == CUT_TEST_RESULT_SUCCESS)
+            return;
+        break;
+      case CUT_RESULT_RETENTION_NON_SUCCESS:
+        if (cut_test_result_get_status(result) == CUT_TEST_RESULT_SUCCESS)
+            return;
+        break;
+      default:
+        break;
+    }
+
     priv->results = g_list_prepend(priv->results, g_object_ref(result));
+}
+
+/* Must be called with priv->mutex locked. */
+static CutRunHistory *
+get_run_history (CutRunContextPrivate *priv)
+{
+    gchar *directory;
+    GError *error = NULL;
+
+    if (priv->run_history || priv->run_history_broken)
+        return priv->run_history;
+
+    if (!priv->symbol_cache_directory || !priv->symbol_cache_directory[0])
+        return NULL;
+    if (!priv->test_directory)
+        return NULL;
+
+    directory = cut_run_history_build_directory(priv->symbol_cache_directory,
+                                                priv->test_directory);
+    priv->run_history = cut_run_history_new(directory);
+    g_free(directory);
+    if (!cut_run_history_load(priv->run_history, &error)) {
+        /* Appending to a history that isn't loaded breaks it. */
+        cut_log_warning("[run-context][run-history][load][fail] <%s>: %s",
+                        cut_run_history_get_directory(priv->run_history),
+                        error->message);
+        g_error_free(error);
+        cut_run_history_free(priv->run_history);
+        priv->run_history = NULL;
+        priv->run_history_broken = TRUE;
+    }
+
+    return priv->run_history;
+}
+
+/* Tests are identified by names because a stream reader creates
+ * new test objects for each event. */
+static gchar *
+build_run_history_status_key (const gchar *test_case_name,
+                              const gchar *test_name)
+{
+    return g_strconcat(test_case_name ? test_case_name : "", "\t",
+                       test_name, NULL);
+}
+
+/*
+ * A test may emit some results. We keep the worst status of them
+ * and record it with the final elapsed time on complete-test.
+ *
+ * Must be called with priv->mutex locked.
+ */
+static void
+update_run_history_status (CutRunContextPrivate *priv, CutTestResult *result)
+{
+    CutTest *test;
+    CutTestResultStatus status;
+    const gchar *test_name;
+    gchar *key;
+    gpointer value;
+
+    if (!priv->update_timing_history)
+        return;
+
+    /* A result of a test case itself isn't a result of a test. */
+    test = cut_test_result_get_test(result);
+    test_name = cut_test_result_get_test_name(result);
+    if (!test || !test_name)
+        return;
+
+    /* An iterated test shares its name with other data. */
+    if (CUT_IS_ITERATED_TEST(test))
+        return;
+
+    status = cut_test_result_get_status(result);
+    key = build_run_history_status_key(cut_test_result_get_test_case_name(result),
+                                       test_name);
+    if (g_hash_table_lookup_extended(priv->run_history_statuses, key,
+                                     NULL, &value) &&
+        (CutTestResultStatus)GPOINTER_TO_INT(value) >= status) {
+        g_free(key);
+        return;
+    }
+
+    g_hash_table_insert(priv->run_history_statuses,
+                        key, GINT_TO_POINTER(status));
+}
+
+static void
+register_success_result (CutRunContext *context, CutTestResult *result)
+{
+    CutRunContextPrivate *priv;
+
+    priv = CUT_RUN_CONTEXT_GET_PRIVATE(context);
+    g_mutex_lock(priv->mutex);
+    retain_result(priv, result);
+    update_run_history_status(priv, result);
     priv->n_successes++;
     g_mutex_unlock(priv->mutex);
 }
@@ -1331,7 +1875,8 @@ register_failure_result (CutRunContext *context, CutTestResult *result)
     CutRunContextPrivate *priv = CUT_RUN_CONTEXT_GET_PRIVATE(context);
 
     g_mutex_lock(priv->mutex);
-    priv->results = g_list_prepend(priv->results, g_object_ref(result));
+    retain_result(priv, result);
+    update_run_history_status(priv, result);
     priv->n_failures++;
     g_mutex_unlock(priv->mutex);
 }
@@ -1343,7 +1888,8 @@ register_error_result (CutRunContext *context, CutTestResult *result)
 
     priv = CUT_RUN_CONTEXT_GET_PRIVATE(context);
     g_mutex_lock(priv->mutex);
-    priv->results = g_list_prepend(priv->results, g_object_ref(result));
+    retain_result(priv, result);
+    update_run_history_status(priv, result);
     priv->n_errors++;
     g_mutex_unlock(priv->mutex);
 }
@@ -1355,7 +1901,8 @@ register_pending_result (CutRunContext *context, CutTestResult *result)
 
     priv = CUT_RUN_CONTEXT_GET_PRIVATE(context);
     g_mutex_lock(priv->mutex);
-    priv->results = g_list_prepend(priv->results, g_object_ref(result));
+    retain_result(priv, result);
+    update_run_history_status(priv, result);
     priv->n_pendings++;
     g_mutex_unlock(priv->mutex);
 }
@@ -1367,7 +1914,8 @@ register_notification_result (CutRunContext  *context, CutTestResult *result)
 
     priv = CUT_RUN_CONTEXT_GET_PRIVATE(context);
     g_mutex_lock(priv->mutex);
-    priv->results = g_list_prepend(priv->results, g_object_ref(result));
+    retain_result(priv, result);
+    update_run_history_status(priv, result);
     priv->n_notifications++;
     g_mutex_unlock(priv->mutex);
 }
@@ -1379,7 +1927,8 @@ register_omission_result (CutRunContext *context, CutTestResult *result)
 
     priv = CUT_RUN_CONTEXT_GET_PRIVATE(context);
     g_mutex_lock(priv->mutex);
-    priv->results = g_list_prepend(priv->results, g_object_ref(result));
+    retain_result(priv, result);
+    update_run_history_status(priv, result);
     priv->n_omissions++;
     g_mutex_unlock(priv->mutex);
 }
@@ -1392,7 +1941,8 @@ register_crash_result (CutRunContext *context, CutTestResult *result)
     priv = CUT_RUN_CONTEXT_GET_PRIVATE(context);
     priv->crashed = TRUE;
     g_mutex_lock(priv->mutex);
-    priv->results = g_list_prepend(priv->results, g_object_ref(result));
+    retain_result(priv, result);
+    update_run_history_status(priv, result);
     g_mutex_unlock(priv->mutex);
 }
 
@@ -1515,6 +2065,136 @@ crash_test_suite (CutRunContext   *context,
     register_crash_result(context, result);
 }
 
+/* Must be called with priv->mutex locked. */
+static CutTimingHistory *
+get_timing_history (CutRunContextPrivate *priv)
+{
+    gchar *filename;
+    GError *error = NULL;
+
+    if (priv->timing_history)
+        return priv->timing_history;
+
+    if (!priv->symbol_cache_directory || !priv->symbol_cache_directory[0])
+        return NULL;
+    if (!priv->test_directory)
+        return NULL;
+
+    filename = cut_timing_history_build_filename(priv->symbol_cache_directory,
+                                                 priv->test_directory);
+    priv->timing_history = cut_timing_history_new(filename);
+    g_free(filename);
+    if (!cut_timing_history_load(priv->timing_history, &error)) {
+        cut_log_warning("[run-context][timing-history][load][fail] <%s>: %s",
+                        cut_timing_history_get_filename(priv->timing_history),
+                        error->message);
+        g_error_free(error);
+    }
+
+    return priv->timing_history;
+}
+
+static void
+record_test_elapsed (CutRunContext *context, CutTest *test,
+                     CutTestContext *test_context)
+{
+    CutRunContextPrivate *priv;
+    CutTestCase *test_case;
+    CutTimingHistory *history;
+
+    priv = CUT_RUN_CONTEXT_GET_PRIVATE(context);
+    if (!priv->update_timing_history)
+        return;
+
+    if (!test_context)
+        return;
+    test_case = cut_test_context_get_test_case(test_context);
+    if (!test_case)
+        return;
+
+    g_mutex_lock(priv->mutex);
+    history = get_timing_history(priv);
+    if (history) {
+        cut_timing_history_record_test(history,
+                                       cut_test_get_name(CUT_TEST(test_case)),
+                                       cut_test_get_name(test),
+                                       cut_test_get_elapsed(test));
+        priv->timing_history_updated = TRUE;
+    }
+    g_mutex_unlock(priv->mutex);
+}
+
+/* Must be called with priv->mutex locked. */
+static CutBaseline *
+get_saving_baseline (CutRunContextPrivate *priv)
+{
+    if (!priv->saving_baseline)
+        priv->saving_baseline = cut_baseline_new(priv->save_baseline_filename);
+
+    return priv->saving_baseline;
+}
+
+static void
+record_baseline_test (CutRunContext *context, CutTest *test,
+                      CutTestContext *test_context)
+{
+    CutRunContextPrivate *priv;
+    CutTestCase *test_case;
+    CutBaseline *baseline;
+    const gchar *test_case_name, *test_name;
+
+    priv = CUT_RUN_CONTEXT_GET_PRIVATE(context);
+    if (!priv->save_baseline_filename)
+        return;
+
+    if (!test_context)
+        return;
+    test_case = cut_test_context_get_test_case(test_context);
+    if (!test_case)
+        return;
+
+    test_case_name = cut_test_get_name(CUT_TEST(test_case));
+    test_name = cut_test_get_name(test);
+    g_mutex_lock(priv->mutex);
+    baseline = get_saving_baseline(priv);
+    /* The elapsed time of a benchmark is decided by the
+     * benchmark time. Its statistics are compared instead. */
+    if (!cut_baseline_has_benchmark(baseline, test_case_name, test_name)) {
+        cut_baseline_record_test(baseline, test_case_name, test_name,
+                                 cut_test_get_elapsed(test));
+        priv->baseline_updated = TRUE;
+    }
+    g_mutex_unlock(priv->mutex);
+}
+
+static void
+benchmark_test (CutRunContext      *context,
+                CutTest            *test,
+                CutTestContext     *test_context,
+                CutBenchmarkResult *result)
+{
+    CutRunContextPrivate *priv;
+    CutTestCase *test_case;
+
+    priv = CUT_RUN_CONTEXT_GET_PRIVATE(context);
+    if (!priv->save_baseline_filename)
+        return;
+
+    if (!test_context)
+        return;
+    test_case = cut_test_context_get_test_case(test_context);
+    if (!test_case)
+        return;
+
+    g_mutex_lock(priv->mutex);
+    cut_baseline_record_benchmark(get_saving_baseline(priv),
+                                  cut_test_get_name(CUT_TEST(test_case)),
+                                  cut_test_get_name(test),
+                                  result);
+    priv->baseline_updated = TRUE;
+    g_mutex_unlock(priv->mutex);
+}
+
 static void
 complete_iterated_test (CutRunContext   *context,
                         CutIteratedTest *iterated_test,
@@ -1529,6 +2209,51 @@ complete_iterated_test (CutRunContext   *context,
     g_mutex_unlock(priv->mutex);
 }
 
+static void
+record_run_history (CutRunContext *context, CutTest *test,
+                    CutTestContext *test_context, gboolean success)
+{
+    CutRunContextPrivate *priv;
+    CutTestCase *test_case = NULL;
+    CutRunHistory *history;
+    CutTestResultStatus status;
+    const gchar *test_case_name = NULL;
+    gchar *key;
+    gpointer value;
+
+    priv = CUT_RUN_CONTEXT_GET_PRIVATE(context);
+    if (!priv->update_timing_history || CUT_IS_ITERATED_TEST(test))
+        return;
+
+    if (test_context)
+        test_case = cut_test_context_get_test_case(test_context);
+    if (test_case)
+        test_case_name = cut_test_get_name(CUT_TEST(test_case));
+
+    key = build_run_history_status_key(test_case_name,
+                                       cut_test_get_name(test));
+    g_mutex_lock(priv->mutex);
+    if (g_hash_table_lookup_extended(priv->run_history_statuses, key,
+                                     NULL, &value)) {
+        status = GPOINTER_TO_INT(value);
+        g_hash_table_remove(priv->run_history_statuses, key);
+    } else {
+        status = success ? CUT_TEST_RESULT_SUCCESS : CUT_TEST_RESULT_FAILURE;
+    }
+    g_free(key);
+
+    history = get_run_history(priv);
+    if (history) {
+        cut_run_history_record(history,
+                               test_case_name,
+                               cut_test_get_name(test),
+                               status,
+                               cut_test_get_elapsed(test));
+        priv->run_history_updated = TRUE;
+    }
+    g_mutex_unlock(priv->mutex);
+}
+
 static void
 complete_test (CutRunContext   *context,
                CutTest         *test,
@@ -1541,6 +2266,35 @@ complete_test (CutRunContext   *context,
     g_mutex_lock(priv->mutex);
     priv->elapsed += cut_test_get_elapsed(test);
     g_mutex_unlock(priv->mutex);
+
+    record_test_elapsed(context, test, test_context);
+    record_run_history(context, test, test_context, success);
+    /* A slow failure isn't a good baseline. */
+    if (success)
+        record_baseline_test(context, test, test_context);
+}
+
+static void
+complete_test_case (CutRunContext   *context,
+                    CutTestCase     *test_case,
+                    gboolean         success)
+{
+    CutRunContextPrivate *priv;
+    CutTimingHistory *history;
+
+    priv = CUT_RUN_CONTEXT_GET_PRIVATE(context);
+    if (!priv->update_timing_history)
+        return;
+
+    g_mutex_lock(priv->mutex);
+    history = get_timing_history(priv);
+    if (history) {
+        cut_timing_history_record_test_case(history,
+                                            cut_test_get_name(CUT_TEST(test_case)),
+                                            cut_test_get_elapsed(CUT_TEST(test_case)));
+        priv->timing_history_updated = TRUE;
+    }
+    g_mutex_unlock(priv->mutex);
 }
 
 static void
@@ -1553,6 +2307,46 @@ complete_run (CutRunContext *context, gboolean success)
     if (priv->timer)
         g_timer_stop(priv->timer);
     priv->completed = TRUE;
+    if (priv->timing_history_updated) {
+        GError *error = NULL;
+
+        if (!cut_timing_history_save(priv->timing_history, &error)) {
+            cut_log_warning("[run-context][timing-history][save][fail] "
+                            "<%s>: %s",
+                            cut_timing_history_get_filename(priv->timing_history),
+                            error->message);
+            g_error_free(error);
+        }
+        priv->timing_history_updated = FALSE;
+    }
+    if (priv->run_history_updated) {
+        GError *error = NULL;
+
+        if (!cut_run_history_append_run(priv->run_history,
+                                        g_get_real_time() / G_USEC_PER_SEC,
+                                        &error)) {
+            cut_log_warning("[run-context][run-history][append][fail] "
+                            "<%s>: %s",
+                            cut_run_history_get_directory(priv->run_history),
+                            error->message);
+            g_error_free(error);
+        }
+        priv->run_history_updated = FALSE;
+    }
+    /* Statuses of tests that aren't completed, e.g. a canceled
+     * test, aren't needed any more. */
+    g_hash_table_remove_all(priv->run_history_statuses);
+    if (priv->baseline_updated) {
+        GError *error = NULL;
+
+        if (!cut_baseline_save(priv->saving_baseline, &error)) {
+            cut_log_warning("[run-context][baseline][save][fail] <%s>: %s",
+                            cut_baseline_get_filename(priv->saving_baseline),
+                            error->message);
+            g_error_free(error);
+        }
+        priv->baseline_updated = FALSE;
+    }
     g_mutex_unlock(priv->mutex);
 }
 
@@ -1630,6 +2424,19 @@ cut_run_context_is_multi_thread (CutRunContext *context)
     return CUT_RUN_CONTEXT_GET_PRIVATE(context)->is_multi_thread;
 }
 
+void
+cut_run_context_set_split_test_cases (CutRunContext *context,
+                                      gboolean split_test_cases)
+{
+    CUT_RUN_CONTEXT_GET_PRIVATE(context)->split_test_cases = split_test_cases;
+}
+
+gboolean
+cut_run_context_get_split_test_cases (CutRunContext *context)
+{
+    return CUT_RUN_CONTEXT_GET_PRIVATE(context)->split_test_cases;
+}
+
 void
 cut_run_context_set_max_threads (CutRunContext *context, gint max_threads)
 {
@@ -1644,6 +2451,20 @@ cut_run_context_get_max_threads (CutRunContext *context)
     return CUT_RUN_CONTEXT_GET_PRIVATE(context)->max_threads;
 }
 
+void
+cut_run_context_set_n_processes (CutRunContext *context, gint n_processes)
+{
+    CutRunContextPrivate *priv = CUT_RUN_CONTEXT_GET_PRIVATE(context);
+
+    priv->n_processes = n_processes;
+}
+
+gint
+cut_run_context_get_n_processes (CutRunContext *context)
+{
+    return CUT_RUN_CONTEXT_GET_PRIVATE(context)->n_processes;
+}
+
 void
 cut_run_context_set_handle_signals (CutRunContext *context,
                                     gboolean handle_signals)
@@ -1884,6 +2705,9 @@ cut_run_context_create_test_suite (CutRunContext *context)
                                             priv->keep_opening_modules);
     cut_repository_set_enable_convenience_attribute_definition(repository,
                                                                priv->enable_convenience_attribute_definition);
+    cut_repository_set_symbol_cache_directory(repository,
+                                              priv->symbol_cache_directory);
+    cut_repository_set_max_threads(repository, priv->max_threads);
     exclude_files = (const gchar **)priv->exclude_files;
     cut_repository_set_exclude_files(repository, exclude_files);
     exclude_directories = (const gchar **)priv->exclude_directories;
@@ -2023,6 +2847,58 @@ compare_test_cases_by_name (gconstpointer a, gconstpointer b, gpointer user_data
         return strcmp(test_case_name2, test_case_name1);
 }
 
+static gint
+compare_test_cases_by_duration (gconstpointer a, gconstpointer b,
+                                gpointer user_data)
+{
+    CutTimingHistory *history = user_data;
+    const gchar *test_case_name1, *test_case_name2;
+    gdouble elapsed1, elapsed2;
+
+    test_case_name1 = cut_test_get_name(CUT_TEST(a));
+    test_case_name2 = cut_test_get_name(CUT_TEST(b));
+    elapsed1 = cut_timing_history_get_test_case_elapsed(history,
+                                                        test_case_name1);
+    elapsed2 = cut_timing_history_get_test_case_elapsed(history,
+                                                        test_case_name2);
+
+    /* Unknown (never measured) test cases are run first because
+     * they may be the longest ones. */
+    if (elapsed1 < 0.0 && elapsed2 >= 0.0)
+        return -1;
+    if (elapsed1 >= 0.0 && elapsed2 < 0.0)
+        return 1;
+    if (elapsed1 > elapsed2)
+        return -1;
+    if (elapsed1 < elapsed2)
+        return 1;
+    return strcmp(test_case_name1, test_case_name2);
+}
+
+static GList *
+sort_test_cases_by_duration (CutRunContextPrivate *priv, GList *test_cases)
+{
+    CutTimingHistory *history;
+    GList *sorted_test_cases;
+    gboolean ascending = TRUE;
+
+    g_mutex_lock(priv->mutex);
+    history = get_timing_history(priv);
+    if (history) {
+        sorted_test_cases =
+            g_list_sort_with_data(test_cases,
+                                  compare_test_cases_by_duration,
+                                  history);
+    } else {
+        sorted_test_cases = g_list_sort_with_data(test_cases,
+                                                  compare_test_cases_by_name,
+                                                  &ascending);
+    }
+    g_mutex_unlock(priv->mutex);
+
+    return sorted_test_cases;
+}
+
 GList *
 cut_run_context_sort_test_cases (CutRunContext *context, GList *test_cases)
 {
@@ -2047,6 +2923,9 @@ cut_run_context_sort_test_cases (CutRunContext *context, GList *test_cases)
                                                   compare_test_cases_by_name,
                                                   &ascending);
         break;
+      case CUT_ORDER_DURATION_DESCENDING:
+        sorted_test_cases = sort_test_cases_by_duration(priv, test_cases);
+        break;
     }
 
     return sorted_test_cases;
@@ -2221,6 +3100,18 @@ cb_delegate_pass_assertion (CutRunContext *context,
                   test, test_context);
 }
 
+static void
+cb_delegate_pass_assertions (CutRunContext *context,
+                             CutTest *test,
+                             CutTestContext *test_context,
+                             guint n_assertions,
+                             gpointer user_data)
+{
+    CutRunContext *other_context = user_data;
+    g_signal_emit(other_context, signals[PASS_ASSERTIONS], detail_delegate,
+                  test, test_context, n_assertions);
+}
+
 static void
 cb_delegate_success_test (CutRunContext *context,
                           CutTest *test,
@@ -2305,6 +3196,18 @@ cb_delegate_crash_test (CutRunContext *context,
                   test, test_context, result);
 }
 
+static void
+cb_delegate_benchmark_test (CutRunContext *context,
+                            CutTest *test,
+                            CutTestContext *test_context,
+                            CutBenchmarkResult *result,
+                            gpointer user_data)
+{
+    CutRunContext *other_context = user_data;
+    g_signal_emit(other_context, signals[BENCHMARK_TEST], detail_delegate,
+                  test, test_context, result);
+}
+
 
 static void
 cb_delegate_complete_test (CutRunContext *context,
@@ -2539,6 +3442,7 @@ cb_delegate_complete_run (CutRunContext *context, gboolean success,
     DISCONNECT_DELEGATE_SIGNAL(start_iterated_test);
 
     DISCONNECT_DELEGATE_SIGNAL(pass_assertion);
+    DISCONNECT_DELEGATE_SIGNAL(pass_assertions);
     DISCONNECT_DELEGATE_SIGNAL(success_test);
     DISCONNECT_DELEGATE_SIGNAL(failure_test);
     DISCONNECT_DELEGATE_SIGNAL(error_test);
@@ -2546,6 +3450,7 @@ cb_delegate_complete_run (CutRunContext *context, gboolean success,
     DISCONNECT_DELEGATE_SIGNAL(notification_test);
     DISCONNECT_DELEGATE_SIGNAL(omission_test);
     DISCONNECT_DELEGATE_SIGNAL(crash_test);
+    DISCONNECT_DELEGATE_SIGNAL(benchmark_test);
 
     DISCONNECT_DELEGATE_SIGNAL(complete_test);
     DISCONNECT_DELEGATE_SIGNAL(complete_iterated_test);
@@ -2596,6 +3501,7 @@ cut_run_context_delegate_signals (CutRunContext *context,
     CONNECT_DELEGATE_SIGNAL(start_iterated_test);
 
     CONNECT_DELEGATE_SIGNAL(pass_assertion);
+    CONNECT_DELEGATE_SIGNAL(pass_assertions);
     CONNECT_DELEGATE_SIGNAL(success_test);
     CONNECT_DELEGATE_SIGNAL(failure_test);
     CONNECT_DELEGATE_SIGNAL(error_test);
@@ -2603,6 +3509,7 @@ cut_run_context_delegate_signals (CutRunContext *context,
     CONNECT_DELEGATE_SIGNAL(notification_test);
     CONNECT_DELEGATE_SIGNAL(omission_test);
     CONNECT_DELEGATE_SIGNAL(crash_test);
+    CONNECT_DELEGATE_SIGNAL(benchmark_test);
 
     CONNECT_DELEGATE_SIGNAL(complete_test);
     CONNECT_DELEGATE_SIGNAL(complete_iterated_test);
@@ -2677,6 +3584,22 @@ cut_run_context_get_enable_convenience_attribute_definition (CutRunContext *cont
     return CUT_RUN_CONTEXT_GET_PRIVATE(context)->enable_convenience_attribute_definition;
 }
 
+void
+cut_run_context_set_symbol_cache_directory (CutRunContext *context,
+                                            const gchar   *directory)
+{
+    CutRunContextPrivate *priv = CUT_RUN_CONTEXT_GET_PRIVATE(context);
+
+    g_free(priv->symbol_cache_directory);
+    priv->symbol_cache_directory = g_strdup(directory);
+}
+
+const gchar *
+cut_run_context_get_symbol_cache_directory (CutRunContext *context)
+{
+    return CUT_RUN_CONTEXT_GET_PRIVATE(context)->symbol_cache_directory;
+}
+
 void
 cut_run_context_set_stop_before_test (CutRunContext *context,
                                       gboolean       stop)
@@ -2690,6 +3613,371 @@ cut_run_context_get_stop_before_test (CutRunContext *context)
     return CUT_RUN_CONTEXT_GET_PRIVATE(context)->stop_before_test;
 }
 
+void
+cut_run_context_set_batch_pass_assertions (CutRunContext *context,
+                                           gboolean       batch)
+{
+    CUT_RUN_CONTEXT_GET_PRIVATE(context)->batch_pass_assertions = batch;
+}
+
+gboolean
+cut_run_context_get_batch_pass_assertions (CutRunContext *context)
+{
+    return CUT_RUN_CONTEXT_GET_PRIVATE(context)->batch_pass_assertions;
+}
+
+void
+cut_run_context_hold_pass_assertion_events (CutRunContext *context)
+{
+    CutRunContextPrivate *priv = CUT_RUN_CONTEXT_GET_PRIVATE(context);
+
+    g_atomic_int_inc(&(priv->n_pass_assertion_event_holders));
+}
+
+void
+cut_run_context_release_pass_assertion_events (CutRunContext *context)
+{
+    CutRunContextPrivate *priv = CUT_RUN_CONTEXT_GET_PRIVATE(context);
+
+    g_atomic_int_add(&(priv->n_pass_assertion_event_holders), -1);
+}
+
+gboolean
+cut_run_context_need_pass_assertion_events (CutRunContext *context)
+{
+    CutRunContextPrivate *priv = CUT_RUN_CONTEXT_GET_PRIVATE(context);
+
+    if (!priv->batch_pass_assertions)
+        return TRUE;
+    return g_atomic_int_get(&(priv->n_pass_assertion_event_holders)) > 0;
+}
+
+void
+cut_run_context_set_result_retention (CutRunContext      *context,
+                                      CutResultRetention  retention)
+{
+    CUT_RUN_CONTEXT_GET_PRIVATE(context)->result_retention = retention;
+}
+
+CutResultRetention
+cut_run_context_get_result_retention (CutRunContext *context)
+{
+    return CUT_RUN_CONTEXT_GET_PRIVATE(context)->result_retention;
+}
+
+void
+cut_run_context_hold_non_success_results (CutRunContext *context)
+{
+    CutRunContextPrivate *priv = CUT_RUN_CONTEXT_GET_PRIVATE(context);
+
+    g_atomic_int_inc(&(priv->n_non_success_result_holders));
+}
+
+void
+cut_run_context_release_non_success_results (CutRunContext *context)
+{
+    CutRunContextPrivate *priv = CUT_RUN_CONTEXT_GET_PRIVATE(context);
+
+    g_atomic_int_add(&(priv->n_non_success_result_holders), -1);
+}
+
+void
+cut_run_context_set_update_timing_history (CutRunContext *context,
+                                           gboolean       update)
+{
+    CUT_RUN_CONTEXT_GET_PRIVATE(context)->update_timing_history = update;
+}
+
+gboolean
+cut_run_context_get_update_timing_history (CutRunContext *context)
+{
+    return CUT_RUN_CONTEXT_GET_PRIVATE(context)->update_timing_history;
+}
+
+void
+cut_run_context_set_timeout (CutRunContext *context, gdouble timeout)
+{
+    CUT_RUN_CONTEXT_GET_PRIVATE(context)->timeout = timeout;
+}
+
+gdouble
+cut_run_context_get_timeout (CutRunContext *context)
+{
+    return CUT_RUN_CONTEXT_GET_PRIVATE(context)->timeout;
+}
+
+gdouble
+cut_run_context_get_test_timeout (CutRunContext *context, CutTest *test,
+                                  CutTestIterator *test_iterator)
+{
+    gdouble timeout;
+
+    timeout = cut_test_get_timeout(test);
+    if (timeout < 0.0 && test_iterator)
+        timeout = cut_test_get_timeout(CUT_TEST(test_iterator));
+    if (timeout < 0.0)
+        timeout = CUT_RUN_CONTEXT_GET_PRIVATE(context)->timeout;
+
+    return timeout;
+}
+
+void
+cut_run_context_set_benchmark_time (CutRunContext *context, gdouble time)
+{
+    CUT_RUN_CONTEXT_GET_PRIVATE(context)->benchmark_time = time;
+}
+
+gdouble
+cut_run_context_get_benchmark_time (CutRunContext *context)
+{
+    return CUT_RUN_CONTEXT_GET_PRIVATE(context)->benchmark_time;
+}
+
+void
+cut_run_context_set_save_baseline (CutRunContext *context,
+                                   const gchar   *filename)
+{
+    CutRunContextPrivate *priv = CUT_RUN_CONTEXT_GET_PRIVATE(context);
+
+    g_free(priv->save_baseline_filename);
+    priv->save_baseline_filename = g_strdup(filename);
+    if (priv->saving_baseline) {
+        cut_baseline_free(priv->saving_baseline);
+        priv->saving_baseline = NULL;
+    }
+    priv->baseline_updated = FALSE;
+}
+
+const gchar *
+cut_run_context_get_save_baseline (CutRunContext *context)
+{
+    return CUT_RUN_CONTEXT_GET_PRIVATE(context)->save_baseline_filename;
+}
+
+void
+cut_run_context_set_compare_baseline (CutRunContext *context,
+                                      const gchar   *filename)
+{
+    CutRunContextPrivate *priv = CUT_RUN_CONTEXT_GET_PRIVATE(context);
+
+    g_free(priv->compare_baseline_filename);
+    priv->compare_baseline_filename = g_strdup(filename);
+    if (priv->comparing_baseline) {
+        cut_baseline_free(priv->comparing_baseline);
+        priv->comparing_baseline = NULL;
+    }
+    priv->comparing_baseline_loaded = FALSE;
+}
+
+const gchar *
+cut_run_context_get_compare_baseline (CutRunContext *context)
+{
+    return CUT_RUN_CONTEXT_GET_PRIVATE(context)->compare_baseline_filename;
+}
+
+void
+cut_run_context_set_regression_threshold (CutRunContext *context,
+                                          gdouble        threshold)
+{
+    CUT_RUN_CONTEXT_GET_PRIVATE(context)->regression_threshold = threshold;
+}
+
+gdouble
+cut_run_context_get_regression_threshold (CutRunContext *context)
+{
+    return CUT_RUN_CONTEXT_GET_PRIVATE(context)->regression_threshold;
+}
+
+void
+cut_run_context_set_fail_on_regression (CutRunContext *context,
+                                        gboolean       fail)
+{
+    CUT_RUN_CONTEXT_GET_PRIVATE(context)->fail_on_regression = fail;
+}
+
+gboolean
+cut_run_context_get_fail_on_regression (CutRunContext *context)
+{
+    return CUT_RUN_CONTEXT_GET_PRIVATE(context)->fail_on_regression;
+}
+
+void
+cut_run_context_set_performance_counters (CutRunContext *context,
+                                          gboolean       measure)
+{
+    CUT_RUN_CONTEXT_GET_PRIVATE(context)->performance_counters = measure;
+}
+
+gboolean
+cut_run_context_get_performance_counters (CutRunContext *context)
+{
+    return CUT_RUN_CONTEXT_GET_PRIVATE(context)->performance_counters;
+}
+
+void
+cut_run_context_set_memory_usage (CutRunContext *context, gboolean measure)
+{
+    CUT_RUN_CONTEXT_GET_PRIVATE(context)->memory_usage = measure;
+}
+
+gboolean
+cut_run_context_get_memory_usage (CutRunContext *context)
+{
+    return CUT_RUN_CONTEXT_GET_PRIVATE(context)->memory_usage;
+}
+
+void
+cut_run_context_set_allocation_failures (CutRunContext *context,
+                                         gint           max_allocations)
+{
+    CUT_RUN_CONTEXT_GET_PRIVATE(context)->allocation_failures = max_allocations;
+}
+
+gint
+cut_run_context_get_allocation_failures (CutRunContext *context)
+{
+    return CUT_RUN_CONTEXT_GET_PRIVATE(context)->allocation_failures;
+}
+
+void
+cut_run_context_set_shard_listen (CutRunContext *context,
+                                  const gchar   *address)
+{
+    CutRunContextPrivate *priv = CUT_RUN_CONTEXT_GET_PRIVATE(context);
+
+    g_free(priv->shard_listen);
+    priv->shard_listen = g_strdup(address);
+}
+
+const gchar *
+cut_run_context_get_shard_listen (CutRunContext *context)
+{
+    return CUT_RUN_CONTEXT_GET_PRIVATE(context)->shard_listen;
+}
+
+void
+cut_run_context_set_shard_connect (CutRunContext *context,
+                                   const gchar   *address)
+{
+    CutRunContextPrivate *priv = CUT_RUN_CONTEXT_GET_PRIVATE(context);
+
+    g_free(priv->shard_connect);
+    priv->shard_connect = g_strdup(address);
+}
+
+const gchar *
+cut_run_context_get_shard_connect (CutRunContext *context)
+{
+    return CUT_RUN_CONTEXT_GET_PRIVATE(context)->shard_connect;
+}
+
+/* Must be called with priv->mutex locked. */
+static CutBaseline *
+get_comparing_baseline (CutRunContextPrivate *priv)
+{
+    GError *error = NULL;
+
+    if (priv->comparing_baseline_loaded)
+        return priv->comparing_baseline;
+    priv->comparing_baseline_loaded = TRUE;
+
+    priv->comparing_baseline =
+        cut_baseline_new(priv->compare_baseline_filename);
+    if (!cut_baseline_load(priv->comparing_baseline, &error)) {
+        cut_log_warning("[run-context][baseline][load][fail] <%s>: %s",
+                        priv->compare_baseline_filename,
+                        error->message);
+        g_error_free(error);
+        cut_baseline_free(priv->comparing_baseline);
+        priv->comparing_baseline = NULL;
+    }
+
+    return priv->comparing_baseline;
+}
+
+gchar *
+cut_run_context_check_test_regression (CutRunContext  *context,
+                                       CutTest        *test,
+                                       CutTestContext *test_context,
+                                       gdouble         elapsed)
+{
+    CutRunContextPrivate *priv;
+    CutTestCase *test_case;
+    CutBaseline *baseline;
+    gdouble baseline_elapsed = -1.0;
+
+    priv = CUT_RUN_CONTEXT_GET_PRIVATE(context);
+    if (!priv->compare_baseline_filename)
+        return NULL;
+
+    test_case = cut_test_context_get_test_case(test_context);
+    if (!test_case)
+        return NULL;
+
+    g_mutex_lock(priv->mutex);
+    baseline = get_comparing_baseline(priv);
+    if (baseline)
+        baseline_elapsed =
+            cut_baseline_get_test_elapsed(baseline,
+                                          cut_test_get_name(CUT_TEST(test_case)),
+                                          cut_test_get_name(test));
+    g_mutex_unlock(priv->mutex);
+
+    if (!cut_baseline_is_regressed_test(baseline_elapsed, elapsed,
+                                        priv->regression_threshold))
+        return NULL;
+
+    return g_strdup_printf("performance regression: "
+                           "%gs -> %gs (threshold: %g%%)",
+                           baseline_elapsed, elapsed,
+                           priv->regression_threshold);
+}
+
+gchar *
+cut_run_context_check_benchmark_regression (CutRunContext      *context,
+                                            CutTest            *test,
+                                            CutTestContext     *test_context,
+                                            CutBenchmarkResult *result)
+{
+    CutRunContextPrivate *priv;
+    CutTestCase *test_case;
+    CutBaseline *baseline;
+    CutBenchmarkResult *baseline_result = NULL;
+    gchar *message = NULL;
+
+    priv = CUT_RUN_CONTEXT_GET_PRIVATE(context);
+    if (!priv->compare_baseline_filename)
+        return NULL;
+
+    test_case = cut_test_context_get_test_case(test_context);
+    if (!test_case)
+        return NULL;
+
+    g_mutex_lock(priv->mutex);
+    baseline = get_comparing_baseline(priv);
+    if (baseline)
+        baseline_result =
+            cut_baseline_get_benchmark(baseline,
+                                       cut_test_get_name(CUT_TEST(test_case)),
+                                       cut_test_get_name(test));
+    g_mutex_unlock(priv->mutex);
+
+    if (!baseline_result)
+        return NULL;
+
+    if (cut_baseline_is_regressed_benchmark(baseline_result, result,
+                                            priv->regression_threshold))
+        message = g_strdup_printf("performance regression: "
+                                  "mean %gs -> %gs per call "
+                                  "(threshold: %g%%)",
+                                  cut_benchmark_result_get_mean(baseline_result),
+                                  cut_benchmark_result_get_mean(result),
+                                  priv->regression_threshold);
+    g_object_unref(baseline_result);
+
+    return message;
+}
+
 /*
 vi:ts=4:nowrap:ai:expandtab:sw=4
 */
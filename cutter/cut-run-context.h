@@ -39,9 +39,16 @@ G_BEGIN_DECLS
 typedef enum {
     CUT_ORDER_NONE_SPECIFIED,
     CUT_ORDER_NAME_ASCENDING,
-    CUT_ORDER_NAME_DESCENDING
+    CUT_ORDER_NAME_DESCENDING,
+    CUT_ORDER_DURATION_DESCENDING
 } CutOrder;
 
+typedef enum {
+    CUT_RESULT_RETENTION_ALL,
+    CUT_RESULT_RETENTION_NON_SUCCESS,
+    CUT_RESULT_RETENTION_NONE
+} CutResultRetention;
+
 typedef struct _CutRunContextClass    CutRunContextClass;
 
 struct _CutRunContext
@@ -80,6 +87,10 @@ struct _CutRunContextClass
     void (*pass_assertion)      (CutRunContext  *context,
                                  CutTest        *test,
                                  CutTestContext *test_context);
+    void (*pass_assertions)     (CutRunContext  *context,
+                                 CutTest        *test,
+                                 CutTestContext *test_context,
+                                 guint           n_assertions);
     void (*success_test)        (CutRunContext  *context,
                                  CutTest        *test,
                                  CutTestContext *test_context,
@@ -108,6 +119,10 @@ struct _CutRunContextClass
                                  CutTest        *test,
                                  CutTestContext *test_context,
                                  CutTestResult  *result);
+    void (*benchmark_test)      (CutRunContext  *context,
+                                 CutTest        *test,
+                                 CutTestContext *test_context,
+                                 CutBenchmarkResult *result);
     void (*complete_test)       (CutRunContext  *context,
                                  CutTest        *test,
                                  CutTestContext *test_context,
@@ -228,11 +243,18 @@ void           cut_run_context_set_multi_thread     (CutRunContext *context,
                                                      gboolean       use_multi_thread);
 gboolean       cut_run_context_get_multi_thread     (CutRunContext *context);
 gboolean       cut_run_context_is_multi_thread      (CutRunContext *context);
+void           cut_run_context_set_split_test_cases (CutRunContext *context,
+                                                     gboolean       split_test_cases);
+gboolean       cut_run_context_get_split_test_cases (CutRunContext *context);
 
 void           cut_run_context_set_max_threads      (CutRunContext *context,
                                                      gint           max_threads);
 gint           cut_run_context_get_max_threads      (CutRunContext *context);
 
+void           cut_run_context_set_n_processes      (CutRunContext *context,
+                                                     gint           n_processes);
+gint           cut_run_context_get_n_processes      (CutRunContext *context);
+
 void           cut_run_context_set_handle_signals   (CutRunContext *context,
                                                      gboolean       handle_signals);
 gboolean       cut_run_context_get_handle_signals   (CutRunContext *context);
@@ -331,11 +353,102 @@ void           cut_run_context_set_enable_convenience_attribute_definition
                                                      gboolean       enable_convenience_attribute_definition);
 gboolean       cut_run_context_get_enable_convenience_attribute_definition
                                                     (CutRunContext *context);
+void           cut_run_context_set_symbol_cache_directory
+                                                    (CutRunContext *context,
+                                                     const gchar   *directory);
+const gchar   *cut_run_context_get_symbol_cache_directory
+                                                    (CutRunContext *context);
 
 void           cut_run_context_set_stop_before_test (CutRunContext *context,
                                                      gboolean       stop);
 gboolean       cut_run_context_get_stop_before_test (CutRunContext *context);
 
+void           cut_run_context_set_batch_pass_assertions
+                                                    (CutRunContext *context,
+                                                     gboolean       batch);
+gboolean       cut_run_context_get_batch_pass_assertions
+                                                    (CutRunContext *context);
+void           cut_run_context_hold_pass_assertion_events
+                                                    (CutRunContext *context);
+void           cut_run_context_release_pass_assertion_events
+                                                    (CutRunContext *context);
+gboolean       cut_run_context_need_pass_assertion_events
+                                                    (CutRunContext *context);
+
+void           cut_run_context_set_result_retention (CutRunContext *context,
+                                                     CutResultRetention retention);
+CutResultRetention
+               cut_run_context_get_result_retention (CutRunContext *context);
+void           cut_run_context_hold_non_success_results
+                                                    (CutRunContext *context);
+void           cut_run_context_release_non_success_results
+                                                    (CutRunContext *context);
+
+void           cut_run_context_set_update_timing_history
+                                                    (CutRunContext *context,
+                                                     gboolean       update);
+gboolean       cut_run_context_get_update_timing_history
+                                                    (CutRunContext *context);
+
+void           cut_run_context_set_timeout          (CutRunContext *context,
+                                                     gdouble        timeout);
+gdouble        cut_run_context_get_timeout          (CutRunContext *context);
+gdouble        cut_run_context_get_test_timeout     (CutRunContext *context,
+                                                     CutTest       *test,
+                                                     CutTestIterator *test_iterator);
+
+void           cut_run_context_set_benchmark_time   (CutRunContext *context,
+                                                     gdouble        time);
+gdouble        cut_run_context_get_benchmark_time   (CutRunContext *context);
+
+void           cut_run_context_set_save_baseline    (CutRunContext *context,
+                                                     const gchar   *filename);
+const gchar   *cut_run_context_get_save_baseline    (CutRunContext *context);
+void           cut_run_context_set_compare_baseline (CutRunContext *context,
+                                                     const gchar   *filename);
+const gchar   *cut_run_context_get_compare_baseline (CutRunContext *context);
+void           cut_run_context_set_regression_threshold
+                                                    (CutRunContext *context,
+                                                     gdouble        threshold);
+gdouble        cut_run_context_get_regression_threshold
+                                                    (CutRunContext *context);
+void           cut_run_context_set_fail_on_regression
+                                                    (CutRunContext *context,
+                                                     gboolean       fail);
+gboolean       cut_run_context_get_fail_on_regression
+                                                    (CutRunContext *context);
+void           cut_run_context_set_performance_counters
+                                                    (CutRunContext *context,
+                                                     gboolean       measure);
+gboolean       cut_run_context_get_performance_counters
+                                                    (CutRunContext *context);
+void           cut_run_context_set_memory_usage     (CutRunContext *context,
+                                                     gboolean       measure);
+gboolean       cut_run_context_get_memory_usage     (CutRunContext *context);
+void           cut_run_context_set_allocation_failures
+                                                    (CutRunContext *context,
+                                                     gint           max_allocations);
+gint           cut_run_context_get_allocation_failures
+                                                    (CutRunContext *context);
+void           cut_run_context_set_shard_listen     (CutRunContext *context,
+                                                     const gchar   *address);
+const gchar   *cut_run_context_get_shard_listen     (CutRunContext *context);
+void           cut_run_context_set_shard_connect    (CutRunContext *context,
+                                                     const gchar   *address);
+const gchar   *cut_run_context_get_shard_connect    (CutRunContext *context);
+/* Returns a message for a regression from the compared
+ * baseline or NULL. The caller owns the message. */
+gchar         *cut_run_context_check_test_regression
+                                                    (CutRunContext *context,
+                                                     CutTest       *test,
+                                                     CutTestContext *test_context,
+                                                     gdouble        elapsed);
+gchar         *cut_run_context_check_benchmark_regression
+                                                    (CutRunContext *context,
+                                                     CutTest       *test,
+                                                     CutTestContext *test_context,
+                                                     CutBenchmarkResult *result);
+
 
 G_END_DECLS
 
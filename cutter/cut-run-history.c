@@ -0,0 +1,681 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+
+#include "cut-run-history.h"
+#include "cut-baseline.h"
+#include "cut-utils.h"
+#include "cut-logger.h"
+
+#define NAMES_FILE "names"
+#define RUNS_FILE "runs"
+#define NAME_IDS_FILE "name-ids"
+#define STATUSES_FILE "statuses"
+#define ELAPSED_FILE "elapsed"
+
+/* time (gint64), first record (guint32), n records (guint32) */
+#define RUN_RECORD_SIZE 16
+#define NAME_ID_SIZE 4
+#define STATUS_SIZE 1
+#define ELAPSED_SIZE 4
+
+#define MAX_ELAPSED_USEC G_MAXUINT32
+
+typedef struct _PendingRecord PendingRecord;
+struct _PendingRecord
+{
+    guint32 name_id;
+    CutTestResultStatus status;
+    gdouble elapsed;
+};
+
+struct _CutRunHistory
+{
+    gchar *directory;
+    GPtrArray *test_case_names;
+    GPtrArray *test_names;
+    GHashTable *name_ids;
+    guint n_committed_names;
+    gsize names_size;
+    guint n_runs;
+    guint32 n_records;
+    GArray *pending_records;
+    GHashTable *pending_indexes;
+};
+
+gchar *
+cut_run_history_build_directory (const gchar *cache_directory,
+                                 const gchar *test_directory)
+{
+    gchar *absolute_test_directory, *base_name, *character, *directory;
+
+    if (g_path_is_absolute(test_directory)) {
+        absolute_test_directory = g_strdup(test_directory);
+    } else {
+        gchar *current_directory;
+
+        current_directory = g_get_current_dir();
+        absolute_test_directory = g_build_filename(current_directory,
+                                                   test_directory,
+                                                   NULL);
+        g_free(current_directory);
+    }
+
+    base_name = g_strconcat(absolute_test_directory, ".history", NULL);
+    for (character = base_name; *character; character++) {
+        if (!g_ascii_isalnum(*character) &&
+            *character != '-' &&
+            *character != '.')
+            *character = '_';
+    }
+    directory = g_build_filename(cache_directory, "history", base_name, NULL);
+    g_free(base_name);
+    g_free(absolute_test_directory);
+
+    return directory;
+}
+
+static void
+reset (CutRunHistory *history)
+{
+    g_ptr_array_set_size(history->test_case_names, 0);
+    g_ptr_array_set_size(history->test_names, 0);
+    g_hash_table_remove_all(history->name_ids);
+    history->n_committed_names = 0;
+    history->names_size = 0;
+    history->n_runs = 0;
+    history->n_records = 0;
+    g_array_set_size(history->pending_records, 0);
+    g_hash_table_remove_all(history->pending_indexes);
+}
+
+CutRunHistory *
+cut_run_history_new (const gchar *directory)
+{
+    CutRunHistory *history;
+
+    history = g_new0(CutRunHistory, 1);
+    history->directory = g_strdup(directory);
+    history->test_case_names = g_ptr_array_new_with_free_func(g_free);
+    history->test_names = g_ptr_array_new_with_free_func(g_free);
+    history->name_ids = g_hash_table_new_full(g_str_hash, g_str_equal,
+                                              g_free, NULL);
+    history->pending_records = g_array_new(FALSE, FALSE,
+                                           sizeof(PendingRecord));
+    history->pending_indexes = g_hash_table_new(g_direct_hash,
+                                                g_direct_equal);
+    reset(history);
+
+    return history;
+}
+
+void
+cut_run_history_free (CutRunHistory *history)
+{
+    g_free(history->directory);
+    g_ptr_array_unref(history->test_case_names);
+    g_ptr_array_unref(history->test_names);
+    g_hash_table_unref(history->name_ids);
+    g_array_free(history->pending_records, TRUE);
+    g_hash_table_unref(history->pending_indexes);
+    g_free(history);
+}
+
+const gchar *
+cut_run_history_get_directory (CutRunHistory *history)
+{
+    return history->directory;
+}
+
+guint
+cut_run_history_get_n_runs (CutRunHistory *history)
+{
+    return history->n_runs;
+}
+
+static guint32
+read_uint32 (const gchar *data)
+{
+    guint32 value;
+
+    memcpy(&value, data, sizeof(value));
+    return GUINT32_FROM_LE(value);
+}
+
+static gint64
+read_int64 (const gchar *data)
+{
+    gint64 value;
+
+    memcpy(&value, data, sizeof(value));
+    return GINT64_FROM_LE(value);
+}
+
+static void
+append_uint32 (GString *buffer, guint32 value)
+{
+    value = GUINT32_TO_LE(value);
+    g_string_append_len(buffer, (const gchar *)&value, sizeof(value));
+}
+
+static void
+append_int64 (GString *buffer, gint64 value)
+{
+    value = GINT64_TO_LE(value);
+    g_string_append_len(buffer, (const gchar *)&value, sizeof(value));
+}
+
+/* FILE is NULL for a missing file. It isn't an error. */
+static gboolean
+map_file (CutRunHistory *history, const gchar *name, GMappedFile **file,
+          GError **error)
+{
+    gchar *path;
+    gboolean success = TRUE;
+
+    *file = NULL;
+    path = g_build_filename(history->directory, name, NULL);
+    if (g_file_test(path, G_FILE_TEST_EXISTS)) {
+        *file = g_mapped_file_new(path, FALSE, error);
+        success = (*file != NULL);
+    }
+    g_free(path);
+
+    return success;
+}
+
+static void
+add_name (CutRunHistory *history, const gchar *test_case_name,
+          const gchar *test_name)
+{
+    guint id;
+
+    id = history->test_names->len;
+    g_ptr_array_add(history->test_case_names, g_strdup(test_case_name));
+    g_ptr_array_add(history->test_names, g_strdup(test_name));
+    g_hash_table_insert(history->name_ids,
+                        g_strconcat(test_case_name, "\t", test_name, NULL),
+                        GUINT_TO_POINTER(id + 1));
+}
+
+static gboolean
+load_names (CutRunHistory *history, GError **error)
+{
+    GMappedFile *file;
+    const gchar *contents, *line, *end;
+    gsize length;
+
+    if (!map_file(history, NAMES_FILE, &file, error))
+        return FALSE;
+    if (!file)
+        return TRUE;
+
+    contents = g_mapped_file_get_contents(file);
+    length = g_mapped_file_get_length(file);
+    for (line = contents;
+         length > 0 &&
+         (end = memchr(line, '\n', contents + length - line));
+         line = end + 1) {
+        const gchar *separator;
+        gchar *test_case_name, *test_name;
+
+        separator = memchr(line, '\t', end - line);
+        if (separator) {
+            test_case_name = g_strndup(line, separator - line);
+            test_name = g_strndup(separator + 1, end - separator - 1);
+        } else {
+            test_case_name = g_strdup("");
+            test_name = g_strndup(line, end - line);
+        }
+        add_name(history, test_case_name, test_name);
+        g_free(test_case_name);
+        g_free(test_name);
+        history->names_size = end + 1 - contents;
+    }
+    g_mapped_file_unref(file);
+
+    history->n_committed_names = history->test_names->len;
+    return TRUE;
+}
+
+static gboolean
+load_runs (CutRunHistory *history, GError **error)
+{
+    GMappedFile *file;
+    const gchar *last_run;
+
+    if (!map_file(history, RUNS_FILE, &file, error))
+        return FALSE;
+    if (!file)
+        return TRUE;
+
+    history->n_runs = g_mapped_file_get_length(file) / RUN_RECORD_SIZE;
+    if (history->n_runs > 0) {
+        last_run = g_mapped_file_get_contents(file) +
+            (history->n_runs - 1) * RUN_RECORD_SIZE;
+        history->n_records = read_uint32(last_run + 8) +
+            read_uint32(last_run + 12);
+    }
+    g_mapped_file_unref(file);
+
+    return TRUE;
+}
+
+gboolean
+cut_run_history_load (CutRunHistory *history, GError **error)
+{
+    reset(history);
+
+    if (!load_names(history, error))
+        return FALSE;
+    if (!load_runs(history, error))
+        return FALSE;
+
+    cut_log_trace("[run-history][load] <%s>: <%u> runs: <%u> records",
+                  history->directory, history->n_runs, history->n_records);
+    return TRUE;
+}
+
+void
+cut_run_history_record (CutRunHistory *history,
+                        const gchar *test_case_name,
+                        const gchar *test_name,
+                        CutTestResultStatus status,
+                        gdouble elapsed)
+{
+    gchar *key;
+    guint id, index;
+    PendingRecord *record;
+
+    if (!test_case_name)
+        test_case_name = "";
+    key = g_strconcat(test_case_name, "\t", test_name, NULL);
+    id = GPOINTER_TO_UINT(g_hash_table_lookup(history->name_ids, key));
+    g_free(key);
+    if (id == 0) {
+        add_name(history, test_case_name, test_name);
+        id = history->test_names->len;
+    }
+    id--;
+
+    index = GPOINTER_TO_UINT(g_hash_table_lookup(history->pending_indexes,
+                                                 GUINT_TO_POINTER(id)));
+    if (index == 0) {
+        PendingRecord new_record;
+
+        new_record.name_id = id;
+        new_record.status = status;
+        new_record.elapsed = elapsed;
+        g_array_append_val(history->pending_records, new_record);
+        g_hash_table_insert(history->pending_indexes,
+                            GUINT_TO_POINTER(id),
+                            GUINT_TO_POINTER(history->pending_records->len));
+        return;
+    }
+
+    record = &g_array_index(history->pending_records, PendingRecord,
+                            index - 1);
+    record->status = MAX(record->status, status);
+    record->elapsed = MAX(record->elapsed, elapsed);
+}
+
+static gboolean
+write_at (CutRunHistory *history, const gchar *name, gsize offset,
+          GString *data, GError **error)
+{
+    gchar *path;
+    FILE *file;
+    gboolean success = TRUE;
+
+    path = g_build_filename(history->directory, name, NULL);
+    file = g_fopen(path, "r+b");
+    if (!file && errno == ENOENT)
+        file = g_fopen(path, "w+b");
+    if (!file) {
+        g_set_error(error,
+                    G_FILE_ERROR,
+                    g_file_error_from_errno(errno),
+                    "failed to open run history file: %s: %s",
+                    path, g_strerror(errno));
+        g_free(path);
+        return FALSE;
+    }
+
+    if (fseek(file, offset, SEEK_SET) != 0 ||
+        fwrite(data->str, 1, data->len, file) != data->len ||
+        fflush(file) != 0) {
+        g_set_error(error,
+                    G_FILE_ERROR,
+                    g_file_error_from_errno(errno),
+                    "failed to write run history file: %s: %s",
+                    path, g_strerror(errno));
+        success = FALSE;
+    }
+    fclose(file);
+    g_free(path);
+
+    return success;
+}
+
+gboolean
+cut_run_history_append_run (CutRunHistory *history, gint64 time,
+                            GError **error)
+{
+    GString *names, *name_ids, *statuses, *elapsed, *run;
+    guint i, n_records;
+    gboolean success = FALSE;
+
+    n_records = history->pending_records->len;
+    if (n_records == 0)
+        return TRUE;
+
+    if (g_mkdir_with_parents(history->directory, 0755) == -1) {
+        g_set_error(error,
+                    G_FILE_ERROR,
+                    g_file_error_from_errno(errno),
+                    "failed to create run history directory: %s: %s",
+                    history->directory, g_strerror(errno));
+        return FALSE;
+    }
+
+    names = g_string_new(NULL);
+    for (i = history->n_committed_names; i < history->test_names->len; i++) {
+        g_string_append_printf(names, "%s\t%s\n",
+                               (gchar *)history->test_case_names->pdata[i],
+                               (gchar *)history->test_names->pdata[i]);
+    }
+
+    name_ids = g_string_sized_new(n_records * NAME_ID_SIZE);
+    statuses = g_string_sized_new(n_records * STATUS_SIZE);
+    elapsed = g_string_sized_new(n_records * ELAPSED_SIZE);
+    for (i = 0; i < n_records; i++) {
+        PendingRecord *record;
+        gdouble usec;
+
+        record = &g_array_index(history->pending_records, PendingRecord, i);
+        append_uint32(name_ids, record->name_id);
+        g_string_append_c(statuses, (gchar)record->status);
+        usec = CLAMP(record->elapsed * G_USEC_PER_SEC, 0, MAX_ELAPSED_USEC);
+        append_uint32(elapsed, (guint32)usec);
+    }
+
+    run = g_string_sized_new(RUN_RECORD_SIZE);
+    append_int64(run, time);
+    append_uint32(run, history->n_records);
+    append_uint32(run, n_records);
+
+    /* The "runs" record must be written at the last to commit
+     * the run. */
+    if (write_at(history, NAMES_FILE, history->names_size, names, error) &&
+        write_at(history, NAME_IDS_FILE,
+                 (gsize)history->n_records * NAME_ID_SIZE, name_ids, error) &&
+        write_at(history, STATUSES_FILE,
+                 (gsize)history->n_records * STATUS_SIZE, statuses, error) &&
+        write_at(history, ELAPSED_FILE,
+                 (gsize)history->n_records * ELAPSED_SIZE, elapsed, error) &&
+        write_at(history, RUNS_FILE,
+                 (gsize)history->n_runs * RUN_RECORD_SIZE, run, error)) {
+        history->names_size += names->len;
+        history->n_committed_names = history->test_names->len;
+        history->n_records += n_records;
+        history->n_runs++;
+        success = TRUE;
+        cut_log_trace("[run-history][append] <%s>: <%u> records",
+                      history->directory, n_records);
+    }
+
+    g_string_free(names, TRUE);
+    g_string_free(name_ids, TRUE);
+    g_string_free(statuses, TRUE);
+    g_string_free(elapsed, TRUE);
+    g_string_free(run, TRUE);
+    g_array_set_size(history->pending_records, 0);
+    g_hash_table_remove_all(history->pending_indexes);
+
+    return success;
+}
+
+static CutRunHistoryTest *
+test_new (const gchar *test_case_name, const gchar *test_name)
+{
+    CutRunHistoryTest *test;
+
+    test = g_new0(CutRunHistoryTest, 1);
+    test->test_case_name = g_strdup(test_case_name);
+    test->test_name = g_strdup(test_name);
+    test->entries = g_array_new(FALSE, FALSE, sizeof(CutRunHistoryEntry));
+
+    return test;
+}
+
+void
+cut_run_history_test_free (CutRunHistoryTest *test)
+{
+    g_free(test->test_case_name);
+    g_free(test->test_name);
+    g_array_free(test->entries, TRUE);
+    g_free(test);
+}
+
+static guint32
+get_n_mapped_records (GMappedFile *file, gsize record_size)
+{
+    if (!file)
+        return 0;
+    return g_mapped_file_get_length(file) / record_size;
+}
+
+/* Only the name ID column is scanned for all records. Other
+ * columns are read only for matched records. */
+static void
+collect_entries (CutRunHistory *history, CutRunHistoryTest **matched_tests,
+                 GMappedFile *runs_file, GMappedFile *name_ids_file,
+                 GMappedFile *statuses_file, GMappedFile *elapsed_file)
+{
+    const gchar *runs, *name_ids, *statuses, *elapsed;
+    guint32 i, n_records, run_end = 0;
+    guint run = 0, n_runs;
+    gint64 time = 0;
+
+    n_runs = MIN(history->n_runs,
+                 get_n_mapped_records(runs_file, RUN_RECORD_SIZE));
+    n_records = history->n_records;
+    n_records = MIN(n_records,
+                    get_n_mapped_records(name_ids_file, NAME_ID_SIZE));
+    n_records = MIN(n_records,
+                    get_n_mapped_records(statuses_file, STATUS_SIZE));
+    n_records = MIN(n_records,
+                    get_n_mapped_records(elapsed_file, ELAPSED_SIZE));
+    if (n_runs == 0 || n_records == 0)
+        return;
+
+    runs = g_mapped_file_get_contents(runs_file);
+    name_ids = g_mapped_file_get_contents(name_ids_file);
+    statuses = g_mapped_file_get_contents(statuses_file);
+    elapsed = g_mapped_file_get_contents(elapsed_file);
+    for (i = 0; i < n_records; i++) {
+        guint32 name_id;
+        CutRunHistoryTest *test;
+        CutRunHistoryEntry entry;
+
+        while (i >= run_end) {
+            const gchar *run_record;
+
+            if (run >= n_runs)
+                return;
+            run_record = runs + run * RUN_RECORD_SIZE;
+            time = read_int64(run_record);
+            run_end = read_uint32(run_record + 8) +
+                read_uint32(run_record + 12);
+            run++;
+        }
+
+        name_id = read_uint32(name_ids + i * NAME_ID_SIZE);
+        if (name_id >= history->n_committed_names)
+            continue;
+        test = matched_tests[name_id];
+        if (!test)
+            continue;
+
+        entry.run = run - 1;
+        entry.time = time;
+        entry.status = (guchar)statuses[i];
+        entry.elapsed =
+            read_uint32(elapsed + i * ELAPSED_SIZE) / (gdouble)G_USEC_PER_SEC;
+        g_array_append_val(test->entries, entry);
+    }
+}
+
+GList *
+cut_run_history_query (CutRunHistory *history, const gchar *pattern,
+                       GError **error)
+{
+    const gchar *filter[] = {pattern, NULL};
+    GList *regexs, *tests = NULL;
+    CutRunHistoryTest **matched_tests;
+    GMappedFile *runs_file = NULL, *name_ids_file = NULL;
+    GMappedFile *statuses_file = NULL, *elapsed_file = NULL;
+    guint i;
+
+    regexs = cut_utils_filter_to_regexs(filter);
+    if (!regexs)
+        return NULL;
+
+    matched_tests = g_new0(CutRunHistoryTest *,
+                           history->n_committed_names + 1);
+    for (i = 0; i < history->n_committed_names; i++) {
+        const gchar *test_name;
+
+        test_name = g_ptr_array_index(history->test_names, i);
+        if (!cut_utils_filter_match(regexs, test_name))
+            continue;
+        matched_tests[i] =
+            test_new(g_ptr_array_index(history->test_case_names, i),
+                     test_name);
+        tests = g_list_prepend(tests, matched_tests[i]);
+    }
+    g_list_foreach(regexs, (GFunc)g_regex_unref, NULL);
+    g_list_free(regexs);
+
+    if (tests) {
+        if (map_file(history, RUNS_FILE, &runs_file, error) &&
+            map_file(history, NAME_IDS_FILE, &name_ids_file, error) &&
+            map_file(history, STATUSES_FILE, &statuses_file, error) &&
+            map_file(history, ELAPSED_FILE, &elapsed_file, error)) {
+            collect_entries(history, matched_tests, runs_file, name_ids_file,
+                            statuses_file, elapsed_file);
+        } else {
+            g_list_foreach(tests, (GFunc)cut_run_history_test_free, NULL);
+            g_list_free(tests);
+            tests = NULL;
+        }
+    }
+
+    if (runs_file)
+        g_mapped_file_unref(runs_file);
+    if (name_ids_file)
+        g_mapped_file_unref(name_ids_file);
+    if (statuses_file)
+        g_mapped_file_unref(statuses_file);
+    if (elapsed_file)
+        g_mapped_file_unref(elapsed_file);
+    g_free(matched_tests);
+
+    return g_list_reverse(tests);
+}
+
+gint
+cut_run_history_test_get_failing_since (CutRunHistoryTest *test)
+{
+    gint i;
+
+    for (i = test->entries->len; i > 0; i--) {
+        CutRunHistoryEntry *entry;
+
+        entry = &g_array_index(test->entries, CutRunHistoryEntry, i - 1);
+        if (entry->status < CUT_TEST_RESULT_FAILURE)
+            break;
+    }
+
+    if (i == (gint)test->entries->len)
+        return -1;
+    return i;
+}
+
+gint
+cut_run_history_test_get_slower_since (CutRunHistoryTest *test,
+                                       gdouble threshold)
+{
+    guint i, n_entries, since = 0;
+    gdouble total = 0.0, mean, deviation = 0.0, min_deviation = 0.0;
+    gdouble before_total = 0.0, before_mean, after_mean;
+
+    n_entries = test->entries->len;
+    if (n_entries < 2)
+        return -1;
+
+    for (i = 0; i < n_entries; i++) {
+        total += g_array_index(test->entries, CutRunHistoryEntry, i).elapsed;
+    }
+    mean = total / n_entries;
+
+    /* The change point is where the cumulative deviation from
+     * the mean is the lowest. Runs before it are faster than
+     * the mean and runs after it are slower. */
+    for (i = 1; i < n_entries; i++) {
+        gdouble elapsed;
+
+        elapsed = g_array_index(test->entries, CutRunHistoryEntry,
+                                i - 1).elapsed;
+        deviation += elapsed - mean;
+        if (deviation < min_deviation) {
+            min_deviation = deviation;
+            since = i;
+        }
+    }
+    if (since == 0)
+        return -1;
+
+    for (i = 0; i < since; i++) {
+        before_total +=
+            g_array_index(test->entries, CutRunHistoryEntry, i).elapsed;
+    }
+    before_mean = before_total / since;
+    after_mean = (total - before_total) / (n_entries - since);
+    if (after_mean <= before_mean * (1.0 + threshold / 100.0))
+        return -1;
+    if (after_mean - before_mean < CUT_BASELINE_MIN_REGRESSION_ELAPSED)
+        return -1;
+
+    return since;
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
@@ -0,0 +1,117 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef __CUT_RUN_HISTORY_H__
+#define __CUT_RUN_HISTORY_H__
+
+#include <glib.h>
+
+#include <cutter/cut-public.h>
+
+G_BEGIN_DECLS
+
+/*
+ * CutRunHistory keeps status and elapsed time of each test of
+ * each run in append-only column files in a directory:
+ *
+ *   names:    test case name and test name per line. The line
+ *             number is a name ID.
+ *   runs:     start time, the first record and the number of
+ *             records of each run as fixed width records.
+ *   name-ids: a name ID of each record.
+ *   statuses: a CutTestResultStatus of each record.
+ *   elapsed:  elapsed time of each record in microseconds.
+ *
+ * A run is committed by writing its "runs" record after its
+ * records. So a broken run that isn't committed is ignored and
+ * overwritten by the next run.
+ */
+typedef struct _CutRunHistory CutRunHistory;
+typedef struct _CutRunHistoryEntry CutRunHistoryEntry;
+typedef struct _CutRunHistoryTest CutRunHistoryTest;
+
+struct _CutRunHistoryEntry
+{
+    guint run;
+    gint64 time;
+    CutTestResultStatus status;
+    gdouble elapsed;
+};
+
+struct _CutRunHistoryTest
+{
+    gchar *test_case_name;
+    gchar *test_name;
+    GArray *entries;
+};
+
+gchar         *cut_run_history_build_directory
+                                        (const gchar        *cache_directory,
+                                         const gchar        *test_directory);
+
+CutRunHistory *cut_run_history_new      (const gchar        *directory);
+void           cut_run_history_free     (CutRunHistory      *history);
+
+const gchar   *cut_run_history_get_directory
+                                        (CutRunHistory      *history);
+gboolean       cut_run_history_load     (CutRunHistory      *history,
+                                         GError            **error);
+guint          cut_run_history_get_n_runs
+                                        (CutRunHistory      *history);
+
+/* A test that has some results is recorded with the worst
+ * status and the longest elapsed time. */
+void           cut_run_history_record   (CutRunHistory      *history,
+                                         const gchar        *test_case_name,
+                                         const gchar        *test_name,
+                                         CutTestResultStatus status,
+                                         gdouble             elapsed);
+gboolean       cut_run_history_append_run
+                                        (CutRunHistory      *history,
+                                         gint64              time,
+                                         GError            **error);
+
+/* Returns a list of CutRunHistoryTest whose test name is
+ * PATTERN or is matched with /PATTERN/. Its entries are in
+ * run order. */
+GList         *cut_run_history_query    (CutRunHistory      *history,
+                                         const gchar        *pattern,
+                                         GError            **error);
+
+void           cut_run_history_test_free
+                                        (CutRunHistoryTest  *test);
+/* Returns the index of the entry that starts the last run of
+ * failures, errors and crashes or -1. */
+gint           cut_run_history_test_get_failing_since
+                                        (CutRunHistoryTest  *test);
+/* Returns the index of the entry from which the test is slower
+ * than before by more than THRESHOLD percent or -1. A slowdown
+ * less than CUT_BASELINE_MIN_REGRESSION_ELAPSED is ignored. */
+gint           cut_run_history_test_get_slower_since
+                                        (CutRunHistoryTest  *test,
+                                         gdouble             threshold);
+
+G_END_DECLS
+
+#endif /* __CUT_RUN_HISTORY_H__ */
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
@@ -37,6 +37,9 @@ struct _CutSequenceMatcherPrivate
     GSequence *to;
     GSequenceIterCompareFunc compare_func;
     gpointer compare_func_user_data;
+    GHashFunc content_hash_func;
+    GEqualFunc content_equal_func;
+    CutSequenceMatchAlgorithm algorithm;
     GHashTable *to_indices;
     GHashTable *junks;
     GList *matches;
@@ -170,6 +173,9 @@ cut_sequence_matcher_init (CutSequenceMatcher *sequence_matcher)
 
     priv->from = NULL;
     priv->to = NULL;
+    priv->content_hash_func = NULL;
+    priv->content_equal_func = NULL;
+    priv->algorithm = CUT_SEQUENCE_MATCH_ALGORITHM_LONGEST_MATCH;
     priv->to_indices = NULL;
     priv->junks = NULL;
     priv->matches = NULL;
@@ -198,6 +204,33 @@ dispose_goruped_operations (CutSequenceMatcherPrivate *priv)
     priv->grouped_operations = NULL;
 }
 
+static void
+dispose_matches (CutSequenceMatcherPrivate *priv)
+{
+    if (priv->matches) {
+        g_list_foreach(priv->matches, (GFunc)cut_sequence_match_info_free, NULL);
+        g_list_free(priv->matches);
+        priv->matches = NULL;
+    }
+
+    if (priv->blocks) {
+        g_list_foreach(priv->blocks, (GFunc)cut_sequence_match_info_free, NULL);
+        g_list_free(priv->blocks);
+        priv->blocks = NULL;
+    }
+
+
+    if (priv->operations) {
+        g_list_foreach(priv->operations,
+                       (GFunc)cut_sequence_match_operation_free, NULL);
+        g_list_free(priv->operations);
+        priv->operations = NULL;
+    }
+
+    dispose_goruped_operations(priv);
+    priv->ratio = -1.0;
+}
+
 static void
 dispose (GObject *object)
 {
@@ -225,27 +258,7 @@ dispose (GObject *object)
         priv->junks = NULL;
     }
 
-    if (priv->matches) {
-        g_list_foreach(priv->matches, (GFunc)cut_sequence_match_info_free, NULL);
-        g_list_free(priv->matches);
-        priv->matches = NULL;
-    }
-
-    if (priv->blocks) {
-        g_list_foreach(priv->blocks, (GFunc)cut_sequence_match_info_free, NULL);
-        g_list_free(priv->blocks);
-        priv->blocks = NULL;
-    }
-
-
-    if (priv->operations) {
-        g_list_foreach(priv->operations,
-                       (GFunc)cut_sequence_match_operation_free, NULL);
-        g_list_free(priv->operations);
-        priv->operations = NULL;
-    }
-
-    dispose_goruped_operations(priv);
+    dispose_matches(priv);
 
     G_OBJECT_CLASS(cut_sequence_matcher_parent_class)->dispose(object);
 }
@@ -359,25 +372,28 @@ update_to_indices (CutSequenceMatcher *matcher,
 {
     CutSequenceMatcherPrivate *priv;
     gint i;
-    GSequenceIter *iter, *begin, *end;
+    GSequenceIter *iter, *begin;
 
     priv = CUT_SEQUENCE_MATCHER_GET_PRIVATE(matcher);
 
     if (!priv->to)
         return;
 
+    /* Walk backward and prepend to keep indices ascending
+     * without copying a list for each element. */
     begin = g_sequence_get_begin_iter(priv->to);
-    end = g_sequence_get_end_iter(priv->to);
-    for (i = 0, iter = begin;
-         iter != end;
-         i++, iter = g_sequence_iter_next(iter)) {
+    iter = g_sequence_get_end_iter(priv->to);
+    for (i = g_sequence_get_length(priv->to) - 1; iter != begin; i--) {
         gpointer data;
         GList *indices;
 
+        iter = g_sequence_iter_prev(iter);
         data = g_sequence_get(iter);
         indices = g_hash_table_lookup(priv->to_indices, data);
-        indices = g_list_append(indices, GINT_TO_POINTER(i));
-        g_hash_table_replace(priv->to_indices, data, g_list_copy(indices));
+        if (indices)
+            g_hash_table_steal(priv->to_indices, data);
+        indices = g_list_prepend(indices, GINT_TO_POINTER(i));
+        g_hash_table_insert(priv->to_indices, data, indices);
     }
 
     if (junk_filter_func)
@@ -396,6 +412,7 @@ cut_sequence_matcher_new (GSequence *from, GSequence *to,
                           gpointer junk_filter_func_user_data)
 {
     CutSequenceMatcher *matcher;
+    CutSequenceMatcherPrivate *priv;
 
     matcher = g_object_new(CUT_TYPE_SEQUENCE_MATCHER,
                            "from-sequence", from,
@@ -410,6 +427,13 @@ cut_sequence_matcher_new (GSequence *from, GSequence *to,
                            "junks", g_hash_table_new(content_hash_func,
                                                      content_equal_func),
                            NULL);
+    priv = CUT_SEQUENCE_MATCHER_GET_PRIVATE(matcher);
+    priv->content_hash_func = content_hash_func;
+    priv->content_equal_func = content_equal_func;
+    if (from && to &&
+        g_sequence_get_length(from) + g_sequence_get_length(to) >
+        CUT_SEQUENCE_MATCHER_MYERS_THRESHOLD)
+        priv->algorithm = CUT_SEQUENCE_MATCH_ALGORITHM_MYERS;
     update_to_indices(matcher, junk_filter_func, junk_filter_func_user_data);
     return matcher;
 }
@@ -730,6 +754,326 @@ compare_match_info (gconstpointer data1, gconstpointer data2)
     }
 }
 
+typedef struct _MyersContext MyersContext;
+struct _MyersContext {
+    guint *from;
+    guint *to;
+    gboolean *from_changed;
+    gboolean *to_changed;
+    gint *forward_furthest;
+    gint *backward_furthest;
+    gint max_cost;
+};
+
+typedef struct _MyersSplit MyersSplit;
+struct _MyersSplit {
+    gint from_index;
+    gint to_index;
+    gboolean minimal_lower;
+    gboolean minimal_upper;
+};
+
+#define MYERS_MIN_MAX_COST 256
+
+static guint *
+sequence_to_ids (GSequence *sequence, GHashTable *ids, gint *length)
+{
+    guint *sequence_ids;
+    GSequenceIter *iter, *end;
+    gint i;
+
+    *length = g_sequence_get_length(sequence);
+    sequence_ids = g_new(guint, *length + 1);
+    end = g_sequence_get_end_iter(sequence);
+    for (i = 0, iter = g_sequence_get_begin_iter(sequence);
+         iter != end;
+         i++, iter = g_sequence_iter_next(iter)) {
+        gpointer data;
+        guint id;
+
+        data = g_sequence_get(iter);
+        id = GPOINTER_TO_UINT(g_hash_table_lookup(ids, data));
+        if (id == 0) {
+            id = g_hash_table_size(ids) + 1;
+            g_hash_table_insert(ids, data, GUINT_TO_POINTER(id));
+        }
+        sequence_ids[i] = id;
+    }
+
+    return sequence_ids;
+}
+
+/*
+ * Finds the middle snake of from[from_begin, from_end) and
+ * to[to_begin, to_end) by searching from both ends at once. If
+ * the edit cost exceeds max_cost, it gives up the minimal
+ * result and splits at the furthest reaching point. It keeps
+ * the whole diff O((N + M) * max_cost).
+ */
+static void
+myers_split (MyersContext *context,
+             gint from_begin, gint from_end,
+             gint to_begin, gint to_end,
+             gboolean need_minimal, MyersSplit *split)
+{
+    gint *forward = context->forward_furthest;
+    gint *backward = context->backward_furthest;
+    gint diagonal_min = from_begin - to_end;
+    gint diagonal_max = from_end - to_begin;
+    gint forward_middle = from_begin - to_begin;
+    gint backward_middle = from_end - to_end;
+    gint forward_min = forward_middle, forward_max = forward_middle;
+    gint backward_min = backward_middle, backward_max = backward_middle;
+    gboolean odd = (forward_middle - backward_middle) & 1;
+    gint cost;
+
+    forward[forward_middle] = from_begin;
+    backward[backward_middle] = from_end;
+
+    for (cost = 1; ; cost++) {
+        gint diagonal;
+
+        if (forward_min > diagonal_min)
+            forward[--forward_min - 1] = -1;
+        else
+            forward_min++;
+        if (forward_max < diagonal_max)
+            forward[++forward_max + 1] = -1;
+        else
+            forward_max--;
+
+        for (diagonal = forward_max;
+             diagonal >= forward_min;
+             diagonal -= 2) {
+            gint from_index, to_index;
+
+            if (forward[diagonal - 1] >= forward[diagonal + 1])
+                from_index = forward[diagonal - 1] + 1;
+            else
+                from_index = forward[diagonal + 1];
+            to_index = from_index - diagonal;
+            while (from_index < from_end && to_index < to_end &&
+                   context->from[from_index] == context->to[to_index]) {
+                from_index++;
+                to_index++;
+            }
+            forward[diagonal] = from_index;
+            if (odd &&
+                backward_min <= diagonal && diagonal <= backward_max &&
+                backward[diagonal] <= from_index) {
+                split->from_index = from_index;
+                split->to_index = to_index;
+                split->minimal_lower = TRUE;
+                split->minimal_upper = TRUE;
+                return;
+            }
+        }
+
+        if (backward_min > diagonal_min)
+            backward[--backward_min - 1] = G_MAXINT;
+        else
+            backward_min++;
+        if (backward_max < diagonal_max)
+            backward[++backward_max + 1] = G_MAXINT;
+        else
+            backward_max--;
+
+        for (diagonal = backward_max;
+             diagonal >= backward_min;
+             diagonal -= 2) {
+            gint from_index, to_index;
+
+            if (backward[diagonal - 1] < backward[diagonal + 1])
+                from_index = backward[diagonal - 1];
+            else
+                from_index = backward[diagonal + 1] - 1;
+            to_index = from_index - diagonal;
+            while (from_index > from_begin && to_index > to_begin &&
+                   context->from[from_index - 1] ==
+                   context->to[to_index - 1]) {
+                from_index--;
+                to_index--;
+            }
+            backward[diagonal] = from_index;
+            if (!odd &&
+                forward_min <= diagonal && diagonal <= forward_max &&
+                from_index <= forward[diagonal]) {
+                split->from_index = from_index;
+                split->to_index = to_index;
+                split->minimal_lower = TRUE;
+                split->minimal_upper = TRUE;
+                return;
+            }
+        }
+
+        if (need_minimal || cost < context->max_cost)
+            continue;
+
+        {
+            gint forward_best = -1, forward_best_from_index = -1;
+            gint backward_best = G_MAXINT, backward_best_from_index = G_MAXINT;
+
+            for (diagonal = forward_max;
+                 diagonal >= forward_min;
+                 diagonal -= 2) {
+                gint from_index, to_index;
+
+                from_index = MIN(forward[diagonal], from_end);
+                to_index = from_index - diagonal;
+                if (to_end < to_index) {
+                    from_index = to_end + diagonal;
+                    to_index = to_end;
+                }
+                if (forward_best < from_index + to_index) {
+                    forward_best = from_index + to_index;
+                    forward_best_from_index = from_index;
+                }
+            }
+
+            for (diagonal = backward_max;
+                 diagonal >= backward_min;
+                 diagonal -= 2) {
+                gint from_index, to_index;
+
+                from_index = MAX(from_begin, backward[diagonal]);
+                to_index = from_index - diagonal;
+                if (to_index < to_begin) {
+                    from_index = to_begin + diagonal;
+                    to_index = to_begin;
+                }
+                if (from_index + to_index < backward_best) {
+                    backward_best = from_index + to_index;
+                    backward_best_from_index = from_index;
+                }
+            }
+
+            if ((from_end + to_end) - backward_best <
+                forward_best - (from_begin + to_begin)) {
+                split->from_index = forward_best_from_index;
+                split->to_index = forward_best - forward_best_from_index;
+                split->minimal_lower = TRUE;
+                split->minimal_upper = FALSE;
+            } else {
+                split->from_index = backward_best_from_index;
+                split->to_index = backward_best - backward_best_from_index;
+                split->minimal_lower = FALSE;
+                split->minimal_upper = TRUE;
+            }
+            return;
+        }
+    }
+}
+
+static void
+myers_compare (MyersContext *context,
+               gint from_begin, gint from_end,
+               gint to_begin, gint to_end,
+               gboolean need_minimal)
+{
+    while (TRUE) {
+        MyersSplit split;
+
+        while (from_begin < from_end && to_begin < to_end &&
+               context->from[from_begin] == context->to[to_begin]) {
+            from_begin++;
+            to_begin++;
+        }
+        while (from_begin < from_end && to_begin < to_end &&
+               context->from[from_end - 1] == context->to[to_end - 1]) {
+            from_end--;
+            to_end--;
+        }
+
+        if (from_begin == from_end) {
+            for (; to_begin < to_end; to_begin++)
+                context->to_changed[to_begin] = TRUE;
+            return;
+        }
+        if (to_begin == to_end) {
+            for (; from_begin < from_end; from_begin++)
+                context->from_changed[from_begin] = TRUE;
+            return;
+        }
+
+        myers_split(context,
+                    from_begin, from_end, to_begin, to_end,
+                    need_minimal, &split);
+        myers_compare(context,
+                      from_begin, split.from_index,
+                      to_begin, split.to_index,
+                      split.minimal_lower);
+        /* The upper half is processed by this loop to avoid deep
+         * recursion. */
+        from_begin = split.from_index;
+        to_begin = split.to_index;
+        need_minimal = split.minimal_upper;
+    }
+}
+
+static GList *
+get_matches_by_myers (CutSequenceMatcher *matcher)
+{
+    CutSequenceMatcherPrivate *priv;
+    MyersContext context;
+    GHashTable *ids;
+    GList *matches = NULL;
+    gint from_length, to_length, n_diagonals, from_index, to_index;
+    gint *furthest;
+
+    priv = CUT_SEQUENCE_MATCHER_GET_PRIVATE(matcher);
+
+    ids = g_hash_table_new(priv->content_hash_func, priv->content_equal_func);
+    context.from = sequence_to_ids(priv->from, ids, &from_length);
+    context.to = sequence_to_ids(priv->to, ids, &to_length);
+    g_hash_table_unref(ids);
+
+    context.from_changed = g_new0(gboolean, from_length + 1);
+    context.to_changed = g_new0(gboolean, to_length + 1);
+    n_diagonals = from_length + to_length + 3;
+    furthest = g_new(gint, n_diagonals * 2);
+    context.forward_furthest = furthest + to_length + 1;
+    context.backward_furthest = furthest + n_diagonals + to_length + 1;
+    for (context.max_cost = 1; n_diagonals > 0; n_diagonals >>= 2)
+        context.max_cost <<= 1;
+    context.max_cost = MAX(context.max_cost, MYERS_MIN_MAX_COST);
+
+    myers_compare(&context, 0, from_length, 0, to_length, FALSE);
+
+    from_index = to_index = 0;
+    while (from_index < from_length && to_index < to_length) {
+        gint size = 0;
+
+        if (context.from_changed[from_index]) {
+            from_index++;
+            continue;
+        }
+        if (context.to_changed[to_index]) {
+            to_index++;
+            continue;
+        }
+
+        while (from_index + size < from_length &&
+               to_index + size < to_length &&
+               !context.from_changed[from_index + size] &&
+               !context.to_changed[to_index + size])
+            size++;
+        matches = g_list_prepend(matches,
+                                 cut_sequence_match_info_new(from_index,
+                                                             to_index,
+                                                             size));
+        from_index += size;
+        to_index += size;
+    }
+
+    g_free(furthest);
+    g_free(context.from_changed);
+    g_free(context.to_changed);
+    g_free(context.from);
+    g_free(context.to);
+
+    return g_list_reverse(matches);
+}
+
 const GList *
 cut_sequence_matcher_get_matches (CutSequenceMatcher *matcher)
 {
@@ -741,6 +1085,11 @@ cut_sequence_matcher_get_matches (CutSequenceMatcher *matcher)
     if (priv->matches)
         return priv->matches;
 
+    if (priv->algorithm == CUT_SEQUENCE_MATCH_ALGORITHM_MYERS) {
+        priv->matches = get_matches_by_myers(matcher);
+        return priv->matches;
+    }
+
     queue = g_queue_new();
     push_matching_info(queue,
                        0, g_sequence_get_length(priv->from),
@@ -1066,6 +1415,25 @@ cut_sequence_matcher_set_context_size (CutSequenceMatcher *matcher,
     }
 }
 
+CutSequenceMatchAlgorithm
+cut_sequence_matcher_get_algorithm (CutSequenceMatcher *matcher)
+{
+    return CUT_SEQUENCE_MATCHER_GET_PRIVATE(matcher)->algorithm;
+}
+
+void
+cut_sequence_matcher_set_algorithm (CutSequenceMatcher *matcher,
+                                    CutSequenceMatchAlgorithm algorithm)
+{
+    CutSequenceMatcherPrivate *priv;
+
+    priv = CUT_SEQUENCE_MATCHER_GET_PRIVATE(matcher);
+    if (priv->algorithm != algorithm) {
+        priv->algorithm = algorithm;
+        dispose_matches(priv);
+    }
+}
+
 /*
 vi:ts=4:nowrap:ai:expandtab:sw=4
 */
@@ -47,6 +47,19 @@ typedef enum {
     CUT_SEQUENCE_MATCH_OPERATION_REPLACE
 } CutSequenceMatchOperationType;
 
+/*
+ * LONGEST_MATCH is a port of Python's difflib. It finds
+ * human friendly matches but it's slow for large sequences.
+ * MYERS is Myers' O(ND) difference algorithm over hashed
+ * element IDs. It ignores junks.
+ */
+typedef enum {
+    CUT_SEQUENCE_MATCH_ALGORITHM_LONGEST_MATCH,
+    CUT_SEQUENCE_MATCH_ALGORITHM_MYERS
+} CutSequenceMatchAlgorithm;
+
+#define CUT_SEQUENCE_MATCHER_MYERS_THRESHOLD 2000
+
 struct _CutSequenceMatcher
 {
     GObject object;
@@ -134,6 +147,10 @@ guint        cut_sequence_matcher_get_context_size
 void         cut_sequence_matcher_set_context_size
                                                  (CutSequenceMatcher *matcher,
                                                   guint               context_size);
+CutSequenceMatchAlgorithm
+             cut_sequence_matcher_get_algorithm  (CutSequenceMatcher *matcher);
+void         cut_sequence_matcher_set_algorithm  (CutSequenceMatcher *matcher,
+                                                  CutSequenceMatchAlgorithm algorithm);
 
 G_END_DECLS
 
@@ -27,6 +27,8 @@
 
 #include "cut-stream-parser.h"
 #include "cut-backtrace-entry.h"
+#include "cut-binary-stream-codec.h"
+#include "cut-benchmark-result.h"
 
 typedef enum {
     IN_TOP_LEVEL,
@@ -78,6 +80,9 @@ typedef enum {
 
     IN_PASS_ASSERTION,
 
+    IN_PASS_ASSERTIONS,
+    IN_PASS_ASSERTIONS_N_ASSERTIONS,
+
     IN_TEST_RESULT,
 
     IN_RESULT,
@@ -90,11 +95,27 @@ typedef enum {
     IN_RESULT_BACKTRACE_ENTRY_INFO,
     IN_RESULT_START_TIME,
     IN_RESULT_ELAPSED,
+    IN_RESULT_PERFORMANCE_COUNTERS,
+    IN_RESULT_PERFORMANCE_COUNTER,
+    IN_RESULT_MEMORY_USAGE,
+    IN_RESULT_MEMORY_USAGE_VALUE,
     IN_RESULT_EXPECTED,
     IN_RESULT_ACTUAL,
     IN_RESULT_DIFF,
     IN_RESULT_FOLDED_DIFF,
 
+    IN_BENCHMARK_TEST,
+
+    IN_BENCHMARK_RESULT,
+    IN_BENCHMARK_RESULT_N_ITERATIONS,
+    IN_BENCHMARK_RESULT_N_SAMPLES,
+    IN_BENCHMARK_RESULT_MEAN,
+    IN_BENCHMARK_RESULT_MEDIAN,
+    IN_BENCHMARK_RESULT_STANDARD_DEVIATION,
+    IN_BENCHMARK_RESULT_MINIMUM,
+    IN_BENCHMARK_RESULT_MAXIMUM,
+    IN_BENCHMARK_RESULT_OPERATIONS_PER_SECOND,
+
     IN_COMPLETE_ITERATED_TEST,
 
     IN_COMPLETE_TEST,
@@ -157,6 +178,7 @@ struct _PassAssertion
 {
     CutTest *test;
     CutTestContext *test_context;
+    guint n_assertions;
 };
 
 typedef struct _TestResult TestResult;
@@ -167,6 +189,14 @@ struct _TestResult
     CutTestResult *result;
 };
 
+typedef struct _BenchmarkTest BenchmarkTest;
+struct _BenchmarkTest
+{
+    CutTest *test;
+    CutTestContext *test_context;
+    CutBenchmarkResult *result;
+};
+
 typedef struct _CompleteIteratedTest CompleteIteratedTest;
 struct _CompleteIteratedTest
 {
@@ -217,6 +247,7 @@ struct _CutStreamParserPrivate
     StartIteratedTest *start_iterated_test;
     PassAssertion *pass_assertion;
     TestResult *test_result;
+    BenchmarkTest *benchmark_test;
     CompleteIteratedTest *complete_iterated_test;
     CompleteTest *complete_test;
     TestIteratorResult *test_iterator_result;
@@ -225,12 +256,17 @@ struct _CutStreamParserPrivate
     CutTestResult *result;
     GList *backtrace;
     CutBacktraceEntry *backtrace_entry;
+    CutPerformanceCounterType performance_counter_type;
+    CutMemoryUsageType memory_usage_type;
     gchar *option_name;
     gchar *option_value;
     gboolean complete_success;
     gboolean stream_success;
 
     GQueue *element_stack;
+
+    gboolean format_detected;
+    CutBinaryStreamDecoder *binary_decoder;
 };
 
 #define PUSH_STATE(priv, state)                                 \
@@ -411,18 +447,24 @@ cut_stream_parser_init (CutStreamParser *stream_parser)
     priv->complete_iterated_test = NULL;
     priv->complete_test = NULL;
     priv->test_result = NULL;
+    priv->benchmark_test = NULL;
     priv->test_iterator_result = NULL;
     priv->test_case_result = NULL;
 
     priv->result = NULL;
     priv->backtrace = NULL;
     priv->backtrace_entry = NULL;
+    priv->performance_counter_type = CUT_PERFORMANCE_COUNTER_CYCLES;
+    priv->memory_usage_type = CUT_MEMORY_USAGE_ALLOCATIONS;
     priv->option_name = NULL;
     priv->option_value = NULL;
     priv->complete_success = TRUE;
     priv->stream_success = TRUE;
 
     priv->element_stack = g_queue_new();
+
+    priv->format_detected = FALSE;
+    priv->binary_decoder = NULL;
 }
 
 static ReadyTestSuite *
@@ -533,6 +575,24 @@ test_result_free (TestResult *test_result)
     g_slice_free(TestResult, test_result);
 }
 
+static BenchmarkTest *
+benchmark_test_new (void)
+{
+    return g_slice_new0(BenchmarkTest);
+}
+
+static void
+benchmark_test_free (BenchmarkTest *benchmark_test)
+{
+    if (benchmark_test->test)
+        g_object_unref(benchmark_test->test);
+    if (benchmark_test->test_context)
+        g_object_unref(benchmark_test->test_context);
+    if (benchmark_test->result)
+        g_object_unref(benchmark_test->result);
+    g_slice_free(BenchmarkTest, benchmark_test);
+}
+
 static CompleteIteratedTest *
 complete_iterated_test_new (void)
 {
@@ -694,6 +754,11 @@ dispose (GObject *object)
         priv->test_result = NULL;
     }
 
+    if (priv->benchmark_test) {
+        benchmark_test_free(priv->benchmark_test);
+        priv->benchmark_test = NULL;
+    }
+
     if (priv->complete_iterated_test) {
         complete_iterated_test_free(priv->complete_iterated_test);
         priv->complete_iterated_test = NULL;
@@ -741,6 +806,11 @@ dispose (GObject *object)
         priv->element_stack = NULL;
     }
 
+    if (priv->binary_decoder) {
+        cut_binary_stream_decoder_free(priv->binary_decoder);
+        priv->binary_decoder = NULL;
+    }
+
     G_OBJECT_CLASS(cut_stream_parser_parent_class)->dispose(object);
 }
 
@@ -806,12 +876,173 @@ cut_test_result_parser_new (void)
     return parser;
 }
 
+static void
+emit_result_signal (CutRunContext *run_context, const gchar *suffix,
+                    gpointer test_object, CutTestContext *test_context,
+                    CutTestResult *result)
+{
+    CutTestResultStatus status;
+    gchar *full_signal_name;
+
+    status = cut_test_result_get_status(result);
+    full_signal_name =
+        g_strdup_printf("%s-%s",
+                        cut_test_result_status_to_signal_name(status),
+                        suffix);
+    if (test_context)
+        g_signal_emit_by_name(run_context, full_signal_name,
+                              test_object, test_context, result);
+    else
+        g_signal_emit_by_name(run_context, full_signal_name,
+                              test_object, result);
+    g_free(full_signal_name);
+}
+
+static void
+emit_binary_event (const CutBinaryStreamEvent *event, gpointer user_data)
+{
+    CutStreamParser *parser = user_data;
+    CutStreamParserPrivate *priv;
+    CutRunContext *run_context;
+
+    priv = CUT_STREAM_PARSER_GET_PRIVATE(parser);
+
+    if (event->result)
+        g_signal_emit_by_name(parser, "result", event->result);
+
+    run_context = priv->run_context;
+    if (!run_context)
+        return;
+
+    switch (event->type) {
+      case CUT_BINARY_STREAM_EVENT_START_RUN:
+        g_signal_emit_by_name(run_context, "start-run");
+        break;
+      case CUT_BINARY_STREAM_EVENT_READY_TEST_SUITE:
+        g_signal_emit_by_name(run_context, "ready-test-suite",
+                              event->test,
+                              event->n_test_cases,
+                              event->n_tests);
+        break;
+      case CUT_BINARY_STREAM_EVENT_START_TEST_SUITE:
+        g_signal_emit_by_name(run_context, "start-test-suite", event->test);
+        break;
+      case CUT_BINARY_STREAM_EVENT_READY_TEST_CASE:
+        g_signal_emit_by_name(run_context, "ready-test-case",
+                              event->test, event->n_tests);
+        break;
+      case CUT_BINARY_STREAM_EVENT_START_TEST_CASE:
+        g_signal_emit_by_name(run_context, "start-test-case", event->test);
+        break;
+      case CUT_BINARY_STREAM_EVENT_READY_TEST_ITERATOR:
+        g_signal_emit_by_name(run_context, "ready-test-iterator",
+                              event->test, event->n_tests);
+        break;
+      case CUT_BINARY_STREAM_EVENT_START_TEST_ITERATOR:
+        g_signal_emit_by_name(run_context, "start-test-iterator",
+                              event->test);
+        break;
+      case CUT_BINARY_STREAM_EVENT_START_TEST:
+        g_signal_emit_by_name(run_context, "start-test",
+                              event->test, event->test_context);
+        break;
+      case CUT_BINARY_STREAM_EVENT_START_ITERATED_TEST:
+        g_signal_emit_by_name(run_context, "start-iterated-test",
+                              event->test, event->test_context);
+        break;
+      case CUT_BINARY_STREAM_EVENT_PASS_ASSERTION:
+        g_signal_emit_by_name(run_context, "pass-assertion",
+                              event->test, event->test_context);
+        break;
+      case CUT_BINARY_STREAM_EVENT_PASS_ASSERTIONS:
+        g_signal_emit_by_name(run_context, "pass-assertions",
+                              event->test, event->test_context,
+                              event->n_assertions);
+        break;
+      case CUT_BINARY_STREAM_EVENT_TEST_RESULT:
+        if (event->result)
+            emit_result_signal(run_context, "test", event->test,
+                               event->test_context, event->result);
+        break;
+      case CUT_BINARY_STREAM_EVENT_BENCHMARK_TEST:
+        if (event->benchmark_result)
+            g_signal_emit_by_name(run_context, "benchmark-test",
+                                  event->test, event->test_context,
+                                  event->benchmark_result);
+        break;
+      case CUT_BINARY_STREAM_EVENT_TEST_ITERATOR_RESULT:
+        if (event->result)
+            emit_result_signal(run_context, "test-iterator", event->test,
+                               NULL, event->result);
+        break;
+      case CUT_BINARY_STREAM_EVENT_TEST_CASE_RESULT:
+        if (event->result)
+            emit_result_signal(run_context, "test-case", event->test,
+                               NULL, event->result);
+        break;
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_ITERATED_TEST:
+        g_signal_emit_by_name(run_context, "complete-iterated-test",
+                              event->test, event->test_context,
+                              event->success);
+        break;
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_TEST:
+        g_signal_emit_by_name(run_context, "complete-test",
+                              event->test, event->test_context,
+                              event->success);
+        break;
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_TEST_ITERATOR:
+        g_signal_emit_by_name(run_context, "complete-test-iterator",
+                              event->test, event->success);
+        break;
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_TEST_CASE:
+        g_signal_emit_by_name(run_context, "complete-test-case",
+                              event->test, event->success);
+        break;
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_TEST_SUITE:
+        g_signal_emit_by_name(run_context, "complete-test-suite",
+                              event->test, event->success);
+        break;
+      case CUT_BINARY_STREAM_EVENT_COMPLETE_RUN:
+        cut_run_context_emit_complete_run(run_context, event->success);
+        break;
+    }
+}
+
+static void
+detect_format (CutStreamParser *stream_parser,
+               const gchar *text, gssize text_len)
+{
+    CutStreamParserPrivate *priv = CUT_STREAM_PARSER_GET_PRIVATE(stream_parser);
+
+    if (text_len == 0)
+        return;
+
+    priv->format_detected = TRUE;
+    /* A binary stream can't be passed as a NUL-terminated string. */
+    if (text_len < 0)
+        return;
+    if (PEEK_STATE(priv) != IN_TOP_LEVEL)
+        return;
+    if (!cut_binary_stream_is_binary(text, text_len))
+        return;
+
+    priv->binary_decoder = cut_binary_stream_decoder_new(emit_binary_event,
+                                                         stream_parser);
+}
+
 gboolean
 cut_stream_parser_parse (CutStreamParser *stream_parser,
                          const gchar *text, gssize text_len, GError **error)
 {
     CutStreamParserPrivate *priv = CUT_STREAM_PARSER_GET_PRIVATE(stream_parser);
 
+    if (!priv->format_detected)
+        detect_format(stream_parser, text, text_len);
+
+    if (priv->binary_decoder)
+        return cut_binary_stream_decoder_feed(priv->binary_decoder,
+                                              text, text_len, error);
+
     return g_markup_parse_context_parse(priv->context, text, text_len, error);
 }
 
@@ -820,6 +1051,9 @@ cut_stream_parser_end_parse (CutStreamParser *stream_parser, GError **error)
 {
     CutStreamParserPrivate *priv = CUT_STREAM_PARSER_GET_PRIVATE(stream_parser);
 
+    if (priv->binary_decoder)
+        return cut_binary_stream_decoder_end(priv->binary_decoder, error);
+
     return g_markup_parse_context_end_parse(priv->context, error);
 }
 
@@ -889,9 +1123,15 @@ start_stream (CutStreamParserPrivate *priv,
     if (g_str_equal("pass-assertion", element_name)) {
         PUSH_STATE(priv, IN_PASS_ASSERTION);
         priv->pass_assertion = pass_assertion_new();
+    } else if (g_str_equal("pass-assertions", element_name)) {
+        PUSH_STATE(priv, IN_PASS_ASSERTIONS);
+        priv->pass_assertion = pass_assertion_new();
     } else if (g_str_equal("test-result", element_name)) {
         PUSH_STATE(priv, IN_TEST_RESULT);
         priv->test_result = test_result_new();
+    } else if (g_str_equal("benchmark-test", element_name)) {
+        PUSH_STATE(priv, IN_BENCHMARK_TEST);
+        priv->benchmark_test = benchmark_test_new();
     } else if (g_str_equal("ready-test-suite", element_name)) {
         PUSH_STATE(priv, IN_READY_TEST_SUITE);
         priv->ready_test_suite = ready_test_suite_new();
@@ -1088,6 +1328,18 @@ start_pass_assertion (CutStreamParserPrivate *priv,
     }
 }
 
+static void
+start_pass_assertions (CutStreamParserPrivate *priv,
+                       GMarkupParseContext *context,
+                       const gchar *element_name, GError **error)
+{
+    if (g_str_equal("n-assertions", element_name)) {
+        PUSH_STATE(priv, IN_PASS_ASSERTIONS_N_ASSERTIONS);
+    } else {
+        start_pass_assertion(priv, context, element_name, error);
+    }
+}
+
 static void
 start_test_result (CutStreamParserPrivate *priv,
                    GMarkupParseContext *context,
@@ -1114,6 +1366,53 @@ start_test_result (CutStreamParserPrivate *priv,
     }
 }
 
+static void
+start_benchmark_test (CutStreamParserPrivate *priv,
+                      GMarkupParseContext *context,
+                      const gchar *element_name, GError **error)
+{
+    if (g_str_equal("test", element_name)) {
+        PUSH_STATE(priv, IN_TEST);
+        priv->benchmark_test->test = cut_test_new_empty();
+        PUSH_TEST(priv, priv->benchmark_test->test);
+    } else if (g_str_equal("test-context", element_name)) {
+        PUSH_STATE(priv, IN_TEST_CONTEXT);
+        priv->benchmark_test->test_context = cut_test_context_new_empty();
+        PUSH_TEST_CONTEXT(priv, priv->benchmark_test->test_context);
+    } else if (g_str_equal("benchmark-result", element_name)) {
+        PUSH_STATE(priv, IN_BENCHMARK_RESULT);
+        priv->benchmark_test->result = cut_benchmark_result_new_empty();
+    } else {
+        invalid_element(priv, context, error);
+    }
+}
+
+static void
+start_benchmark_result (CutStreamParserPrivate *priv,
+                        GMarkupParseContext *context,
+                        const gchar *element_name, GError **error)
+{
+    if (g_str_equal("n-iterations", element_name)) {
+        PUSH_STATE(priv, IN_BENCHMARK_RESULT_N_ITERATIONS);
+    } else if (g_str_equal("n-samples", element_name)) {
+        PUSH_STATE(priv, IN_BENCHMARK_RESULT_N_SAMPLES);
+    } else if (g_str_equal("mean", element_name)) {
+        PUSH_STATE(priv, IN_BENCHMARK_RESULT_MEAN);
+    } else if (g_str_equal("median", element_name)) {
+        PUSH_STATE(priv, IN_BENCHMARK_RESULT_MEDIAN);
+    } else if (g_str_equal("standard-deviation", element_name)) {
+        PUSH_STATE(priv, IN_BENCHMARK_RESULT_STANDARD_DEVIATION);
+    } else if (g_str_equal("minimum", element_name)) {
+        PUSH_STATE(priv, IN_BENCHMARK_RESULT_MINIMUM);
+    } else if (g_str_equal("maximum", element_name)) {
+        PUSH_STATE(priv, IN_BENCHMARK_RESULT_MAXIMUM);
+    } else if (g_str_equal("operations-per-second", element_name)) {
+        PUSH_STATE(priv, IN_BENCHMARK_RESULT_OPERATIONS_PER_SECOND);
+    } else {
+        invalid_element(priv, context, error);
+    }
+}
+
 static void
 start_top_level_result (CutStreamParserPrivate *priv,
                         GMarkupParseContext *context,
@@ -1177,6 +1476,10 @@ start_result (CutStreamParserPrivate *priv, GMarkupParseContext *context,
         PUSH_STATE(priv, IN_RESULT_START_TIME);
     } else if (g_str_equal("elapsed", element_name)) {
         PUSH_STATE(priv, IN_RESULT_ELAPSED);
+    } else if (g_str_equal("performance-counters", element_name)) {
+        PUSH_STATE(priv, IN_RESULT_PERFORMANCE_COUNTERS);
+    } else if (g_str_equal("memory-usage", element_name)) {
+        PUSH_STATE(priv, IN_RESULT_MEMORY_USAGE);
     } else if (g_str_equal("expected", element_name)) {
         PUSH_STATE(priv, IN_RESULT_EXPECTED);
     } else if (g_str_equal("actual", element_name)) {
@@ -1374,6 +1677,32 @@ start_result_backtrace_entry (CutStreamParserPrivate *priv,
     }
 }
 
+static void
+start_result_performance_counters (CutStreamParserPrivate *priv,
+                                   GMarkupParseContext *context,
+                                   const gchar *element_name, GError **error)
+{
+    if (cut_performance_counter_type_from_name(element_name,
+                                               &(priv->performance_counter_type))) {
+        PUSH_STATE(priv, IN_RESULT_PERFORMANCE_COUNTER);
+    } else {
+        invalid_element(priv, context, error);
+    }
+}
+
+static void
+start_result_memory_usage (CutStreamParserPrivate *priv,
+                           GMarkupParseContext *context,
+                           const gchar *element_name, GError **error)
+{
+    if (cut_memory_usage_type_from_name(element_name,
+                                        &(priv->memory_usage_type))) {
+        PUSH_STATE(priv, IN_RESULT_MEMORY_USAGE_VALUE);
+    } else {
+        invalid_element(priv, context, error);
+    }
+}
+
 static void
 start_test_context (CutStreamParserPrivate *priv, GMarkupParseContext *context,
                     const gchar *element_name, GError **error)
@@ -1496,9 +1825,18 @@ start_element_handler (GMarkupParseContext *context,
       case IN_PASS_ASSERTION:
         start_pass_assertion(priv, context, element_name, error);
         break;
+      case IN_PASS_ASSERTIONS:
+        start_pass_assertions(priv, context, element_name, error);
+        break;
       case IN_TEST_RESULT:
         start_test_result(priv, context, element_name, error);
         break;
+      case IN_BENCHMARK_TEST:
+        start_benchmark_test(priv, context, element_name, error);
+        break;
+      case IN_BENCHMARK_RESULT:
+        start_benchmark_result(priv, context, element_name, error);
+        break;
       case IN_TOP_LEVEL_RESULT:
         start_top_level_result(priv, context, element_name, error);
         break;
@@ -1542,6 +1880,12 @@ start_element_handler (GMarkupParseContext *context,
       case IN_RESULT_BACKTRACE_ENTRY:
         start_result_backtrace_entry(priv, context, element_name, error);
         break;
+      case IN_RESULT_PERFORMANCE_COUNTERS:
+        start_result_performance_counters(priv, context, element_name, error);
+        break;
+      case IN_RESULT_MEMORY_USAGE:
+        start_result_memory_usage(priv, context, element_name, error);
+        break;
       case IN_TEST_CONTEXT:
         start_test_context(priv, context, element_name, error);
         break;
@@ -1839,6 +2183,28 @@ end_pass_assertion (CutStreamParser *parser, CutStreamParserPrivate *priv,
     priv->pass_assertion = NULL;
 }
 
+static void
+end_pass_assertions (CutStreamParser *parser, CutStreamParserPrivate *priv,
+                     GMarkupParseContext *context,
+                     const gchar *element_name, GError **error)
+{
+    if (!priv->pass_assertion)
+        return;
+
+    if (priv->run_context && priv->pass_assertion->n_assertions > 0)
+        g_signal_emit_by_name(priv->run_context, "pass-assertions",
+                              priv->pass_assertion->test,
+                              priv->pass_assertion->test_context,
+                              priv->pass_assertion->n_assertions);
+
+    if (priv->pass_assertion->test)
+        DROP_TEST(priv);
+    if (priv->pass_assertion->test_context)
+        DROP_TEST_CONTEXT(priv);
+    pass_assertion_free(priv->pass_assertion);
+    priv->pass_assertion = NULL;
+}
+
 static void
 end_test_result (CutStreamParser *parser, CutStreamParserPrivate *priv,
                  GMarkupParseContext *context,
@@ -1873,6 +2239,28 @@ end_test_result (CutStreamParser *parser, CutStreamParserPrivate *priv,
     priv->result = NULL;
 }
 
+static void
+end_benchmark_test (CutStreamParser *parser, CutStreamParserPrivate *priv,
+                    GMarkupParseContext *context,
+                    const gchar *element_name, GError **error)
+{
+    if (!priv->benchmark_test)
+        return;
+
+    if (priv->run_context && priv->benchmark_test->result)
+        g_signal_emit_by_name(priv->run_context, "benchmark-test",
+                              priv->benchmark_test->test,
+                              priv->benchmark_test->test_context,
+                              priv->benchmark_test->result);
+
+    if (priv->benchmark_test->test)
+        DROP_TEST(priv);
+    if (priv->benchmark_test->test_context)
+        DROP_TEST_CONTEXT(priv);
+    benchmark_test_free(priv->benchmark_test);
+    priv->benchmark_test = NULL;
+}
+
 static void
 end_complete_iterated_test (CutStreamParser *parser,
                             CutStreamParserPrivate *priv,
@@ -2103,9 +2491,15 @@ end_element_handler (GMarkupParseContext *context,
     case IN_PASS_ASSERTION:
         end_pass_assertion(parser, priv, context, element_name, error);
         break;
+    case IN_PASS_ASSERTIONS:
+        end_pass_assertions(parser, priv, context, element_name, error);
+        break;
     case IN_TEST_RESULT:
         end_test_result(parser, priv, context, element_name, error);
         break;
+    case IN_BENCHMARK_TEST:
+        end_benchmark_test(parser, priv, context, element_name, error);
+        break;
     case IN_COMPLETE_ITERATED_TEST:
         end_complete_iterated_test(parser, priv, context, element_name, error);
         break;
@@ -2416,6 +2810,45 @@ text_result_elapsed (CutStreamParserPrivate *priv, GMarkupParseContext *context,
     }
 }
 
+static void
+text_result_performance_counter (CutStreamParserPrivate *priv,
+                                 GMarkupParseContext *context,
+                                 const gchar *text, gsize text_len,
+                                 GError **error)
+{
+    if (!is_integer(text) || text[0] == '\0') {
+        set_parse_error(priv, context, error,
+                        "invalid %s value: %s",
+                        cut_performance_counter_type_to_name(
+                            priv->performance_counter_type),
+                        text);
+        return;
+    }
+
+    cut_test_result_set_performance_counter(priv->result,
+                                            priv->performance_counter_type,
+                                            g_ascii_strtoll(text, NULL, 10));
+}
+
+static void
+text_result_memory_usage_value (CutStreamParserPrivate *priv,
+                                GMarkupParseContext *context,
+                                const gchar *text, gsize text_len,
+                                GError **error)
+{
+    if (!is_integer(text) || text[0] == '\0') {
+        set_parse_error(priv, context, error,
+                        "invalid %s value: %s",
+                        cut_memory_usage_type_to_name(priv->memory_usage_type),
+                        text);
+        return;
+    }
+
+    cut_test_result_set_memory_usage(priv->result,
+                                     priv->memory_usage_type,
+                                     g_ascii_strtoll(text, NULL, 10));
+}
+
 static void
 text_result_expected (CutStreamParserPrivate *priv, GMarkupParseContext *context,
                       const gchar *text, gsize text_len, GError **error)
@@ -2484,6 +2917,85 @@ text_ready_test_case_n_tests (CutStreamParserPrivate *priv,
     }
 }
 
+static void
+text_pass_assertions_n_assertions (CutStreamParserPrivate *priv,
+                                   GMarkupParseContext *context,
+                                   const gchar *text, gsize text_len,
+                                   GError **error)
+{
+    if (is_integer(text)) {
+        priv->pass_assertion->n_assertions = atoi(text);
+    } else {
+        set_parse_error(priv, context, error,
+                        "invalid # of assertions: %s", text);
+    }
+}
+
+static void
+text_benchmark_result_n (CutStreamParserPrivate *priv,
+                         GMarkupParseContext *context,
+                         ParseState state,
+                         const gchar *text, gsize text_len, GError **error)
+{
+    CutBenchmarkResult *result;
+    guint value;
+
+    if (!is_integer(text)) {
+        set_parse_error(priv, context, error,
+                        "invalid # of benchmark %s: %s",
+                        state == IN_BENCHMARK_RESULT_N_ITERATIONS ?
+                        "iterations" : "samples",
+                        text);
+        return;
+    }
+
+    result = priv->benchmark_test->result;
+    value = atoi(text);
+    if (state == IN_BENCHMARK_RESULT_N_ITERATIONS)
+        cut_benchmark_result_set_n_iterations(result, value);
+    else
+        cut_benchmark_result_set_n_samples(result, value);
+}
+
+static void
+text_benchmark_result_time (CutStreamParserPrivate *priv,
+                            GMarkupParseContext *context,
+                            ParseState state,
+                            const gchar *text, gsize text_len, GError **error)
+{
+    CutBenchmarkResult *result;
+    gdouble value;
+    gchar *end_position;
+
+    value = g_ascii_strtod(text, &end_position);
+    if (text == end_position || end_position[0] != '\0') {
+        set_parse_error(priv, context, error,
+                        "invalid benchmark time value: %s", text);
+        return;
+    }
+
+    result = priv->benchmark_test->result;
+    switch (state) {
+      case IN_BENCHMARK_RESULT_MEAN:
+        cut_benchmark_result_set_mean(result, value);
+        break;
+      case IN_BENCHMARK_RESULT_MEDIAN:
+        cut_benchmark_result_set_median(result, value);
+        break;
+      case IN_BENCHMARK_RESULT_STANDARD_DEVIATION:
+        cut_benchmark_result_set_standard_deviation(result, value);
+        break;
+      case IN_BENCHMARK_RESULT_MINIMUM:
+        cut_benchmark_result_set_minimum(result, value);
+        break;
+      case IN_BENCHMARK_RESULT_MAXIMUM:
+        cut_benchmark_result_set_maximum(result, value);
+        break;
+      default:
+        break;
+    }
+}
+
 static void
 text_ready_test_iterator_n_tests (CutStreamParserPrivate *priv,
                                   GMarkupParseContext *context,
@@ -2598,6 +3110,12 @@ text_handler (GMarkupParseContext *context,
     case IN_RESULT_ELAPSED:
         text_result_elapsed(priv, context, text, text_len, error);
         break;
+    case IN_RESULT_PERFORMANCE_COUNTER:
+        text_result_performance_counter(priv, context, text, text_len, error);
+        break;
+    case IN_RESULT_MEMORY_USAGE_VALUE:
+        text_result_memory_usage_value(priv, context, text, text_len, error);
+        break;
     case IN_RESULT_EXPECTED:
         text_result_expected(priv, context, text, text_len, error);
         break;
@@ -2622,6 +3140,21 @@ text_handler (GMarkupParseContext *context,
     case IN_READY_TEST_ITERATOR_N_TESTS:
         text_ready_test_iterator_n_tests(priv, context, text, text_len, error);
         break;
+    case IN_PASS_ASSERTIONS_N_ASSERTIONS:
+        text_pass_assertions_n_assertions(priv, context, text, text_len, error);
+        break;
+    case IN_BENCHMARK_RESULT_N_ITERATIONS:
+    case IN_BENCHMARK_RESULT_N_SAMPLES:
+        text_benchmark_result_n(priv, context, state, text, text_len, error);
+        break;
+    case IN_BENCHMARK_RESULT_MEAN:
+    case IN_BENCHMARK_RESULT_MEDIAN:
+    case IN_BENCHMARK_RESULT_STANDARD_DEVIATION:
+    case IN_BENCHMARK_RESULT_MINIMUM:
+    case IN_BENCHMARK_RESULT_MAXIMUM:
+        text_benchmark_result_time(priv, context, state,
+                                   text, text_len, error);
+        break;
     case IN_TEST_DATA_NAME:
         text_test_data_name(priv, context, text, text_len, error);
         break;
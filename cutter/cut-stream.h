@@ -34,6 +34,10 @@ G_BEGIN_DECLS
 typedef gboolean (*CutStreamFunction) (const gchar *message,
                                        GError **error,
                                        gpointer user_data);
+typedef gboolean (*CutStreamDataFunction) (const gchar *data,
+                                           gsize length,
+                                           GError **error,
+                                           gpointer user_data);
 
 typedef struct _CutStream         CutStream;
 typedef struct _CutStreamClass    CutStreamClass;
@@ -32,6 +32,8 @@
 #include "cut-run-context.h"
 #include "cut-test-result.h"
 #include "cut-crash-backtrace.h"
+#include "cut-test-scheduler.h"
+#include "cut-glib-compatible.h"
 
 #include <gcutter/gcut-marshalers.h>
 
@@ -421,6 +423,7 @@ run_test (CutTestCase *test_case, CutTest *test,
                               test, test_context, success);
     } else {
         cut_test_case_run_teardown(test_case, test_context);
+        cut_test_context_flush_pass_assertions(test_context);
         g_signal_emit_by_name(test_case, "complete-test",
                               test, test_context, success);
     }
@@ -706,6 +709,227 @@ cut_test_case_run_with_filter (CutTestCase *test_case,
     return success;
 }
 
+typedef struct _ScheduledRun
+{
+    CutTestCase *test_case;
+    CutRunContext *run_context;
+    CutTestScheduler *scheduler;
+    CutTestContext *test_context;
+    GList *tests;
+    volatile gint n_running_tests;
+    GMutex *mutex;
+    CutTestResultStatus status;
+    gboolean all_success;
+    CutTestCaseCompleteNotify notify;
+    gpointer user_data;
+} ScheduledRun;
+
+typedef struct _ScheduledTest
+{
+    ScheduledRun *scheduled_run;
+    CutTest *test;
+} ScheduledTest;
+
+static void
+cb_scheduled_status (GObject *object, CutTestContext *test_context,
+                     CutTestResult *result, gpointer data)
+{
+    ScheduledRun *scheduled_run = data;
+
+    g_mutex_lock(scheduled_run->mutex);
+    scheduled_run->status = MAX(scheduled_run->status,
+                                cut_test_result_get_status(result));
+    g_mutex_unlock(scheduled_run->mutex);
+}
+
+static void
+finish_scheduled_run (ScheduledRun *scheduled_run)
+{
+    CutTestCase *test_case;
+    CutTestResult *result;
+
+    test_case = scheduled_run->test_case;
+
+    cut_test_context_current_push(scheduled_run->test_context);
+    cut_test_case_run_shutdown(test_case, scheduled_run->test_context);
+    cut_test_context_current_pop();
+
+    g_signal_handlers_disconnect_by_func(test_case,
+                                         G_CALLBACK(cb_scheduled_status),
+                                         scheduled_run);
+    result = cut_test_result_new(scheduled_run->status,
+                                 NULL, NULL, test_case, NULL, NULL,
+                                 NULL, NULL, NULL);
+    cut_test_case_emit_result_signal(test_case, result);
+    g_object_unref(result);
+
+    g_signal_emit_by_name(CUT_TEST(test_case), "complete",
+                          NULL, scheduled_run->all_success);
+
+    if (scheduled_run->notify)
+        scheduled_run->notify(test_case, scheduled_run->all_success,
+                              scheduled_run->user_data);
+
+    g_object_unref(scheduled_run->test_context);
+    g_object_unref(scheduled_run->test_case);
+    g_object_unref(scheduled_run->run_context);
+    g_list_free(scheduled_run->tests);
+    g_mutex_free(scheduled_run->mutex);
+    g_free(scheduled_run);
+}
+
+static void
+run_scheduled_test (gpointer data)
+{
+    ScheduledTest *scheduled_test = data;
+    ScheduledRun *scheduled_run;
+    CutTest *test;
+
+    scheduled_run = scheduled_test->scheduled_run;
+    test = scheduled_test->test;
+    g_free(scheduled_test);
+
+#define CONNECT(event)                                  \
+    g_signal_connect(test, #event,                      \
+                     G_CALLBACK(cb_scheduled_status),   \
+                     scheduled_run)
+
+    CONNECT(success);
+    CONNECT(failure);
+    CONNECT(error);
+    CONNECT(pending);
+    CONNECT(notification);
+    CONNECT(omission);
+    CONNECT(crash);
+
+#undef CONNECT
+
+    if (!run(scheduled_run->test_case, test, scheduled_run->run_context)) {
+        g_mutex_lock(scheduled_run->mutex);
+        scheduled_run->all_success = FALSE;
+        g_mutex_unlock(scheduled_run->mutex);
+    }
+
+    g_signal_handlers_disconnect_by_func(test,
+                                         G_CALLBACK(cb_scheduled_status),
+                                         scheduled_run);
+
+    if (g_atomic_int_dec_and_test(&(scheduled_run->n_running_tests)))
+        finish_scheduled_run(scheduled_run);
+}
+
+static void
+start_scheduled_run (ScheduledRun *scheduled_run)
+{
+    CutTestCase *test_case;
+    CutRunContext *run_context;
+    CutTestContext *test_context;
+    CutTestSuite *test_suite;
+    GList *node;
+
+    test_case = scheduled_run->test_case;
+    run_context = scheduled_run->run_context;
+
+    g_signal_emit_by_name(test_case, "ready",
+                          g_list_length(scheduled_run->tests));
+    g_signal_emit_by_name(CUT_TEST(test_case), "start", NULL);
+
+    test_suite = cut_run_context_get_test_suite(run_context);
+    test_context = cut_test_context_new(run_context,
+                                        test_suite, test_case, NULL, NULL);
+    scheduled_run->test_context = test_context;
+
+#define CONNECT(event)                                  \
+    g_signal_connect(test_case, #event "-in",           \
+                     G_CALLBACK(cb_scheduled_status),   \
+                     scheduled_run)
+
+    CONNECT(failure);
+    CONNECT(error);
+    CONNECT(pending);
+    CONNECT(notification);
+    CONNECT(omission);
+    CONNECT(crash);
+
+#undef CONNECT
+
+    cut_test_context_current_push(test_context);
+    cut_test_case_run_startup(test_case, test_context);
+    cut_test_context_current_pop();
+
+    if (cut_test_context_is_failed(test_context))
+        scheduled_run->all_success = FALSE;
+
+    if (!scheduled_run->all_success ||
+        scheduled_run->status == CUT_TEST_RESULT_OMISSION ||
+        !scheduled_run->tests) {
+        finish_scheduled_run(scheduled_run);
+        return;
+    }
+
+    g_atomic_int_set(&(scheduled_run->n_running_tests),
+                     g_list_length(scheduled_run->tests));
+    /* The current worker pops the last pushed job first. We push
+     * tests in reverse order to run them in the defined order. */
+    for (node = g_list_last(scheduled_run->tests);
+         node;
+         node = g_list_previous(node)) {
+        ScheduledTest *scheduled_test;
+
+        scheduled_test = g_new0(ScheduledTest, 1);
+        scheduled_test->scheduled_run = scheduled_run;
+        scheduled_test->test = node->data;
+        cut_test_scheduler_push(scheduled_run->scheduler,
+                                run_scheduled_test, scheduled_test);
+    }
+}
+
+void
+cut_test_case_run_with_scheduler (CutTestCase *test_case,
+                                  CutRunContext *run_context,
+                                  CutTestScheduler *scheduler,
+                                  const gchar **test_names,
+                                  CutTestCaseCompleteNotify notify,
+                                  gpointer user_data)
+{
+    ScheduledRun *scheduled_run;
+    GList *filtered_tests, *node;
+
+    g_return_if_fail(CUT_IS_TEST_CASE(test_case));
+
+    filtered_tests = get_filtered_tests(test_case, test_names);
+    if (!filtered_tests) {
+        if (notify)
+            notify(test_case, TRUE, user_data);
+        return;
+    }
+
+    scheduled_run = g_new0(ScheduledRun, 1);
+    scheduled_run->test_case = g_object_ref(test_case);
+    scheduled_run->run_context = g_object_ref(run_context);
+    scheduled_run->scheduler = scheduler;
+    scheduled_run->test_context = NULL;
+    scheduled_run->tests = NULL;
+    for (node = filtered_tests; node; node = g_list_next(node)) {
+        if (CUT_IS_TEST(node->data)) {
+            scheduled_run->tests = g_list_prepend(scheduled_run->tests,
+                                                  node->data);
+        } else {
+            g_warning("This object is not CutTest object");
+        }
+    }
+    scheduled_run->tests = g_list_reverse(scheduled_run->tests);
+    g_list_free(filtered_tests);
+    scheduled_run->n_running_tests = 0;
+    scheduled_run->mutex = g_mutex_new();
+    scheduled_run->status = CUT_TEST_RESULT_SUCCESS;
+    scheduled_run->all_success = TRUE;
+    scheduled_run->notify = notify;
+    scheduled_run->user_data = user_data;
+
+    start_scheduled_run(scheduled_run);
+}
+
 gboolean
 cut_test_case_run (CutTestCase *test_case, CutRunContext *run_context)
 {
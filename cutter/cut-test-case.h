@@ -37,6 +37,10 @@ G_BEGIN_DECLS
 typedef void (*CutStartupFunction)    (void);
 typedef void (*CutShutdownFunction)   (void);
 
+typedef void (*CutTestCaseCompleteNotify) (CutTestCase *test_case,
+                                           gboolean     success,
+                                           gpointer     user_data);
+
 typedef struct _CutTestCaseClass CutTestCaseClass;
 
 struct _CutTestCase
@@ -105,6 +109,13 @@ gboolean     cut_test_case_run_test       (CutTestCase   *test_case,
 gboolean     cut_test_case_run_with_filter(CutTestCase   *test_case,
                                            CutRunContext *run_context,
                                            const gchar  **test_names);
+void         cut_test_case_run_with_scheduler
+                                          (CutTestCase      *test_case,
+                                           CutRunContext    *run_context,
+                                           CutTestScheduler *scheduler,
+                                           const gchar     **test_names,
+                                           CutTestCaseCompleteNotify notify,
+                                           gpointer          user_data);
 
 void         cut_test_case_run_setup      (CutTestCase    *test_case,
                                            CutTestContext *test_context);
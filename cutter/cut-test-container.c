@@ -99,6 +99,20 @@ cut_test_container_add_test (CutTestContainer *container, CutTest *test)
     }
 }
 
+void
+cut_test_container_remove_test (CutTestContainer *container, CutTest *test)
+{
+    CutTestContainerPrivate *priv = CUT_TEST_CONTAINER_GET_PRIVATE(container);
+    GList *node;
+
+    node = g_list_find(priv->tests, test);
+    if (!node)
+        return;
+
+    priv->tests = g_list_delete_link(priv->tests, node);
+    g_object_unref(test);
+}
+
 GList *
 cut_test_container_get_children (CutTestContainer *container)
 {
@@ -50,6 +50,8 @@ GType        cut_test_container_get_type     (void) G_GNUC_CONST;
 
 void         cut_test_container_add_test     (CutTestContainer *container,
                                               CutTest          *test);
+void         cut_test_container_remove_test  (CutTestContainer *container,
+                                              CutTest          *test);
 GList       *cut_test_container_get_children (CutTestContainer *container);
 GList       *cut_test_container_filter_children
                                              (CutTestContainer *container,
@@ -53,6 +53,7 @@
 #include "cut-process.h"
 #include "cut-backtrace-entry.h"
 #include "cut-utils.h"
+#include "cut-arena.h"
 #include "cut-glib-compatible.h"
 
 #define CUT_SIGNAL_EXPLICIT_JUMP G_MININT
@@ -80,6 +81,7 @@ struct _CutTestContextPrivate
     gboolean is_multi_thread;
     jmp_buf *jump_buffer;
     GList *taken_objects;
+    CutArena *arena;
     GList *taken_string_arrays;
     GList *taken_g_objects;
     GList *taken_errors;
@@ -100,6 +102,7 @@ struct _CutTestContextPrivate
     guint user_message_jump_nest;
     GThread *main_thread;
     CutTestContext *parent;
+    gint n_pending_assertions;
 };
 
 enum
@@ -268,6 +271,7 @@ cut_test_context_init (CutTestContext *context)
     priv->is_multi_thread = FALSE;
 
     priv->taken_objects = NULL;
+    priv->arena = NULL;
 
     priv->data_list = NULL;
     priv->current_data = NULL;
@@ -295,6 +299,7 @@ cut_test_context_init (CutTestContext *context)
     priv->main_thread = g_thread_self();
 
     priv->parent = NULL;
+    priv->n_pending_assertions = 0;
 }
 
 static void
@@ -350,6 +355,17 @@ dispose (GObject *object)
 {
     CutTestContextPrivate *priv = CUT_TEST_CONTEXT_GET_PRIVATE(object);
 
+    if (priv->parent && priv->n_pending_assertions > 0) {
+        CutTestContextPrivate *parent_priv;
+
+        /* A sub context is gone with its thread. Its parent
+         * reports the passed assertions. */
+        parent_priv = CUT_TEST_CONTEXT_GET_PRIVATE(priv->parent);
+        g_atomic_int_add(&(parent_priv->n_pending_assertions),
+                         priv->n_pending_assertions);
+        priv->n_pending_assertions = 0;
+    }
+
     if (priv->run_context) {
         g_object_unref(priv->run_context);
         priv->run_context = NULL;
@@ -387,6 +403,11 @@ dispose (GObject *object)
         priv->taken_objects = NULL;
     }
 
+    if (priv->arena) {
+        cut_arena_free(priv->arena);
+        priv->arena = NULL;
+    }
+
     free_data_list(priv);
 
     if (priv->fixture_data_dir) {
@@ -686,8 +707,10 @@ cut_test_context_set_test (CutTestContext *context, CutTest *test)
 {
     CutTestContextPrivate *priv = CUT_TEST_CONTEXT_GET_PRIVATE(context);
 
-    if (priv->test)
+    if (priv->test) {
+        cut_test_context_flush_pass_assertions(context);
         g_object_unref(priv->test);
+    }
     if (test)
         g_object_ref(test);
     priv->test = test;
@@ -883,7 +906,34 @@ cut_test_context_pass_assertion (CutTestContext *context)
     g_return_if_fail(priv->test);
 
     clear_user_message(priv);
-    g_signal_emit_by_name(priv->test, "pass-assertion", context);
+    if (priv->run_context &&
+        !cut_run_context_need_pass_assertion_events(priv->run_context)) {
+        g_atomic_int_inc(&(priv->n_pending_assertions));
+    } else {
+        g_signal_emit_by_name(priv->test, "pass-assertion", context);
+    }
+}
+
+void
+cut_test_context_flush_pass_assertions (CutTestContext *context)
+{
+    CutTestContextPrivate *priv;
+    gint n_assertions;
+
+    priv = CUT_TEST_CONTEXT_GET_PRIVATE(context);
+    if (!priv->test)
+        return;
+
+    do {
+        n_assertions = g_atomic_int_get(&(priv->n_pending_assertions));
+    } while (n_assertions > 0 &&
+             !g_atomic_int_compare_and_exchange(&(priv->n_pending_assertions),
+                                                n_assertions, 0));
+    if (n_assertions == 0)
+        return;
+
+    g_signal_emit_by_name(priv->test, "pass-assertions",
+                          context, (guint)n_assertions);
 }
 
 static CutProcess *
@@ -1103,11 +1153,27 @@ cut_test_context_take_string (CutTestContext *context,
     return cut_test_context_take(context, string, g_free);
 }
 
+/* Copies that don't need a destroy function are allocated from
+ * the arena. They are released at once with the context. A test
+ * runs with its own context, so they live only while the test
+ * runs. */
+static CutArena *
+get_arena (CutTestContext *context)
+{
+    CutTestContextPrivate *priv;
+
+    priv = CUT_TEST_CONTEXT_GET_PRIVATE(context);
+    if (!priv->arena)
+        priv->arena = cut_arena_new();
+
+    return priv->arena;
+}
+
 const char *
 cut_test_context_take_strdup (CutTestContext *context,
                               const char     *string)
 {
-    return cut_test_context_take_string(context, g_strdup(string));
+    return cut_arena_strdup(get_arena(context), string);
 }
 
 const char *
@@ -1115,7 +1181,7 @@ cut_test_context_take_strndup (CutTestContext *context,
                                const char     *string,
                                size_t          size)
 {
-    return cut_test_context_take_string(context, g_strndup(string, size));
+    return cut_arena_strndup(get_arena(context), string, size);
 }
 
 const void *
@@ -1123,7 +1189,7 @@ cut_test_context_take_memdup (CutTestContext *context,
                               const void     *memory,
                               size_t          size)
 {
-    return cut_test_context_take_memory(context, g_memdup(memory, size));
+    return cut_arena_memdup(get_arena(context), memory, size);
 }
 
 const char *
@@ -1133,11 +1199,8 @@ cut_test_context_take_printf (CutTestContext *context, const char *format, ...)
     va_list args;
 
     va_start(args, format);
-    if (format) {
-        char *formatted_string;
-        formatted_string = g_strdup_vprintf(format, args);
-        taken_string = cut_test_context_take_string(context, formatted_string);
-    }
+    if (format)
+        taken_string = cut_arena_vprintf(get_arena(context), format, args);
     va_end(args);
 
     return taken_string;
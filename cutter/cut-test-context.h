@@ -111,6 +111,8 @@ gboolean      cut_test_context_need_test_run  (CutTestContext *context);
 
 void          cut_test_context_emit_signal    (CutTestContext *context,
                                                CutTestResult  *result);
+void          cut_test_context_flush_pass_assertions
+                                              (CutTestContext *context);
 
 gchar        *cut_test_context_to_xml         (CutTestContext *context);
 void          cut_test_context_to_xml_string  (CutTestContext *context,
@@ -34,6 +34,7 @@
 #include "cut-test-result.h"
 #include "cut-utils.h"
 #include "cut-crash-backtrace.h"
+#include "cut-test-scheduler.h"
 
 #include "../gcutter/gcut-error.h"
 #include "../gcutter/gcut-marshalers.h"
@@ -256,6 +257,8 @@ typedef struct _RunTestInfo
     CutIteratedTest *iterated_test;
     CutTestContext *test_context;
     CutTestContext *parent_test_context;
+    gboolean *success;
+    volatile gint *n_pending_tests;
 } RunTestInfo;
 
 static void
@@ -330,6 +333,7 @@ run_test_without_thread (gpointer data, gpointer user_data)
     }
 
     cut_test_case_run_teardown(test_case, test_context);
+    cut_test_context_flush_pass_assertions(test_context);
 
     cut_test_context_set_failed(parent_test_context,
                                 cut_test_context_is_failed(test_context));
@@ -350,11 +354,24 @@ run_test_without_thread (gpointer data, gpointer user_data)
     g_free(info);
 }
 
+static void
+run_scheduled_iterated_test (gpointer data)
+{
+    RunTestInfo *info = data;
+    volatile gint *n_pending_tests;
+
+    n_pending_tests = info->n_pending_tests;
+    run_test_without_thread(info, info->success);
+    g_atomic_int_add(n_pending_tests, -1);
+}
+
 static void
 run_test_with_thread_support (CutTestIterator *test_iterator,
                               CutIteratedTest *iterated_test,
                               CutTestContext *test_context,
                               CutRunContext *run_context,
+                              CutTestScheduler *scheduler,
+                              volatile gint *n_pending_tests,
                               GThreadPool *thread_pool,
                               gboolean *success)
 {
@@ -394,7 +411,14 @@ run_test_with_thread_support (CutTestIterator *test_iterator,
     info->iterated_test = g_object_ref(iterated_test);
     info->test_context = local_test_context;
     info->parent_test_context = g_object_ref(test_context);
-    if (is_multi_thread && thread_pool) {
+    info->success = success;
+    info->n_pending_tests = n_pending_tests;
+    if (is_multi_thread && scheduler) {
+        g_atomic_int_inc(n_pending_tests);
+        cut_test_scheduler_push_to_group(scheduler, n_pending_tests,
+                                         run_scheduled_iterated_test, info);
+        need_no_thread_run = FALSE;
+    } else if (is_multi_thread && thread_pool) {
         GError *error = NULL;
 
         g_thread_pool_push(thread_pool, info, &error);
@@ -430,16 +454,25 @@ run_iterated_tests (CutTest *test, CutTestContext *test_context,
     GList *node, *iterated_tests = NULL, *filtered_tests = NULL;
     const gchar **test_names;
     guint n_tests;
+    CutTestScheduler *scheduler;
+    volatile gint n_pending_tests = 0;
     GThreadPool *thread_pool = NULL;
 
-    thread_pool = g_thread_pool_new(run_test_without_thread,
-                                    all_success,
-                                    cut_run_context_get_max_threads(run_context),
-                                    FALSE,
-                                    &error);
-    if (error) {
-        cut_utils_report_error(error);
-        return;
+    /* Iterated tests are run by workers of the current scheduler if
+     * we are in a scheduler's job. We don't need a nested thread
+     * pool in the case. */
+    scheduler = cut_test_scheduler_get_current();
+    if (!scheduler) {
+        thread_pool =
+            g_thread_pool_new(run_test_without_thread,
+                              all_success,
+                              cut_run_context_get_max_threads(run_context),
+                              FALSE,
+                              &error);
+        if (error) {
+            cut_utils_report_error(error);
+            return;
+        }
     }
 
     priv = CUT_TEST_ITERATOR_GET_PRIVATE(test);
@@ -489,10 +522,13 @@ run_iterated_tests (CutTest *test, CutTestContext *test_context,
 
         run_test_with_thread_support(test_iterator, iterated_test,
                                      test_context, run_context,
+                                     scheduler, &n_pending_tests,
                                      thread_pool, all_success);
     }
     g_list_free(filtered_tests);
 
+    if (scheduler)
+        cut_test_scheduler_wait(scheduler, &n_pending_tests);
     if (thread_pool)
         g_thread_pool_free(thread_pool, FALSE, TRUE);
 
@@ -36,7 +36,7 @@
 #include "cut-utils.h"
 #include "cut-readable-differ.h"
 
-#define MAX_DIFF_TARGET_SIZE 8092
+#define DEFAULT_MAX_DIFF_TARGET_SIZE 8092
 
 #define CUT_TEST_RESULT_GET_PRIVATE(obj) (G_TYPE_INSTANCE_GET_PRIVATE ((obj), CUT_TYPE_TEST_RESULT, CutTestResultPrivate))
 
@@ -56,12 +56,15 @@ struct _CutTestResultPrivate
     GList *backtrace;
     GTimeVal start_time;
     gdouble elapsed;
+    gint64 performance_counters[CUT_PERFORMANCE_COUNTER_N_TYPES];
+    gint64 memory_usage[CUT_MEMORY_USAGE_N_TYPES];
     gchar *expected;
     gchar *actual;
     gchar *diff;
     gchar *folded_diff;
     gboolean user_set_diff;
     gboolean user_set_folded_diff;
+    gboolean diff_summarized;
 };
 
 enum
@@ -215,6 +218,7 @@ static void
 cut_test_result_init (CutTestResult *result)
 {
     CutTestResultPrivate *priv = CUT_TEST_RESULT_GET_PRIVATE(result);
+    gint i;
 
     priv->status = CUT_TEST_RESULT_SUCCESS;
     priv->test = NULL;
@@ -230,12 +234,19 @@ cut_test_result_init (CutTestResult *result)
     priv->start_time.tv_sec = 0;
     priv->start_time.tv_usec = 0;
     priv->elapsed = 0.0;
+    for (i = 0; i < CUT_PERFORMANCE_COUNTER_N_TYPES; i++) {
+        priv->performance_counters[i] = -1;
+    }
+    for (i = 0; i < CUT_MEMORY_USAGE_N_TYPES; i++) {
+        priv->memory_usage[i] = -1;
+    }
     priv->expected = NULL;
     priv->actual = NULL;
     priv->diff = NULL;
     priv->folded_diff= NULL;
     priv->user_set_diff = FALSE;
     priv->user_set_folded_diff = FALSE;
+    priv->diff_summarized = FALSE;
 }
 
 static void
@@ -679,6 +690,56 @@ cut_test_result_get_elapsed (CutTestResult *result)
     return CUT_TEST_RESULT_GET_PRIVATE(result)->elapsed;
 }
 
+gint64
+cut_test_result_get_performance_counter (CutTestResult *result,
+                                         CutPerformanceCounterType type)
+{
+    if (type >= CUT_PERFORMANCE_COUNTER_N_TYPES)
+        return -1;
+
+    return CUT_TEST_RESULT_GET_PRIVATE(result)->performance_counters[type];
+}
+
+gboolean
+cut_test_result_has_performance_counters (CutTestResult *result)
+{
+    CutTestResultPrivate *priv;
+    gint i;
+
+    priv = CUT_TEST_RESULT_GET_PRIVATE(result);
+    for (i = 0; i < CUT_PERFORMANCE_COUNTER_N_TYPES; i++) {
+        if (priv->performance_counters[i] >= 0)
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+gint64
+cut_test_result_get_memory_usage (CutTestResult *result,
+                                  CutMemoryUsageType type)
+{
+    if (type >= CUT_MEMORY_USAGE_N_TYPES)
+        return -1;
+
+    return CUT_TEST_RESULT_GET_PRIVATE(result)->memory_usage[type];
+}
+
+gboolean
+cut_test_result_has_memory_usage (CutTestResult *result)
+{
+    CutTestResultPrivate *priv;
+    gint i;
+
+    priv = CUT_TEST_RESULT_GET_PRIVATE(result);
+    for (i = 0; i < CUT_MEMORY_USAGE_N_TYPES; i++) {
+        if (priv->memory_usage[i] >= 0)
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
 const gchar *
 cut_test_result_get_expected (CutTestResult *result)
 {
@@ -691,6 +752,31 @@ cut_test_result_get_actual (CutTestResult *result)
     return CUT_TEST_RESULT_GET_PRIVATE(result)->actual;
 }
 
+static gsize max_diff_target_size = DEFAULT_MAX_DIFF_TARGET_SIZE;
+
+void
+cut_test_result_set_max_diff_target_size (gsize size)
+{
+    max_diff_target_size = size;
+}
+
+gsize
+cut_test_result_get_max_diff_target_size (void)
+{
+    return max_diff_target_size;
+}
+
+gboolean
+cut_test_result_is_diff_target_too_large (const gchar *expected,
+                                          const gchar *actual)
+{
+    if (max_diff_target_size == 0)
+        return FALSE;
+
+    return strlen(expected) >= max_diff_target_size ||
+        strlen(actual) >= max_diff_target_size;
+}
+
 const gchar *
 cut_test_result_get_diff (CutTestResult *result)
 {
@@ -701,9 +787,14 @@ cut_test_result_get_diff (CutTestResult *result)
     if (priv->diff)
         return priv->diff;
 
-    if (priv->expected && priv->actual &&
-        strlen(priv->expected) < MAX_DIFF_TARGET_SIZE &&
-        strlen(priv->actual) < MAX_DIFF_TARGET_SIZE) {
+    if (!priv->expected || !priv->actual)
+        return NULL;
+
+    if (cut_test_result_is_diff_target_too_large(priv->expected,
+                                                 priv->actual)) {
+        priv->diff = cut_diff_readable_summary(priv->expected, priv->actual);
+        priv->diff_summarized = TRUE;
+    } else {
         priv->diff = cut_diff_readable(priv->expected, priv->actual);
         if (!cut_diff_readable_is_interested(priv->diff)) {
             g_free(priv->diff);
@@ -726,7 +817,7 @@ cut_test_result_get_folded_diff (CutTestResult *result)
         return priv->folded_diff;
 
     diff = cut_test_result_get_diff(result);
-    if (cut_diff_readable_need_fold(diff)) {
+    if (!priv->diff_summarized && cut_diff_readable_need_fold(diff)) {
         priv->folded_diff =
             cut_diff_readable_folded(priv->expected, priv->actual);
     }
@@ -734,6 +825,36 @@ cut_test_result_get_folded_diff (CutTestResult *result)
     return priv->folded_diff;
 }
 
+const gchar *
+cut_test_result_get_explicit_message (CutTestResult *result)
+{
+    CutTestResultPrivate *priv = CUT_TEST_RESULT_GET_PRIVATE(result);
+
+    if (!priv->user_set_message)
+        return NULL;
+    return priv->message;
+}
+
+const gchar *
+cut_test_result_get_explicit_diff (CutTestResult *result)
+{
+    CutTestResultPrivate *priv = CUT_TEST_RESULT_GET_PRIVATE(result);
+
+    if (!priv->user_set_diff)
+        return NULL;
+    return priv->diff;
+}
+
+const gchar *
+cut_test_result_get_explicit_folded_diff (CutTestResult *result)
+{
+    CutTestResultPrivate *priv = CUT_TEST_RESULT_GET_PRIVATE(result);
+
+    if (!priv->user_set_folded_diff)
+        return NULL;
+    return priv->folded_diff;
+}
+
 gchar *
 cut_test_result_to_xml (CutTestResult *result)
 {
@@ -796,6 +917,64 @@ append_backtrace_to_string (GString *string, CutTestResult *result, guint indent
     g_string_append(string, "</backtrace>\n");
 }
 
+static void
+append_performance_counters_to_string (GString *string, CutTestResult *result,
+                                       guint indent)
+{
+    gint i;
+
+    if (!cut_test_result_has_performance_counters(result))
+        return;
+
+    cut_utils_append_indent(string, indent);
+    g_string_append(string, "<performance-counters>\n");
+    for (i = 0; i < CUT_PERFORMANCE_COUNTER_N_TYPES; i++) {
+        gint64 value;
+        gchar *value_string;
+
+        value = cut_test_result_get_performance_counter(result, i);
+        if (value < 0)
+            continue;
+        value_string = g_strdup_printf("%" G_GINT64_FORMAT, value);
+        cut_utils_append_xml_element_with_value(
+            string, indent + 2,
+            cut_performance_counter_type_to_name(i),
+            value_string);
+        g_free(value_string);
+    }
+    cut_utils_append_indent(string, indent);
+    g_string_append(string, "</performance-counters>\n");
+}
+
+static void
+append_memory_usage_to_string (GString *string, CutTestResult *result,
+                               guint indent)
+{
+    gint i;
+
+    if (!cut_test_result_has_memory_usage(result))
+        return;
+
+    cut_utils_append_indent(string, indent);
+    g_string_append(string, "<memory-usage>\n");
+    for (i = 0; i < CUT_MEMORY_USAGE_N_TYPES; i++) {
+        gint64 value;
+        gchar *value_string;
+
+        value = cut_test_result_get_memory_usage(result, i);
+        if (value < 0)
+            continue;
+        value_string = g_strdup_printf("%" G_GINT64_FORMAT, value);
+        cut_utils_append_xml_element_with_value(
+            string, indent + 2,
+            cut_memory_usage_type_to_name(i),
+            value_string);
+        g_free(value_string);
+    }
+    cut_utils_append_indent(string, indent);
+    g_string_append(string, "</memory-usage>\n");
+}
+
 static void
 append_test_result_to_string (GString *string, CutTestResult *result,
                               guint indent)
@@ -832,6 +1011,9 @@ append_test_result_to_string (GString *string, CutTestResult *result,
                                             elapsed_string);
     g_free(elapsed_string);
 
+    append_performance_counters_to_string(string, result, indent);
+    append_memory_usage_to_string(string, result, indent);
+
     if (expected)
         cut_utils_append_xml_element_with_value(string, indent,
                                                 "expected", expected);
@@ -1068,6 +1250,28 @@ cut_test_result_set_elapsed (CutTestResult *result,
     CUT_TEST_RESULT_GET_PRIVATE(result)->elapsed = elapsed;
 }
 
+void
+cut_test_result_set_performance_counter (CutTestResult *result,
+                                         CutPerformanceCounterType type,
+                                         gint64 value)
+{
+    if (type >= CUT_PERFORMANCE_COUNTER_N_TYPES)
+        return;
+
+    CUT_TEST_RESULT_GET_PRIVATE(result)->performance_counters[type] = value;
+}
+
+void
+cut_test_result_set_memory_usage (CutTestResult *result,
+                                  CutMemoryUsageType type,
+                                  gint64 value)
+{
+    if (type >= CUT_MEMORY_USAGE_N_TYPES)
+        return;
+
+    CUT_TEST_RESULT_GET_PRIVATE(result)->memory_usage[type] = value;
+}
+
 static void
 reset_diff (CutTestResultPrivate *priv)
 {
@@ -1077,6 +1281,7 @@ reset_diff (CutTestResultPrivate *priv)
         if (priv->diff)
             g_free(priv->diff);
         priv->diff = NULL;
+        priv->diff_summarized = FALSE;
         need_message_regeneration = TRUE;
     }
 
@@ -1141,6 +1346,7 @@ cut_test_result_set_diff (CutTestResult *result, const gchar *diff)
         priv->diff = NULL;
     }
 
+    priv->diff_summarized = FALSE;
     if (diff && diff[0]) {
         priv->diff = g_strdup(diff);
         priv->user_set_diff = TRUE;
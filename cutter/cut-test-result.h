@@ -25,6 +25,8 @@
 #include <cutter/cut-test.h>
 #include <cutter/cut-test-case.h>
 #include <cutter/cut-test-suite.h>
+#include <cutter/cut-performance-counters.h>
+#include <cutter/cut-memory-usage.h>
 
 G_BEGIN_DECLS
 
@@ -80,11 +82,44 @@ const GList         *cut_test_result_get_backtrace    (CutTestResult *result);
 void                 cut_test_result_get_start_time    (CutTestResult *result,
                                                         GTimeVal *start_time);
 gdouble              cut_test_result_get_elapsed       (CutTestResult *result);
+/* Returns a negative value for a counter that isn't measured. */
+gint64               cut_test_result_get_performance_counter
+                                                       (CutTestResult *result,
+                                                        CutPerformanceCounterType type);
+gboolean             cut_test_result_has_performance_counters
+                                                       (CutTestResult *result);
+/* Returns a negative value for a value that isn't measured. */
+gint64               cut_test_result_get_memory_usage  (CutTestResult *result,
+                                                        CutMemoryUsageType type);
+gboolean             cut_test_result_has_memory_usage  (CutTestResult *result);
 const gchar         *cut_test_result_get_expected      (CutTestResult *result);
 const gchar         *cut_test_result_get_actual        (CutTestResult *result);
 const gchar         *cut_test_result_get_diff          (CutTestResult *result);
 const gchar         *cut_test_result_get_folded_diff   (CutTestResult *result);
 
+/*
+ * They return only values that are set explicitly. They never
+ * compute a message or a diff from expected and actual values.
+ */
+const gchar         *cut_test_result_get_explicit_message
+                                                       (CutTestResult *result);
+const gchar         *cut_test_result_get_explicit_diff (CutTestResult *result);
+const gchar         *cut_test_result_get_explicit_folded_diff
+                                                       (CutTestResult *result);
+
+/*
+ * A diff of expected and actual values that are larger than
+ * the max diff target size isn't computed. A summary of the
+ * first difference is used instead. 0 means no limit.
+ */
+void                 cut_test_result_set_max_diff_target_size
+                                                       (gsize          size);
+gsize                cut_test_result_get_max_diff_target_size
+                                                       (void);
+gboolean             cut_test_result_is_diff_target_too_large
+                                                       (const gchar   *expected,
+                                                        const gchar   *actual);
+
 void cut_test_result_set_status          (CutTestResult *result,
                                           CutTestResultStatus status);
 void cut_test_result_set_test            (CutTestResult *result,
@@ -109,6 +144,13 @@ void cut_test_result_set_start_time      (CutTestResult *result,
                                           GTimeVal *start_time);
 void cut_test_result_set_elapsed         (CutTestResult *result,
                                           gdouble elapsed);
+void cut_test_result_set_performance_counter
+                                         (CutTestResult *result,
+                                          CutPerformanceCounterType type,
+                                          gint64         value);
+void cut_test_result_set_memory_usage    (CutTestResult *result,
+                                          CutMemoryUsageType type,
+                                          gint64         value);
 void cut_test_result_set_expected        (CutTestResult *result,
                                           const gchar   *expected);
 void cut_test_result_set_actual          (CutTestResult *result,
@@ -82,6 +82,16 @@ cb_pass_assertion_test (CutTest *test, CutTestContext *test_context,
     g_signal_emit_by_name(context, "pass-assertion", test, test_context);
 }
 
+static void
+cb_pass_assertions_test (CutTest *test, CutTestContext *test_context,
+                         guint n_assertions, gpointer data)
+{
+    CutRunContext *context = data;
+
+    g_signal_emit_by_name(context, "pass-assertions",
+                          test, test_context, n_assertions);
+}
+
 static void
 cb_success_test (CutTest *test, CutTestContext *test_context,
                  CutTestResult *result, gpointer data)
@@ -146,6 +156,16 @@ cb_crash_test (CutTest *test, CutTestContext *test_context,
     g_signal_emit_by_name(context, "crash-test", test, test_context, result);
 }
 
+static void
+cb_benchmark_test (CutTest *test, CutTestContext *test_context,
+                   CutBenchmarkResult *result, gpointer data)
+{
+    CutRunContext *context = data;
+
+    g_signal_emit_by_name(context, "benchmark-test",
+                          test, test_context, result);
+}
+
 static void
 cb_complete_test (CutTest *test, CutTestContext *test_context,
                   gboolean success, gpointer data)
@@ -164,6 +184,7 @@ connect_to_test (CutRunContext *context, CutTest *test)
 
     CONNECT(start);
     CONNECT(pass_assertion);
+    CONNECT(pass_assertions);
     CONNECT(success);
     CONNECT(failure);
     CONNECT(error);
@@ -171,6 +192,7 @@ connect_to_test (CutRunContext *context, CutTest *test)
     CONNECT(notification);
     CONNECT(omission);
     CONNECT(crash);
+    CONNECT(benchmark);
     CONNECT(complete);
 #undef CONNECT
 }
@@ -198,6 +220,7 @@ cb_complete_test_test_case (CutTestCase *test_case, CutTest *test,
 
     DISCONNECT(start);
     DISCONNECT(pass_assertion);
+    DISCONNECT(pass_assertions);
     DISCONNECT(success);
     DISCONNECT(failure);
     DISCONNECT(error);
@@ -205,6 +228,7 @@ cb_complete_test_test_case (CutTestCase *test_case, CutTest *test,
     DISCONNECT(notification);
     DISCONNECT(omission);
     DISCONNECT(crash);
+    DISCONNECT(benchmark);
     DISCONNECT(complete);
 #undef DISCONNECT
 }
@@ -400,6 +424,15 @@ cb_pass_assertion_iterated_test (CutIteratedTest *iterated_test,
     cb_pass_assertion_test(CUT_TEST(iterated_test), test_context, data);
 }
 
+static void
+cb_pass_assertions_iterated_test (CutIteratedTest *iterated_test,
+                                  CutTestContext *test_context,
+                                  guint n_assertions, gpointer data)
+{
+    cb_pass_assertions_test(CUT_TEST(iterated_test), test_context,
+                            n_assertions, data);
+}
+
 static void
 cb_success_iterated_test (CutIteratedTest *iterated_test,
                           CutTestContext *test_context,
@@ -484,6 +517,7 @@ cb_start_iterated_test_test_iterator (CutTestIterator *test_iterator,
     CONNECT(complete);
 
     CONNECT(pass_assertion);
+    CONNECT(pass_assertions);
     CONNECT(success);
     CONNECT(failure);
     CONNECT(error);
@@ -512,6 +546,7 @@ cb_complete_iterated_test_test_iterator (CutTestIterator *test_iterator,
     DISCONNECT(complete);
 
     DISCONNECT(pass_assertion);
+    DISCONNECT(pass_assertions);
     DISCONNECT(success);
     DISCONNECT(failure);
     DISCONNECT(error);
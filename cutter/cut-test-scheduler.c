@@ -0,0 +1,411 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <glib.h>
+
+#include "cut-test-scheduler.h"
+#include "cut-utils.h"
+#include "cut-glib-compatible.h"
+
+#include "../gcutter/gcut-error.h"
+
+/*
+ * Each worker owns a deque of jobs. A worker pushes jobs created by
+ * a running job (e.g. tests of a started test case) to the tail of
+ * its own deque and pops from the tail. Jobs pushed from outside
+ * workers (e.g. sorted test cases) are queued to the tail of the
+ * shared queue and taken from its head in the pushed order. Idle
+ * workers steal the oldest jobs from the head of other workers'
+ * deques.
+ *
+ * A worker that waits for a group of jobs runs only jobs in the
+ * group. It must not run an unrelated job on the stack of the
+ * waiting job.
+ */
+
+typedef struct _Job
+{
+    CutTestSchedulerJobFunction function;
+    gpointer data;
+    volatile gint *group;
+} Job;
+
+typedef struct _Worker
+{
+    CutTestScheduler *scheduler;
+    gint id;
+    GQueue *jobs;
+    GMutex *mutex;
+} Worker;
+
+struct _CutTestScheduler
+{
+    Worker *workers;
+    gint n_workers;
+    GQueue *shared_jobs;
+    gint n_queued_jobs;
+    gint n_unfinished_jobs;
+    GMutex *mutex;
+    GCond *cond;
+};
+
+static GPrivate current_worker_private = G_PRIVATE_INIT(NULL);
+
+CutTestScheduler *
+cut_test_scheduler_new (gint n_workers)
+{
+    CutTestScheduler *scheduler;
+    gint i;
+
+    if (n_workers <= 0) {
+#if GLIB_CHECK_VERSION(2, 36, 0)
+        n_workers = g_get_num_processors();
+#else
+        n_workers = 10;
+#endif
+    }
+
+    scheduler = g_new0(CutTestScheduler, 1);
+    scheduler->n_workers = n_workers;
+    scheduler->workers = g_new0(Worker, n_workers);
+    for (i = 0; i < n_workers; i++) {
+        Worker *worker = &(scheduler->workers[i]);
+
+        worker->scheduler = scheduler;
+        worker->id = i;
+        worker->jobs = g_queue_new();
+        worker->mutex = g_mutex_new();
+    }
+    scheduler->shared_jobs = g_queue_new();
+    scheduler->n_queued_jobs = 0;
+    scheduler->n_unfinished_jobs = 0;
+    scheduler->mutex = g_mutex_new();
+    scheduler->cond = g_cond_new();
+
+    return scheduler;
+}
+
+static void
+free_job (gpointer data, gpointer user_data)
+{
+    g_slice_free(Job, data);
+}
+
+void
+cut_test_scheduler_free (CutTestScheduler *scheduler)
+{
+    gint i;
+
+    for (i = 0; i < scheduler->n_workers; i++) {
+        Worker *worker = &(scheduler->workers[i]);
+
+        g_queue_foreach(worker->jobs, free_job, NULL);
+        g_queue_free(worker->jobs);
+        g_mutex_free(worker->mutex);
+    }
+    g_free(scheduler->workers);
+    g_queue_foreach(scheduler->shared_jobs, free_job, NULL);
+    g_queue_free(scheduler->shared_jobs);
+    g_mutex_free(scheduler->mutex);
+    g_cond_free(scheduler->cond);
+    g_free(scheduler);
+}
+
+gint
+cut_test_scheduler_get_n_workers (CutTestScheduler *scheduler)
+{
+    return scheduler->n_workers;
+}
+
+static Worker *
+get_current_worker (CutTestScheduler *scheduler)
+{
+    Worker *worker;
+
+    worker = g_private_get(&current_worker_private);
+    if (worker && worker->scheduler == scheduler)
+        return worker;
+    else
+        return NULL;
+}
+
+static void
+push_job (CutTestScheduler *scheduler, volatile gint *group,
+          CutTestSchedulerJobFunction function, gpointer data)
+{
+    Job *job;
+    Worker *worker;
+
+    job = g_slice_new(Job);
+    job->function = function;
+    job->data = data;
+    job->group = group;
+
+    worker = get_current_worker(scheduler);
+    if (worker) {
+        g_mutex_lock(worker->mutex);
+        g_queue_push_tail(worker->jobs, job);
+        g_mutex_unlock(worker->mutex);
+    }
+
+    g_mutex_lock(scheduler->mutex);
+    if (!worker)
+        g_queue_push_tail(scheduler->shared_jobs, job);
+    scheduler->n_queued_jobs++;
+    scheduler->n_unfinished_jobs++;
+    g_cond_broadcast(scheduler->cond);
+    g_mutex_unlock(scheduler->mutex);
+}
+
+void
+cut_test_scheduler_push (CutTestScheduler *scheduler,
+                         CutTestSchedulerJobFunction function,
+                         gpointer data)
+{
+    push_job(scheduler, NULL, function, data);
+}
+
+void
+cut_test_scheduler_push_to_group (CutTestScheduler *scheduler,
+                                  volatile gint *n_pending_jobs,
+                                  CutTestSchedulerJobFunction function,
+                                  gpointer data)
+{
+    push_job(scheduler, n_pending_jobs, function, data);
+}
+
+static void
+dequeue_job (CutTestScheduler *scheduler)
+{
+    g_mutex_lock(scheduler->mutex);
+    scheduler->n_queued_jobs--;
+    g_mutex_unlock(scheduler->mutex);
+}
+
+static Job *
+take_job (CutTestScheduler *scheduler, Worker *worker)
+{
+    Job *job = NULL;
+    gint i, first_victim_id = 0;
+
+    if (worker) {
+        g_mutex_lock(worker->mutex);
+        job = g_queue_pop_tail(worker->jobs);
+        g_mutex_unlock(worker->mutex);
+        first_victim_id = worker->id + 1;
+    }
+
+    if (!job) {
+        g_mutex_lock(scheduler->mutex);
+        job = g_queue_pop_head(scheduler->shared_jobs);
+        g_mutex_unlock(scheduler->mutex);
+    }
+
+    for (i = 0; !job && i < scheduler->n_workers; i++) {
+        Worker *victim;
+
+        victim = &(scheduler->workers[(first_victim_id + i) %
+                                      scheduler->n_workers]);
+        if (victim == worker)
+            continue;
+
+        g_mutex_lock(victim->mutex);
+        job = g_queue_pop_head(victim->jobs);
+        g_mutex_unlock(victim->mutex);
+    }
+
+    if (job)
+        dequeue_job(scheduler);
+
+    return job;
+}
+
+static Job *
+take_group_job_from (GQueue *jobs, GMutex *mutex,
+                     volatile gint *group, gboolean newest)
+{
+    GList *node;
+    Job *job = NULL;
+
+    g_mutex_lock(mutex);
+    node = newest ? jobs->tail : jobs->head;
+    for (; node; node = newest ? g_list_previous(node) : g_list_next(node)) {
+        Job *candidate = node->data;
+
+        if (candidate->group == group) {
+            job = candidate;
+            g_queue_delete_link(jobs, node);
+            break;
+        }
+    }
+    g_mutex_unlock(mutex);
+
+    return job;
+}
+
+static Job *
+take_group_job (CutTestScheduler *scheduler, Worker *worker,
+                volatile gint *group)
+{
+    Job *job = NULL;
+    gint i;
+
+    if (worker)
+        job = take_group_job_from(worker->jobs, worker->mutex, group, TRUE);
+
+    if (!job)
+        job = take_group_job_from(scheduler->shared_jobs, scheduler->mutex,
+                                  group, FALSE);
+
+    for (i = 0; !job && i < scheduler->n_workers; i++) {
+        Worker *victim = &(scheduler->workers[i]);
+
+        if (victim == worker)
+            continue;
+        job = take_group_job_from(victim->jobs, victim->mutex, group, FALSE);
+    }
+
+    if (job)
+        dequeue_job(scheduler);
+
+    return job;
+}
+
+static void
+run_job (CutTestScheduler *scheduler, Job *job)
+{
+    job->function(job->data);
+    g_slice_free(Job, job);
+
+    g_mutex_lock(scheduler->mutex);
+    scheduler->n_unfinished_jobs--;
+    g_cond_broadcast(scheduler->cond);
+    g_mutex_unlock(scheduler->mutex);
+}
+
+static void
+run_worker (gpointer data, gpointer user_data)
+{
+    Worker *worker = data;
+    CutTestScheduler *scheduler = user_data;
+    Worker *previous_worker;
+    gboolean finished = FALSE;
+
+    previous_worker = g_private_get(&current_worker_private);
+    g_private_set(&current_worker_private, worker);
+
+    while (!finished) {
+        Job *job;
+
+        job = take_job(scheduler, worker);
+        if (job) {
+            run_job(scheduler, job);
+            continue;
+        }
+
+        g_mutex_lock(scheduler->mutex);
+        while (scheduler->n_queued_jobs == 0 &&
+               scheduler->n_unfinished_jobs > 0) {
+            g_cond_wait(scheduler->cond, scheduler->mutex);
+        }
+        finished = (scheduler->n_unfinished_jobs == 0);
+        g_mutex_unlock(scheduler->mutex);
+    }
+
+    g_private_set(&current_worker_private, previous_worker);
+}
+
+void
+cut_test_scheduler_run (CutTestScheduler *scheduler)
+{
+    GThreadPool *thread_pool;
+    GError *error = NULL;
+    gint i;
+
+    thread_pool = g_thread_pool_new(run_worker, scheduler,
+                                    scheduler->n_workers, FALSE, &error);
+    if (error) {
+        cut_utils_report_error(error);
+        run_worker(&(scheduler->workers[0]), scheduler);
+        return;
+    }
+
+    for (i = 0; i < scheduler->n_workers; i++) {
+        g_thread_pool_push(thread_pool, &(scheduler->workers[i]), &error);
+        if (error) {
+            cut_utils_report_error(error);
+            error = NULL;
+            break;
+        }
+    }
+
+    /* Jobs of workers that couldn't be started are stolen by
+     * others. If no worker is started, we run jobs by ourselves. */
+    if (i == 0)
+        run_worker(&(scheduler->workers[0]), scheduler);
+
+    g_thread_pool_free(thread_pool, FALSE, TRUE);
+}
+
+void
+cut_test_scheduler_wait (CutTestScheduler *scheduler,
+                         volatile gint *n_pending_jobs)
+{
+    Worker *worker;
+
+    worker = get_current_worker(scheduler);
+    while (g_atomic_int_get(n_pending_jobs) > 0) {
+        Job *job;
+
+        /* We run jobs of the group instead of blocking. Other jobs
+         * must not run in the waiting job. */
+        job = take_group_job(scheduler, worker, n_pending_jobs);
+        if (job) {
+            run_job(scheduler, job);
+            continue;
+        }
+
+        /* The rest jobs of the group are running on other workers.
+         * A finished job broadcasts while holding the lock. */
+        g_mutex_lock(scheduler->mutex);
+        if (g_atomic_int_get(n_pending_jobs) > 0)
+            g_cond_wait(scheduler->cond, scheduler->mutex);
+        g_mutex_unlock(scheduler->mutex);
+    }
+}
+
+CutTestScheduler *
+cut_test_scheduler_get_current (void)
+{
+    Worker *worker;
+
+    worker = g_private_get(&current_worker_private);
+    if (worker)
+        return worker->scheduler;
+    else
+        return NULL;
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
@@ -0,0 +1,58 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CUT_TEST_SCHEDULER_H__
+#define __CUT_TEST_SCHEDULER_H__
+
+#include <glib.h>
+
+#include <cutter/cut-private.h>
+
+G_BEGIN_DECLS
+
+typedef void (*CutTestSchedulerJobFunction) (gpointer data);
+
+CutTestScheduler *cut_test_scheduler_new         (gint              n_workers);
+void              cut_test_scheduler_free        (CutTestScheduler *scheduler);
+
+gint              cut_test_scheduler_get_n_workers
+                                                 (CutTestScheduler *scheduler);
+void              cut_test_scheduler_push        (CutTestScheduler *scheduler,
+                                                  CutTestSchedulerJobFunction function,
+                                                  gpointer          data);
+/* Pushes a job that is waited by cut_test_scheduler_wait() with
+ * n_pending_jobs. The job must decrement n_pending_jobs. */
+void              cut_test_scheduler_push_to_group
+                                                 (CutTestScheduler *scheduler,
+                                                  volatile gint    *n_pending_jobs,
+                                                  CutTestSchedulerJobFunction function,
+                                                  gpointer          data);
+void              cut_test_scheduler_run         (CutTestScheduler *scheduler);
+void              cut_test_scheduler_wait        (CutTestScheduler *scheduler,
+                                                  volatile gint    *n_pending_jobs);
+
+CutTestScheduler *cut_test_scheduler_get_current (void);
+
+G_END_DECLS
+
+#endif /* __CUT_TEST_SCHEDULER_H__ */
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
@@ -43,6 +43,8 @@
 #include "cut-test-result.h"
 #include "cut-backtrace-entry.h"
 #include "cut-crash-backtrace.h"
+#include "cut-test-scheduler.h"
+#include "cut-process-pool.h"
 
 #include "../gcutter/gcut-marshalers.h"
 #include "../gcutter/gcut-error.h"
@@ -220,8 +222,20 @@ typedef struct _RunTestInfo
     CutTestCase *test_case;
     CutRunContext *run_context;
     gchar **test_names;
+    CutTestScheduler *scheduler;
+    gboolean *success;
 } RunTestInfo;
 
+static void
+free_run_test_info (RunTestInfo *info)
+{
+    g_object_unref(info->test_suite);
+    g_object_unref(info->test_case);
+    g_object_unref(info->run_context);
+    g_strfreev(info->test_names);
+    g_free(info);
+}
+
 static void
 run (gpointer data, gpointer user_data)
 {
@@ -243,17 +257,46 @@ run (gpointer data, gpointer user_data)
         *success =  FALSE;
     g_signal_emit_by_name(test_suite, "complete-test-case", test_case, *success);
 
-    g_object_unref(test_suite);
-    g_object_unref(test_case);
-    g_object_unref(run_context);
-    g_strfreev(test_names);
-    g_free(info);
+    free_run_test_info(info);
+}
+
+static void
+cb_complete_scheduled_test_case (CutTestCase *test_case, gboolean success,
+                                 gpointer user_data)
+{
+    RunTestInfo *info = user_data;
+
+    if (!success)
+        *(info->success) = FALSE;
+    g_signal_emit_by_name(info->test_suite, "complete-test-case",
+                          test_case, *(info->success));
+
+    free_run_test_info(info);
+}
+
+static void
+run_scheduled (gpointer data)
+{
+    RunTestInfo *info = data;
+
+    if (!cut_run_context_get_split_test_cases(info->run_context)) {
+        run(info, info->success);
+        return;
+    }
+
+    g_signal_emit_by_name(info->test_suite, "start-test-case", info->test_case);
+    cut_test_case_run_with_scheduler(info->test_case,
+                                     info->run_context,
+                                     info->scheduler,
+                                     (const gchar **)(info->test_names),
+                                     cb_complete_scheduled_test_case,
+                                     info);
 }
 
 static void
 run_with_thread_support (CutTestSuite *test_suite, CutTestCase *test_case,
                          CutRunContext *run_context, const gchar **test_names,
-                         GThreadPool *thread_pool, gboolean *success)
+                         CutTestScheduler *scheduler, gboolean *success)
 {
     RunTestInfo *info;
     gboolean need_no_thread_run = TRUE;
@@ -266,27 +309,33 @@ run_with_thread_support (CutTestSuite *test_suite, CutTestCase *test_case,
     info->test_case = g_object_ref(test_case);
     info->run_context = g_object_ref(run_context);
     info->test_names = g_strdupv((gchar **)test_names);
+    info->scheduler = scheduler;
+    info->success = success;
 
-    if (thread_pool) {
-        GError *error = NULL;
-
-        g_thread_pool_push(thread_pool, info, &error);
-        if (error) {
-            gchar *inspected;
-
-            inspected = gcut_error_inspect(error);
-            g_warning("%s", inspected);
-            g_free(inspected);
-            g_error_free(error);
-        } else {
-            need_no_thread_run = FALSE;
-        }
+    if (scheduler) {
+        cut_test_scheduler_push(scheduler, run_scheduled, info);
+        need_no_thread_run = FALSE;
     }
 
     if (need_no_thread_run)
         run(info, success);
 }
 
+static gboolean
+run_test_case_in_process (CutTestCase *test_case, CutRunContext *run_context,
+                          const gchar **test_names, gpointer user_data)
+{
+    CutTestSuite *test_suite = user_data;
+    gboolean success;
+
+    g_signal_emit_by_name(test_suite, "start-test-case", test_case);
+    success = cut_test_case_run_with_filter(test_case, run_context,
+                                            test_names);
+    g_signal_emit_by_name(test_suite, "complete-test-case", test_case, success);
+
+    return success;
+}
+
 static void
 emit_ready_signal (CutTestSuite *test_suite, GList *test_cases,
                    CutRunContext *run_context)
@@ -308,6 +357,30 @@ emit_ready_signal (CutTestSuite *test_suite, GList *test_cases,
     g_signal_emit_by_name(test_suite, "ready", n_test_cases, n_tests);
 }
 
+static gboolean
+have_test_timeout (CutRunContext *run_context, GList *test_cases)
+{
+    GList *node;
+
+    if (cut_run_context_get_timeout(run_context) > 0.0)
+        return TRUE;
+
+    for (node = test_cases; node; node = g_list_next(node)) {
+        CutTestCase *test_case = node->data;
+        GList *child;
+
+        if (!CUT_IS_TEST_CASE(test_case))
+            continue;
+        child = cut_test_container_get_children(CUT_TEST_CONTAINER(test_case));
+        for (; child; child = g_list_next(child)) {
+            if (cut_test_get_timeout(CUT_TEST(child->data)) > 0.0)
+                return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
 static gboolean
 cut_test_suite_run_test_cases (CutTestSuite *test_suite,
                                CutRunContext *run_context,
@@ -315,8 +388,11 @@ cut_test_suite_run_test_cases (CutTestSuite *test_suite,
 {
     CutTestSuitePrivate *priv;
     GList *node;
-    GThreadPool *thread_pool = NULL;
+    CutTestScheduler *scheduler = NULL;
+    CutProcessPool *process_pool = NULL;
+    const gchar *shard_listen, *shard_connect;
     GList *sorted_test_cases;
+    gint n_processes;
     gboolean try_thread;
     gboolean all_success = TRUE;
     gint signum;
@@ -330,16 +406,32 @@ cut_test_suite_run_test_cases (CutTestSuite *test_suite,
                                                         sorted_test_cases);
 
     try_thread = cut_run_context_get_multi_thread(run_context);
-    if (try_thread) {
-        GError *error = NULL;
+    shard_listen = cut_run_context_get_shard_listen(run_context);
+    shard_connect = cut_run_context_get_shard_connect(run_context);
+    n_processes = cut_run_context_get_n_processes(run_context);
+    /* A test that never returns can't be stopped in this process.
+     * Tests are run in worker processes instead, and a worker
+     * process that runs a timed out test is killed. */
+    if (n_processes == 0 && !shard_listen && !shard_connect &&
+        cut_process_pool_is_available() &&
+        have_test_timeout(run_context, sorted_test_cases)) {
+        if (try_thread)
+            n_processes = MAX(cut_run_context_get_max_threads(run_context), 1);
+        else
+            n_processes = 1;
+    }
+    if (n_processes > 0 || shard_listen || shard_connect) {
+        process_pool = cut_process_pool_new(run_context, n_processes,
+                                            run_test_case_in_process,
+                                            test_suite);
+        if (shard_listen && !shard_connect &&
+            !cut_process_pool_listen(process_pool, shard_listen))
+            all_success = FALSE;
+    } else if (try_thread) {
         gint max_threads;
 
         max_threads = cut_run_context_get_max_threads(run_context);
-        thread_pool = g_thread_pool_new(run, &all_success,
-                                        max_threads, FALSE, &error);
-        if (error) {
-            cut_utils_report_error(error);
-        }
+        scheduler = cut_test_scheduler_new(max_threads);
     }
 
     if (cut_run_context_get_handle_signals(run_context)) {
@@ -361,16 +453,33 @@ cut_test_suite_run_test_cases (CutTestSuite *test_suite,
 
             if (!test_case)
                 continue;
-            if (CUT_IS_TEST_CASE(test_case)) {
+            if (!CUT_IS_TEST_CASE(test_case)) {
+                g_warning("This object is not test case!");
+            } else if (process_pool) {
+                cut_process_pool_add_test_case(process_pool, test_case);
+            } else {
                 run_with_thread_support(test_suite, test_case, run_context,
-                                        test_names, thread_pool, &all_success);
+                                        test_names, scheduler, &all_success);
+            }
+        }
+
+        if (process_pool) {
+            if (shard_connect) {
+                if (!cut_process_pool_run_as_worker(process_pool,
+                                                    shard_connect,
+                                                    test_names))
+                    all_success = FALSE;
             } else {
-                g_warning("This object is not test case!");
+                if (!cut_process_pool_run(process_pool, test_names))
+                    all_success = FALSE;
             }
+            cut_process_pool_free(process_pool);
         }
 
-        if (thread_pool)
-            g_thread_pool_free(thread_pool, FALSE, TRUE);
+        if (scheduler) {
+            cut_test_scheduler_run(scheduler);
+            cut_test_scheduler_free(scheduler);
+        }
 
         if (all_success) {
             CutTestResult *result;
@@ -0,0 +1,200 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <glib.h>
+
+#ifndef G_OS_WIN32
+#  include <unistd.h>
+#endif
+
+#include "cut-test-watchdog.h"
+#include "cut-glib-compatible.h"
+#include "cut-logger.h"
+
+struct _CutTestWatchdog
+{
+    gchar *name;
+    gdouble timeout;
+    gint64 deadline;
+    gboolean armed;
+    gboolean overdue;
+    gboolean timed_out;
+};
+
+static GMutex *watchdog_mutex = NULL;
+static GCond *watchdog_cond = NULL;
+static GList *watchdogs = NULL;
+static GThreadPool *watchdog_thread_pool = NULL;
+static gint watchdog_pid = 0;
+G_LOCK_DEFINE_STATIC(watchdog_initialize);
+
+static gint
+get_pid (void)
+{
+#ifdef G_OS_WIN32
+    return 1;
+#else
+    return getpid();
+#endif
+}
+
+/* The watchdog thread only reports a test that is still running
+ * after its deadline. It never interrupts the test because the
+ * test may be in any code, e.g. in malloc() with a lock. */
+static void
+run_watchdog (gpointer data, gpointer user_data)
+{
+    g_mutex_lock(watchdog_mutex);
+    while (TRUE) {
+        GList *node;
+        gint64 now, nearest_deadline = 0;
+
+        now = g_get_monotonic_time();
+        for (node = watchdogs; node; node = g_list_next(node)) {
+            CutTestWatchdog *watchdog = node->data;
+
+            if (watchdog->overdue)
+                continue;
+
+            if (watchdog->deadline <= now) {
+                watchdog->overdue = TRUE;
+                cut_log_warning("[test-watchdog][overdue] <%s>: <%g>",
+                                watchdog->name, watchdog->timeout);
+                continue;
+            }
+
+            if (nearest_deadline == 0 || watchdog->deadline < nearest_deadline)
+                nearest_deadline = watchdog->deadline;
+        }
+
+        if (nearest_deadline > 0)
+            g_cond_wait_until(watchdog_cond, watchdog_mutex, nearest_deadline);
+        else
+            g_cond_wait(watchdog_cond, watchdog_mutex);
+    }
+    g_mutex_unlock(watchdog_mutex);
+}
+
+static void
+ensure_watchdog_thread (void)
+{
+    GError *error = NULL;
+
+    G_LOCK(watchdog_initialize);
+    /* A worker process forked by CutProcessPool doesn't have the
+     * watchdog thread of its parent. */
+    if (watchdog_pid == get_pid()) {
+        G_UNLOCK(watchdog_initialize);
+        return;
+    }
+
+    watchdog_pid = get_pid();
+    watchdog_mutex = g_mutex_new();
+    watchdog_cond = g_cond_new();
+    watchdogs = NULL;
+
+    watchdog_thread_pool = g_thread_pool_new(run_watchdog, NULL, 1, TRUE,
+                                             &error);
+    if (watchdog_thread_pool)
+        g_thread_pool_push(watchdog_thread_pool, GINT_TO_POINTER(TRUE),
+                           &error);
+    if (error) {
+        cut_log_warning("[test-watchdog][thread][fail] %s", error->message);
+        g_error_free(error);
+    }
+    G_UNLOCK(watchdog_initialize);
+}
+
+CutTestWatchdog *
+cut_test_watchdog_new (const gchar *name, gdouble timeout)
+{
+    CutTestWatchdog *watchdog;
+
+    watchdog = g_new0(CutTestWatchdog, 1);
+    watchdog->name = g_strdup(name);
+    watchdog->timeout = timeout;
+    watchdog->deadline = 0;
+    watchdog->armed = FALSE;
+    watchdog->overdue = FALSE;
+    watchdog->timed_out = FALSE;
+
+    return watchdog;
+}
+
+void
+cut_test_watchdog_start (CutTestWatchdog *watchdog)
+{
+    if (watchdog->armed)
+        return;
+
+    ensure_watchdog_thread();
+
+    watchdog->deadline = g_get_monotonic_time() +
+        (gint64)(watchdog->timeout * G_USEC_PER_SEC);
+    watchdog->timed_out = FALSE;
+
+    g_mutex_lock(watchdog_mutex);
+    watchdog->overdue = FALSE;
+    watchdogs = g_list_prepend(watchdogs, watchdog);
+    watchdog->armed = TRUE;
+    g_cond_signal(watchdog_cond);
+    g_mutex_unlock(watchdog_mutex);
+}
+
+void
+cut_test_watchdog_stop (CutTestWatchdog *watchdog)
+{
+    if (!watchdog->armed)
+        return;
+
+    watchdog->timed_out = (g_get_monotonic_time() >= watchdog->deadline);
+
+    g_mutex_lock(watchdog_mutex);
+    watchdogs = g_list_remove(watchdogs, watchdog);
+    watchdog->armed = FALSE;
+    g_mutex_unlock(watchdog_mutex);
+}
+
+void
+cut_test_watchdog_free (CutTestWatchdog *watchdog)
+{
+    cut_test_watchdog_stop(watchdog);
+    g_free(watchdog->name);
+    g_free(watchdog);
+}
+
+gboolean
+cut_test_watchdog_is_timed_out (CutTestWatchdog *watchdog)
+{
+    return watchdog->timed_out;
+}
+
+gdouble
+cut_test_watchdog_get_timeout (CutTestWatchdog *watchdog)
+{
+    return watchdog->timeout;
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
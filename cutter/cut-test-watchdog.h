@@ -0,0 +1,55 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CUT_TEST_WATCHDOG_H__
+#define __CUT_TEST_WATCHDOG_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/*
+ * A watchdog checks whether a test finishes in time. A test
+ * that doesn't finish in time is reported after it returns. It
+ * isn't interrupted because jumping out of arbitrary code, e.g.
+ * code that holds a lock, isn't safe. A watchdog thread warns
+ * about a test that is still running after its deadline. A test
+ * that never returns is killed only in a worker process of
+ * CutProcessPool. CutTestSuite runs tests in worker processes
+ * when a timeout is set for them.
+ */
+typedef struct _CutTestWatchdog CutTestWatchdog;
+
+CutTestWatchdog *cut_test_watchdog_new           (const gchar     *name,
+                                                  gdouble          timeout);
+void             cut_test_watchdog_free          (CutTestWatchdog *watchdog);
+
+void             cut_test_watchdog_start         (CutTestWatchdog *watchdog);
+void             cut_test_watchdog_stop          (CutTestWatchdog *watchdog);
+
+gboolean         cut_test_watchdog_is_timed_out  (CutTestWatchdog *watchdog);
+gdouble          cut_test_watchdog_get_timeout   (CutTestWatchdog *watchdog);
+
+G_END_DECLS
+
+#endif /* __CUT_TEST_WATCHDOG_H__ */
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
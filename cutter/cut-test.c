@@ -32,8 +32,14 @@
 #include "cut-test-container.h"
 #include "cut-run-context.h"
 #include "cut-test-result.h"
+#include "cut-benchmark-result.h"
 #include "cut-utils.h"
 #include "cut-crash-backtrace.h"
+#include "cut-test-watchdog.h"
+#include "cut-performance-counters.h"
+#include "cut-memory-usage.h"
+#include "cut-allocation-failure.h"
+#include "cut-benchmark.h"
 
 #include <gcutter/gcut-marshalers.h>
 
@@ -53,6 +59,8 @@ struct _CutTestPrivate
     GTimer *timer;
     GTimeVal start_time;
     gdouble elapsed;
+    CutPerformanceCounters *performance_counters;
+    CutMemoryUsage *memory_usage;
     GHashTable *attributes;
     gchar *base_directory;
     jmp_buf *jump_buffer;
@@ -71,6 +79,7 @@ enum
 {
     START,
     PASS_ASSERTION,
+    PASS_ASSERTIONS,
     SUCCESS,
     FAILURE,
     ERROR,
@@ -78,6 +87,7 @@ enum
     NOTIFICATION,
     OMISSION,
     CRASH,
+    BENCHMARK,
     COMPLETE,
     LAST_SIGNAL
 };
@@ -183,6 +193,15 @@ cut_test_class_init (CutTestClass *klass)
                         g_cclosure_marshal_VOID__OBJECT,
                         G_TYPE_NONE, 1, CUT_TYPE_TEST_CONTEXT);
 
+    cut_test_signals[PASS_ASSERTIONS]
+        = g_signal_new ("pass-assertions",
+                        G_TYPE_FROM_CLASS (klass),
+                        G_SIGNAL_RUN_LAST,
+                        G_STRUCT_OFFSET (CutTestClass, pass_assertions),
+                        NULL, NULL,
+                        _gcut_marshal_VOID__OBJECT_UINT,
+                        G_TYPE_NONE, 2, CUT_TYPE_TEST_CONTEXT, G_TYPE_UINT);
+
     cut_test_signals[SUCCESS]
         = g_signal_new ("success",
                         G_TYPE_FROM_CLASS (klass),
@@ -253,6 +272,16 @@ cut_test_class_init (CutTestClass *klass)
                         G_TYPE_NONE, 2,
                         CUT_TYPE_TEST_CONTEXT, CUT_TYPE_TEST_RESULT);
 
+    cut_test_signals[BENCHMARK]
+        = g_signal_new("benchmark",
+                       G_TYPE_FROM_CLASS(klass),
+                       G_SIGNAL_RUN_LAST,
+                       G_STRUCT_OFFSET(CutTestClass, benchmark),
+                       NULL, NULL,
+                       _gcut_marshal_VOID__OBJECT_OBJECT,
+                       G_TYPE_NONE, 2,
+                       CUT_TYPE_TEST_CONTEXT, CUT_TYPE_BENCHMARK_RESULT);
+
     cut_test_signals[COMPLETE]
         = g_signal_new("complete",
                        G_TYPE_FROM_CLASS (klass),
@@ -278,6 +307,8 @@ cut_test_init (CutTest *test)
     priv->start_time.tv_sec = 0;
     priv->start_time.tv_usec = 0;
     priv->elapsed = -1.0;
+    priv->performance_counters = NULL;
+    priv->memory_usage = NULL;
     priv->attributes = g_hash_table_new_full(g_str_hash, g_str_equal,
                                              g_free, g_free);
     priv->jump_buffer = NULL;
@@ -429,6 +460,195 @@ invoke (CutTest *test, CutTestContext *test_context, CutRunContext *run_context)
     priv->test_function();
 }
 
+static void
+emit_timeout_result (CutTest *test, CutTestContext *test_context,
+                     CutTestWatchdog *watchdog)
+{
+    CutTestResult *result;
+    CutTestData *data = NULL;
+    gchar *message;
+
+    if (CUT_IS_ITERATED_TEST(test))
+        data = cut_iterated_test_get_data(CUT_ITERATED_TEST(test));
+    message = g_strdup_printf("timed out: %g second(s): elapsed: %g second(s)",
+                              cut_test_watchdog_get_timeout(watchdog),
+                              cut_test_get_elapsed(test));
+    result = cut_test_result_new(CUT_TEST_RESULT_ERROR,
+                                 test,
+                                 cut_test_context_get_test_iterator(test_context),
+                                 cut_test_context_get_test_case(test_context),
+                                 cut_test_context_get_test_suite(test_context),
+                                 data,
+                                 NULL, message, NULL);
+    g_free(message);
+
+    cut_test_context_set_failed(test_context, TRUE);
+    cut_test_emit_result_signal(test, test_context, result);
+    g_object_unref(result);
+}
+
+void
+cut_test_emit_regression_result (CutTest        *test,
+                                 CutTestContext *test_context,
+                                 CutRunContext  *run_context,
+                                 const gchar    *message)
+{
+    CutTestResult *result;
+    CutTestResultStatus status;
+    CutTestData *data = NULL;
+
+    if (CUT_IS_ITERATED_TEST(test))
+        data = cut_iterated_test_get_data(CUT_ITERATED_TEST(test));
+    if (cut_run_context_get_fail_on_regression(run_context))
+        status = CUT_TEST_RESULT_FAILURE;
+    else
+        status = CUT_TEST_RESULT_NOTIFICATION;
+    result = cut_test_result_new(status,
+                                 test,
+                                 cut_test_context_get_test_iterator(test_context),
+                                 cut_test_context_get_test_case(test_context),
+                                 cut_test_context_get_test_suite(test_context),
+                                 data,
+                                 NULL, message, NULL);
+
+    if (status == CUT_TEST_RESULT_FAILURE)
+        cut_test_context_set_failed(test_context, TRUE);
+    cut_test_emit_result_signal(test, test_context, result);
+    g_object_unref(result);
+}
+
+static void
+check_regression (CutTest *test, CutTestContext *test_context,
+                  CutRunContext *run_context)
+{
+    gchar *message;
+
+    /* An iterated test shares its name with other data. */
+    if (CUT_IS_ITERATED_TEST(test))
+        return;
+
+    message = cut_run_context_check_test_regression(run_context,
+                                                    test, test_context,
+                                                    cut_test_get_elapsed(test));
+    if (!message)
+        return;
+
+    cut_test_emit_regression_result(test, test_context, run_context, message);
+    g_free(message);
+}
+
+typedef struct _AllocationFailureData
+{
+    CutTest *test;
+    CutTestContext *test_context;
+    CutRunContext *run_context;
+} AllocationFailureData;
+
+static gint64
+run_with_allocation_failure (gpointer user_data)
+{
+    AllocationFailureData *data = user_data;
+    CutTestCase *test_case;
+    CutTestContext *test_context;
+    CutMemoryUsage *memory_usage;
+    jmp_buf jump_buffer;
+    gint64 heap_growth;
+
+    cut_run_context_detach_listeners(data->run_context);
+    cut_run_context_set_result_retention(data->run_context,
+                                         CUT_RESULT_RETENTION_NONE);
+
+    /* The fixture of the test in the parent process is still
+     * alive. */
+    test_case = cut_test_context_get_test_case(data->test_context);
+    if (test_case)
+        cut_test_case_run_teardown(test_case, data->test_context);
+
+    /* Objects taken by a test context are freed with it. So the
+     * new test context is measured too. */
+    memory_usage = cut_memory_usage_new();
+    cut_memory_usage_start(memory_usage);
+    test_context =
+        cut_test_context_new(data->run_context,
+                             cut_test_context_get_test_suite(data->test_context),
+                             test_case, NULL, data->test);
+    cut_test_context_current_push(test_context);
+    if (test_case)
+        cut_test_case_run_setup(test_case, test_context);
+    if (!cut_test_context_is_failed(test_context)) {
+        cut_test_context_set_jump_buffer(test_context, &jump_buffer);
+        if (setjmp(jump_buffer) == 0) {
+            cut_allocation_failure_start();
+            CUT_TEST_GET_CLASS(data->test)->invoke(data->test, test_context,
+                                                   data->run_context);
+        }
+        cut_allocation_failure_stop();
+    }
+    if (test_case)
+        cut_test_case_run_teardown(test_case, test_context);
+    cut_test_context_current_pop();
+    g_object_unref(test_context);
+    cut_memory_usage_stop(memory_usage);
+    heap_growth = cut_memory_usage_get_heap_growth(memory_usage);
+    cut_memory_usage_free(memory_usage);
+
+    return heap_growth;
+}
+
+static void
+check_allocation_failures (CutTest *test, CutTestContext *test_context,
+                           CutRunContext *run_context)
+{
+    AllocationFailureData data;
+    CutTestResult *result;
+    gint max_allocations, n_processes;
+    gchar *message;
+
+    max_allocations = cut_run_context_get_allocation_failures(run_context);
+    if (max_allocations <= 0)
+        return;
+    /* An iterated test needs its data setup. A benchmark runs its
+     * body too many times. */
+    if (CUT_IS_ITERATED_TEST(test) || CUT_IS_BENCHMARK(test))
+        return;
+    /* Forking a process that runs tests in threads isn't safe. */
+    if (cut_run_context_is_multi_thread(run_context))
+        return;
+
+    n_processes = cut_run_context_get_n_processes(run_context);
+    if (n_processes <= 0) {
+#if GLIB_CHECK_VERSION(2, 36, 0)
+        n_processes = g_get_num_processors();
+#else
+        n_processes = 1;
+#endif
+    }
+
+    data.test = test;
+    data.test_context = test_context;
+    data.run_context = run_context;
+    message = cut_allocation_failure_check(
+        run_with_allocation_failure, &data,
+        max_allocations, n_processes,
+        cut_run_context_get_test_timeout(
+            run_context, test,
+            cut_test_context_get_test_iterator(test_context)));
+    if (!message)
+        return;
+
+    result = cut_test_result_new(CUT_TEST_RESULT_FAILURE,
+                                 test,
+                                 cut_test_context_get_test_iterator(test_context),
+                                 cut_test_context_get_test_case(test_context),
+                                 cut_test_context_get_test_suite(test_context),
+                                 NULL,
+                                 NULL, message, NULL);
+    cut_test_context_set_failed(test_context, TRUE);
+    cut_test_emit_result_signal(test, test_context, result);
+    g_object_unref(result);
+    g_free(message);
+}
+
 static gboolean
 run (CutTest *test, CutTestContext *test_context, CutRunContext *run_context)
 {
@@ -443,6 +663,8 @@ run (CutTest *test, CutTestContext *test_context, CutRunContext *run_context)
     gint signum;
     jmp_buf crash_jump_buffer;
     CutCrashBacktrace *crash_backtrace = NULL;
+    CutTestWatchdog *watchdog = NULL;
+    gdouble timeout;
 
     priv = CUT_TEST_GET_PRIVATE(test);
     klass = CUT_TEST_GET_CLASS(test);
@@ -459,6 +681,17 @@ run (CutTest *test, CutTestContext *test_context, CutRunContext *run_context)
     if (CUT_IS_ITERATED_TEST(test))
         data = cut_iterated_test_get_data(CUT_ITERATED_TEST(test));
 
+    timeout = cut_run_context_get_test_timeout(run_context, test,
+                                               test_iterator);
+    if (timeout > 0.0)
+        watchdog = cut_test_watchdog_new(cut_test_get_name(test), timeout);
+
+    /* Counters count only the thread that opens them. */
+    if (cut_run_context_get_performance_counters(run_context))
+        priv->performance_counters = cut_performance_counters_new();
+    if (cut_run_context_get_memory_usage(run_context))
+        priv->memory_usage = cut_memory_usage_new();
+
     if (cut_run_context_is_multi_thread(run_context) ||
         !cut_run_context_get_handle_signals(run_context)) {
         signum = 0;
@@ -477,11 +710,33 @@ run (CutTest *test, CutTestContext *test_context, CutRunContext *run_context)
             } else {
                 priv->timer = g_timer_new();
             }
+            if (watchdog)
+                cut_test_watchdog_start(watchdog);
+            if (priv->performance_counters)
+                cut_performance_counters_start(priv->performance_counters);
+            if (priv->memory_usage)
+                cut_memory_usage_start(priv->memory_usage);
             klass->invoke(test, test_context, run_context);
         }
+        if (priv->memory_usage)
+            cut_memory_usage_stop(priv->memory_usage);
+        if (priv->performance_counters)
+            cut_performance_counters_stop(priv->performance_counters);
         g_timer_stop(priv->timer);
 
+        if (watchdog) {
+            cut_test_watchdog_stop(watchdog);
+            if (cut_test_watchdog_is_timed_out(watchdog))
+                emit_timeout_result(test, test_context, watchdog);
+        }
+
+        if (!cut_test_context_is_failed(test_context))
+            check_regression(test, test_context, run_context);
+        if (!cut_test_context_is_failed(test_context))
+            check_allocation_failures(test, test_context, run_context);
+
         success = !cut_test_context_is_failed(test_context);
+        cut_test_context_flush_pass_assertions(test_context);
 
         if (crash_backtrace)
             cut_crash_backtrace_free(crash_backtrace);
@@ -520,6 +775,16 @@ run (CutTest *test, CutTestContext *test_context, CutRunContext *run_context)
     g_signal_emit_by_name(test, "complete", test_context, success);
 
     priv->jump_buffer = NULL;
+    if (watchdog)
+        cut_test_watchdog_free(watchdog);
+    if (priv->performance_counters) {
+        cut_performance_counters_free(priv->performance_counters);
+        priv->performance_counters = NULL;
+    }
+    if (priv->memory_usage) {
+        cut_memory_usage_free(priv->memory_usage);
+        priv->memory_usage = NULL;
+    }
 
     return success;
 }
@@ -676,6 +941,24 @@ cut_test_get_attributes (CutTest *test)
     return CUT_TEST_GET_PRIVATE(test)->attributes;
 }
 
+gdouble
+cut_test_get_timeout (CutTest *test)
+{
+    const gchar *value;
+    gchar *end;
+    gdouble timeout;
+
+    value = cut_test_get_attribute(test, "timeout");
+    if (!value)
+        return -1.0;
+
+    timeout = g_ascii_strtod(value, &end);
+    if (end == value || *end != '\0' || timeout < 0.0)
+        return -1.0;
+
+    return timeout;
+}
+
 const gchar *
 cut_test_get_base_directory (CutTest *test)
 {
@@ -799,12 +1082,48 @@ emit_result_signal (CutTest *test,
     g_signal_emit_by_name(test, status_signal_name, test_context, result);
 }
 
+static void
+set_result_performance_counters (CutTest *test, CutTestResult *result)
+{
+    CutTestPrivate *priv;
+    gint i;
+
+    priv = CUT_TEST_GET_PRIVATE(test);
+    if (!priv->performance_counters)
+        return;
+
+    for (i = 0; i < CUT_PERFORMANCE_COUNTER_N_TYPES; i++) {
+        cut_test_result_set_performance_counter(
+            result, i,
+            cut_performance_counters_get_value(priv->performance_counters, i));
+    }
+}
+
+static void
+set_result_memory_usage (CutTest *test, CutTestResult *result)
+{
+    CutTestPrivate *priv;
+    gint i;
+
+    priv = CUT_TEST_GET_PRIVATE(test);
+    if (!priv->memory_usage)
+        return;
+
+    for (i = 0; i < CUT_MEMORY_USAGE_N_TYPES; i++) {
+        cut_test_result_set_memory_usage(
+            result, i,
+            cut_memory_usage_get_value(priv->memory_usage, i));
+    }
+}
+
 void
 cut_test_emit_result_signal (CutTest *test,
                              CutTestContext *test_context,
                              CutTestResult *result)
 {
     cut_test_set_result_elapsed(test, result);
+    set_result_performance_counters(test, result);
+    set_result_memory_usage(test, result);
 
     CUT_TEST_GET_CLASS(test)->emit_result_signal(test, test_context, result);
 }
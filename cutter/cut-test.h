@@ -58,6 +58,9 @@ struct _CutTestClass
                             CutTestContext *context);
     void (*pass_assertion) (CutTest        *test,
                             CutTestContext *context);
+    void (*pass_assertions)(CutTest        *test,
+                            CutTestContext *context,
+                            guint           n_assertions);
     void (*success)        (CutTest        *test,
                             CutTestContext *context,
                             CutTestResult  *result);
@@ -79,6 +82,9 @@ struct _CutTestClass
     void (*crash)          (CutTest        *test,
                             CutTestContext *context,
                             CutTestResult  *result);
+    void (*benchmark)      (CutTest        *test,
+                            CutTestContext *context,
+                            CutBenchmarkResult *result);
     void (*complete)       (CutTest        *test,
                             CutTestContext *context,
                             gboolean        success);
@@ -137,6 +143,7 @@ void         cut_test_set_attribute       (CutTest     *test,
                                            const gchar *name,
                                            const gchar *value);
 GHashTable  *cut_test_get_attributes      (CutTest     *test);
+gdouble      cut_test_get_timeout         (CutTest     *test);
 const gchar *cut_test_get_base_directory  (CutTest     *test);
 void         cut_test_set_base_directory  (CutTest     *test,
                                            const gchar *base_directory);
@@ -151,6 +158,13 @@ void         cut_test_set_result_elapsed  (CutTest       *test,
 void         cut_test_emit_result_signal  (CutTest     *test,
                                            CutTestContext *test_context,
                                            CutTestResult *result);
+/* Emits a notification or, with "fail-on-regression", a
+ * failure for a performance regression. */
+void         cut_test_emit_regression_result
+                                          (CutTest     *test,
+                                           CutTestContext *test_context,
+                                           CutRunContext *run_context,
+                                           const gchar *message);
 
 G_END_DECLS
 
@@ -0,0 +1,212 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <errno.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+
+#include "cut-timing-history.h"
+#include "cut-logger.h"
+
+#define ELAPSED_KEY "Elapsed"
+#define TEST_KEY_PREFIX "Test."
+
+struct _CutTimingHistory
+{
+    gchar *filename;
+    GKeyFile *key_file;
+};
+
+gchar *
+cut_timing_history_build_filename (const gchar *cache_directory,
+                                   const gchar *test_directory)
+{
+    gchar *absolute_test_directory, *base_name, *character, *filename;
+
+    if (g_path_is_absolute(test_directory)) {
+        absolute_test_directory = g_strdup(test_directory);
+    } else {
+        gchar *current_directory;
+
+        current_directory = g_get_current_dir();
+        absolute_test_directory = g_build_filename(current_directory,
+                                                   test_directory,
+                                                   NULL);
+        g_free(current_directory);
+    }
+
+    base_name = g_strconcat(absolute_test_directory, ".timing", NULL);
+    for (character = base_name; *character; character++) {
+        if (!g_ascii_isalnum(*character) &&
+            *character != '-' &&
+            *character != '.')
+            *character = '_';
+    }
+    filename = g_build_filename(cache_directory, "timing", base_name, NULL);
+    g_free(base_name);
+    g_free(absolute_test_directory);
+
+    return filename;
+}
+
+CutTimingHistory *
+cut_timing_history_new (const gchar *filename)
+{
+    CutTimingHistory *history;
+
+    history = g_new0(CutTimingHistory, 1);
+    history->filename = g_strdup(filename);
+    history->key_file = g_key_file_new();
+
+    return history;
+}
+
+void
+cut_timing_history_free (CutTimingHistory *history)
+{
+    g_free(history->filename);
+    g_key_file_free(history->key_file);
+    g_free(history);
+}
+
+const gchar *
+cut_timing_history_get_filename (CutTimingHistory *history)
+{
+    return history->filename;
+}
+
+gboolean
+cut_timing_history_load (CutTimingHistory *history, GError **error)
+{
+    if (!g_file_test(history->filename, G_FILE_TEST_EXISTS))
+        return TRUE;
+
+    if (!g_key_file_load_from_file(history->key_file, history->filename,
+                                   G_KEY_FILE_NONE, error))
+        return FALSE;
+
+    cut_log_trace("[timing-history][load] <%s>", history->filename);
+    return TRUE;
+}
+
+gboolean
+cut_timing_history_save (CutTimingHistory *history, GError **error)
+{
+    gchar *data, *directory;
+    gsize length;
+    gboolean success;
+
+    directory = g_path_get_dirname(history->filename);
+    if (g_mkdir_with_parents(directory, 0755) == -1) {
+        g_set_error(error,
+                    G_FILE_ERROR,
+                    g_file_error_from_errno(errno),
+                    "failed to create timing history directory: %s: %s",
+                    directory, g_strerror(errno));
+        g_free(directory);
+        return FALSE;
+    }
+    g_free(directory);
+
+    data = g_key_file_to_data(history->key_file, &length, NULL);
+    success = g_file_set_contents(history->filename, data, length, error);
+    g_free(data);
+
+    if (success)
+        cut_log_trace("[timing-history][save] <%s>", history->filename);
+    return success;
+}
+
+static gdouble
+get_elapsed (CutTimingHistory *history, const gchar *group, const gchar *key)
+{
+    gdouble elapsed;
+    GError *error = NULL;
+
+    elapsed = g_key_file_get_double(history->key_file, group, key, &error);
+    if (error) {
+        g_error_free(error);
+        return -1.0;
+    }
+
+    return elapsed;
+}
+
+static void
+record_elapsed (CutTimingHistory *history, const gchar *group,
+                const gchar *key, gdouble elapsed)
+{
+    gdouble previous_elapsed;
+
+    previous_elapsed = get_elapsed(history, group, key);
+    if (previous_elapsed >= 0.0)
+        elapsed = (previous_elapsed + elapsed) / 2.0;
+    g_key_file_set_double(history->key_file, group, key, elapsed);
+}
+
+void
+cut_timing_history_record_test_case (CutTimingHistory *history,
+                                     const gchar *test_case_name,
+                                     gdouble elapsed)
+{
+    record_elapsed(history, test_case_name, ELAPSED_KEY, elapsed);
+}
+
+void
+cut_timing_history_record_test (CutTimingHistory *history,
+                                const gchar *test_case_name,
+                                const gchar *test_name,
+                                gdouble elapsed)
+{
+    gchar *key;
+
+    key = g_strconcat(TEST_KEY_PREFIX, test_name, NULL);
+    record_elapsed(history, test_case_name, key, elapsed);
+    g_free(key);
+}
+
+gdouble
+cut_timing_history_get_test_case_elapsed (CutTimingHistory *history,
+                                          const gchar *test_case_name)
+{
+    return get_elapsed(history, test_case_name, ELAPSED_KEY);
+}
+
+gdouble
+cut_timing_history_get_test_elapsed (CutTimingHistory *history,
+                                     const gchar *test_case_name,
+                                     const gchar *test_name)
+{
+    gchar *key;
+    gdouble elapsed;
+
+    key = g_strconcat(TEST_KEY_PREFIX, test_name, NULL);
+    elapsed = get_elapsed(history, test_case_name, key);
+    g_free(key);
+
+    return elapsed;
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
@@ -0,0 +1,73 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef __CUT_TIMING_HISTORY_H__
+#define __CUT_TIMING_HISTORY_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/*
+ * CutTimingHistory keeps elapsed times of test cases and tests
+ * measured by past runs. A recorded time is averaged with the
+ * previous one to smooth out a noisy run.
+ */
+typedef struct _CutTimingHistory CutTimingHistory;
+
+gchar            *cut_timing_history_build_filename
+                                            (const gchar      *cache_directory,
+                                             const gchar      *test_directory);
+
+CutTimingHistory *cut_timing_history_new   (const gchar      *filename);
+void              cut_timing_history_free  (CutTimingHistory *history);
+
+const gchar      *cut_timing_history_get_filename
+                                            (CutTimingHistory *history);
+gboolean          cut_timing_history_load  (CutTimingHistory *history,
+                                            GError          **error);
+gboolean          cut_timing_history_save  (CutTimingHistory *history,
+                                            GError          **error);
+
+void              cut_timing_history_record_test_case
+                                            (CutTimingHistory *history,
+                                             const gchar      *test_case_name,
+                                             gdouble           elapsed);
+void              cut_timing_history_record_test
+                                            (CutTimingHistory *history,
+                                             const gchar      *test_case_name,
+                                             const gchar      *test_name,
+                                             gdouble           elapsed);
+
+/* Returns a negative value for an unknown test case or test. */
+gdouble           cut_timing_history_get_test_case_elapsed
+                                            (CutTimingHistory *history,
+                                             const gchar      *test_case_name);
+gdouble           cut_timing_history_get_test_elapsed
+                                            (CutTimingHistory *history,
+                                             const gchar      *test_case_name,
+                                             const gchar      *test_name);
+
+G_END_DECLS
+
+#endif /* __CUT_TIMING_HISTORY_H__ */
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
@@ -40,6 +40,8 @@
 #include "cut-sub-process.h"
 #include "cut-sub-process-group.h"
 #include "cut-readable-differ.h"
+#include "cut-regex-cache.h"
+#include "cut-test-result.h"
 #include "cut-main.h"
 #include "cut-backtrace-entry.h"
 #include "../gcutter/gcut-public.h"
@@ -95,7 +97,7 @@ cut_utils_filter_to_regexs (const gchar **filter)
             continue;
 
         pattern = cut_utils_create_regex_pattern(*filter);
-        regex = g_regex_new(pattern, 0, 0, &error);
+        regex = cut_regex_cache_get(pattern, 0, &error);
         if (regex) {
             regexs = g_list_prepend(regexs, regex);
         } else {
@@ -165,6 +167,63 @@ cut_utils_inspect_memory (const void *memory, size_t size)
     return g_string_free(buffer, FALSE);
 }
 
+#define HEXDUMP_BYTES_PER_LINE 16
+#define HEXDUMP_CONTEXT_LINES 2
+
+/*
+ * Dumps lines around @offset like "hexdump -C". The line that
+ * has @offset is marked with ">".
+ */
+char *
+cut_utils_hexdump_around (const void *memory, size_t size, size_t offset)
+{
+    const guchar *binary = memory;
+    GString *buffer;
+    size_t line, start, end;
+
+    if (memory == NULL || size == 0)
+        return g_strdup("(empty)");
+
+    line = MIN(offset, size - 1) / HEXDUMP_BYTES_PER_LINE;
+    start = line * HEXDUMP_BYTES_PER_LINE;
+    if (line > HEXDUMP_CONTEXT_LINES)
+        start -= HEXDUMP_CONTEXT_LINES * HEXDUMP_BYTES_PER_LINE;
+    else
+        start = 0;
+    end = MIN(size,
+              (line + HEXDUMP_CONTEXT_LINES + 1) * HEXDUMP_BYTES_PER_LINE);
+
+    buffer = g_string_new(NULL);
+    for (; start < end; start += HEXDUMP_BYTES_PER_LINE) {
+        size_t i;
+
+        if (buffer->len > 0)
+            g_string_append_c(buffer, '\n');
+        g_string_append_printf(buffer, "%c%08" G_GINT64_MODIFIER "x ",
+                               start / HEXDUMP_BYTES_PER_LINE == line ?
+                               '>' : ' ',
+                               (guint64)start);
+        for (i = 0; i < HEXDUMP_BYTES_PER_LINE; i++) {
+            if (i == HEXDUMP_BYTES_PER_LINE / 2)
+                g_string_append_c(buffer, ' ');
+            if (start + i < end)
+                g_string_append_printf(buffer, " %02x", binary[start + i]);
+            else
+                g_string_append(buffer, "   ");
+        }
+        g_string_append(buffer, "  |");
+        for (i = 0; i < HEXDUMP_BYTES_PER_LINE && start + i < end; i++) {
+            if (g_ascii_isprint(binary[start + i]))
+                g_string_append_c(buffer, binary[start + i]);
+            else
+                g_string_append_c(buffer, '.');
+        }
+        g_string_append_c(buffer, '|');
+    }
+
+    return g_string_free(buffer, FALSE);
+}
+
 gboolean
 cut_utils_equal_string (const gchar *string1, const gchar *string2)
 {
@@ -436,7 +495,7 @@ cut_utils_path_exist (const gchar *path)
 gboolean
 cut_utils_regex_match (const gchar *pattern, const gchar *string)
 {
-    return g_regex_match_simple(pattern, string, G_REGEX_MULTILINE, 0);
+    return cut_regex_cache_match(pattern, G_REGEX_MULTILINE, string);
 }
 
 gchar *
@@ -446,7 +505,7 @@ cut_utils_regex_replace (const gchar *pattern, const gchar *string,
     GRegex *regex;
     gchar *replaced;
 
-    regex = g_regex_new(pattern, G_REGEX_MULTILINE, 0, error);
+    regex = cut_regex_cache_get(pattern, G_REGEX_MULTILINE, error);
     if (!regex)
         return NULL;
 
@@ -743,6 +802,19 @@ cut_utils_append_diff (const gchar *message, const gchar *from, const gchar *to)
 {
     gchar *diff, *result;
 
+    if (cut_test_result_is_diff_target_too_large(from, to)) {
+        diff = cut_diff_readable_summary(from, to);
+        if (!diff)
+            return g_strdup(message);
+        result = g_strdup_printf("%s\n"
+                                 "\n"
+                                 "diff:\n"
+                                 "%s",
+                                 message, diff);
+        g_free(diff);
+        return result;
+    }
+
     diff = cut_diff_readable(from, to);
     if (cut_diff_readable_is_interested(diff)) {
         result = g_strdup_printf("%s\n"
@@ -310,6 +310,15 @@ void cut_shutdown(void);
  *
  * Sets attributes of the test.
  *
+ * The "timeout" attribute sets the timeout of the test in
+ * seconds, e.g. "0.5". It overrides --timeout option. "0"
+ * disables the timeout of the test.
+ *
+ * The "benchmark-time" attribute sets the time to measure a
+ * benchmark function, a function whose name starts with
+ * "bench_", in seconds. It overrides --benchmark-time
+ * option. "0" runs the benchmark function only once.
+ *
  * e.g.:
  * |[
  * #include <cutter.h>
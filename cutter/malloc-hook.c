@@ -0,0 +1,185 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+/*
+ * malloc() family interposer for --memory-usage and
+ * --allocation-failures. Functions defined in an executable take
+ * precedence over the ones in shared libraries. So allocations by
+ * test modules and libraries they use are also reported to
+ * CutMemoryUsage and may be failed by CutAllocationFailure.
+ * glibc's __libc_*() does the real allocation. Until the hook is
+ * enabled, an allocation only checks one flag.
+ */
+
+#ifdef ENABLE_MALLOC_HOOK
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <errno.h>
+#include <malloc.h>
+#include <unistd.h>
+
+#include "cut-memory-usage.h"
+#include "cut-allocation-failure.h"
+#include "cut-malloc-hook.h"
+
+extern void *__libc_malloc  (size_t size);
+extern void *__libc_calloc  (size_t n_members, size_t size);
+extern void *__libc_realloc (void *pointer, size_t size);
+extern void *__libc_memalign(size_t alignment, size_t size);
+extern void  __libc_free    (void *pointer);
+
+#define CALLER() __builtin_return_address(0)
+#define ENABLED() __builtin_expect(cut_malloc_hook_enabled, 0)
+
+static void install (void) __attribute__((constructor));
+
+static void
+install (void)
+{
+    cut_malloc_hook_install();
+}
+
+static int
+should_fail (const void *caller)
+{
+    if (!cut_allocation_failure_should_fail(caller))
+        return 0;
+
+    errno = ENOMEM;
+    return 1;
+}
+
+static void *
+track_allocation (void *pointer, size_t size)
+{
+    if (pointer)
+        cut_memory_usage_track_allocation(size, malloc_usable_size(pointer));
+    return pointer;
+}
+
+static void *
+aligned_allocate (const void *caller, size_t alignment, size_t size)
+{
+    if (!ENABLED())
+        return __libc_memalign(alignment, size);
+    if (should_fail(caller))
+        return NULL;
+    return track_allocation(__libc_memalign(alignment, size), size);
+}
+
+void *
+malloc (size_t size)
+{
+    if (!ENABLED())
+        return __libc_malloc(size);
+    if (should_fail(CALLER()))
+        return NULL;
+    return track_allocation(__libc_malloc(size), size);
+}
+
+void *
+calloc (size_t n_members, size_t size)
+{
+    if (!ENABLED())
+        return __libc_calloc(n_members, size);
+    if (size > 0 && n_members > SIZE_MAX / size) {
+        errno = ENOMEM;
+        return NULL;
+    }
+    if (should_fail(CALLER()))
+        return NULL;
+    return track_allocation(__libc_calloc(n_members, size), n_members * size);
+}
+
+void *
+realloc (void *pointer, size_t size)
+{
+    size_t old_usable_size = 0;
+    void *new_pointer;
+
+    if (!ENABLED())
+        return __libc_realloc(pointer, size);
+    if (size > 0 && should_fail(CALLER()))
+        return NULL;
+
+    if (pointer)
+        old_usable_size = malloc_usable_size(pointer);
+    new_pointer = __libc_realloc(pointer, size);
+    if (pointer && (new_pointer || size == 0))
+        cut_memory_usage_track_free(old_usable_size);
+    return track_allocation(new_pointer, size);
+}
+
+void *
+memalign (size_t alignment, size_t size)
+{
+    return aligned_allocate(CALLER(), alignment, size);
+}
+
+void *
+aligned_alloc (size_t alignment, size_t size)
+{
+    return aligned_allocate(CALLER(), alignment, size);
+}
+
+void *
+valloc (size_t size)
+{
+    return aligned_allocate(CALLER(), sysconf(_SC_PAGESIZE), size);
+}
+
+int
+posix_memalign (void **pointer, size_t alignment, size_t size)
+{
+    void *new_pointer;
+
+    if (alignment % sizeof(void *) != 0 ||
+        (alignment & (alignment - 1)) != 0 ||
+        alignment == 0)
+        return EINVAL;
+
+    new_pointer = aligned_allocate(CALLER(), alignment, size);
+    if (!new_pointer)
+        return ENOMEM;
+
+    *pointer = new_pointer;
+    return 0;
+}
+
+void
+free (void *pointer)
+{
+    if (!pointer)
+        return;
+
+    if (ENABLED())
+        cut_memory_usage_track_free(malloc_usable_size(pointer));
+    __libc_free(pointer);
+}
+
+#endif
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
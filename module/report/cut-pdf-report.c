@@ -650,6 +650,9 @@ attach_to_run_context (CutListener *listener,
 
     if (run_context) {
         report->run_context = g_object_ref(run_context);
+        /* All results are drawn on completion. */
+        cut_run_context_set_result_retention(run_context,
+                                             CUT_RESULT_RETENTION_ALL);
         connect_to_run_context(CUT_PDF_REPORT(listener), run_context);
     }
 }
@@ -29,12 +29,28 @@
 #include <glib/gstdio.h>
 #include <gmodule.h>
 
+#ifndef G_OS_WIN32
+#  include <unistd.h>
+#endif
+
 #include <cutter/cut-module-impl.h>
 #include <cutter/cut-report.h>
 #include <cutter/cut-listener.h>
 #include <cutter/cut-run-context.h>
 #include <cutter/cut-test-result.h>
+#include <cutter/cut-benchmark-result.h>
 #include <cutter/cut-enum-types.h>
+#include <cutter/cut-glib-compatible.h>
+
+/* Results are written with one buffered channel. The buffer is
+ * flushed when it is full, after FLUSH_INTERVAL seconds and on a
+ * crash. A forked process, e.g. a worker process, shares the
+ * unflushed buffer with its parent. So only the process that
+ * opens the channel flushes it. Events may be emitted from some
+ * threads with --multi-thread. So the channel is guarded by the
+ * mutex. */
+#define OUTPUT_BUFFER_SIZE (64 * 1024)
+#define FLUSH_INTERVAL 1.0
 
 #define CUT_TYPE_XML_REPORT            cut_type_xml_report
 #define CUT_XML_REPORT(obj)            (G_TYPE_CHECK_INSTANCE_CAST ((obj), CUT_TYPE_XML_REPORT, CutXMLReport))
@@ -50,6 +66,12 @@ struct _CutXMLReport
 {
     CutReport     object;
     CutRunContext    *run_context;
+    GIOChannel       *channel;
+    GTimer           *flush_timer;
+    GMutex           *mutex;
+#ifndef G_OS_WIN32
+    pid_t             pid;
+#endif
 };
 
 struct _CutXMLReportClass
@@ -130,6 +152,9 @@ static void
 init (CutXMLReport *report)
 {
     report->run_context = NULL;
+    report->channel = NULL;
+    report->flush_timer = NULL;
+    report->mutex = g_mutex_new();
 }
 
 static void
@@ -199,11 +224,19 @@ CUT_MODULE_IMPL_INSTANTIATE (const gchar *first_property, va_list var_args)
     return g_object_new_valist(CUT_TYPE_XML_REPORT, first_property, var_args);
 }
 
+static void close_output (CutXMLReport *report);
+
 static void
 dispose (GObject *object)
 {
     CutXMLReport *report = CUT_XML_REPORT(object);
 
+    if (report->mutex) {
+        close_output(report);
+        g_mutex_free(report->mutex);
+        report->mutex = NULL;
+    }
+
     if (report->run_context) {
         g_object_unref(report->run_context);
         report->run_context = NULL;
@@ -248,34 +281,136 @@ get_property (GObject    *object,
     }
 }
 
-static void
-output_to_file (CutXMLReport *report, gchar *string)
+/* Must be called with report->mutex locked. */
+static gboolean
+open_output (CutXMLReport *report)
 {
     const gchar *filename;
-    FILE *fp;
-    int n_retries = 0;
+    GError *error = NULL;
 
-    if (!string)
-        return;
+    if (report->channel)
+        return TRUE;
 
     filename = cut_report_get_filename(CUT_REPORT(report));
     if (!filename)
+        return FALSE;
+
+    report->channel = g_io_channel_new_file(filename, "a", &error);
+    if (!report->channel) {
+        g_warning("can't open XML report file [%s]: %s",
+                  filename, error->message);
+        g_error_free(error);
+        return FALSE;
+    }
+    g_io_channel_set_encoding(report->channel, NULL, NULL);
+    g_io_channel_set_buffer_size(report->channel, OUTPUT_BUFFER_SIZE);
+#ifndef G_OS_WIN32
+    report->pid = getpid();
+#endif
+
+    report->flush_timer = g_timer_new();
+    return TRUE;
+}
+
+static gboolean
+is_output_owner (CutXMLReport *report)
+{
+#ifndef G_OS_WIN32
+    if (report->pid != getpid())
+        return FALSE;
+#endif
+    return TRUE;
+}
+
+/* Must be called with report->mutex locked. */
+static void
+flush_channel (CutXMLReport *report)
+{
+    GError *error = NULL;
+
+    if (!report->channel)
         return;
+    if (!is_output_owner(report))
+        return;
+
+    if (g_io_channel_flush(report->channel, &error) != G_IO_STATUS_NORMAL) {
+        g_warning("can't flush XML report to file [%s]: %s",
+                  cut_report_get_filename(CUT_REPORT(report)),
+                  error ? error->message : "unknown error");
+        if (error)
+            g_error_free(error);
+    }
+    g_timer_start(report->flush_timer);
+}
 
-    fp = g_fopen(filename, "a");
-    if (!fp)
+static void
+flush_output (CutXMLReport *report)
+{
+    g_mutex_lock(report->mutex);
+    flush_channel(report);
+    g_mutex_unlock(report->mutex);
+}
+
+/* Must be called with report->mutex locked. */
+static void
+close_channel (CutXMLReport *report)
+{
+    if (!report->channel)
         return;
 
-    while (fwrite(string, strlen(string), 1, fp) != 1) {
-        n_retries++;
-        if (n_retries >= 3) {
-            g_warning("can't write XML report to file [%s]: [%s]",
-                      filename, string);
-            break;
-        }
+    if (is_output_owner(report)) {
+        flush_channel(report);
+        g_io_channel_shutdown(report->channel, FALSE, NULL);
+    } else {
+        /* The buffered data are written by the parent process.
+         * Unreferencing a channel that is closed on unref
+         * flushes it. */
+        g_io_channel_set_close_on_unref(report->channel, FALSE);
+#ifndef G_OS_WIN32
+        close(g_io_channel_unix_get_fd(report->channel));
+#endif
     }
+    g_io_channel_unref(report->channel);
+    report->channel = NULL;
+    g_timer_destroy(report->flush_timer);
+    report->flush_timer = NULL;
+}
 
-    fclose(fp);
+static void
+close_output (CutXMLReport *report)
+{
+    g_mutex_lock(report->mutex);
+    close_channel(report);
+    g_mutex_unlock(report->mutex);
+}
+
+static void
+output_to_file (CutXMLReport *report, gchar *string)
+{
+    gsize written;
+    GError *error = NULL;
+
+    if (!string)
+        return;
+
+    g_mutex_lock(report->mutex);
+    if (!open_output(report)) {
+        g_mutex_unlock(report->mutex);
+        return;
+    }
+
+    if (g_io_channel_write_chars(report->channel, string, -1,
+                                 &written, &error) != G_IO_STATUS_NORMAL) {
+        g_warning("can't write XML report to file [%s]: %s: [%s]",
+                  cut_report_get_filename(CUT_REPORT(report)),
+                  error ? error->message : "unknown error",
+                  string);
+        if (error)
+            g_error_free(error);
+    } else if (g_timer_elapsed(report->flush_timer, NULL) >= FLUSH_INTERVAL) {
+        flush_channel(report);
+    }
+    g_mutex_unlock(report->mutex);
 }
 
 static void
@@ -285,6 +420,8 @@ cb_ready_test_suite (CutRunContext *run_context, CutTestSuite *test_suite,
 {
     const gchar *filename;
 
+    close_output(report);
+
     filename = cut_report_get_filename(CUT_REPORT(report));
     if (!filename)
         return;
@@ -326,6 +463,31 @@ cb_test_signal (CutRunContext      *run_context,
     g_string_free(string, TRUE);
 }
 
+static void
+cb_benchmark_test (CutRunContext      *run_context,
+                   CutTest            *test,
+                   CutTestContext     *test_context,
+                   CutBenchmarkResult *result,
+                   CutXMLReport       *report)
+{
+    GString *string;
+
+    string = g_string_new("  <benchmark>\n");
+    cut_test_to_xml_string(test, string, 4);
+    cut_benchmark_result_to_xml_string(result, string, 4);
+    g_string_append(string, "  </benchmark>\n");
+    output_to_file(report, string->str);
+    g_string_free(string, TRUE);
+}
+
+static void
+cb_crash_test_suite (CutRunContext *run_context, CutTestSuite *test_suite,
+                     CutTestResult *result, CutXMLReport *report)
+{
+    /* We may not be able to reach complete-test-suite. */
+    flush_output(report);
+}
+
 static void
 cb_complete_test (CutRunContext *run_context, CutTest *test,
                   CutTestContext *test_context, gboolean success,
@@ -344,6 +506,7 @@ cb_complete_test_suite (CutRunContext *run_context, CutTestSuite *test_suite,
                         gboolean success, CutXMLReport *report)
 {
     output_to_file(report, "</report>");
+    close_output(report);
 }
 
 static void
@@ -368,6 +531,10 @@ connect_to_run_context (CutXMLReport *report, CutRunContext *run_context)
     CONNECT_TO_TEST(omission_test);
     CONNECT_TO_TEST(crash_test);
 
+    CONNECT(benchmark_test);
+
+    CONNECT(crash_test_suite);
+
     CONNECT(complete_test);
     CONNECT(complete_test_case);
     CONNECT(complete_test_suite);
@@ -383,10 +550,15 @@ disconnect_from_run_context (CutXMLReport *report, CutRunContext *run_context)
                                          G_CALLBACK(cb_ ## name),      \
                                          report)
 
+    DISCONNECT(ready_test_suite);
     DISCONNECT(start_test_suite);
     DISCONNECT(start_test_case);
     DISCONNECT(start_test);
 
+    DISCONNECT(benchmark_test);
+
+    DISCONNECT(crash_test_suite);
+
     DISCONNECT(complete_test);
     DISCONNECT(complete_test_case);
     DISCONNECT(complete_test_suite);
@@ -408,6 +580,8 @@ attach_to_run_context (CutListener *listener,
 
     if (run_context) {
         report->run_context = g_object_ref(run_context);
+        /* Results are queried after the run. */
+        cut_run_context_hold_non_success_results(run_context);
         connect_to_run_context(CUT_XML_REPORT(listener), run_context);
     }
 }
@@ -421,6 +595,8 @@ detach_from_run_context (CutListener *listener,
         return;
 
     disconnect_from_run_context(report, run_context);
+    close_output(report);
+    cut_run_context_release_non_success_results(run_context);
     g_object_unref(report->run_context);
     report->run_context = NULL;
 }
@@ -0,0 +1,657 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+#include <glib/gi18n-lib.h>
+#include <gmodule.h>
+
+#include <cutter/cut-module-impl.h>
+#include <cutter/cut-stream.h>
+#include <cutter/cut-listener.h>
+#include <cutter/cut-run-context.h>
+#include <cutter/cut-test-result.h>
+#include <cutter/cut-enum-types.h>
+#include <cutter/cut-binary-stream-codec.h>
+#include <cutter/cut-glib-compatible.h>
+
+#define CUT_TYPE_BINARY_STREAM            cut_type_binary_stream
+#define CUT_BINARY_STREAM(obj)            (G_TYPE_CHECK_INSTANCE_CAST ((obj), CUT_TYPE_BINARY_STREAM, CutBinaryStream))
+#define CUT_BINARY_STREAM_CLASS(klass)    (G_TYPE_CHECK_CLASS_CAST ((klass), CUT_TYPE_BINARY_STREAM, CutBinaryStreamClass))
+#define CUT_IS_BINARY_STREAM(obj)         (G_TYPE_CHECK_INSTANCE_TYPE ((obj), CUT_TYPE_BINARY_STREAM))
+#define CUT_IS_BINARY_STREAM_CLASS(klass) (G_TYPE_CHECK_CLASS_TYPE ((klass), CUT_TYPE_BINARY_STREAM))
+#define CUT_BINARY_STREAM_GET_CLASS(obj)  (G_TYPE_INSTANCE_GET_CLASS((obj), CUT_TYPE_BINARY_STREAM, CutBinaryStreamClass))
+
+typedef struct _CutBinaryStream CutBinaryStream;
+typedef struct _CutBinaryStreamClass CutBinaryStreamClass;
+
+struct _CutBinaryStream
+{
+    CutStream   object;
+    CutRunContext    *run_context;
+    GMutex *mutex;
+    GString *buffer;
+    CutStreamDataFunction stream_function;
+    gpointer stream_function_user_data;
+    GDestroyNotify stream_function_user_data_destroy_function;
+};
+
+struct _CutBinaryStreamClass
+{
+    CutStreamClass parent_class;
+};
+
+enum
+{
+    PROP_0,
+    PROP_RUN_CONTEXT,
+    PROP_STREAM_FUNCTION,
+    PROP_STREAM_FUNCTION_USER_DATA,
+    PROP_STREAM_FUNCTION_USER_DATA_DESTROY_FUNCTION
+};
+
+static GType cut_type_binary_stream = 0;
+static CutStreamClass *parent_class;
+
+static void dispose        (GObject         *object);
+static void set_property   (GObject         *object,
+                            guint            prop_id,
+                            const GValue    *value,
+                            GParamSpec      *pspec);
+static void get_property   (GObject         *object,
+                            guint            prop_id,
+                            GValue          *value,
+                            GParamSpec      *pspec);
+
+static void attach_to_run_context             (CutListener *listener,
+                                               CutRunContext   *run_context);
+static void detach_from_run_context           (CutListener *listener,
+                                               CutRunContext   *run_context);
+
+static void
+class_init (CutBinaryStreamClass *klass)
+{
+    GObjectClass *gobject_class;
+    GParamSpec *spec;
+
+    parent_class = g_type_class_peek_parent(klass);
+
+    gobject_class = G_OBJECT_CLASS(klass);
+
+    gobject_class->dispose      = dispose;
+    gobject_class->set_property = set_property;
+    gobject_class->get_property = get_property;
+
+    spec = g_param_spec_object("cut-run-context",
+                               "CutRunContext object",
+                               "A CutRunContext object",
+                               CUT_TYPE_RUN_CONTEXT,
+                               G_PARAM_READWRITE);
+    g_object_class_install_property(gobject_class, PROP_RUN_CONTEXT, spec);
+
+    spec = g_param_spec_pointer("stream-function",
+                                "Stream function",
+                                "A function to stream data "
+                                "(CutStreamDataFunction)",
+                                G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY);
+    g_object_class_install_property(gobject_class, PROP_STREAM_FUNCTION, spec);
+
+    spec = g_param_spec_pointer("stream-function-user-data",
+                                "Stream function user data",
+                                "A user data to use with stream function",
+                                G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY);
+    g_object_class_install_property(gobject_class,
+                                    PROP_STREAM_FUNCTION_USER_DATA, spec);
+
+    spec = g_param_spec_pointer("stream-function-user-data-destroy-function",
+                                "Destroy function for stream function user data",
+                                "A function to destroy user data",
+                                G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY);
+    g_object_class_install_property(gobject_class,
+                                    PROP_STREAM_FUNCTION_USER_DATA_DESTROY_FUNCTION,
+                                    spec);
+}
+
+static void
+init (CutBinaryStream *stream)
+{
+    stream->run_context = NULL;
+    stream->mutex = g_mutex_new();
+    stream->buffer = g_string_new(NULL);
+    stream->stream_function = NULL;
+    stream->stream_function_user_data = NULL;
+    stream->stream_function_user_data_destroy_function = NULL;
+}
+
+static void
+listener_init (CutListenerClass *listener)
+{
+    listener->attach_to_run_context   = attach_to_run_context;
+    listener->detach_from_run_context = detach_from_run_context;
+}
+
+static void
+register_type (GTypeModule *type_module)
+{
+    static const GTypeInfo info =
+        {
+            sizeof (CutBinaryStreamClass),
+            (GBaseInitFunc) NULL,
+            (GBaseFinalizeFunc) NULL,
+            (GClassInitFunc) class_init,
+            NULL,           /* class_finalize */
+            NULL,           /* class_data */
+            sizeof(CutBinaryStream),
+            0,
+            (GInstanceInitFunc) init,
+        };
+
+    static const GInterfaceInfo listener_info =
+        {
+            (GInterfaceInitFunc) listener_init,
+            NULL,
+            NULL
+        };
+
+    cut_type_binary_stream =
+        g_type_module_register_type(type_module,
+                                    CUT_TYPE_STREAM,
+                                    "CutBinaryStream",
+                                    &info, 0);
+
+    g_type_module_add_interface(type_module,
+                                cut_type_binary_stream,
+                                CUT_TYPE_LISTENER,
+                                &listener_info);
+}
+
+G_MODULE_EXPORT GList *
+CUT_MODULE_IMPL_INIT (GTypeModule *type_module)
+{
+    GList *registered_types = NULL;
+
+    register_type(type_module);
+    if (cut_type_binary_stream)
+        registered_types =
+            g_list_prepend(registered_types,
+                           (gchar *)g_type_name(cut_type_binary_stream));
+
+    return registered_types;
+}
+
+G_MODULE_EXPORT void
+CUT_MODULE_IMPL_EXIT (void)
+{
+}
+
+G_MODULE_EXPORT GObject *
+CUT_MODULE_IMPL_INSTANTIATE (const gchar *first_property, va_list var_args)
+{
+    return g_object_new_valist(CUT_TYPE_BINARY_STREAM, first_property, var_args);
+}
+
+static void
+dispose (GObject *object)
+{
+    CutBinaryStream *stream = CUT_BINARY_STREAM(object);
+
+    if (stream->run_context) {
+        g_object_unref(stream->run_context);
+        stream->run_context = NULL;
+    }
+
+    if (stream->mutex) {
+        g_mutex_free(stream->mutex);
+        stream->mutex = NULL;
+    }
+
+    if (stream->buffer) {
+        g_string_free(stream->buffer, TRUE);
+        stream->buffer = NULL;
+    }
+
+    if (stream->stream_function_user_data) {
+        if (stream->stream_function_user_data_destroy_function)
+            stream->stream_function_user_data_destroy_function(stream->stream_function_user_data);
+        stream->stream_function_user_data = NULL;
+    }
+
+    G_OBJECT_CLASS(parent_class)->dispose(object);
+}
+
+static void
+set_property (GObject      *object,
+              guint         prop_id,
+              const GValue *value,
+              GParamSpec   *pspec)
+{
+    CutBinaryStream *stream = CUT_BINARY_STREAM(object);
+
+    switch (prop_id) {
+      case PROP_RUN_CONTEXT:
+        attach_to_run_context(CUT_LISTENER(stream),
+                              CUT_RUN_CONTEXT(g_value_get_object(value)));
+        break;
+      case PROP_STREAM_FUNCTION:
+        stream->stream_function = g_value_get_pointer(value);
+        break;
+      case PROP_STREAM_FUNCTION_USER_DATA:
+        stream->stream_function_user_data = g_value_get_pointer(value);
+        break;
+      case PROP_STREAM_FUNCTION_USER_DATA_DESTROY_FUNCTION:
+        stream->stream_function_user_data_destroy_function =
+            g_value_get_pointer(value);
+        break;
+      default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+}
+
+static void
+get_property (GObject    *object,
+              guint       prop_id,
+              GValue     *value,
+              GParamSpec *pspec)
+{
+    CutBinaryStream *stream = CUT_BINARY_STREAM(object);
+
+    switch (prop_id) {
+      case PROP_RUN_CONTEXT:
+        g_value_set_object(value, G_OBJECT(stream->run_context));
+        break;
+      case PROP_STREAM_FUNCTION:
+        g_value_set_pointer(value, stream->stream_function);
+        break;
+      case PROP_STREAM_FUNCTION_USER_DATA:
+        g_value_set_pointer(value, stream->stream_function_user_data);
+        break;
+      case PROP_STREAM_FUNCTION_USER_DATA_DESTROY_FUNCTION:
+        g_value_set_pointer(value, stream->stream_function_user_data_destroy_function);
+        break;
+      default:
+        G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
+        break;
+    }
+}
+
+static void
+flow (CutBinaryStream *stream, CutBinaryStreamEvent *event)
+{
+    GError *error = NULL;
+
+    if (!stream->stream_function)
+        return;
+
+    /* The buffer is reused to avoid allocating for each event. */
+    g_mutex_lock(stream->mutex);
+    g_string_truncate(stream->buffer, 0);
+    if (event->type == CUT_BINARY_STREAM_EVENT_START_RUN)
+        cut_binary_stream_append_header(stream->buffer);
+    cut_binary_stream_append_event(stream->buffer, event);
+    stream->stream_function(stream->buffer->str, stream->buffer->len, &error,
+                            stream->stream_function_user_data);
+    g_mutex_unlock(stream->mutex);
+
+    if (error) {
+        g_warning("WriteError: %s:%d: %s",
+                  g_quark_to_string(error->domain),
+                  error->code,
+                  error->message);
+        g_error_free(error);
+    }
+}
+
+#define FLOW(stream, event_type, ...) do                                \
+{                                                                       \
+    CutBinaryStreamEvent _event = {event_type, __VA_ARGS__};            \
+    flow((stream), &_event);                                            \
+} while (0)
+
+static void
+cb_start_run (CutRunContext *run_context, CutBinaryStream *stream)
+{
+    FLOW(stream, CUT_BINARY_STREAM_EVENT_START_RUN,
+         NULL, NULL, NULL, 0, 0, FALSE);
+}
+
+static void
+cb_ready_test_suite (CutRunContext *run_context, CutTestSuite *test_suite,
+                     guint n_test_cases, guint n_tests,
+                     CutBinaryStream *stream)
+{
+    FLOW(stream, CUT_BINARY_STREAM_EVENT_READY_TEST_SUITE,
+         CUT_TEST(test_suite), NULL, NULL, n_test_cases, n_tests, FALSE);
+}
+
+static void
+cb_start_test_suite (CutRunContext *run_context, CutTestSuite *test_suite,
+                     CutBinaryStream *stream)
+{
+    FLOW(stream, CUT_BINARY_STREAM_EVENT_START_TEST_SUITE,
+         CUT_TEST(test_suite), NULL, NULL, 0, 0, FALSE);
+}
+
+static void
+cb_ready_test_case (CutRunContext *run_context, CutTestCase *test_case,
+                    guint n_tests, CutBinaryStream *stream)
+{
+    FLOW(stream, CUT_BINARY_STREAM_EVENT_READY_TEST_CASE,
+         CUT_TEST(test_case), NULL, NULL, 0, n_tests, FALSE);
+}
+
+static void
+cb_start_test_case (CutRunContext *run_context, CutTestCase *test_case,
+                    CutBinaryStream *stream)
+{
+    FLOW(stream, CUT_BINARY_STREAM_EVENT_START_TEST_CASE,
+         CUT_TEST(test_case), NULL, NULL, 0, 0, FALSE);
+}
+
+static void
+cb_ready_test_iterator (CutRunContext *run_context,
+                        CutTestIterator *test_iterator,
+                        guint n_tests, CutBinaryStream *stream)
+{
+    FLOW(stream, CUT_BINARY_STREAM_EVENT_READY_TEST_ITERATOR,
+         CUT_TEST(test_iterator), NULL, NULL, 0, n_tests, FALSE);
+}
+
+static void
+cb_start_test_iterator (CutRunContext *run_context,
+                        CutTestIterator *test_iterator,
+                        CutBinaryStream *stream)
+{
+    FLOW(stream, CUT_BINARY_STREAM_EVENT_START_TEST_ITERATOR,
+         CUT_TEST(test_iterator), NULL, NULL, 0, 0, FALSE);
+}
+
+static void
+cb_start_iterated_test (CutRunContext *run_context,
+                        CutIteratedTest *iterated_test,
+                        CutTestContext *test_context,
+                        CutBinaryStream *stream)
+{
+    FLOW(stream, CUT_BINARY_STREAM_EVENT_START_ITERATED_TEST,
+         CUT_TEST(iterated_test), test_context, NULL, 0, 0, FALSE);
+}
+
+static void
+cb_start_test (CutRunContext *run_context, CutTest *test,
+               CutTestContext *test_context, CutBinaryStream *stream)
+{
+    FLOW(stream, CUT_BINARY_STREAM_EVENT_START_TEST,
+         test, test_context, NULL, 0, 0, FALSE);
+}
+
+static void
+cb_pass_assertion (CutRunContext *run_context, CutTest *test,
+                   CutTestContext *test_context, CutBinaryStream *stream)
+{
+    FLOW(stream, CUT_BINARY_STREAM_EVENT_PASS_ASSERTION,
+         test, test_context, NULL, 0, 0, FALSE);
+}
+
+static void
+cb_pass_assertions (CutRunContext *run_context, CutTest *test,
+                    CutTestContext *test_context, guint n_assertions,
+                    CutBinaryStream *stream)
+{
+    FLOW(stream, CUT_BINARY_STREAM_EVENT_PASS_ASSERTIONS,
+         test, test_context, NULL, 0, 0, FALSE, n_assertions);
+}
+
+static void
+cb_test_result (CutRunContext  *run_context,
+                CutTest        *test,
+                CutTestContext *test_context,
+                CutTestResult  *result,
+                CutBinaryStream *stream)
+{
+    FLOW(stream, CUT_BINARY_STREAM_EVENT_TEST_RESULT,
+         test, test_context, result, 0, 0, FALSE);
+}
+
+static void
+cb_benchmark_test (CutRunContext *run_context, CutTest *test,
+                   CutTestContext *test_context,
+                   CutBenchmarkResult *result, CutBinaryStream *stream)
+{
+    FLOW(stream, CUT_BINARY_STREAM_EVENT_BENCHMARK_TEST,
+         test, test_context, NULL, 0, 0, FALSE, 0, result);
+}
+
+static void
+cb_complete_test (CutRunContext *run_context, CutTest *test,
+                  CutTestContext *test_context, gboolean success,
+                  CutBinaryStream *stream)
+{
+    FLOW(stream, CUT_BINARY_STREAM_EVENT_COMPLETE_TEST,
+         test, test_context, NULL, 0, 0, success);
+}
+
+static void
+cb_complete_iterated_test (CutRunContext *run_context,
+                           CutIteratedTest *iterated_test,
+                           CutTestContext *test_context,
+                           gboolean success,
+                           CutBinaryStream *stream)
+{
+    FLOW(stream, CUT_BINARY_STREAM_EVENT_COMPLETE_ITERATED_TEST,
+         CUT_TEST(iterated_test), test_context, NULL, 0, 0, success);
+}
+
+static void
+cb_test_iterator_result (CutRunContext  *run_context,
+                         CutTestIterator *test_iterator,
+                         CutTestResult *result,
+                         CutBinaryStream *stream)
+{
+    FLOW(stream, CUT_BINARY_STREAM_EVENT_TEST_ITERATOR_RESULT,
+         CUT_TEST(test_iterator), NULL, result, 0, 0, FALSE);
+}
+
+static void
+cb_complete_test_iterator (CutRunContext *run_context,
+                           CutTestIterator *test_iterator,
+                           gboolean success,
+                           CutBinaryStream *stream)
+{
+    FLOW(stream, CUT_BINARY_STREAM_EVENT_COMPLETE_TEST_ITERATOR,
+         CUT_TEST(test_iterator), NULL, NULL, 0, 0, success);
+}
+
+static void
+cb_test_case_result (CutRunContext  *run_context,
+                     CutTestCase    *test_case,
+                     CutTestResult  *result,
+                     CutBinaryStream *stream)
+{
+    FLOW(stream, CUT_BINARY_STREAM_EVENT_TEST_CASE_RESULT,
+         CUT_TEST(test_case), NULL, result, 0, 0, FALSE);
+}
+
+static void
+cb_complete_test_case (CutRunContext *run_context, CutTestCase *test_case,
+                       gboolean success, CutBinaryStream *stream)
+{
+    FLOW(stream, CUT_BINARY_STREAM_EVENT_COMPLETE_TEST_CASE,
+         CUT_TEST(test_case), NULL, NULL, 0, 0, success);
+}
+
+static void
+cb_complete_test_suite (CutRunContext *run_context, CutTestSuite *test_suite,
+                        gboolean success, CutBinaryStream *stream)
+{
+    FLOW(stream, CUT_BINARY_STREAM_EVENT_COMPLETE_TEST_SUITE,
+         CUT_TEST(test_suite), NULL, NULL, 0, 0, success);
+}
+
+static void
+cb_complete_run (CutRunContext *run_context, gboolean success,
+                 CutBinaryStream *stream)
+{
+    FLOW(stream, CUT_BINARY_STREAM_EVENT_COMPLETE_RUN,
+         NULL, NULL, NULL, 0, 0, success);
+}
+
+#undef FLOW
+
+static void
+connect_to_run_context (CutBinaryStream *stream, CutRunContext *run_context)
+{
+#define CONNECT(name)                                                   \
+    g_signal_connect(run_context, #name, G_CALLBACK(cb_ ## name), stream)
+
+#define CONNECT_TO_TEST(name)                                           \
+    g_signal_connect(run_context, #name "_test",                        \
+                     G_CALLBACK(cb_test_result), stream)
+
+#define CONNECT_TO_TEST_CASE(name)                                      \
+    g_signal_connect(run_context, #name "_test_case",                   \
+                     G_CALLBACK(cb_test_case_result), stream)
+
+#define CONNECT_TO_TEST_ITERATOR(name)                                  \
+    g_signal_connect(run_context, #name "_test_iterator",               \
+                     G_CALLBACK(cb_test_iterator_result), stream)
+
+    CONNECT(start_run);
+    CONNECT(ready_test_suite);
+    CONNECT(start_test_suite);
+    CONNECT(ready_test_case);
+    CONNECT(start_test_case);
+    CONNECT(ready_test_iterator);
+    CONNECT(start_test_iterator);
+    CONNECT(start_iterated_test);
+    CONNECT(start_test);
+
+    CONNECT(pass_assertion);
+    CONNECT(pass_assertions);
+
+    CONNECT_TO_TEST(success);
+    CONNECT_TO_TEST(failure);
+    CONNECT_TO_TEST(error);
+    CONNECT_TO_TEST(pending);
+    CONNECT_TO_TEST(notification);
+    CONNECT_TO_TEST(omission);
+    CONNECT_TO_TEST(crash);
+
+    CONNECT_TO_TEST_ITERATOR(success);
+    CONNECT_TO_TEST_ITERATOR(failure);
+    CONNECT_TO_TEST_ITERATOR(error);
+    CONNECT_TO_TEST_ITERATOR(pending);
+    CONNECT_TO_TEST_ITERATOR(notification);
+    CONNECT_TO_TEST_ITERATOR(omission);
+    CONNECT_TO_TEST_ITERATOR(crash);
+
+    CONNECT_TO_TEST_CASE(success);
+    CONNECT_TO_TEST_CASE(failure);
+    CONNECT_TO_TEST_CASE(error);
+    CONNECT_TO_TEST_CASE(pending);
+    CONNECT_TO_TEST_CASE(notification);
+    CONNECT_TO_TEST_CASE(omission);
+    CONNECT_TO_TEST_CASE(crash);
+
+    CONNECT(benchmark_test);
+
+    CONNECT(complete_test);
+    CONNECT(complete_iterated_test);
+    CONNECT(complete_test_iterator);
+    CONNECT(complete_test_case);
+    CONNECT(complete_test_suite);
+    CONNECT(complete_run);
+
+#undef CONNECT
+#undef CONNECT_TO_TEST
+#undef CONNECT_TO_TEST_CASE
+#undef CONNECT_TO_TEST_ITERATOR
+}
+
+static void
+disconnect_from_run_context (CutBinaryStream *stream,
+                             CutRunContext *run_context)
+{
+#define DISCONNECT(name)                                                \
+    g_signal_handlers_disconnect_by_func(run_context,                   \
+                                         G_CALLBACK(cb_ ## name),       \
+                                         stream)
+    DISCONNECT(start_run);
+    DISCONNECT(ready_test_suite);
+    DISCONNECT(start_test_suite);
+    DISCONNECT(ready_test_case);
+    DISCONNECT(start_test_case);
+    DISCONNECT(ready_test_iterator);
+    DISCONNECT(start_test_iterator);
+    DISCONNECT(start_iterated_test);
+    DISCONNECT(start_test);
+
+    DISCONNECT(pass_assertion);
+    DISCONNECT(pass_assertions);
+
+    DISCONNECT(test_result);
+    DISCONNECT(test_iterator_result);
+    DISCONNECT(test_case_result);
+
+    DISCONNECT(benchmark_test);
+
+    DISCONNECT(complete_test);
+    DISCONNECT(complete_iterated_test);
+    DISCONNECT(complete_test_iterator);
+    DISCONNECT(complete_test_case);
+    DISCONNECT(complete_test_suite);
+    DISCONNECT(complete_run);
+
+#undef DISCONNECT
+}
+
+static void
+attach_to_run_context (CutListener *listener,
+                       CutRunContext   *run_context)
+{
+    CutBinaryStream *stream = CUT_BINARY_STREAM(listener);
+    if (stream->run_context)
+        detach_from_run_context(listener, stream->run_context);
+
+    if (run_context) {
+        stream->run_context = g_object_ref(run_context);
+        connect_to_run_context(CUT_BINARY_STREAM(listener), run_context);
+    }
+}
+
+static void
+detach_from_run_context (CutListener *listener,
+                         CutRunContext   *run_context)
+{
+    CutBinaryStream *stream = CUT_BINARY_STREAM(listener);
+    if (stream->run_context != run_context)
+        return;
+
+    disconnect_from_run_context(stream, run_context);
+    g_object_unref(stream->run_context);
+    stream->run_context = NULL;
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
@@ -40,6 +40,8 @@
 #  define STDOUT_FILENO 1
 #endif
 
+#define DEFAULT_BUFFER_SIZE (1024 * 1024)
+
 #define CUT_TYPE_XML_STREAM_FACTORY            cut_type_xml_stream_factory
 #define CUT_XML_STREAM_FACTORY(obj)            (G_TYPE_CHECK_INSTANCE_CAST ((obj), CUT_TYPE_XML_STREAM_FACTORY, CutXMLStreamFactory))
 #define CUT_XML_STREAM_FACTORY_CLASS(klass)    (G_TYPE_CHECK_CLASS_CAST ((klass), CUT_TYPE_XML_STREAM_FACTORY, CutXMLStreamFactoryClass))
@@ -56,6 +58,9 @@ struct _CutXMLStreamFactory
 
     gint                 fd;
     gchar               *directory;
+    gboolean             async;
+    guint                buffer_size;
+    gboolean             drop_on_overflow;
 };
 
 struct _CutXMLStreamFactoryClass
@@ -124,6 +129,9 @@ init (CutXMLStreamFactory *factory)
 {
     factory->fd = -1;
     factory->directory = NULL;
+    factory->async = FALSE;
+    factory->buffer_size = DEFAULT_BUFFER_SIZE;
+    factory->drop_on_overflow = FALSE;
 }
 
 static void
@@ -234,20 +242,96 @@ CUT_MODULE_IMPL_INSTANTIATE (const gchar *first_property, va_list var_args)
     return g_object_new_valist(CUT_TYPE_XML_STREAM_FACTORY, first_property, var_args);
 }
 
+static gboolean
+parse_async_arg (const gchar *option_name, const gchar *value,
+                 gpointer data, GError **error)
+{
+    CutXMLStreamFactory *xml = data;
+
+    if (value == NULL ||
+        g_utf8_collate(value, "yes") == 0 ||
+        g_utf8_collate(value, "true") == 0) {
+        xml->async = TRUE;
+    } else if (g_utf8_collate(value, "no") == 0 ||
+               g_utf8_collate(value, "false") == 0) {
+        xml->async = FALSE;
+    } else {
+        g_set_error(error,
+                    G_OPTION_ERROR,
+                    G_OPTION_ERROR_BAD_VALUE,
+                    _("Invalid boolean value: %s"), value);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+static gboolean
+parse_buffer_size_arg (const gchar *option_name, const gchar *value,
+                       gpointer data, GError **error)
+{
+    CutXMLStreamFactory *xml = data;
+    guint64 buffer_size;
+    gchar *end;
+
+    buffer_size = g_ascii_strtoull(value, &end, 10);
+    if (end == value || *end != '\0' ||
+        buffer_size == 0 || buffer_size > G_MAXINT32) {
+        g_set_error(error,
+                    G_OPTION_ERROR,
+                    G_OPTION_ERROR_BAD_VALUE,
+                    _("Invalid buffer size: %s"), value);
+        return FALSE;
+    }
+    xml->buffer_size = buffer_size;
+
+    return TRUE;
+}
+
+static gboolean
+parse_overflow_arg (const gchar *option_name, const gchar *value,
+                    gpointer data, GError **error)
+{
+    CutXMLStreamFactory *xml = data;
+
+    if (g_utf8_collate(value, "block") == 0) {
+        xml->drop_on_overflow = FALSE;
+    } else if (g_utf8_collate(value, "drop") == 0) {
+        xml->drop_on_overflow = TRUE;
+    } else {
+        g_set_error(error,
+                    G_OPTION_ERROR,
+                    G_OPTION_ERROR_BAD_VALUE,
+                    _("Invalid overflow policy: %s"), value);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
 static void
 set_option_group (CutModuleFactory *factory, GOptionContext *context)
 {
     CutXMLStreamFactory *xml = CUT_XML_STREAM_FACTORY(factory);
     GOptionGroup *group;
     GOptionEntry entries[] = {
+        {"xml-stream-async", 0, G_OPTION_FLAG_OPTIONAL_ARG,
+         G_OPTION_ARG_CALLBACK, parse_async_arg,
+         N_("Stream events by a writer thread"), "[yes|true|no|false]"},
+        {"xml-stream-buffer-size", 0, 0,
+         G_OPTION_ARG_CALLBACK, parse_buffer_size_arg,
+         N_("Queue at most BYTES of events in async mode "
+            "(default: 1048576)"), "BYTES"},
+        {"xml-stream-overflow", 0, 0,
+         G_OPTION_ARG_CALLBACK, parse_overflow_arg,
+         N_("Block or drop an event when the buffer is full "
+            "(default: block)"), "[block|drop]"},
         {NULL}
     };
 
     if (CUT_MODULE_FACTORY_CLASS(parent_class)->set_option_group)
         CUT_MODULE_FACTORY_CLASS(parent_class)->set_option_group(factory, context);
 
-    return;
-
     group = g_option_group_new(("xml-stream"),
                                _("XML Stream Options"),
                                _("Show XML stream options"),
@@ -404,6 +488,10 @@ create (CutModuleFactory *factory)
                                    "stream-function-user-data", data,
                                    "stream-function-user-data-destroy-function",
                                    stream_data_free,
+                                   "async", xml_factory->async,
+                                   "buffer-size", xml_factory->buffer_size,
+                                   "drop-on-overflow",
+                                   xml_factory->drop_on_overflow,
                                    NULL));
 }
 
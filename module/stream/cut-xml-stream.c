@@ -28,15 +28,25 @@
 #include <glib/gi18n-lib.h>
 #include <gmodule.h>
 
+#ifndef G_OS_WIN32
+#  include <unistd.h>
+#endif
+
 #include <cutter/cut-module-impl.h>
 #include <cutter/cut-stream.h>
 #include <cutter/cut-listener.h>
 #include <cutter/cut-run-context.h>
 #include <cutter/cut-test-result.h>
+#include <cutter/cut-benchmark-result.h>
 #include <cutter/cut-enum-types.h>
 #include <cutter/cut-utils.h>
 #include <cutter/cut-glib-compatible.h>
 
+#define ASYNC_DEFAULT_BUFFER_SIZE (1024 * 1024)
+#define ASYNC_N_SLOTS 4096
+#define ASYNC_WRITE_CHUNK_SIZE (64 * 1024)
+#define ASYNC_WAIT_USEC (100 * 1000)
+
 #define CUT_TYPE_XML_STREAM            cut_type_xml_stream
 #define CUT_XML_STREAM(obj)            (G_TYPE_CHECK_INSTANCE_CAST ((obj), CUT_TYPE_XML_STREAM, CutXMLStream))
 #define CUT_XML_STREAM_CLASS(klass)    (G_TYPE_CHECK_CLASS_CAST ((klass), CUT_TYPE_XML_STREAM, CutXMLStreamClass))
@@ -46,6 +56,7 @@
 
 typedef struct _CutXMLStream CutXMLStream;
 typedef struct _CutXMLStreamClass CutXMLStreamClass;
+typedef struct _AsyncWriter AsyncWriter;
 
 struct _CutXMLStream
 {
@@ -55,6 +66,11 @@ struct _CutXMLStream
     CutStreamFunction stream_function;
     gpointer stream_function_user_data;
     GDestroyNotify stream_function_user_data_destroy_function;
+    gboolean async;
+    guint buffer_size;
+    gboolean drop_on_overflow;
+    AsyncWriter *writer;
+    guint n_dropped_events;
 };
 
 struct _CutXMLStreamClass
@@ -68,7 +84,11 @@ enum
     PROP_RUN_CONTEXT,
     PROP_STREAM_FUNCTION,
     PROP_STREAM_FUNCTION_USER_DATA,
-    PROP_STREAM_FUNCTION_USER_DATA_DESTROY_FUNCTION
+    PROP_STREAM_FUNCTION_USER_DATA_DESTROY_FUNCTION,
+    PROP_ASYNC,
+    PROP_BUFFER_SIZE,
+    PROP_DROP_ON_OVERFLOW,
+    PROP_N_DROPPED_EVENTS
 };
 
 static GType cut_type_xml_stream = 0;
@@ -130,6 +150,39 @@ class_init (CutXMLStreamClass *klass)
     g_object_class_install_property(gobject_class,
                                     PROP_STREAM_FUNCTION_USER_DATA_DESTROY_FUNCTION,
                                     spec);
+
+    spec = g_param_spec_boolean("async",
+                                "Asynchronous",
+                                "Whether events are streamed by "
+                                "a writer thread",
+                                FALSE,
+                                G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY);
+    g_object_class_install_property(gobject_class, PROP_ASYNC, spec);
+
+    spec = g_param_spec_uint("buffer-size",
+                             "Buffer size",
+                             "The max bytes of queued events in async mode",
+                             1, G_MAXINT32, ASYNC_DEFAULT_BUFFER_SIZE,
+                             G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY);
+    g_object_class_install_property(gobject_class, PROP_BUFFER_SIZE, spec);
+
+    spec = g_param_spec_boolean("drop-on-overflow",
+                                "Drop on overflow",
+                                "Whether an event is dropped instead of "
+                                "waiting for the writer thread when "
+                                "the buffer is full",
+                                FALSE,
+                                G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY);
+    g_object_class_install_property(gobject_class, PROP_DROP_ON_OVERFLOW,
+                                    spec);
+
+    spec = g_param_spec_uint("n-dropped-events",
+                             "Number of dropped events",
+                             "The number of events dropped on overflow",
+                             0, G_MAXUINT32, 0,
+                             G_PARAM_READABLE);
+    g_object_class_install_property(gobject_class, PROP_N_DROPPED_EVENTS,
+                                    spec);
 }
 
 static void
@@ -140,6 +193,11 @@ init (CutXMLStream *stream)
     stream->stream_function = NULL;
     stream->stream_function_user_data = NULL;
     stream->stream_function_user_data_destroy_function = NULL;
+    stream->async = FALSE;
+    stream->buffer_size = ASYNC_DEFAULT_BUFFER_SIZE;
+    stream->drop_on_overflow = FALSE;
+    stream->writer = NULL;
+    stream->n_dropped_events = 0;
 }
 
 static void
@@ -209,11 +267,18 @@ CUT_MODULE_IMPL_INSTANTIATE (const gchar *first_property, va_list var_args)
     return g_object_new_valist(CUT_TYPE_XML_STREAM, first_property, var_args);
 }
 
+static void async_writer_free (AsyncWriter *writer);
+
 static void
 dispose (GObject *object)
 {
     CutXMLStream *stream = CUT_XML_STREAM(object);
 
+    if (stream->writer) {
+        async_writer_free(stream->writer);
+        stream->writer = NULL;
+    }
+
     if (stream->run_context) {
         g_object_unref(stream->run_context);
         stream->run_context = NULL;
@@ -256,6 +321,15 @@ set_property (GObject      *object,
         stream->stream_function_user_data_destroy_function =
             g_value_get_pointer(value);
         break;
+      case PROP_ASYNC:
+        stream->async = g_value_get_boolean(value);
+        break;
+      case PROP_BUFFER_SIZE:
+        stream->buffer_size = g_value_get_uint(value);
+        break;
+      case PROP_DROP_ON_OVERFLOW:
+        stream->drop_on_overflow = g_value_get_boolean(value);
+        break;
       default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
         break;
@@ -283,6 +357,18 @@ get_property (GObject    *object,
       case PROP_STREAM_FUNCTION_USER_DATA_DESTROY_FUNCTION:
         g_value_set_pointer(value, stream->stream_function_user_data_destroy_function);
         break;
+      case PROP_ASYNC:
+        g_value_set_boolean(value, stream->async);
+        break;
+      case PROP_BUFFER_SIZE:
+        g_value_set_uint(value, stream->buffer_size);
+        break;
+      case PROP_DROP_ON_OVERFLOW:
+        g_value_set_boolean(value, stream->drop_on_overflow);
+        break;
+      case PROP_N_DROPPED_EVENTS:
+        g_value_set_uint(value, g_atomic_int_get(&(stream->n_dropped_events)));
+        break;
       default:
         G_OBJECT_WARN_INVALID_PROPERTY_ID(object, prop_id, pspec);
         break;
@@ -290,23 +376,12 @@ get_property (GObject    *object,
 }
 
 static void
-flow (CutXMLStream *stream, const gchar *format, ...)
+write_message (CutXMLStream *stream, const gchar *message)
 {
     GError *error = NULL;
-    gchar *message;
-    va_list va_args;
-
-    if (!stream->stream_function)
-        return;
-
-    va_start(va_args, format);
-    message = g_strdup_vprintf(format, va_args);
-    va_end(va_args);
 
-    g_mutex_lock(stream->mutex);
     stream->stream_function(message, &error,
                             stream->stream_function_user_data);
-    g_mutex_unlock(stream->mutex);
 
     if (error) {
         g_warning("WriteError: %s:%d: %s",
@@ -315,14 +390,333 @@ flow (CutXMLStream *stream, const gchar *format, ...)
                   error->message);
         g_error_free(error);
     }
+}
+
+/*
+ * In async mode, signal handlers put serialized events into a
+ * bounded lock-free ring and a writer thread passes them to the
+ * stream function in large chunks. A handler doesn't take a lock
+ * unless the ring is full or the writer thread is sleeping.
+ *
+ * The ring is a multi-producer single-consumer version of Dmitry
+ * Vyukov's bounded queue. A slot is free for a producer at
+ * position P when its sequence is P. It is filled for the writer
+ * when its sequence is P + 1.
+ */
+typedef struct _AsyncSlot
+{
+    volatile gint sequence;
+    gchar *message;
+    gsize length;
+} AsyncSlot;
+
+struct _AsyncWriter
+{
+    CutXMLStream *stream;
+    AsyncSlot slots[ASYNC_N_SLOTS];
+    volatile gint enqueue_position;
+    guint dequeue_position;
+    /* Bytes of events that aren't written yet. They are
+     * released after they are written. */
+    volatile gint n_queued_bytes;
+    gint max_queued_bytes;
+    volatile gint sleeping;
+    volatile gint n_waiting_producers;
+    volatile gint stopping;
+    GMutex *mutex;
+    GCond *data_cond;
+    GCond *space_cond;
+    GThreadPool *thread_pool;
+#ifndef G_OS_WIN32
+    pid_t pid;
+#endif
+};
 
-    g_free(message);
+static void
+timed_wait (GCond *cond, GMutex *mutex)
+{
+    g_cond_wait_until(cond, mutex, g_get_monotonic_time() + ASYNC_WAIT_USEC);
+}
+
+static gboolean
+async_writer_try_push (AsyncWriter *writer, gchar *message, gsize length)
+{
+    gint n_queued_bytes;
+    guint position;
+    AsyncSlot *slot;
+
+    /* An event that is larger than the buffer is accepted when
+     * nothing is queued. */
+    do {
+        n_queued_bytes = g_atomic_int_get(&(writer->n_queued_bytes));
+        if (n_queued_bytes > 0 &&
+            n_queued_bytes + length > (gsize)writer->max_queued_bytes)
+            return FALSE;
+    } while (!g_atomic_int_compare_and_exchange(&(writer->n_queued_bytes),
+                                                n_queued_bytes,
+                                                n_queued_bytes + length));
+
+    while (TRUE) {
+        gint difference;
+
+        position = g_atomic_int_get(&(writer->enqueue_position));
+        slot = &(writer->slots[position % ASYNC_N_SLOTS]);
+        difference = (gint)((guint)g_atomic_int_get(&(slot->sequence)) -
+                            position);
+        if (difference == 0) {
+            if (g_atomic_int_compare_and_exchange(&(writer->enqueue_position),
+                                                  position, position + 1))
+                break;
+        } else if (difference < 0) {
+            g_atomic_int_add(&(writer->n_queued_bytes), -(gint)length);
+            return FALSE;
+        }
+    }
+
+    slot->message = message;
+    slot->length = length;
+    g_atomic_int_set(&(slot->sequence), position + 1);
+
+    return TRUE;
+}
+
+static gchar *
+async_writer_pop (AsyncWriter *writer, gsize *length)
+{
+    AsyncSlot *slot;
+    gchar *message;
+    guint position;
+
+    position = writer->dequeue_position;
+    slot = &(writer->slots[position % ASYNC_N_SLOTS]);
+    if ((guint)g_atomic_int_get(&(slot->sequence)) != position + 1)
+        return NULL;
+
+    message = slot->message;
+    *length = slot->length;
+    slot->message = NULL;
+    g_atomic_int_set(&(slot->sequence), position + ASYNC_N_SLOTS);
+    writer->dequeue_position = position + 1;
+
+    return message;
+}
+
+static gboolean
+async_writer_is_empty (AsyncWriter *writer)
+{
+    AsyncSlot *slot;
+    guint position;
+
+    position = writer->dequeue_position;
+    slot = &(writer->slots[position % ASYNC_N_SLOTS]);
+    return (guint)g_atomic_int_get(&(slot->sequence)) != position + 1;
+}
+
+static void
+run_async_writer (gpointer data, gpointer user_data)
+{
+    AsyncWriter *writer = data;
+    GString *chunk;
+
+    chunk = g_string_sized_new(ASYNC_WRITE_CHUNK_SIZE);
+    while (TRUE) {
+        gchar *message;
+        gsize length;
+
+        while (chunk->len < ASYNC_WRITE_CHUNK_SIZE &&
+               (message = async_writer_pop(writer, &length))) {
+            g_string_append_len(chunk, message, length);
+            g_free(message);
+        }
+
+        if (chunk->len > 0) {
+            write_message(writer->stream, chunk->str);
+            g_atomic_int_add(&(writer->n_queued_bytes), -(gint)chunk->len);
+            g_string_truncate(chunk, 0);
+            if (g_atomic_int_get(&(writer->n_waiting_producers)) > 0) {
+                g_mutex_lock(writer->mutex);
+                g_cond_broadcast(writer->space_cond);
+                g_mutex_unlock(writer->mutex);
+            }
+            continue;
+        }
+
+        g_mutex_lock(writer->mutex);
+        g_atomic_int_set(&(writer->sleeping), TRUE);
+        if (async_writer_is_empty(writer)) {
+            if (g_atomic_int_get(&(writer->stopping))) {
+                g_atomic_int_set(&(writer->sleeping), FALSE);
+                g_mutex_unlock(writer->mutex);
+                break;
+            }
+            timed_wait(writer->data_cond, writer->mutex);
+        }
+        g_atomic_int_set(&(writer->sleeping), FALSE);
+        g_mutex_unlock(writer->mutex);
+    }
+    g_string_free(chunk, TRUE);
+}
+
+static AsyncWriter *
+async_writer_new (CutXMLStream *stream)
+{
+    AsyncWriter *writer;
+    GError *error = NULL;
+    guint i;
+
+    writer = g_new0(AsyncWriter, 1);
+    writer->stream = stream;
+    for (i = 0; i < ASYNC_N_SLOTS; i++) {
+        writer->slots[i].sequence = i;
+    }
+    writer->max_queued_bytes = stream->buffer_size;
+    writer->mutex = g_mutex_new();
+    writer->data_cond = g_cond_new();
+    writer->space_cond = g_cond_new();
+#ifndef G_OS_WIN32
+    writer->pid = getpid();
+#endif
+
+    writer->thread_pool = g_thread_pool_new(run_async_writer, NULL, 1, TRUE,
+                                            &error);
+    if (writer->thread_pool)
+        g_thread_pool_push(writer->thread_pool, writer, &error);
+    if (error) {
+        g_warning("can't start XML stream writer thread: %s", error->message);
+        g_error_free(error);
+        if (writer->thread_pool)
+            g_thread_pool_free(writer->thread_pool, TRUE, FALSE);
+        g_mutex_free(writer->mutex);
+        g_cond_free(writer->data_cond);
+        g_cond_free(writer->space_cond);
+        g_free(writer);
+        return NULL;
+    }
+
+    return writer;
+}
+
+static void
+async_writer_wake_up (AsyncWriter *writer)
+{
+    g_mutex_lock(writer->mutex);
+    g_cond_signal(writer->data_cond);
+    g_mutex_unlock(writer->mutex);
+}
+
+static void
+async_writer_wait (AsyncWriter *writer, gchar *message, gsize length)
+{
+    g_mutex_lock(writer->mutex);
+    g_atomic_int_inc(&(writer->n_waiting_producers));
+    while (message ?
+           !async_writer_try_push(writer, message, length) :
+           g_atomic_int_get(&(writer->n_queued_bytes)) > 0) {
+        g_cond_signal(writer->data_cond);
+        timed_wait(writer->space_cond, writer->mutex);
+    }
+    g_atomic_int_add(&(writer->n_waiting_producers), -1);
+    g_mutex_unlock(writer->mutex);
+}
+
+/* Takes the ownership of message. */
+static void
+async_writer_push (AsyncWriter *writer, gchar *message, gboolean droppable)
+{
+    gsize length;
+
+    length = strlen(message);
+    if (length == 0) {
+        g_free(message);
+        return;
+    }
+
+    if (!async_writer_try_push(writer, message, length)) {
+        if (droppable && writer->stream->drop_on_overflow) {
+            g_atomic_int_inc(&(writer->stream->n_dropped_events));
+            g_free(message);
+            return;
+        }
+        async_writer_wait(writer, message, length);
+    }
+
+    if (g_atomic_int_get(&(writer->sleeping)))
+        async_writer_wake_up(writer);
+}
+
+/* Waits until all queued events are written. */
+static void
+async_writer_flush (AsyncWriter *writer)
+{
+    async_writer_wait(writer, NULL, 0);
+}
+
+static void
+async_writer_free (AsyncWriter *writer)
+{
+#ifndef G_OS_WIN32
+    /* A forked process doesn't have the writer thread. Joining it
+     * blocks forever and the mutex may be locked by a thread of
+     * the parent process. Queued events are written by the
+     * parent process. So the writer is just abandoned. */
+    if (writer->pid != getpid())
+        return;
+#endif
+
+    g_atomic_int_set(&(writer->stopping), TRUE);
+    async_writer_wake_up(writer);
+    g_thread_pool_free(writer->thread_pool, FALSE, TRUE);
+
+    g_mutex_free(writer->mutex);
+    g_cond_free(writer->data_cond);
+    g_cond_free(writer->space_cond);
+    g_free(writer);
+}
+
+static gboolean
+is_async (CutXMLStream *stream)
+{
+    if (!stream->writer)
+        return FALSE;
+#ifndef G_OS_WIN32
+    /* A forked process doesn't have the writer thread. */
+    if (stream->writer->pid != getpid())
+        return FALSE;
+#endif
+    return TRUE;
+}
+
+/* Takes the ownership of message. A message that isn't
+ * droppable is queued even if the buffer is full. */
+static void
+flow_message (CutXMLStream *stream, gchar *message, gboolean droppable)
+{
+    if (!stream->stream_function) {
+        g_free(message);
+        return;
+    }
+
+    if (is_async(stream)) {
+        async_writer_push(stream->writer, message, droppable);
+    } else {
+        g_mutex_lock(stream->mutex);
+        write_message(stream, message);
+        g_mutex_unlock(stream->mutex);
+        g_free(message);
+    }
+}
+
+/* Takes the ownership of string. */
+static void
+flow_string (CutXMLStream *stream, GString *string)
+{
+    flow_message(stream, g_string_free(string, FALSE), TRUE);
 }
 
 static void
 cb_start_run (CutRunContext *run_context, CutXMLStream *stream)
 {
-    flow(stream, "<stream>\n");
+    flow_message(stream, g_strdup("<stream>\n"), FALSE);
 }
 
 static void
@@ -349,9 +743,7 @@ cb_ready_test_suite (CutRunContext *run_context, CutTestSuite *test_suite,
 
     g_string_append(string, "  </ready-test-suite>\n");
 
-    flow(stream, "%s", string->str);
-
-    g_string_free(string, TRUE);
+    flow_string(stream, string);
 }
 
 static void
@@ -366,9 +758,7 @@ cb_start_test_suite (CutRunContext *run_context, CutTestSuite *test_suite,
     cut_test_to_xml_string(CUT_TEST(test_suite), string, 4);
     g_string_append(string, "  </start-test-suite>\n");
 
-    flow(stream, "%s", string->str);
-
-    g_string_free(string, TRUE);
+    flow_string(stream, string);
 }
 
 static void
@@ -390,9 +780,7 @@ cb_ready_test_case (CutRunContext *run_context, CutTestCase *test_case,
 
     g_string_append(string, "  </ready-test-case>\n");
 
-    flow(stream, "%s", string->str);
-
-    g_string_free(string, TRUE);
+    flow_string(stream, string);
 }
 
 static void
@@ -407,9 +795,7 @@ cb_start_test_case (CutRunContext *run_context, CutTestCase *test_case,
     cut_test_to_xml_string(CUT_TEST(test_case), string, 4);
     g_string_append(string, "  </start-test-case>\n");
 
-    flow(stream, "%s", string->str);
-
-    g_string_free(string, TRUE);
+    flow_string(stream, string);
 }
 
 static void
@@ -432,9 +818,7 @@ cb_ready_test_iterator (CutRunContext *run_context,
 
     g_string_append(string, "  </ready-test-iterator>\n");
 
-    flow(stream, "%s", string->str);
-
-    g_string_free(string, TRUE);
+    flow_string(stream, string);
 }
 
 static void
@@ -450,9 +834,7 @@ cb_start_test_iterator (CutRunContext *run_context,
     cut_test_to_xml_string(CUT_TEST(test_iterator), string, 4);
     g_string_append(string, "  </start-test-iterator>\n");
 
-    flow(stream, "%s", string->str);
-
-    g_string_free(string, TRUE);
+    flow_string(stream, string);
 }
 
 static void
@@ -470,9 +852,7 @@ cb_start_iterated_test (CutRunContext *run_context,
     cut_test_context_to_xml_string(test_context, string, 4);
     g_string_append(string, "  </start-iterated-test>\n");
 
-    flow(stream, "%s", string->str);
-
-    g_string_free(string, TRUE);
+    flow_string(stream, string);
 }
 
 static void
@@ -488,9 +868,7 @@ cb_start_test (CutRunContext *run_context, CutTest *test,
     cut_test_context_to_xml_string(test_context, string, 4);
     g_string_append(string, "  </start-test>\n");
 
-    flow(stream, "%s", string->str);
-
-    g_string_free(string, TRUE);
+    flow_string(stream, string);
 }
 
 static void
@@ -506,9 +884,30 @@ cb_pass_assertion (CutRunContext *run_context, CutTest *test,
     cut_test_context_to_xml_string(test_context, string, 4);
     g_string_append(string, "  </pass-assertion>\n");
 
-    flow(stream, "%s", string->str);
+    flow_string(stream, string);
+}
+
+static void
+cb_pass_assertions (CutRunContext *run_context, CutTest *test,
+                    CutTestContext *test_context, guint n_assertions,
+                    CutXMLStream *stream)
+{
+    GString *string;
+    gchar *str;
+
+    string = g_string_new(NULL);
+
+    g_string_append(string, "  <pass-assertions>\n");
+    cut_test_to_xml_string(test, string, 4);
+    cut_test_context_to_xml_string(test_context, string, 4);
+
+    str = g_strdup_printf("%u", n_assertions);
+    cut_utils_append_xml_element_with_value(string, 4, "n-assertions", str);
+    g_free(str);
+
+    g_string_append(string, "  </pass-assertions>\n");
 
-    g_string_free(string, TRUE);
+    flow_string(stream, string);
 }
 
 static void
@@ -528,9 +927,25 @@ cb_test_result (CutRunContext  *run_context,
     cut_test_result_to_xml_string(result, string, 4);
     g_string_append(string, "  </test-result>\n");
 
-    flow(stream, "%s", string->str);
+    flow_string(stream, string);
+}
 
-    g_string_free(string, TRUE);
+static void
+cb_benchmark_test (CutRunContext *run_context, CutTest *test,
+                   CutTestContext *test_context,
+                   CutBenchmarkResult *result, CutXMLStream *stream)
+{
+    GString *string;
+
+    string = g_string_new(NULL);
+
+    g_string_append(string, "  <benchmark-test>\n");
+    cut_test_to_xml_string(test, string, 4);
+    cut_test_context_to_xml_string(test_context, string, 4);
+    cut_benchmark_result_to_xml_string(result, string, 4);
+    g_string_append(string, "  </benchmark-test>\n");
+
+    flow_string(stream, string);
 }
 
 static void
@@ -550,9 +965,7 @@ cb_complete_test (CutRunContext *run_context, CutTest *test,
                                                     "success", success);
     g_string_append(string, "  </complete-test>\n");
 
-    flow(stream, "%s", string->str);
-
-    g_string_free(string, TRUE);
+    flow_string(stream, string);
 }
 
 static void
@@ -573,9 +986,7 @@ cb_complete_iterated_test (CutRunContext *run_context,
                                                     "success", success);
     g_string_append(string, "  </complete-iterated-test>\n");
 
-    flow(stream, "%s", string->str);
-
-    g_string_free(string, TRUE);
+    flow_string(stream, string);
 }
 
 static void
@@ -593,9 +1004,7 @@ cb_test_iterator_result (CutRunContext  *run_context,
     cut_test_result_to_xml_string(result, string, 4);
     g_string_append(string, "  </test-iterator-result>\n");
 
-    flow(stream, "%s", string->str);
-
-    g_string_free(string, TRUE);
+    flow_string(stream, string);
 }
 
 static void
@@ -614,9 +1023,7 @@ cb_complete_test_iterator (CutRunContext *run_context,
                                                     "success", success);
     g_string_append(string, "  </complete-test-iterator>\n");
 
-    flow(stream, "%s", string->str);
-
-    g_string_free(string, TRUE);
+    flow_string(stream, string);
 }
 
 static void
@@ -634,9 +1041,7 @@ cb_test_case_result (CutRunContext  *run_context,
     cut_test_result_to_xml_string(result, string, 4);
     g_string_append(string, "  </test-case-result>\n");
 
-    flow(stream, "%s", string->str);
-
-    g_string_free(string, TRUE);
+    flow_string(stream, string);
 }
 
 static void
@@ -653,9 +1058,7 @@ cb_complete_test_case (CutRunContext *run_context, CutTestCase *test_case,
                                                     "success", success);
     g_string_append(string, "  </complete-test-case>\n");
 
-    flow(stream, "%s", string->str);
-
-    g_string_free(string, TRUE);
+    flow_string(stream, string);
 }
 
 static void
@@ -672,9 +1075,7 @@ cb_complete_test_suite (CutRunContext *run_context, CutTestSuite *test_suite,
                                                     "success", success);
     g_string_append(string, "  </complete-test-suite>\n");
 
-    flow(stream, "%s", string->str);
-
-    g_string_free(string, TRUE);
+    flow_string(stream, string);
 }
 
 static void
@@ -688,9 +1089,17 @@ cb_complete_run (CutRunContext *run_context, gboolean success,
                                                     "success", success);
     g_string_append(string, "</stream>\n");
 
-    flow(stream, "%s", string->str);
+    flow_message(stream, g_string_free(string, FALSE), FALSE);
+
+    if (is_async(stream)) {
+        guint n_dropped_events;
 
-    g_string_free(string, TRUE);
+        async_writer_flush(stream->writer);
+        n_dropped_events = g_atomic_int_get(&(stream->n_dropped_events));
+        if (n_dropped_events > 0)
+            g_warning("XML stream dropped %u events on overflow",
+                      n_dropped_events);
+    }
 }
 
 static void
@@ -722,6 +1131,7 @@ connect_to_run_context (CutXMLStream *stream, CutRunContext *run_context)
     CONNECT(start_test);
 
     CONNECT(pass_assertion);
+    CONNECT(pass_assertions);
 
     CONNECT_TO_TEST(success);
     CONNECT_TO_TEST(failure);
@@ -747,6 +1157,8 @@ connect_to_run_context (CutXMLStream *stream, CutRunContext *run_context)
     CONNECT_TO_TEST_CASE(omission);
     CONNECT_TO_TEST_CASE(crash);
 
+    CONNECT(benchmark_test);
+
     CONNECT(complete_test);
     CONNECT(complete_iterated_test);
     CONNECT(complete_test_iterator);
@@ -776,6 +1188,7 @@ disconnect_from_run_context (CutXMLStream *stream,
     DISCONNECT(start_test);
 
     DISCONNECT(pass_assertion);
+    DISCONNECT(pass_assertions);
 
     g_signal_handlers_disconnect_by_func(run_context,
                                          G_CALLBACK(cb_test_result),
@@ -789,6 +1202,8 @@ disconnect_from_run_context (CutXMLStream *stream,
                                          G_CALLBACK(cb_test_case_result),
                                          stream);
 
+    DISCONNECT(benchmark_test);
+
     DISCONNECT(complete_test);
     DISCONNECT(complete_iterated_test);
     DISCONNECT(complete_test_iterator);
@@ -809,6 +1224,8 @@ attach_to_run_context (CutListener *listener,
     
     if (run_context) {
         stream->run_context = g_object_ref(run_context);
+        if (stream->async && !stream->writer)
+            stream->writer = async_writer_new(stream);
         connect_to_run_context(CUT_XML_STREAM(listener), run_context);
     }
 }
@@ -822,6 +1239,10 @@ detach_from_run_context (CutListener *listener,
         return;
 
     disconnect_from_run_context(stream, run_context);
+    if (stream->writer) {
+        async_writer_free(stream->writer);
+        stream->writer = NULL;
+    }
     g_object_unref(stream->run_context);
     stream->run_context = NULL;
 }
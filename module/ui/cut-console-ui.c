@@ -32,6 +32,7 @@
 #include <cutter/cut-ui.h>
 #include <cutter/cut-test-runner.h>
 #include <cutter/cut-test-result.h>
+#include <cutter/cut-benchmark-result.h>
 #include <cutter/cut-test.h>
 #include <cutter/cut-test-suite.h>
 #include <cutter/cut-test-context.h>
@@ -65,6 +66,7 @@ struct _CutConsoleUI
     CutVerboseLevel verbose_level;
     gchar        *notify_command;
     GList        *errors;
+    GList        *benchmarks;
     gint          progress_row;
     gint          progress_row_max;
     gboolean      show_detail_immediately;
@@ -168,6 +170,7 @@ init (CutConsoleUI *console)
     console->verbose_level = CUT_VERBOSE_LEVEL_NORMAL;
     console->notify_command = NULL;
     console->errors = NULL;
+    console->benchmarks = NULL;
     console->progress_row = 0;
     console->progress_row_max = -1;
     console->show_detail_immediately = TRUE;
@@ -270,6 +273,12 @@ dispose (GObject *object)
         console->errors = NULL;
     }
 
+    if (console->benchmarks) {
+        g_list_foreach(console->benchmarks, (GFunc)g_free, NULL);
+        g_list_free(console->benchmarks);
+        console->benchmarks = NULL;
+    }
+
     if (console->notify_command) {
         g_free(console->notify_command);
         console->notify_command = NULL;
@@ -736,6 +745,24 @@ cb_crash_test_suite (CutRunContext  *run_context,
     handle_crash(run_context, result, console);
 }
 
+static void
+cb_benchmark_test (CutRunContext      *run_context,
+                   CutTest            *test,
+                   CutTestContext     *test_context,
+                   CutBenchmarkResult *result,
+                   CutConsoleUI       *console)
+{
+    gchar *formatted_result;
+
+    formatted_result = cut_benchmark_result_format(result);
+    console->benchmarks =
+        g_list_append(console->benchmarks,
+                      g_strdup_printf("%s: %s",
+                                      cut_test_get_name(test),
+                                      formatted_result));
+    g_free(formatted_result);
+}
+
 static void
 cb_complete_test (CutRunContext *run_context, CutTest *test,
                   CutTestContext *test_context, gboolean success,
@@ -992,6 +1019,22 @@ print_results (CutConsoleUI *console, CutRunContext *run_context)
     }
 }
 
+static void
+print_benchmarks (CutConsoleUI *console)
+{
+    const GList *node;
+
+    if (!console->benchmarks)
+        return;
+
+    g_print("\nBenchmarks:\n");
+    for (node = console->benchmarks; node; node = g_list_next(node)) {
+        const gchar *benchmark = node->data;
+
+        g_print("  %s\n", benchmark);
+    }
+}
+
 static gdouble
 compute_pass_percentage (CutRunContext *run_context)
 {
@@ -1288,6 +1331,7 @@ cb_complete_run (CutRunContext *run_context, gboolean success,
         g_print("\n");
 
     print_results(console, run_context);
+    print_benchmarks(console);
 
     g_print("\n");
     g_print("Finished in %f seconds (total: %f seconds)",
@@ -1335,6 +1379,8 @@ connect_to_run_context (CutConsoleUI *console, CutRunContext *run_context)
 
     CONNECT(crash_test_suite);
 
+    CONNECT(benchmark_test);
+
     CONNECT(complete_test);
     CONNECT(complete_iterated_test);
     CONNECT(complete_test_iterator);
@@ -1371,6 +1417,8 @@ disconnect_from_run_context (CutConsoleUI *console, CutRunContext *run_context)
 
     DISCONNECT(crash_test_suite);
 
+    DISCONNECT(benchmark_test);
+
     DISCONNECT(complete_iterated_test);
     DISCONNECT(complete_test);
     DISCONNECT(complete_test_iterator);
@@ -1387,6 +1435,8 @@ static void
 attach_to_run_context (CutListener *listener,
                        CutRunContext   *run_context)
 {
+    /* Details of non-success results are shown on completion. */
+    cut_run_context_hold_non_success_results(run_context);
     connect_to_run_context(CUT_CONSOLE_UI(listener), run_context);
 }
 
@@ -1395,6 +1445,7 @@ detach_from_run_context (CutListener *listener,
                          CutRunContext   *run_context)
 {
     disconnect_from_run_context(CUT_CONSOLE_UI(listener), run_context);
+    cut_run_context_release_non_success_results(run_context);
 }
 
 static gboolean
@@ -1272,6 +1272,16 @@ cb_pass_assertion (CutRunContext *run_context,
     }
 }
 
+static void
+cb_pass_assertions (CutRunContext *run_context,
+                    CutTest *test, CutTestContext *test_context,
+                    guint n_assertions, gpointer data)
+{
+    RowInfo *row_info = data;
+
+    update_summary(row_info->ui);
+}
+
 static void
 cb_success_test (CutRunContext *run_context,
                  CutTest *test, CutTestContext *context, CutTestResult *result,
@@ -1404,6 +1414,7 @@ cb_complete_test (CutRunContext *run_context,
                                          G_CALLBACK(cb_ ## name),       \
                                          user_data)
     DISCONNECT(pass_assertion, row_info);
+    DISCONNECT(pass_assertions, row_info);
     DISCONNECT(success_test, row_info);
     DISCONNECT(failure_test, row_info);
     DISCONNECT(error_test, row_info);
@@ -1451,6 +1462,7 @@ cb_start_test (CutRunContext *run_context,
     g_signal_connect(run_context, #name, G_CALLBACK(cb_ ## name), user_data)
 
     CONNECT(pass_assertion, row_info);
+    CONNECT(pass_assertions, row_info);
     CONNECT(success_test, row_info);
     CONNECT(failure_test, row_info);
     CONNECT(error_test, row_info);
@@ -1499,6 +1511,7 @@ cb_complete_iterated_test (CutRunContext *run_context,
                                          G_CALLBACK(cb_ ## name),       \
                                          user_data)
     DISCONNECT(pass_assertion, row_info);
+    DISCONNECT(pass_assertions, row_info);
     DISCONNECT(success_test, row_info);
     DISCONNECT(failure_test, row_info);
     DISCONNECT(error_test, row_info);
@@ -1553,6 +1566,7 @@ cb_start_iterated_test (CutRunContext *run_context,
     g_signal_connect(run_context, #name, G_CALLBACK(cb_ ## name), user_data)
 
     CONNECT(pass_assertion, row_info);
+    CONNECT(pass_assertions, row_info);
     CONNECT(success_test, row_info);
     CONNECT(failure_test, row_info);
     CONNECT(error_test, row_info);
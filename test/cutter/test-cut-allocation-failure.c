@@ -0,0 +1,170 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdlib.h>
+
+#include <gcutter.h>
+#include <cutter/cut-allocation-failure.h>
+#include <cutter/cut-run-context.h>
+#include <cutter/cut-test-runner.h>
+
+void test_handled (void);
+void test_crash (void);
+void test_leak (void);
+void test_disabled (void);
+
+static CutRunContext *run_context;
+static CutTestCase *test_case;
+static CutTestResult *result;
+/* volatile keeps a compiler from removing allocations. */
+static gchar * volatile memory1;
+static gchar * volatile memory2;
+
+void
+cut_setup (void)
+{
+    run_context = NULL;
+    test_case = NULL;
+    result = NULL;
+
+    if (!cut_allocation_failure_is_available())
+        cut_omit("malloc() isn't interposed");
+
+    run_context = CUT_RUN_CONTEXT(cut_test_runner_new());
+    cut_run_context_set_allocation_failures(run_context, 10);
+    cut_run_context_set_n_processes(run_context, 2);
+}
+
+void
+cut_teardown (void)
+{
+    if (result)
+        g_object_unref(result);
+    if (test_case)
+        g_object_unref(test_case);
+    if (run_context)
+        g_object_unref(run_context);
+}
+
+static void
+stub_handled_test (void)
+{
+    memory1 = malloc(16);
+    if (!memory1)
+        return;
+    memory2 = malloc(16);
+    if (!memory2) {
+        free(memory1);
+        return;
+    }
+    free(memory2);
+    free(memory1);
+}
+
+static void
+stub_crash_test (void)
+{
+    memory1 = malloc(16);
+    memory1[0] = 'X';
+    free(memory1);
+}
+
+static void
+stub_leak_test (void)
+{
+    memory1 = malloc(16);
+    if (!memory1)
+        return;
+    memory2 = malloc(16);
+    if (!memory2)
+        return;
+    free(memory2);
+    free(memory1);
+}
+
+static void
+cb_failure_test (CutRunContext *context, CutTest *test,
+                 CutTestContext *test_context, CutTestResult *test_result,
+                 gpointer data)
+{
+    if (result)
+        g_object_unref(result);
+    result = g_object_ref(test_result);
+}
+
+static gboolean
+run (CutTestFunction function)
+{
+    CutTest *test;
+    gboolean success;
+
+    test_case = cut_test_case_new("allocation_failure_test_case",
+                                  NULL, NULL, NULL, NULL);
+    test = cut_test_new("test_stub", function);
+    cut_test_case_add_test(test_case, test);
+    g_object_unref(test);
+
+    g_signal_connect(run_context, "failure-test",
+                     G_CALLBACK(cb_failure_test), NULL);
+    success = cut_test_runner_run_test_case(CUT_TEST_RUNNER(run_context),
+                                            test_case);
+    g_signal_handlers_disconnect_by_func(run_context,
+                                         G_CALLBACK(cb_failure_test),
+                                         NULL);
+    return success;
+}
+
+void
+test_handled (void)
+{
+    cut_assert_true(run(stub_handled_test));
+    cut_assert_null(result);
+}
+
+void
+test_crash (void)
+{
+    cut_assert_false(run(stub_crash_test));
+    cut_assert_not_null(result);
+    cut_assert_match("\\A1 of 1 allocation failures aren't handled:\n"
+                     "  allocation #1: crashed by signal ",
+                     cut_test_result_get_system_message(result));
+}
+
+void
+test_leak (void)
+{
+    cut_assert_false(run(stub_leak_test));
+    cut_assert_not_null(result);
+    cut_assert_match("\\A1 of 2 allocation failures aren't handled:\n"
+                     "  allocation #2: leaked \\d+ bytes\\z",
+                     cut_test_result_get_system_message(result));
+}
+
+void
+test_disabled (void)
+{
+    cut_run_context_set_allocation_failures(run_context, 0);
+    cut_assert_true(run(stub_crash_test));
+    cut_assert_null(result);
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
@@ -0,0 +1,219 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <glib/gstdio.h>
+
+#include <gcutter.h>
+#include <cutter/cut-analyzer.h>
+#include <cutter/cut-log-index.h>
+#include "../lib/cuttest-utils.h"
+
+void test_analyze (void);
+void test_cached_summary (void);
+void test_removed_log (void);
+void test_broken_log (void);
+
+#define OLD_LOG_NAME "2026-01-01-00-00-00.xml"
+#define NEW_LOG_NAME "2026-01-02-00-00-00.xml"
+
+static gchar *tmp_dir;
+static CutAnalyzer *analyzer;
+static CutLogIndex *log_index;
+
+void
+cut_setup (void)
+{
+    tmp_dir = g_build_filename(cuttest_get_base_dir(), "tmp", NULL);
+    cut_remove_path(tmp_dir, NULL);
+    g_mkdir_with_parents(tmp_dir, 0755);
+    analyzer = cut_analyzer_new();
+    log_index = NULL;
+
+    cut_set_fixture_data_dir(cuttest_get_base_dir(),
+                             "fixtures",
+                             "file-stream-reader",
+                             NULL);
+}
+
+void
+cut_teardown (void)
+{
+    g_object_unref(analyzer);
+    if (log_index)
+        cut_log_index_free(log_index);
+
+    cut_remove_path(tmp_dir, NULL);
+    g_free(tmp_dir);
+}
+
+static void
+copy_log (const gchar *fixture_name, const gchar *log_name)
+{
+    const gchar *contents;
+    gsize length;
+    GError *error = NULL;
+
+    contents = cut_get_fixture_data(&length, fixture_name, NULL);
+    g_file_set_contents(cut_take_string(g_build_filename(tmp_dir,
+                                                         log_name,
+                                                         NULL)),
+                        contents, length, &error);
+    gcut_assert_error(error);
+}
+
+static void
+setup_logs (void)
+{
+    copy_log("all-success.xml", OLD_LOG_NAME);
+    copy_log("error-test.xml", NEW_LOG_NAME);
+}
+
+static void
+load_index (void)
+{
+    GError *error = NULL;
+
+    if (log_index)
+        cut_log_index_free(log_index);
+    log_index = cut_log_index_new(
+        cut_take_string(cut_log_index_build_filename(tmp_dir)));
+    cut_log_index_load(log_index, &error);
+    gcut_assert_error(error);
+}
+
+static guint
+get_n_summaries (void)
+{
+    return g_list_length((GList *)cut_analyzer_get_summaries(analyzer));
+}
+
+static CutLogSummary *
+get_summary (guint i)
+{
+    return g_list_nth_data((GList *)cut_analyzer_get_summaries(analyzer), i);
+}
+
+void
+test_analyze (void)
+{
+    const gchar *expected_names[] = {OLD_LOG_NAME, NEW_LOG_NAME, NULL};
+    CutLogSummary *summary;
+    GError *error = NULL;
+
+    setup_logs();
+    cut_assert_true(cut_analyzer_analyze(analyzer, tmp_dir, &error));
+    gcut_assert_error(error);
+
+    cut_assert_equal_uint(2, get_n_summaries());
+    summary = get_summary(0);
+    cut_assert_equal_string(NEW_LOG_NAME, summary->log_name);
+    cut_assert_false(summary->success);
+    cut_assert_equal_uint(6, summary->n_tests);
+    cut_assert_equal_uint(16, summary->n_assertions);
+    cut_assert_equal_uint(4, summary->n_successes);
+    cut_assert_equal_uint(1, summary->n_failures);
+    cut_assert_equal_uint(1, summary->n_errors);
+
+    summary = get_summary(1);
+    cut_assert_equal_string(OLD_LOG_NAME, summary->log_name);
+    cut_assert_true(summary->success);
+    cut_assert_equal_uint(19, summary->n_tests);
+    cut_assert_equal_uint(49, summary->n_assertions);
+    cut_assert_equal_uint(19, summary->n_successes);
+
+    load_index();
+    cut_assert_equal_string_array_with_free(
+        (gchar **)expected_names,
+        cut_log_index_get_log_names(log_index));
+}
+
+void
+test_cached_summary (void)
+{
+    CutLogSummary *summary;
+    GStatBuf stat_buffer;
+    gchar *log_path;
+    GError *error = NULL;
+
+    setup_logs();
+    cut_assert_true(cut_analyzer_analyze(analyzer, tmp_dir, NULL));
+
+    log_path = cut_take_string(g_build_filename(tmp_dir, OLD_LOG_NAME, NULL));
+    cut_assert_equal_int(0, g_stat(log_path, &stat_buffer));
+    load_index();
+    summary = cut_log_index_lookup(log_index, OLD_LOG_NAME,
+                                   stat_buffer.st_size, stat_buffer.st_mtime);
+    cut_assert_not_null(summary);
+    summary->n_tests = 29;
+    cut_log_index_record(log_index, summary,
+                         stat_buffer.st_size, stat_buffer.st_mtime);
+    cut_log_summary_free(summary);
+    cut_log_index_save(log_index, &error);
+    gcut_assert_error(error);
+
+    cut_assert_true(cut_analyzer_analyze(analyzer, tmp_dir, &error));
+    gcut_assert_error(error);
+    cut_assert_equal_uint(29, get_summary(1)->n_tests);
+}
+
+void
+test_removed_log (void)
+{
+    const gchar *expected_names[] = {NEW_LOG_NAME, NULL};
+
+    setup_logs();
+    cut_assert_true(cut_analyzer_analyze(analyzer, tmp_dir, NULL));
+
+    g_unlink(cut_take_string(g_build_filename(tmp_dir, OLD_LOG_NAME, NULL)));
+    cut_assert_true(cut_analyzer_analyze(analyzer, tmp_dir, NULL));
+    cut_assert_equal_uint(1, get_n_summaries());
+
+    load_index();
+    cut_assert_equal_string_array_with_free(
+        (gchar **)expected_names,
+        cut_log_index_get_log_names(log_index));
+}
+
+void
+test_broken_log (void)
+{
+    const gchar *expected_names[] = {OLD_LOG_NAME, NULL};
+    GError *error = NULL;
+
+    copy_log("all-success.xml", OLD_LOG_NAME);
+    g_file_set_contents(cut_take_string(g_build_filename(tmp_dir,
+                                                         NEW_LOG_NAME,
+                                                         NULL)),
+                        "<stream><broken>", -1, &error);
+    gcut_assert_error(error);
+
+    cut_assert_false(cut_analyzer_analyze(analyzer, tmp_dir, &error));
+    cut_assert_not_null(error);
+    g_error_free(error);
+
+    load_index();
+    cut_assert_equal_string_array_with_free(
+        (gchar **)expected_names,
+        cut_log_index_get_log_names(log_index));
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
@@ -0,0 +1,123 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdarg.h>
+
+#include <gcutter.h>
+#include <cutter/cut-arena.h>
+
+void test_alloc (void);
+void test_large_alloc (void);
+void test_strdup (void);
+void test_strndup (void);
+void test_memdup (void);
+void test_printf (void);
+
+static CutArena *arena;
+
+void
+cut_setup (void)
+{
+    arena = cut_arena_new();
+}
+
+void
+cut_teardown (void)
+{
+    if (arena)
+        cut_arena_free(arena);
+}
+
+void
+test_alloc (void)
+{
+    gchar *memory1, *memory2;
+
+    memory1 = cut_arena_alloc(arena, 1);
+    memory2 = cut_arena_alloc(arena, 1);
+    cut_assert_equal_uint(0, GPOINTER_TO_UINT(memory1) % sizeof(gpointer));
+    cut_assert_equal_uint(0, GPOINTER_TO_UINT(memory2) % sizeof(gpointer));
+    cut_assert_true(memory1 != memory2);
+}
+
+void
+test_large_alloc (void)
+{
+    gchar *small, *large, *next;
+
+    small = cut_arena_alloc(arena, 16);
+    large = cut_arena_alloc(arena, 10000);
+    memset(large, 'x', 10000);
+    next = cut_arena_alloc(arena, 16);
+    cut_assert_equal_uint(16, next - small);
+}
+
+void
+test_strdup (void)
+{
+    cut_assert_equal_string("string", cut_arena_strdup(arena, "string"));
+    cut_assert_equal_string(NULL, cut_arena_strdup(arena, NULL));
+}
+
+void
+test_strndup (void)
+{
+    cut_assert_equal_string("str", cut_arena_strndup(arena, "string", 3));
+    cut_assert_equal_string("string", cut_arena_strndup(arena, "string", 10));
+}
+
+void
+test_memdup (void)
+{
+    const gchar memory[] = {'a', '\0', 'b'};
+
+    cut_assert_equal_memory(memory, sizeof(memory),
+                            cut_arena_memdup(arena, memory, sizeof(memory)),
+                            sizeof(memory));
+    cut_assert_null(cut_arena_memdup(arena, memory, 0));
+}
+
+static gchar *
+arena_printf (const gchar *format, ...)
+{
+    gchar *formatted_string;
+    va_list args;
+
+    va_start(args, format);
+    formatted_string = cut_arena_vprintf(arena, format, args);
+    va_end(args);
+
+    return formatted_string;
+}
+
+void
+test_printf (void)
+{
+    const gchar *long_string;
+
+    cut_assert_equal_string("1 + 2 = 3", arena_printf("%d + %d = %d", 1, 2, 3));
+
+    long_string = cut_take_string(g_strnfill(1000, 'x'));
+    cut_assert_equal_string(cut_take_printf("<%s>", long_string),
+                            arena_printf("<%s>", long_string));
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
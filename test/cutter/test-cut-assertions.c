@@ -144,6 +144,7 @@ void test_error_errno (void);
 void test_equal_sockaddr (void);
 void test_equal_file_raw (void);
 void test_not_equal_file_raw (void);
+void test_equal_file_raw_not_regular (void);
 
 static gboolean compare_function_is_called;
 static gchar *tmp_file_name;
@@ -2576,18 +2577,18 @@ test_equal_file_raw (void)
                            "equal-file-raw", NULL,
                            "<content(data) == content(sub_data)>",
                            cut_take_printf("path: <%s>\n"
-                                           "0x74 0x6f 0x70 0x20 "
-                                           "0x6c 0x65 0x76 0x65 0x6c 0x20 "
-                                           "0x64 0x61 0x74 0x61 0x0a: "
-                                           "top level data. "
-                                           "(size: 15)",
+                                           "size: <15>\n"
+                                           "first difference at: <0>\n"
+                                           ">00000000  74 6f 70 20 6c 65 76 65  "
+                                           "6c 20 64 61 74 61 0a     "
+                                           "|top level data.|",
                                            data),
                            cut_take_printf("path: <%s>\n"
-                                           "0x73 0x75 0x62 0x20 "
-                                           "0x6c 0x65 0x76 0x65 0x6c 0x20 "
-                                           "0x64 0x61 0x74 0x61 0x0a: "
-                                           "sub level data. "
-                                           "(size: 15)",
+                                           "size: <15>\n"
+                                           "first difference at: <0>\n"
+                                           ">00000000  73 75 62 20 6c 65 76 65  "
+                                           "6c 20 64 61 74 61 0a     "
+                                           "|sub level data.|",
                                            sub_data),
                            FAIL_LOCATION,
                            FUNCTION("equal_file_raw"),
@@ -2623,24 +2624,50 @@ test_not_equal_file_raw (void)
                            "not-equal-file-raw", NULL,
                            "<content(data) != content(data)>",
                            cut_take_printf("path: <%s>\n"
-                                           "0x74 0x6f 0x70 0x20 "
-                                           "0x6c 0x65 0x76 0x65 0x6c 0x20 "
-                                           "0x64 0x61 0x74 0x61 0x0a: "
-                                           "top level data. "
-                                           "(size: 15)",
+                                           "size: <15>\n"
+                                           ">00000000  74 6f 70 20 6c 65 76 65  "
+                                           "6c 20 64 61 74 61 0a     "
+                                           "|top level data.|",
                                            data),
                            cut_take_printf("path: <%s>\n"
-                                           "0x74 0x6f 0x70 0x20 "
-                                           "0x6c 0x65 0x76 0x65 0x6c 0x20 "
-                                           "0x64 0x61 0x74 0x61 0x0a: "
-                                           "top level data. "
-                                           "(size: 15)",
+                                           "size: <15>\n"
+                                           ">00000000  74 6f 70 20 6c 65 76 65  "
+                                           "6c 20 64 61 74 61 0a     "
+                                           "|top level data.|",
                                            data),
                            FAIL_LOCATION,
                            FUNCTION("not_equal_file_raw"),
                            NULL);
 }
 
+void
+test_equal_file_raw_not_regular (void)
+{
+    const gchar *proc_file = "/proc/self/cmdline";
+    gchar *contents;
+    gsize length;
+    gint fd;
+    GError *error = NULL;
+
+    if (!g_file_test(proc_file, G_FILE_TEST_EXISTS))
+        cut_omit("/proc isn't available.");
+
+    /* A file in /proc has no size. It can't be mapped. */
+    g_file_get_contents(proc_file, &contents, &length, &error);
+    gcut_assert_error(error);
+    cut_take_memory(contents);
+    cut_assert_operator_uint(length, >, 0);
+
+    fd = g_file_open_tmp(NULL, &tmp_file_name, &error);
+    gcut_assert_error(error);
+    close(fd);
+    g_file_set_contents(tmp_file_name, contents, length, &error);
+    gcut_assert_error(error);
+
+    cut_assert_equal_file_raw(tmp_file_name, proc_file);
+    cut_assert_not_equal_file_raw(tmp_file_name, "/dev/null");
+}
+
 /*
 vi:ts=4:nowrap:ai:expandtab:sw=4
 */
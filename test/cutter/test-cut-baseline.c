@@ -0,0 +1,302 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <gcutter.h>
+#include <cutter/cut-baseline.h>
+#include <cutter/cut-benchmark-result.h>
+#include <cutter/cut-run-context.h>
+#include <cutter/cut-test-runner.h>
+#include "../lib/cuttest-utils.h"
+
+void test_unknown (void);
+void test_record (void);
+void test_save_and_load (void);
+void test_load_nonexistent (void);
+void test_is_regressed_test (void);
+void test_is_regressed_benchmark (void);
+void test_save_run (void);
+void test_compare_run (void);
+void test_compare_run_fail_on_regression (void);
+
+static gchar *tmp_dir;
+static gchar *filename;
+static CutBaseline *baseline;
+static CutBenchmarkResult *baseline_result;
+static CutBenchmarkResult *result;
+static CutRunContext *run_context;
+static CutTestCase *test_case;
+static guint n_notifications;
+static guint n_failures;
+
+void
+cut_setup (void)
+{
+    tmp_dir = g_build_filename(cuttest_get_base_dir(), "tmp", NULL);
+    cut_remove_path(tmp_dir, NULL);
+    filename = g_build_filename(tmp_dir, "baseline", "run.baseline", NULL);
+    baseline = NULL;
+    baseline_result = NULL;
+    result = NULL;
+    run_context = NULL;
+    test_case = NULL;
+    n_notifications = 0;
+    n_failures = 0;
+}
+
+void
+cut_teardown (void)
+{
+    if (baseline)
+        cut_baseline_free(baseline);
+    if (baseline_result)
+        g_object_unref(baseline_result);
+    if (result)
+        g_object_unref(result);
+    if (run_context)
+        g_object_unref(run_context);
+    if (test_case)
+        g_object_unref(test_case);
+
+    cut_remove_path(tmp_dir, NULL);
+    g_free(filename);
+    g_free(tmp_dir);
+}
+
+static CutBenchmarkResult *
+benchmark_result_new (gdouble mean, gdouble standard_deviation)
+{
+    CutBenchmarkResult *benchmark_result;
+
+    benchmark_result = cut_benchmark_result_new_empty();
+    cut_benchmark_result_set_n_samples(benchmark_result, 10);
+    cut_benchmark_result_set_mean(benchmark_result, mean);
+    cut_benchmark_result_set_standard_deviation(benchmark_result,
+                                                standard_deviation);
+
+    return benchmark_result;
+}
+
+void
+test_unknown (void)
+{
+    baseline = cut_baseline_new("run.baseline");
+    cut_assert_true(cut_baseline_get_test_elapsed(baseline,
+                                                  "test_case",
+                                                  "test_1") < 0.0);
+    cut_assert_null(cut_baseline_get_benchmark(baseline,
+                                               "test_case", "bench_1"));
+    cut_assert_false(cut_baseline_has_benchmark(baseline,
+                                                "test_case", "bench_1"));
+}
+
+void
+test_record (void)
+{
+    baseline = cut_baseline_new("run.baseline");
+
+    cut_baseline_record_test(baseline, "test_case", "test_1", 2.0);
+    cut_baseline_record_test(baseline, "test_case", "test_1", 4.0);
+    cut_assert_equal_double(4.0, 0.001,
+                            cut_baseline_get_test_elapsed(baseline,
+                                                          "test_case",
+                                                          "test_1"));
+}
+
+void
+test_save_and_load (void)
+{
+    GError *error = NULL;
+
+    baseline = cut_baseline_new(filename);
+    cut_baseline_record_test(baseline, "test_case", "test_1", 0.25);
+    result = benchmark_result_new(0.5, 0.125);
+    cut_baseline_record_benchmark(baseline, "test_case", "bench_1", result);
+    cut_baseline_save(baseline, &error);
+    gcut_assert_error(error);
+    cut_baseline_free(baseline);
+
+    baseline = cut_baseline_new(filename);
+    cut_baseline_load(baseline, &error);
+    gcut_assert_error(error);
+    cut_assert_equal_double(0.25, 0.001,
+                            cut_baseline_get_test_elapsed(baseline,
+                                                          "test_case",
+                                                          "test_1"));
+    cut_assert_true(cut_baseline_has_benchmark(baseline,
+                                               "test_case", "bench_1"));
+    baseline_result = cut_baseline_get_benchmark(baseline,
+                                                 "test_case", "bench_1");
+    cut_assert_not_null(baseline_result);
+    cut_assert_equal_uint(10,
+                          cut_benchmark_result_get_n_samples(baseline_result));
+    cut_assert_equal_double(0.5, 0.001,
+                            cut_benchmark_result_get_mean(baseline_result));
+    cut_assert_equal_double(
+        0.125, 0.001,
+        cut_benchmark_result_get_standard_deviation(baseline_result));
+}
+
+void
+test_load_nonexistent (void)
+{
+    GError *error = NULL;
+
+    baseline = cut_baseline_new(filename);
+    cut_assert_false(cut_baseline_load(baseline, &error));
+    cut_assert_not_null(error);
+    g_error_free(error);
+}
+
+void
+test_is_regressed_test (void)
+{
+    cut_assert_false(cut_baseline_is_regressed_test(-1.0, 10.0, 20.0));
+    cut_assert_false(cut_baseline_is_regressed_test(1.0, 1.1, 20.0));
+    cut_assert_true(cut_baseline_is_regressed_test(1.0, 1.3, 20.0));
+    cut_assert_false(cut_baseline_is_regressed_test(1.0, 1.3, 50.0));
+    /* Too short to be trusted. */
+    cut_assert_false(cut_baseline_is_regressed_test(0.001, 0.005, 20.0));
+}
+
+void
+test_is_regressed_benchmark (void)
+{
+    baseline_result = benchmark_result_new(1.0, 0.0);
+
+    result = benchmark_result_new(1.1, 0.0);
+    cut_assert_false(cut_baseline_is_regressed_benchmark(baseline_result,
+                                                         result, 20.0));
+    g_object_unref(result);
+
+    result = benchmark_result_new(1.5, 0.0);
+    cut_assert_true(cut_baseline_is_regressed_benchmark(baseline_result,
+                                                        result, 20.0));
+    g_object_unref(result);
+
+    /* Over the threshold but not significant. */
+    result = benchmark_result_new(1.5, 2.0);
+    cut_assert_false(cut_baseline_is_regressed_benchmark(baseline_result,
+                                                         result, 20.0));
+    g_object_unref(result);
+
+    result = benchmark_result_new(1.5, 0.1);
+    cut_assert_true(cut_baseline_is_regressed_benchmark(baseline_result,
+                                                        result, 20.0));
+}
+
+static void
+stub_slow_test (void)
+{
+    g_usleep(CUT_BASELINE_MIN_REGRESSION_ELAPSED * 2 * G_USEC_PER_SEC);
+}
+
+static void
+cb_notification_test (CutRunContext *context, CutTest *test,
+                      CutTestContext *test_context, CutTestResult *test_result,
+                      gpointer data)
+{
+    n_notifications++;
+}
+
+static void
+cb_failure_test (CutRunContext *context, CutTest *test,
+                 CutTestContext *test_context, CutTestResult *test_result,
+                 gpointer data)
+{
+    n_failures++;
+}
+
+static gboolean
+run_test_case (void)
+{
+    CutTest *test;
+
+    test_case = cut_test_case_new("baseline_test_case",
+                                  NULL, NULL, NULL, NULL);
+    test = cut_test_new("test_slow", stub_slow_test);
+    cut_test_case_add_test(test_case, test);
+    g_object_unref(test);
+
+    g_signal_connect(run_context, "notification-test",
+                     G_CALLBACK(cb_notification_test), NULL);
+    g_signal_connect(run_context, "failure-test",
+                     G_CALLBACK(cb_failure_test), NULL);
+    return cut_test_runner_run_test_case(CUT_TEST_RUNNER(run_context),
+                                         test_case);
+}
+
+void
+test_save_run (void)
+{
+    GError *error = NULL;
+
+    run_context = CUT_RUN_CONTEXT(cut_test_runner_new());
+    cut_run_context_set_save_baseline(run_context, filename);
+    cut_assert_true(run_test_case());
+    cut_run_context_emit_complete_run(run_context, TRUE);
+
+    baseline = cut_baseline_new(filename);
+    cut_baseline_load(baseline, &error);
+    gcut_assert_error(error);
+    cut_assert_operator_double(CUT_BASELINE_MIN_REGRESSION_ELAPSED, <,
+                               cut_baseline_get_test_elapsed(baseline,
+                                                             "baseline_test_case",
+                                                             "test_slow"));
+}
+
+static void
+save_fast_baseline (void)
+{
+    GError *error = NULL;
+
+    baseline = cut_baseline_new(filename);
+    cut_baseline_record_test(baseline, "baseline_test_case", "test_slow", 0.0);
+    cut_baseline_save(baseline, &error);
+    gcut_assert_error(error);
+}
+
+void
+test_compare_run (void)
+{
+    save_fast_baseline();
+
+    run_context = CUT_RUN_CONTEXT(cut_test_runner_new());
+    cut_run_context_set_compare_baseline(run_context, filename);
+    cut_assert_true(run_test_case());
+    cut_assert_equal_uint(1, n_notifications);
+    cut_assert_equal_uint(0, n_failures);
+}
+
+void
+test_compare_run_fail_on_regression (void)
+{
+    save_fast_baseline();
+
+    run_context = CUT_RUN_CONTEXT(cut_test_runner_new());
+    cut_run_context_set_compare_baseline(run_context, filename);
+    cut_run_context_set_fail_on_regression(run_context, TRUE);
+    cut_assert_false(run_test_case());
+    cut_assert_equal_uint(0, n_notifications);
+    cut_assert_equal_uint(1, n_failures);
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
@@ -0,0 +1,249 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <gcutter.h>
+#include <cutter/cut-benchmark.h>
+#include <cutter/cut-benchmark-result.h>
+#include <cutter/cut-test-runner.h>
+
+void test_result_statistics (void);
+void test_result_single_sample (void);
+void test_result_to_xml (void);
+void test_get_time (void);
+void test_run (void);
+void test_run_without_time (void);
+void test_failure (void);
+void test_benchmark_test_signal (void);
+
+static CutRunContext *run_context;
+static CutBenchmark *benchmark;
+static CutBenchmarkResult *result;
+static CutTestCase *test_case;
+static guint n_calls;
+
+static void
+stub_benchmark_function (void)
+{
+    n_calls++;
+}
+
+static void
+stub_fail_benchmark_function (void)
+{
+    n_calls++;
+    cut_fail("This benchmark should fail");
+}
+
+void
+cut_setup (void)
+{
+    run_context = CUT_RUN_CONTEXT(cut_test_runner_new());
+    cut_run_context_set_benchmark_time(run_context, 0.01);
+    benchmark = NULL;
+    result = NULL;
+    test_case = NULL;
+    n_calls = 0;
+}
+
+void
+cut_teardown (void)
+{
+    if (benchmark)
+        g_object_unref(benchmark);
+    if (result)
+        g_object_unref(result);
+    if (test_case)
+        g_object_unref(test_case);
+    g_object_unref(run_context);
+}
+
+static void
+cb_benchmark (CutTest *test, CutTestContext *test_context,
+              CutBenchmarkResult *benchmark_result, gpointer data)
+{
+    if (result)
+        g_object_unref(result);
+    result = g_object_ref(benchmark_result);
+}
+
+static gboolean
+run (void)
+{
+    gboolean success;
+    CutTestContext *test_context;
+
+    test_context = cut_test_context_new(run_context, NULL, NULL, NULL,
+                                        CUT_TEST(benchmark));
+    cut_test_context_current_push(test_context);
+    success = cut_test_run(CUT_TEST(benchmark), test_context, run_context);
+    cut_test_context_current_pop();
+
+    g_object_unref(test_context);
+
+    return success;
+}
+
+void
+test_result_statistics (void)
+{
+    gdouble samples[] = {4.0, 1.0, 3.0, 2.0};
+
+    result = cut_benchmark_result_new(100, samples, G_N_ELEMENTS(samples));
+    cut_assert_equal_uint(100, cut_benchmark_result_get_n_iterations(result));
+    cut_assert_equal_uint(4, cut_benchmark_result_get_n_samples(result));
+    cut_assert_equal_double(2.5, 0.0001,
+                            cut_benchmark_result_get_mean(result));
+    cut_assert_equal_double(2.5, 0.0001,
+                            cut_benchmark_result_get_median(result));
+    cut_assert_equal_double(1.2910, 0.0001,
+                            cut_benchmark_result_get_standard_deviation(result));
+    cut_assert_equal_double(1.0, 0.0001,
+                            cut_benchmark_result_get_minimum(result));
+    cut_assert_equal_double(4.0, 0.0001,
+                            cut_benchmark_result_get_maximum(result));
+    cut_assert_equal_double(0.4, 0.0001,
+                            cut_benchmark_result_get_operations_per_second(result));
+}
+
+void
+test_result_single_sample (void)
+{
+    gdouble samples[] = {0.5};
+
+    result = cut_benchmark_result_new(1, samples, G_N_ELEMENTS(samples));
+    cut_assert_equal_double(0.5, 0.0001,
+                            cut_benchmark_result_get_median(result));
+    cut_assert_equal_double(0.0, 0.0001,
+                            cut_benchmark_result_get_standard_deviation(result));
+    cut_assert_equal_double(2.0, 0.0001,
+                            cut_benchmark_result_get_operations_per_second(result));
+}
+
+void
+test_result_to_xml (void)
+{
+    gdouble samples[] = {0.25, 0.75, 0.5};
+
+    result = cut_benchmark_result_new(8, samples, G_N_ELEMENTS(samples));
+    cut_assert_equal_string_with_free(
+        "<benchmark-result>\n"
+        "  <n-iterations>8</n-iterations>\n"
+        "  <n-samples>3</n-samples>\n"
+        "  <mean>0.5</mean>\n"
+        "  <median>0.5</median>\n"
+        "  <standard-deviation>0.25</standard-deviation>\n"
+        "  <minimum>0.25</minimum>\n"
+        "  <maximum>0.75</maximum>\n"
+        "  <operations-per-second>2</operations-per-second>\n"
+        "</benchmark-result>\n",
+        cut_benchmark_result_to_xml(result));
+}
+
+void
+test_get_time (void)
+{
+    benchmark = cut_benchmark_new("bench_stub", stub_benchmark_function);
+
+    cut_assert_equal_double(-1.0, 0.0, cut_benchmark_get_time(benchmark));
+    cut_test_set_attribute(CUT_TEST(benchmark), "benchmark-time", "0.5");
+    cut_assert_equal_double(0.5, 0.0, cut_benchmark_get_time(benchmark));
+    cut_test_set_attribute(CUT_TEST(benchmark), "benchmark-time", "invalid");
+    cut_assert_equal_double(-1.0, 0.0, cut_benchmark_get_time(benchmark));
+}
+
+void
+test_run (void)
+{
+    guint n_iterations;
+
+    benchmark = cut_benchmark_new("bench_stub", stub_benchmark_function);
+    g_signal_connect(benchmark, "benchmark", G_CALLBACK(cb_benchmark), NULL);
+
+    cut_assert_true(run());
+    cut_assert_not_null(result);
+
+    n_iterations = cut_benchmark_result_get_n_iterations(result);
+    cut_assert_operator_uint(n_iterations, >, 0);
+    cut_assert_equal_uint(CUT_BENCHMARK_N_SAMPLES,
+                          cut_benchmark_result_get_n_samples(result));
+    /* Calibration, warm up and samples. */
+    cut_assert_operator_uint(n_calls, >=,
+                             n_iterations * (CUT_BENCHMARK_N_SAMPLES + 1));
+    cut_assert_operator_double(cut_benchmark_result_get_minimum(result), <=,
+                               cut_benchmark_result_get_median(result));
+    cut_assert_operator_double(cut_benchmark_result_get_median(result), <=,
+                               cut_benchmark_result_get_maximum(result));
+}
+
+void
+test_run_without_time (void)
+{
+    benchmark = cut_benchmark_new("bench_stub", stub_benchmark_function);
+    cut_test_set_attribute(CUT_TEST(benchmark), "benchmark-time", "0");
+    g_signal_connect(benchmark, "benchmark", G_CALLBACK(cb_benchmark), NULL);
+
+    cut_assert_true(run());
+    cut_assert_equal_uint(1, n_calls);
+    cut_assert_null(result);
+}
+
+void
+test_failure (void)
+{
+    benchmark = cut_benchmark_new("bench_fail", stub_fail_benchmark_function);
+    g_signal_connect(benchmark, "benchmark", G_CALLBACK(cb_benchmark), NULL);
+
+    cut_assert_false(run());
+    cut_assert_equal_uint(1, n_calls);
+    cut_assert_null(result);
+}
+
+static void
+cb_benchmark_test (CutRunContext *context, CutTest *test,
+                   CutTestContext *test_context,
+                   CutBenchmarkResult *benchmark_result, gpointer data)
+{
+    cb_benchmark(test, test_context, benchmark_result, data);
+}
+
+void
+test_benchmark_test_signal (void)
+{
+    test_case = cut_test_case_new("benchmark_test_case",
+                                  NULL, NULL, NULL, NULL);
+    benchmark = cut_benchmark_new("bench_stub", stub_benchmark_function);
+    cut_test_case_add_test(test_case, CUT_TEST(benchmark));
+
+    g_signal_connect(run_context, "benchmark-test",
+                     G_CALLBACK(cb_benchmark_test), NULL);
+    cut_assert_true(cut_test_runner_run_test_case(CUT_TEST_RUNNER(run_context),
+                                                  test_case));
+    g_signal_handlers_disconnect_by_func(run_context,
+                                         G_CALLBACK(cb_benchmark_test),
+                                         NULL);
+
+    cut_assert_not_null(result);
+    cut_assert_equal_uint(CUT_BENCHMARK_N_SAMPLES,
+                          cut_benchmark_result_get_n_samples(result));
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
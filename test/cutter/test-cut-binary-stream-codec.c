@@ -0,0 +1,244 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gcutter.h>
+#include <cutter/cut-stream-parser.h>
+#include <cutter/cut-backtrace-entry.h>
+#include <cutter/cut-binary-stream-codec.h>
+#include "../lib/cuttest-event-receiver.h"
+
+void test_pass_assertion (void);
+void test_failure_test (void);
+void test_complete_run (void);
+void test_broken_frame (void);
+void test_to_xml (void);
+
+static CutStreamParser *parser;
+static CutRunContext *run_context;
+static CuttestEventReceiver *receiver;
+static GString *binary;
+static CutTestCase *test_case;
+static CutTest *test;
+static CutTestContext *test_context;
+static CutTestResult *result;
+
+void
+cut_setup (void)
+{
+    run_context = cuttest_event_receiver_new();
+    receiver = CUTTEST_EVENT_RECEIVER(run_context);
+    parser = cut_stream_parser_new(run_context);
+
+    binary = g_string_new(NULL);
+    cut_binary_stream_append_header(binary);
+
+    test_case = cut_test_case_new("my test case", NULL, NULL, NULL, NULL);
+    test = cut_test_new("my test", NULL);
+    cut_test_set_attribute(test, "description", "my description");
+    test_context = cut_test_context_new_empty();
+    cut_test_context_set_test_case(test_context, test_case);
+    cut_test_context_set_test(test_context, test);
+    result = NULL;
+}
+
+void
+cut_teardown (void)
+{
+    g_object_unref(receiver);
+    g_object_unref(parser);
+    g_string_free(binary, TRUE);
+    g_object_unref(test_case);
+    g_object_unref(test);
+    g_object_unref(test_context);
+    if (result)
+        g_object_unref(result);
+}
+
+static void
+append_event (CutBinaryStreamEventType type, CutTest *test_object,
+              CutTestContext *context, CutTestResult *test_result,
+              gboolean success)
+{
+    CutBinaryStreamEvent event;
+
+    memset(&event, 0, sizeof(event));
+    event.type = type;
+    event.test = test_object;
+    event.test_context = context;
+    event.result = test_result;
+    event.success = success;
+    cut_binary_stream_append_event(binary, &event);
+}
+
+#define cut_assert_parse(data, length) do                       \
+{                                                               \
+    GError *error = NULL;                                       \
+    cut_stream_parser_parse(parser, (data), (length), &error);  \
+    gcut_assert_error(error);                                   \
+} while (0)
+
+void
+test_pass_assertion (void)
+{
+    CuttestPassAssertionInfo *info;
+    gsize split;
+
+    append_event(CUT_BINARY_STREAM_EVENT_START_RUN, NULL, NULL, NULL, FALSE);
+    append_event(CUT_BINARY_STREAM_EVENT_PASS_ASSERTION,
+                 test, test_context, NULL, FALSE);
+
+    split = binary->len - 1;
+    cut_assert_parse(binary->str, split);
+    cut_assert_equal_int(1, receiver->n_start_runs);
+    cut_assert_null(receiver->pass_assertions);
+
+    cut_assert_parse(binary->str + split, binary->len - split);
+    cut_assert_equal_int(1, g_list_length(receiver->pass_assertions));
+
+    info = receiver->pass_assertions->data;
+    cut_assert_equal_string("my test", cut_test_get_name(info->test));
+    cut_assert_equal_string("my description",
+                            cut_test_get_description(info->test));
+    cut_assert_equal_string("my test case",
+                            cut_test_get_name(CUT_TEST(cut_test_context_get_test_case(info->test_context))));
+    cut_assert_equal_string("my test",
+                            cut_test_get_name(cut_test_context_get_test(info->test_context)));
+}
+
+void
+test_failure_test (void)
+{
+    CuttestFailureTestInfo *info;
+    CutBacktraceEntry *entry;
+    GList *backtrace = NULL;
+    const GList *actual_backtrace;
+
+    result = cut_test_result_new_empty();
+    cut_test_result_set_status(result, CUT_TEST_RESULT_FAILURE);
+    cut_test_result_set_test(result, test);
+    cut_test_result_set_test_case(result, test_case);
+    cut_test_result_set_message(result, "not equal");
+    cut_test_result_set_expected(result, "1");
+    cut_test_result_set_actual(result, "2");
+    entry = cut_backtrace_entry_new("test-my.c", 29, "test_my()", NULL);
+    backtrace = g_list_append(backtrace, entry);
+    cut_test_result_set_backtrace(result, backtrace);
+    g_list_free(backtrace);
+    g_object_unref(entry);
+
+    append_event(CUT_BINARY_STREAM_EVENT_START_RUN, NULL, NULL, NULL, FALSE);
+    append_event(CUT_BINARY_STREAM_EVENT_TEST_RESULT,
+                 test, test_context, result, FALSE);
+    cut_assert_parse(binary->str, binary->len);
+
+    cut_assert_equal_int(1, g_list_length(receiver->failure_tests));
+    info = receiver->failure_tests->data;
+    cut_assert_equal_string("my test", cut_test_get_name(info->test));
+    cut_assert_equal_int(CUT_TEST_RESULT_FAILURE,
+                         cut_test_result_get_status(info->test_result));
+    cut_assert_equal_string("not equal",
+                            cut_test_result_get_message(info->test_result));
+    cut_assert_equal_string("1",
+                            cut_test_result_get_expected(info->test_result));
+    cut_assert_equal_string("2",
+                            cut_test_result_get_actual(info->test_result));
+    cut_assert_equal_string("my test case",
+                            cut_test_result_get_test_case_name(info->test_result));
+
+    actual_backtrace = cut_test_result_get_backtrace(info->test_result);
+    cut_assert_equal_int(1, g_list_length((GList *)actual_backtrace));
+    entry = actual_backtrace->data;
+    cut_assert_equal_string("test-my.c", cut_backtrace_entry_get_file(entry));
+    cut_assert_equal_uint(29, cut_backtrace_entry_get_line(entry));
+    cut_assert_equal_string("test_my()",
+                            cut_backtrace_entry_get_function(entry));
+}
+
+void
+test_complete_run (void)
+{
+    GError *error = NULL;
+
+    append_event(CUT_BINARY_STREAM_EVENT_START_RUN, NULL, NULL, NULL, FALSE);
+    append_event(CUT_BINARY_STREAM_EVENT_COMPLETE_RUN,
+                 NULL, NULL, NULL, FALSE);
+    cut_assert_parse(binary->str, binary->len);
+    cut_stream_parser_end_parse(parser, &error);
+    gcut_assert_error(error);
+
+    cut_assert_equal_int(1, g_list_length(receiver->complete_runs));
+    cut_assert_false(GPOINTER_TO_INT(receiver->complete_runs->data));
+}
+
+void
+test_broken_frame (void)
+{
+    GError *error = NULL;
+    GError *expected_error;
+
+    append_event(CUT_BINARY_STREAM_EVENT_START_RUN, NULL, NULL, NULL, FALSE);
+    g_string_truncate(binary, binary->len - 1);
+    cut_assert_parse(binary->str, binary->len);
+    cut_stream_parser_end_parse(parser, &error);
+
+    expected_error = g_error_new(CUT_BINARY_STREAM_ERROR,
+                                 CUT_BINARY_STREAM_ERROR_TRUNCATED,
+                                 "binary stream is truncated: "
+                                 "4 byte(s) are left");
+    gcut_take_error(expected_error);
+    gcut_assert_equal_error(expected_error, error);
+}
+
+void
+test_to_xml (void)
+{
+    GString *expected;
+    gchar *xml;
+    GError *error = NULL;
+
+    append_event(CUT_BINARY_STREAM_EVENT_START_RUN, NULL, NULL, NULL, FALSE);
+    append_event(CUT_BINARY_STREAM_EVENT_START_TEST_CASE,
+                 CUT_TEST(test_case), NULL, NULL, FALSE);
+    append_event(CUT_BINARY_STREAM_EVENT_COMPLETE_TEST,
+                 test, test_context, NULL, TRUE);
+    append_event(CUT_BINARY_STREAM_EVENT_COMPLETE_RUN,
+                 NULL, NULL, NULL, TRUE);
+
+    expected = g_string_new("<stream>\n");
+    g_string_append(expected, "  <start-test-case>\n");
+    cut_test_to_xml_string(CUT_TEST(test_case), expected, 4);
+    g_string_append(expected, "  </start-test-case>\n");
+    g_string_append(expected, "  <complete-test>\n");
+    cut_test_to_xml_string(test, expected, 4);
+    cut_test_context_to_xml_string(test_context, expected, 4);
+    g_string_append(expected, "    <success>true</success>\n");
+    g_string_append(expected, "  </complete-test>\n");
+    g_string_append(expected, "  <success>true</success>\n");
+    g_string_append(expected, "</stream>\n");
+
+    xml = cut_binary_stream_to_xml(binary->str, binary->len, &error);
+    gcut_assert_error(error);
+    cut_assert_equal_string_with_free(cut_take_string(g_string_free(expected,
+                                                                    FALSE)),
+                                      xml);
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
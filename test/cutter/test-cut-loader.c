@@ -28,6 +28,7 @@
 #include "../lib/cuttest-assertions.h"
 
 void test_load_function (void);
+void test_load_function_with_symbol_cache (void);
 void data_fixture_function (void);
 void test_fixture_function (gconstpointer data);
 void test_fail_to_load (void);
@@ -44,6 +45,7 @@ static CutTestCase *test_case;
 static CutRunContext *run_context;
 static GPtrArray *test_names;
 static GModule *module;
+static gchar *symbol_cache_directory;
 
 void
 cut_setup (void)
@@ -53,6 +55,7 @@ cut_setup (void)
     test_names = NULL;
     run_context = NULL;
     module = NULL;
+    symbol_cache_directory = NULL;
 }
 
 void
@@ -68,6 +71,10 @@ cut_teardown (void)
         g_object_unref(run_context);
     if (module)
         g_module_close(module);
+    if (symbol_cache_directory) {
+        cut_remove_path(symbol_cache_directory, NULL);
+        g_free(symbol_cache_directory);
+    }
 }
 
 static CutLoader *
@@ -154,6 +161,39 @@ test_load_function (void)
                                   (gchar **)test_names->pdata);
 }
 
+void
+test_load_function_with_symbol_cache (void)
+{
+    symbol_cache_directory = g_build_filename(cuttest_get_base_dir(),
+                                              "tmp",
+                                              "symbol-cache",
+                                              NULL);
+    cut_remove_path(symbol_cache_directory, NULL);
+
+    loader = loader_new("test", "stub-test-functions." G_MODULE_SUFFIX);
+    cut_loader_set_symbol_cache_directory(loader, symbol_cache_directory);
+    test_case = cut_loader_load_test_case(loader);
+    cut_assert_not_null(test_case);
+    cut_assert_equal_int(4,
+                         cut_test_container_get_n_tests(
+                             CUT_TEST_CONTAINER(test_case), NULL));
+    cut_assert_path_exist(cut_take_string(g_build_filename(
+                                              symbol_cache_directory,
+                                              "symbols",
+                                              NULL)));
+
+    g_object_unref(test_case);
+    g_object_unref(loader);
+
+    loader = loader_new("test", "stub-test-functions." G_MODULE_SUFFIX);
+    cut_loader_set_symbol_cache_directory(loader, symbol_cache_directory);
+    test_case = cut_loader_load_test_case(loader);
+    cut_assert_not_null(test_case);
+    cut_assert_equal_int(4,
+                         cut_test_container_get_n_tests(
+                             CUT_TEST_CONTAINER(test_case), NULL));
+}
+
 typedef struct _FixtureTestData
 {
     gchar *file_name;
@@ -0,0 +1,177 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <gcutter.h>
+#include <cutter/cut-log-index.h>
+#include "../lib/cuttest-utils.h"
+
+void test_build_filename (void);
+void test_unknown (void);
+void test_record (void);
+void test_changed_log (void);
+void test_remove (void);
+void test_save_and_load (void);
+
+static gchar *tmp_dir;
+static CutLogIndex *log_index;
+static CutLogSummary *summary;
+static CutLogSummary *actual_summary;
+
+void
+cut_setup (void)
+{
+    tmp_dir = g_build_filename(cuttest_get_base_dir(), "tmp", NULL);
+    cut_remove_path(tmp_dir, NULL);
+    log_index = NULL;
+
+    summary = cut_log_summary_new("2026-01-01-00-00-00.xml");
+    summary->success = FALSE;
+    summary->crashed = FALSE;
+    summary->elapsed = 1.5;
+    summary->n_tests = 6;
+    summary->n_assertions = 16;
+    summary->n_successes = 4;
+    summary->n_failures = 1;
+    summary->n_errors = 1;
+    actual_summary = NULL;
+}
+
+void
+cut_teardown (void)
+{
+    if (log_index)
+        cut_log_index_free(log_index);
+    cut_log_summary_free(summary);
+    if (actual_summary)
+        cut_log_summary_free(actual_summary);
+
+    cut_remove_path(tmp_dir, NULL);
+    g_free(tmp_dir);
+}
+
+#define assert_summary(expected, actual)                                \
+    do {                                                                \
+        cut_assert_not_null(actual);                                    \
+        cut_assert_equal_string((expected)->log_name, (actual)->log_name); \
+        cut_assert_equal_boolean((expected)->success, (actual)->success); \
+        cut_assert_equal_boolean((expected)->crashed, (actual)->crashed); \
+        cut_assert_equal_double((expected)->elapsed, 0.001,             \
+                                (actual)->elapsed);                     \
+        cut_assert_equal_uint((expected)->n_tests, (actual)->n_tests);  \
+        cut_assert_equal_uint((expected)->n_assertions,                 \
+                              (actual)->n_assertions);                  \
+        cut_assert_equal_uint((expected)->n_successes,                  \
+                              (actual)->n_successes);                   \
+        cut_assert_equal_uint((expected)->n_failures,                   \
+                              (actual)->n_failures);                    \
+        cut_assert_equal_uint((expected)->n_errors, (actual)->n_errors); \
+        cut_assert_equal_uint((expected)->n_pendings,                   \
+                              (actual)->n_pendings);                    \
+        cut_assert_equal_uint((expected)->n_notifications,              \
+                              (actual)->n_notifications);               \
+        cut_assert_equal_uint((expected)->n_omissions,                  \
+                              (actual)->n_omissions);                   \
+    } while (0)
+
+void
+test_build_filename (void)
+{
+    cut_assert_equal_string(
+        cut_take_string(g_build_filename("log", "summary.index", NULL)),
+        cut_take_string(cut_log_index_build_filename("log")));
+}
+
+void
+test_unknown (void)
+{
+    log_index = cut_log_index_new("summary.index");
+    cut_assert_null(cut_log_index_lookup(log_index, summary->log_name,
+                                         10, 100));
+    cut_assert_false(cut_log_index_is_modified(log_index));
+}
+
+void
+test_record (void)
+{
+    log_index = cut_log_index_new("summary.index");
+    cut_log_index_record(log_index, summary, 10, 100);
+    cut_assert_true(cut_log_index_is_modified(log_index));
+
+    actual_summary = cut_log_index_lookup(log_index, summary->log_name,
+                                          10, 100);
+    assert_summary(summary, actual_summary);
+}
+
+void
+test_changed_log (void)
+{
+    log_index = cut_log_index_new("summary.index");
+    cut_log_index_record(log_index, summary, 10, 100);
+
+    cut_assert_null(cut_log_index_lookup(log_index, summary->log_name,
+                                         11, 100));
+    cut_assert_null(cut_log_index_lookup(log_index, summary->log_name,
+                                         10, 101));
+}
+
+void
+test_remove (void)
+{
+    const gchar *expected_names[] = {"2026-01-02-00-00-00.xml", NULL};
+
+    log_index = cut_log_index_new("summary.index");
+    cut_log_index_record(log_index, summary, 10, 100);
+    g_free(summary->log_name);
+    summary->log_name = g_strdup("2026-01-02-00-00-00.xml");
+    cut_log_index_record(log_index, summary, 20, 200);
+
+    cut_log_index_remove(log_index, "2026-01-01-00-00-00.xml");
+    cut_assert_equal_string_array_with_free(
+        (gchar **)expected_names,
+        cut_log_index_get_log_names(log_index));
+}
+
+void
+test_save_and_load (void)
+{
+    gchar *filename;
+    GError *error = NULL;
+
+    cut_assert_true(g_mkdir_with_parents(tmp_dir, 0755) == 0);
+    filename = cut_take_string(cut_log_index_build_filename(tmp_dir));
+
+    log_index = cut_log_index_new(filename);
+    cut_log_index_record(log_index, summary, 10, 100);
+    cut_log_index_save(log_index, &error);
+    gcut_assert_error(error);
+    cut_assert_false(cut_log_index_is_modified(log_index));
+    cut_log_index_free(log_index);
+
+    log_index = cut_log_index_new(filename);
+    cut_log_index_load(log_index, &error);
+    gcut_assert_error(error);
+    actual_summary = cut_log_index_lookup(log_index, summary->log_name,
+                                          10, 100);
+    assert_summary(summary, actual_summary);
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
@@ -0,0 +1,242 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gcutter.h>
+#include <cutter/cut-memory-usage.h>
+#include <cutter/cut-run-context.h>
+#include <cutter/cut-test-runner.h>
+
+#if !GLIB_CHECK_VERSION(2, 32, 0)
+#  define g_thread_try_new(name, func, data, error) \
+    g_thread_create(func, data, TRUE, error)
+#endif
+
+void test_type_name (void);
+void test_type_from_unknown_name (void);
+void test_measure (void);
+void test_nested_peak (void);
+void test_other_thread (void);
+void test_disabled (void);
+void test_enabled (void);
+
+static CutRunContext *run_context;
+static CutTestCase *test_case;
+static CutTestResult *result;
+static CutMemoryUsage *usage;
+static CutMemoryUsage *inner_usage;
+
+void
+cut_setup (void)
+{
+    run_context = CUT_RUN_CONTEXT(cut_test_runner_new());
+    test_case = NULL;
+    result = NULL;
+    usage = NULL;
+    inner_usage = NULL;
+}
+
+void
+cut_teardown (void)
+{
+    if (inner_usage)
+        cut_memory_usage_free(inner_usage);
+    if (usage)
+        cut_memory_usage_free(usage);
+    if (result)
+        g_object_unref(result);
+    if (test_case)
+        g_object_unref(test_case);
+    g_object_unref(run_context);
+}
+
+static void
+omit_if_unavailable (CutMemoryUsage *memory_usage)
+{
+    if (!cut_memory_usage_is_available(memory_usage))
+        cut_omit("malloc() isn't interposed");
+}
+
+void
+test_type_name (void)
+{
+    CutMemoryUsageType type;
+
+    cut_assert_equal_string("allocated-bytes",
+                            cut_memory_usage_type_to_name(
+                                CUT_MEMORY_USAGE_ALLOCATED_BYTES));
+    cut_assert_true(cut_memory_usage_type_from_name("peak-heap-growth",
+                                                    &type));
+    cut_assert_equal_int(CUT_MEMORY_USAGE_PEAK_HEAP_GROWTH, type);
+}
+
+void
+test_type_from_unknown_name (void)
+{
+    CutMemoryUsageType type;
+
+    cut_assert_false(cut_memory_usage_type_from_name("unknown", &type));
+}
+
+void
+test_measure (void)
+{
+    gchar *memory;
+
+    usage = cut_memory_usage_new();
+    omit_if_unavailable(usage);
+
+    cut_memory_usage_start(usage);
+    memory = g_malloc(4096);
+    g_free(memory);
+    cut_memory_usage_stop(usage);
+
+    cut_assert_operator_int(1, <=,
+                            cut_memory_usage_get_value(
+                                usage, CUT_MEMORY_USAGE_ALLOCATIONS));
+    cut_assert_operator_int(4096, <=,
+                            cut_memory_usage_get_value(
+                                usage, CUT_MEMORY_USAGE_ALLOCATED_BYTES));
+    cut_assert_operator_int(4096, <=,
+                            cut_memory_usage_get_value(
+                                usage, CUT_MEMORY_USAGE_PEAK_HEAP_GROWTH));
+}
+
+void
+test_nested_peak (void)
+{
+    gchar *memory;
+
+    usage = cut_memory_usage_new();
+    omit_if_unavailable(usage);
+    inner_usage = cut_memory_usage_new();
+
+    cut_memory_usage_start(usage);
+    memory = g_malloc(8192);
+    g_free(memory);
+    cut_memory_usage_start(inner_usage);
+    memory = g_malloc(1024);
+    g_free(memory);
+    cut_memory_usage_stop(inner_usage);
+    cut_memory_usage_stop(usage);
+
+    cut_assert_operator_int(1024, <=,
+                            cut_memory_usage_get_value(
+                                inner_usage,
+                                CUT_MEMORY_USAGE_PEAK_HEAP_GROWTH));
+    cut_assert_operator_int(8192, <=,
+                            cut_memory_usage_get_value(
+                                usage, CUT_MEMORY_USAGE_PEAK_HEAP_GROWTH));
+}
+
+static gpointer
+allocate_in_thread (gpointer data)
+{
+    gchar *memory;
+
+    memory = g_malloc(1024 * 1024);
+    g_free(memory);
+
+    return NULL;
+}
+
+void
+test_other_thread (void)
+{
+    GThread *thread;
+    GError *error = NULL;
+
+    usage = cut_memory_usage_new();
+    omit_if_unavailable(usage);
+
+    /* Tests in other threads run at once with --multi-thread. */
+    cut_memory_usage_start(usage);
+    thread = g_thread_try_new(NULL, allocate_in_thread, NULL, &error);
+    gcut_assert_error(error);
+    g_thread_join(thread);
+    cut_memory_usage_stop(usage);
+
+    cut_assert_operator_int(1024 * 1024, >,
+                            cut_memory_usage_get_value(
+                                usage, CUT_MEMORY_USAGE_ALLOCATED_BYTES));
+}
+
+static void
+stub_test (void)
+{
+    gchar *memory;
+
+    memory = g_malloc0(1024 * 1024);
+    g_free(memory);
+}
+
+static void
+cb_success_test (CutRunContext *context, CutTest *test,
+                 CutTestContext *test_context, CutTestResult *test_result,
+                 gpointer data)
+{
+    if (result)
+        g_object_unref(result);
+    result = g_object_ref(test_result);
+}
+
+static void
+run (void)
+{
+    CutTest *test;
+
+    test_case = cut_test_case_new("memory_usage_test_case",
+                                  NULL, NULL, NULL, NULL);
+    test = cut_test_new("test_stub", stub_test);
+    cut_test_case_add_test(test_case, test);
+    g_object_unref(test);
+
+    g_signal_connect(run_context, "success-test",
+                     G_CALLBACK(cb_success_test), NULL);
+    cut_assert_true(cut_test_runner_run_test_case(CUT_TEST_RUNNER(run_context),
+                                                  test_case));
+    g_signal_handlers_disconnect_by_func(run_context,
+                                         G_CALLBACK(cb_success_test),
+                                         NULL);
+    cut_assert_not_null(result);
+}
+
+void
+test_disabled (void)
+{
+    run();
+    cut_assert_false(cut_test_result_has_memory_usage(result));
+}
+
+void
+test_enabled (void)
+{
+    usage = cut_memory_usage_new();
+    omit_if_unavailable(usage);
+
+    cut_run_context_set_memory_usage(run_context, TRUE);
+    run();
+    cut_assert_true(cut_test_result_has_memory_usage(result));
+    cut_assert_operator_int(1024 * 1024, <=,
+                            cut_test_result_get_memory_usage(
+                                result, CUT_MEMORY_USAGE_ALLOCATED_BYTES));
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
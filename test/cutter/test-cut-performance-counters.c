@@ -0,0 +1,139 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <gcutter.h>
+#include <cutter/cut-performance-counters.h>
+#include <cutter/cut-run-context.h>
+#include <cutter/cut-test-runner.h>
+
+void test_type_name (void);
+void test_type_from_unknown_name (void);
+void test_disabled (void);
+void test_enabled (void);
+
+static CutRunContext *run_context;
+static CutTestCase *test_case;
+static CutTestResult *result;
+static CutPerformanceCounters *counters;
+
+void
+cut_setup (void)
+{
+    run_context = CUT_RUN_CONTEXT(cut_test_runner_new());
+    test_case = NULL;
+    result = NULL;
+    counters = NULL;
+}
+
+void
+cut_teardown (void)
+{
+    if (counters)
+        cut_performance_counters_free(counters);
+    if (result)
+        g_object_unref(result);
+    if (test_case)
+        g_object_unref(test_case);
+    g_object_unref(run_context);
+}
+
+void
+test_type_name (void)
+{
+    CutPerformanceCounterType type;
+
+    cut_assert_equal_string("cache-misses",
+                            cut_performance_counter_type_to_name(
+                                CUT_PERFORMANCE_COUNTER_CACHE_MISSES));
+    cut_assert_true(cut_performance_counter_type_from_name("page-faults",
+                                                           &type));
+    cut_assert_equal_int(CUT_PERFORMANCE_COUNTER_PAGE_FAULTS, type);
+}
+
+void
+test_type_from_unknown_name (void)
+{
+    CutPerformanceCounterType type;
+
+    cut_assert_false(cut_performance_counter_type_from_name("unknown", &type));
+}
+
+static void
+stub_test (void)
+{
+    gchar *memory;
+
+    memory = g_malloc0(1024 * 1024);
+    g_free(memory);
+}
+
+static void
+cb_success_test (CutRunContext *context, CutTest *test,
+                 CutTestContext *test_context, CutTestResult *test_result,
+                 gpointer data)
+{
+    if (result)
+        g_object_unref(result);
+    result = g_object_ref(test_result);
+}
+
+static void
+run (void)
+{
+    CutTest *test;
+
+    test_case = cut_test_case_new("performance_counters_test_case",
+                                  NULL, NULL, NULL, NULL);
+    test = cut_test_new("test_stub", stub_test);
+    cut_test_case_add_test(test_case, test);
+    g_object_unref(test);
+
+    g_signal_connect(run_context, "success-test",
+                     G_CALLBACK(cb_success_test), NULL);
+    cut_assert_true(cut_test_runner_run_test_case(CUT_TEST_RUNNER(run_context),
+                                                  test_case));
+    g_signal_handlers_disconnect_by_func(run_context,
+                                         G_CALLBACK(cb_success_test),
+                                         NULL);
+    cut_assert_not_null(result);
+}
+
+void
+test_disabled (void)
+{
+    run();
+    cut_assert_false(cut_test_result_has_performance_counters(result));
+}
+
+void
+test_enabled (void)
+{
+    counters = cut_performance_counters_new();
+    if (!cut_performance_counters_is_available(counters))
+        cut_omit("perf_event_open(2) isn't available");
+
+    cut_run_context_set_performance_counters(run_context, TRUE);
+    run();
+    cut_assert_true(cut_test_result_has_performance_counters(result));
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
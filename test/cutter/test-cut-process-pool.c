@@ -0,0 +1,451 @@
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <glib.h>
+#ifndef G_OS_WIN32
+#  include <unistd.h>
+#  include <sys/wait.h>
+#  include <sys/socket.h>
+#  include <netinet/in.h>
+#  include <arpa/inet.h>
+#endif
+#include <gcutter.h>
+#include <cutter/cut-test-runner.h>
+#include <cutter/cut-test-case.h>
+#include <cutter/cut-test-suite.h>
+#include <cutter/cut-process-pool.h>
+#include <cutter/cut-run-history.h>
+
+#include "../lib/cuttest-utils.h"
+
+void test_run (void);
+void test_crash (void);
+void test_timeout (void);
+void test_timeout_without_processes (void);
+void test_run_history (void);
+void test_shard (void);
+void test_shard_crash (void);
+void test_shard_refuse (void);
+
+static CutRunContext *run_context;
+static CutTestSuite *test_suite;
+static CutTestCase *test_case;
+static GList *worker_pids;
+static gchar *tmp_dir;
+static CutRunHistory *history;
+static GList *history_tests;
+
+static void
+stub_success_test (void)
+{
+    cut_assert_true(TRUE);
+}
+
+static void
+stub_crash_test (void)
+{
+    abort();
+}
+
+static void
+stub_hang_test (void)
+{
+    while (TRUE)
+        g_usleep(G_USEC_PER_SEC);
+}
+
+static void
+stub_notification_test (void)
+{
+    cut_notify("notification");
+    cut_assert_true(TRUE);
+}
+
+static void
+stub_pending_test (void)
+{
+    cut_pend("pending");
+}
+
+void
+cut_setup (void)
+{
+    run_context = NULL;
+    test_suite = NULL;
+    test_case = NULL;
+    worker_pids = NULL;
+    tmp_dir = g_build_filename(cuttest_get_base_dir(), "tmp", NULL);
+    cut_remove_path(tmp_dir, NULL);
+    history = NULL;
+    history_tests = NULL;
+
+#ifdef G_OS_WIN32
+    cut_omit("fork() isn't available on Windows.");
+#endif
+    if (!cut_process_pool_is_available())
+        cut_omit("XML stream module isn't available.");
+
+    run_context = CUT_RUN_CONTEXT(cut_test_runner_new());
+    cut_run_context_set_n_processes(run_context, 2);
+    test_suite = cut_test_suite_new_empty();
+    cut_run_context_set_test_suite(run_context, test_suite);
+}
+
+void
+cut_teardown (void)
+{
+#ifndef G_OS_WIN32
+    GList *node;
+
+    for (node = worker_pids; node; node = g_list_next(node)) {
+        pid_t pid = GPOINTER_TO_INT(node->data);
+
+        kill(pid, SIGKILL);
+        waitpid(pid, NULL, 0);
+    }
+#endif
+    g_list_free(worker_pids);
+    g_unsetenv("CUT_SHARD_TOKEN");
+
+    if (test_case)
+        g_object_unref(test_case);
+    if (test_suite)
+        g_object_unref(test_suite);
+    if (run_context)
+        g_object_unref(run_context);
+
+    g_list_foreach(history_tests, (GFunc)cut_run_history_test_free, NULL);
+    g_list_free(history_tests);
+    if (history)
+        cut_run_history_free(history);
+    cut_remove_path(tmp_dir, NULL);
+    g_free(tmp_dir);
+}
+
+static gboolean
+run (void)
+{
+    return cut_test_runner_run_test_suite(CUT_TEST_RUNNER(run_context),
+                                          test_suite);
+}
+
+void
+test_run (void)
+{
+    test_case = cut_test_case_new("success-test-case1", NULL, NULL,
+                                  NULL, NULL);
+    cuttest_add_test(test_case, "test_success1", stub_success_test);
+    cuttest_add_test(test_case, "test_success2", stub_success_test);
+    cut_test_suite_add_test_case(test_suite, test_case);
+    g_object_unref(test_case);
+
+    test_case = cut_test_case_new("success-test-case2", NULL, NULL,
+                                  NULL, NULL);
+    cuttest_add_test(test_case, "test_success3", stub_success_test);
+    cut_test_suite_add_test_case(test_suite, test_case);
+
+    cut_assert_true(run());
+    cut_assert_equal_uint(3, cut_run_context_get_n_tests(run_context));
+    cut_assert_equal_uint(3, cut_run_context_get_n_successes(run_context));
+}
+
+void
+test_crash (void)
+{
+    test_case = cut_test_case_new("crash-test-case", NULL, NULL,
+                                  NULL, NULL);
+    cuttest_add_test(test_case, "test_success1", stub_success_test);
+    cuttest_add_test(test_case, "test_crash", stub_crash_test);
+    cuttest_add_test(test_case, "test_success2", stub_success_test);
+    cut_test_suite_add_test_case(test_suite, test_case);
+
+    cut_assert_false(run());
+    cut_assert_equal_uint(3, cut_run_context_get_n_tests(run_context));
+    cut_assert_equal_uint(2, cut_run_context_get_n_successes(run_context));
+    cut_assert_true(cut_run_context_is_crashed(run_context));
+}
+
+static void
+assert_timeout (void)
+{
+    test_case = cut_test_case_new("timeout-test-case", NULL, NULL,
+                                  NULL, NULL);
+    cuttest_add_test(test_case, "test_success1", stub_success_test);
+    cuttest_add_test(test_case, "test_hang", stub_hang_test);
+    cuttest_add_test(test_case, "test_success2", stub_success_test);
+    cut_test_suite_add_test_case(test_suite, test_case);
+
+    cut_run_context_set_timeout(run_context, 0.1);
+    cut_assert_false(run());
+    /* The rest of the test case is resumed in a new worker
+     * process. */
+    cut_assert_equal_uint(3, cut_run_context_get_n_tests(run_context));
+    cut_assert_equal_uint(2, cut_run_context_get_n_successes(run_context));
+    cut_assert_equal_uint(1, cut_run_context_get_n_errors(run_context));
+    cut_assert_false(cut_run_context_is_crashed(run_context));
+}
+
+void
+test_timeout (void)
+{
+    assert_timeout();
+}
+
+void
+test_timeout_without_processes (void)
+{
+    /* A timeout runs tests in a worker process. Otherwise the
+     * hung test never returns. */
+    cut_run_context_set_n_processes(run_context, 0);
+    assert_timeout();
+}
+
+static CutRunHistoryEntry *
+query_history (const gchar *test_name)
+{
+    CutRunHistoryTest *history_test;
+    GError *error = NULL;
+
+    g_list_foreach(history_tests, (GFunc)cut_run_history_test_free, NULL);
+    g_list_free(history_tests);
+    history_tests = cut_run_history_query(history, test_name, &error);
+    gcut_assert_error(error);
+    cut_assert_equal_uint(1, g_list_length(history_tests));
+
+    history_test = history_tests->data;
+    cut_assert_equal_string("run-history-test-case",
+                            history_test->test_case_name);
+    cut_assert_equal_uint(1, history_test->entries->len);
+    return &g_array_index(history_test->entries, CutRunHistoryEntry, 0);
+}
+
+void
+test_run_history (void)
+{
+    const gchar *test_dir;
+    gchar *history_dir;
+    GError *error = NULL;
+
+    test_case = cut_test_case_new("run-history-test-case", NULL, NULL,
+                                  NULL, NULL);
+    cuttest_add_test(test_case, "test_notification", stub_notification_test);
+    cuttest_add_test(test_case, "test_pending", stub_pending_test);
+    cut_test_suite_add_test_case(test_suite, test_case);
+
+    test_dir = cut_take_string(g_build_filename(tmp_dir, "test", NULL));
+    cut_run_context_set_test_directory(run_context, test_dir);
+    cut_run_context_set_symbol_cache_directory(run_context, tmp_dir);
+    cut_assert_false(run());
+
+    /* Results are streamed from worker processes. Each test is
+     * recorded once with the worst status of its results. */
+    history_dir = cut_run_history_build_directory(tmp_dir, test_dir);
+    history = cut_run_history_new(history_dir);
+    g_free(history_dir);
+    cut_run_history_load(history, &error);
+    gcut_assert_error(error);
+    cut_assert_equal_uint(1, cut_run_history_get_n_runs(history));
+
+    cut_assert_equal_int(CUT_TEST_RESULT_NOTIFICATION,
+                         query_history("test_notification")->status);
+    cut_assert_equal_int(CUT_TEST_RESULT_PENDING,
+                         query_history("test_pending")->status);
+}
+
+#ifndef G_OS_WIN32
+static const gchar *
+pick_address (void)
+{
+    struct sockaddr_in address;
+    socklen_t length = sizeof(address);
+    gint fd;
+
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    if (fd == -1 ||
+        bind(fd, (struct sockaddr *)&address, sizeof(address)) == -1 ||
+        getsockname(fd, (struct sockaddr *)&address, &length) == -1) {
+        if (fd != -1)
+            close(fd);
+        cut_omit("can't find a free port on localhost.");
+    }
+    close(fd);
+
+    return cut_take_printf("127.0.0.1:%d", ntohs(address.sin_port));
+}
+
+static void
+start_worker (const gchar *address)
+{
+    pid_t pid;
+
+    pid = fork();
+    if (pid == -1)
+        cut_omit("can't fork a shard worker.");
+
+    if (pid == 0) {
+        CutRunContext *worker_context;
+        gboolean success;
+
+        worker_context = CUT_RUN_CONTEXT(cut_test_runner_new());
+        cut_run_context_set_shard_connect(worker_context, address);
+        success =
+            cut_test_runner_run_test_suite(CUT_TEST_RUNNER(worker_context),
+                                           test_suite);
+        _exit(success ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    worker_pids = g_list_prepend(worker_pids, GINT_TO_POINTER(pid));
+}
+
+static gboolean
+connect_with_handshake (const gchar *address, const gchar *handshake)
+{
+    struct sockaddr_in socket_address;
+    const gchar *port;
+    gchar reply;
+    gint fd;
+    gssize size;
+
+    port = strrchr(address, ':') + 1;
+    memset(&socket_address, 0, sizeof(socket_address));
+    socket_address.sin_family = AF_INET;
+    socket_address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socket_address.sin_port = htons(atoi(port));
+
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    while (connect(fd, (struct sockaddr *)&socket_address,
+                   sizeof(socket_address)) == -1) {
+        g_usleep(G_USEC_PER_SEC / 10);
+    }
+    write(fd, handshake, strlen(handshake));
+    /* A refused worker is disconnected without any reply. */
+    size = read(fd, &reply, 1);
+    close(fd);
+
+    return size == 0;
+}
+
+static void
+start_refused_worker (const gchar *address)
+{
+    pid_t pid;
+
+    pid = fork();
+    if (pid == -1)
+        cut_omit("can't fork a shard worker.");
+
+    if (pid == 0) {
+        CutRunContext *worker_context;
+        gboolean refused;
+
+        refused = connect_with_handshake(address,
+                                         "cutter-shard\tunknown\twrong\n");
+
+        /* A worker with the same token runs test cases after that. */
+        worker_context = CUT_RUN_CONTEXT(cut_test_runner_new());
+        cut_run_context_set_shard_connect(worker_context, address);
+        cut_test_runner_run_test_suite(CUT_TEST_RUNNER(worker_context),
+                                       test_suite);
+        _exit(refused ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    worker_pids = g_list_prepend(worker_pids, GINT_TO_POINTER(pid));
+}
+
+static gboolean
+run_shard (void)
+{
+    const gchar *address;
+
+    address = pick_address();
+    cut_run_context_set_n_processes(run_context, 0);
+    cut_run_context_set_shard_listen(run_context, address);
+    start_worker(address);
+    start_worker(address);
+
+    return run();
+}
+#endif
+
+void
+test_shard (void)
+{
+#ifdef G_OS_WIN32
+    cut_omit("shard isn't available on Windows.");
+#else
+    test_case = cut_test_case_new("success-test-case1", NULL, NULL,
+                                  NULL, NULL);
+    cuttest_add_test(test_case, "test_success1", stub_success_test);
+    cuttest_add_test(test_case, "test_success2", stub_success_test);
+    cut_test_suite_add_test_case(test_suite, test_case);
+    g_object_unref(test_case);
+
+    test_case = cut_test_case_new("success-test-case2", NULL, NULL,
+                                  NULL, NULL);
+    cuttest_add_test(test_case, "test_success3", stub_success_test);
+    cut_test_suite_add_test_case(test_suite, test_case);
+
+    cut_assert_true(run_shard());
+    cut_assert_equal_uint(3, cut_run_context_get_n_tests(run_context));
+    cut_assert_equal_uint(3, cut_run_context_get_n_successes(run_context));
+#endif
+}
+
+void
+test_shard_crash (void)
+{
+#ifdef G_OS_WIN32
+    cut_omit("shard isn't available on Windows.");
+#else
+    test_case = cut_test_case_new("crash-test-case", NULL, NULL,
+                                  NULL, NULL);
+    cuttest_add_test(test_case, "test_success1", stub_success_test);
+    cuttest_add_test(test_case, "test_crash", stub_crash_test);
+    cuttest_add_test(test_case, "test_success2", stub_success_test);
+    cut_test_suite_add_test_case(test_suite, test_case);
+
+    cut_assert_false(run_shard());
+    cut_assert_equal_uint(3, cut_run_context_get_n_tests(run_context));
+    cut_assert_equal_uint(2, cut_run_context_get_n_successes(run_context));
+    cut_assert_true(cut_run_context_is_crashed(run_context));
+#endif
+}
+
+void
+test_shard_refuse (void)
+{
+#ifdef G_OS_WIN32
+    cut_omit("shard isn't available on Windows.");
+#else
+    const gchar *address;
+    pid_t pid;
+    gint status = 0;
+
+    test_case = cut_test_case_new("success-test-case", NULL, NULL,
+                                  NULL, NULL);
+    cuttest_add_test(test_case, "test_success", stub_success_test);
+    cut_test_suite_add_test_case(test_suite, test_case);
+
+    g_setenv("CUT_SHARD_TOKEN", "secret", TRUE);
+    address = pick_address();
+    cut_run_context_set_n_processes(run_context, 0);
+    cut_run_context_set_shard_listen(run_context, address);
+    start_refused_worker(address);
+
+    cut_assert_true(run());
+    cut_assert_equal_uint(1, cut_run_context_get_n_tests(run_context));
+
+    pid = GPOINTER_TO_INT(worker_pids->data);
+    cut_assert_equal_int(pid, waitpid(pid, &status, 0));
+    worker_pids = g_list_delete_link(worker_pids, worker_pids);
+    cut_assert_true(WIFEXITED(status));
+    cut_assert_equal_int(EXIT_SUCCESS, WEXITSTATUS(status));
+#endif
+}
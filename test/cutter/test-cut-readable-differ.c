@@ -2,6 +2,7 @@
 
 #include <gcutter.h>
 #include <cutter/cut-readable-differ.h>
+#include <cutter/cut-string-diff-writer.h>
 
 void test_same_contents_readable_diff(void);
 void test_inserted_readable_diff(void);
@@ -14,6 +15,8 @@ void test_empty_readable_diff(void);
 void test_tab_readable_diff(void);
 void test_is_interested (void);
 void test_need_fold (void);
+void test_myers_readable_diff (void);
+void test_summary (void);
 
 #define cut_assert_readable_diff(expected, from, to)    \
     cut_assert_equal_string_with_free(expected, cut_diff_readable(from, to))
@@ -302,6 +305,76 @@ test_need_fold (void)
                                        "\n");
 }
 
+static gchar *
+diff_readable_by_myers (const gchar *from, const gchar *to)
+{
+    CutDiffWriter *writer;
+    CutDiffer *differ;
+    gchar *diff;
+
+    differ = cut_readable_differ_new(from, to);
+    cut_differ_set_algorithm(differ, CUT_SEQUENCE_MATCH_ALGORITHM_MYERS);
+    writer = cut_string_diff_writer_new();
+    cut_differ_diff(differ, writer);
+    diff = g_strdup(cut_string_diff_writer_get_result(writer));
+    g_object_unref(writer);
+    g_object_unref(differ);
+
+    return diff;
+}
+
+void
+test_myers_readable_diff (void)
+{
+    const gchar *from, *to;
+
+    from =
+        "aaa\n"
+        "bbb\n"
+        "ccc\n"
+        "ddd\n"
+        "efg";
+    to =
+        "aaa\n"
+        "BbB\n"
+        "ccc\n"
+        "eg";
+    cut_assert_equal_string_with_free(cut_take_string(cut_diff_readable(from,
+                                                                        to)),
+                                      diff_readable_by_myers(from, to));
+}
+
+void
+test_summary (void)
+{
+    cut_assert_equal_string(NULL,
+                            cut_take_string(cut_diff_readable_summary("abc",
+                                                                      "abc")));
+    cut_assert_equal_string("first difference at line 1, column 4\n"
+                            "- abc\n"
+                            "+ abcd",
+                            cut_take_string(cut_diff_readable_summary("abc",
+                                                                      "abcd")));
+    cut_assert_equal_string("first difference at line 2, column 2\n"
+                            "- あい\n"
+                            "+ あう",
+                            cut_take_string(cut_diff_readable_summary("x\nあい",
+                                                                      "x\nあう")));
+    cut_assert_equal_string("first difference at line 1, column 41\n"
+                            "- ..."
+                            "0123456789012345678901234567890123456789"
+                            "012345678901234567890123456789"
+                            "...\n"
+                            "+ ...012345678901234567890123456789X",
+                            cut_take_string(
+                                cut_diff_readable_summary(
+                                    "0123456789012345678901234567890123456789"
+                                    "0123456789012345678901234567890123456789"
+                                    "0123456789012345678901234567890123456789",
+                                    "0123456789012345678901234567890123456789"
+                                    "X")));
+}
+
 /*
 vi:ts=4:nowrap:ai:expandtab:sw=4
 */
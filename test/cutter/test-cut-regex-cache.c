@@ -0,0 +1,133 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gcutter.h>
+#include <cutter/cut-regex-cache.h>
+
+void test_get (void);
+void test_get_invalid_pattern (void);
+void test_compile_options (void);
+void test_match (void);
+void test_least_recently_used (void);
+void test_disable (void);
+
+static guint max_size;
+static GRegex *regex1;
+static GRegex *regex2;
+static GError *error;
+
+void
+cut_setup (void)
+{
+    max_size = cut_regex_cache_get_max_size();
+    cut_regex_cache_clear();
+    regex1 = NULL;
+    regex2 = NULL;
+    error = NULL;
+}
+
+void
+cut_teardown (void)
+{
+    if (regex1)
+        g_regex_unref(regex1);
+    if (regex2)
+        g_regex_unref(regex2);
+    if (error)
+        g_error_free(error);
+    cut_regex_cache_set_max_size(max_size);
+    cut_regex_cache_clear();
+}
+
+void
+test_get (void)
+{
+    regex1 = cut_regex_cache_get("^a+$", 0, &error);
+    gcut_assert_error(error);
+    regex2 = cut_regex_cache_get("^a+$", 0, &error);
+    gcut_assert_error(error);
+    cut_assert_equal_pointer(regex1, regex2);
+    cut_assert_equal_uint(1, cut_regex_cache_get_size());
+}
+
+void
+test_get_invalid_pattern (void)
+{
+    regex1 = cut_regex_cache_get("(", 0, &error);
+    cut_assert_null(regex1);
+    cut_assert_not_null(error);
+    cut_assert_equal_uint(0, cut_regex_cache_get_size());
+}
+
+void
+test_compile_options (void)
+{
+    regex1 = cut_regex_cache_get("^a$", 0, NULL);
+    regex2 = cut_regex_cache_get("^a$", G_REGEX_MULTILINE, NULL);
+    cut_assert_true(regex1 != regex2);
+    cut_assert_equal_uint(2, cut_regex_cache_get_size());
+}
+
+void
+test_match (void)
+{
+    cut_assert_true(cut_regex_cache_match("^b", G_REGEX_MULTILINE, "a\nb"));
+    cut_assert_false(cut_regex_cache_match("^b", 0, "a\nb"));
+    cut_assert_false(cut_regex_cache_match("(", 0, "("));
+}
+
+void
+test_least_recently_used (void)
+{
+    cut_regex_cache_set_max_size(2);
+
+    regex1 = cut_regex_cache_get("a", 0, NULL);
+    cut_assert_true(cut_regex_cache_match("b", 0, "b"));
+    regex2 = cut_regex_cache_get("a", 0, NULL);
+    cut_assert_equal_pointer(regex1, regex2);
+    g_regex_unref(regex2);
+
+    cut_assert_true(cut_regex_cache_match("c", 0, "c"));
+    cut_assert_equal_uint(2, cut_regex_cache_get_size());
+    regex2 = cut_regex_cache_get("a", 0, NULL);
+    cut_assert_equal_pointer(regex1, regex2);
+    g_regex_unref(regex2);
+
+    cut_assert_true(cut_regex_cache_match("d", 0, "d"));
+    regex2 = cut_regex_cache_get("c", 0, NULL);
+    cut_assert_equal_uint(2, cut_regex_cache_get_size());
+    g_regex_unref(regex2);
+    regex2 = cut_regex_cache_get("a", 0, NULL);
+    cut_assert_true(regex1 != regex2);
+}
+
+void
+test_disable (void)
+{
+    cut_regex_cache_set_max_size(0);
+
+    regex1 = cut_regex_cache_get("a", 0, NULL);
+    regex2 = cut_regex_cache_get("a", 0, NULL);
+    cut_assert_true(regex1 != regex2);
+    cut_assert_equal_uint(0, cut_regex_cache_get_size());
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
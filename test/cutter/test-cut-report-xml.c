@@ -16,24 +16,45 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <cutter.h>
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif /* HAVE_CONFIG_H */
+
+#ifdef HAVE_UNISTD_H
+#  include <unistd.h>
+#endif
+
+#include <gcutter.h>
 #include <cutter/cut-test-runner.h>
 #include <cutter/cut-listener.h>
 #include <cutter/cut-report.h>
 #include "../lib/cuttest-utils.h"
 
+#if !GLIB_CHECK_VERSION(2, 32, 0)
+#  define g_thread_try_new(name, func, data, error) \
+    g_thread_create(func, data, TRUE, error)
+#endif
+
+#define N_OUTPUT_THREADS 4
+#define N_OUTPUT_RESULTS 100
+
 void test_report_success (void);
 void test_report_failure (void);
 void test_report_error (void);
 void test_report_pending (void);
 void test_report_notification (void);
 void test_plural_reports (void);
+void test_output_to_file (void);
+void test_output_in_forked_process (void);
+void test_output_from_threads (void);
 
 static CutRunContext *run_context;
 static CutReport *report;
 static CutTest *test;
 static CutTestCase *test_case;
 static CutTestContext *test_context;
+static CutReport *file_report;
+static gchar *tmp_dir;
 
 static gint fail_line;
 
@@ -84,6 +105,10 @@ cut_setup (void)
     const gchar *test_names[] = {"/.*/", NULL};
     test = NULL;
     test_context = NULL;
+    file_report = NULL;
+
+    tmp_dir = g_build_filename(cuttest_get_base_dir(), "tmp", NULL);
+    cut_remove_path(tmp_dir, NULL);
 
     run_context = CUT_RUN_CONTEXT(cut_test_runner_new());
     cut_run_context_set_target_test_names(run_context, test_names);
@@ -104,7 +129,15 @@ cut_teardown (void)
         g_object_unref(test_context);
     cut_listener_detach_from_run_context(CUT_LISTENER(report), run_context);
     g_object_unref(report);
+    if (file_report) {
+        cut_listener_detach_from_run_context(CUT_LISTENER(file_report),
+                                             run_context);
+        g_object_unref(file_report);
+    }
     g_object_unref(run_context);
+
+    cut_remove_path(tmp_dir, NULL);
+    g_free(tmp_dir);
 }
 
 static void
@@ -478,6 +511,156 @@ test_plural_reports (void)
     cut_assert_equal_string(expected, normalized_result);
 }
 
+void
+test_output_to_file (void)
+{
+    const gchar *filename;
+    CutTestResult *crash_result;
+    gchar *contents;
+    GError *error = NULL;
+
+    if (g_mkdir_with_parents(tmp_dir, 0700) == -1)
+        cut_error_errno();
+    filename = cut_take_string(g_build_filename(tmp_dir, "report.xml", NULL));
+    file_report = cut_report_new("xml", "filename", filename, NULL);
+    cut_listener_attach_to_run_context(CUT_LISTENER(file_report), run_context);
+
+    g_signal_emit_by_name(run_context, "start-test-suite", NULL);
+    test = cut_test_new("stub-success-test", stub_success_test);
+    cut_test_case_add_test(test_case, test);
+    cut_assert_true(run());
+
+    crash_result = cut_test_result_new(CUT_TEST_RESULT_CRASH,
+                                       NULL, NULL, NULL, NULL, NULL,
+                                       NULL, NULL, NULL);
+    gcut_take_object(G_OBJECT(crash_result));
+    g_signal_emit_by_name(run_context, "crash-test-suite", NULL, crash_result);
+
+    g_file_get_contents(filename, &contents, NULL, &error);
+    gcut_assert_error(error);
+    cut_take_string(contents);
+    cut_assert_match("\\A<report>\n"
+                     "  <result>\n"
+                     "(?s:.*)"
+                     "    <status>success</status>\n"
+                     "(?s:.*)"
+                     "  </result>\n\\z",
+                     contents);
+
+    g_signal_emit_by_name(run_context, "complete-test-suite", NULL, FALSE);
+    g_file_get_contents(filename, &contents, NULL, &error);
+    gcut_assert_error(error);
+    cut_take_string(contents);
+    cut_assert_match("  </result>\n</report>\\z", contents);
+}
+
+void
+test_output_in_forked_process (void)
+{
+    const gchar *filename;
+    gchar *contents;
+    gchar **results;
+    GError *error = NULL;
+    int pid;
+
+#ifdef G_OS_WIN32
+    cut_omit("fork() isn't available on Windows.");
+#endif
+
+    if (g_mkdir_with_parents(tmp_dir, 0700) == -1)
+        cut_error_errno();
+    filename = cut_take_string(g_build_filename(tmp_dir, "report.xml", NULL));
+    file_report = cut_report_new("xml", "filename", filename, NULL);
+    cut_listener_attach_to_run_context(CUT_LISTENER(file_report), run_context);
+
+    g_signal_emit_by_name(run_context, "start-test-suite", NULL);
+    test = cut_test_new("stub-success-test", stub_success_test);
+    cut_test_case_add_test(test_case, test);
+    cut_assert_true(run());
+
+    /* The result is still in the buffer. A forked process must
+     * not write it again. */
+    pid = cut_fork();
+    cut_assert_errno();
+    if (pid == 0) {
+        cut_listener_detach_from_run_context(CUT_LISTENER(file_report),
+                                             run_context);
+        _exit(EXIT_SUCCESS);
+    }
+    cut_assert_equal_int(EXIT_SUCCESS, cut_wait_process(pid, 1000));
+
+    g_signal_emit_by_name(run_context, "complete-test-suite", NULL, FALSE);
+    g_file_get_contents(filename, &contents, NULL, &error);
+    gcut_assert_error(error);
+    cut_take_string(contents);
+    results = g_strsplit(contents, "<result>", -1);
+    cut_take_string_array(results);
+    cut_assert_equal_uint(2, g_strv_length(results));
+}
+
+static gpointer
+emit_success_results (gpointer data)
+{
+    CutTestResult *result = data;
+    gint i;
+
+    for (i = 0; i < N_OUTPUT_RESULTS; i++) {
+        g_signal_emit_by_name(run_context, "success-test",
+                              test, NULL, result);
+    }
+
+    return NULL;
+}
+
+void
+test_output_from_threads (void)
+{
+    const gchar *filename;
+    CutTestResult *result;
+    GThread *threads[N_OUTPUT_THREADS];
+    gchar *contents;
+    gchar **results;
+    GError *error = NULL;
+    gint i;
+
+    if (g_mkdir_with_parents(tmp_dir, 0700) == -1)
+        cut_error_errno();
+    filename = cut_take_string(g_build_filename(tmp_dir, "report.xml", NULL));
+    file_report = cut_report_new("xml", "filename", filename, NULL);
+    cut_listener_attach_to_run_context(CUT_LISTENER(file_report), run_context);
+
+    test = cut_test_new("stub-success-test", stub_success_test);
+    result = cut_test_result_new(CUT_TEST_RESULT_SUCCESS,
+                                 test, NULL, test_case, NULL, NULL,
+                                 NULL, NULL, NULL);
+    gcut_take_object(G_OBJECT(result));
+
+    /* Results are written from some threads at once with
+     * --multi-thread. Each of them must be written as is. */
+    g_signal_emit_by_name(run_context, "start-test-suite", NULL);
+    for (i = 0; i < N_OUTPUT_THREADS; i++) {
+        threads[i] = g_thread_try_new(NULL, emit_success_results, result,
+                                      &error);
+        gcut_assert_error(error);
+    }
+    for (i = 0; i < N_OUTPUT_THREADS; i++) {
+        g_thread_join(threads[i]);
+    }
+    g_signal_emit_by_name(run_context, "complete-test-suite", NULL, TRUE);
+
+    g_file_get_contents(filename, &contents, NULL, &error);
+    gcut_assert_error(error);
+    cut_take_string(contents);
+    cut_assert_match("\\A<report>\n"
+                     "(?:  <result>\n(?:    .*\n)*?  </result>\n)*"
+                     "</report>\\z",
+                     contents);
+    results = g_strsplit(contents, "<result>", -1);
+    cut_take_string_array(results);
+    cut_assert_equal_uint(N_OUTPUT_THREADS * N_OUTPUT_RESULTS + 1,
+                          g_strv_length(results));
+}
+
 /*
 vi:ts=4:nowrap:ai:expandtab:sw=4
 */
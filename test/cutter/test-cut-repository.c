@@ -10,6 +10,7 @@
 #include "../lib/cuttest-utils.h"
 
 void test_create_test_suite (void);
+void test_create_test_suite_with_threads (void);
 
 static CutRepository *test_repository;
 
@@ -79,6 +80,33 @@ test_create_test_suite (void)
     g_object_unref(suite);
 }
 
+void
+test_create_test_suite_with_threads (void)
+{
+    CutTestSuite *suite;
+    CutTestContainer *container;
+    const GList *test_cases, *list;
+    gint i;
+
+    cut_repository_set_max_threads(test_repository, 4);
+    suite = cut_repository_create_test_suite(test_repository);
+    cut_assert(suite);
+
+    container = CUT_TEST_CONTAINER(suite);
+    test_cases = cut_test_container_get_children(container);
+    cut_assert_not_null(test_cases);
+
+    for (list = test_cases, i = 0; list; list = g_list_next(list), i++) {
+        cut_assert(i < n_expected_test_case_names);
+        cut_assert(CUT_IS_TEST_CASE(list->data));
+        cut_assert_equal_string(expected_test_case_name[i],
+                                cut_test_get_name(CUT_TEST(list->data)));
+    }
+    cut_assert_equal_int(n_expected_test_case_names, i);
+
+    g_object_unref(suite);
+}
+
 /*
 vi:nowrap:ai:expandtab:sw=4
 */
@@ -0,0 +1,316 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <stdio.h>
+
+#include <gcutter.h>
+#include <cutter/cut-run-history.h>
+#include "../lib/cuttest-utils.h"
+
+void test_build_directory (void);
+void test_empty (void);
+void test_append_run (void);
+void test_worst_status (void);
+void test_regex_pattern (void);
+void test_uncommitted_run (void);
+void test_failing_since (void);
+void test_not_failing (void);
+void test_slower_since (void);
+void test_not_slower (void);
+
+static gchar *tmp_dir;
+static gchar *history_dir;
+static CutRunHistory *history;
+static GList *tests;
+static CutRunHistoryTest *test;
+
+void
+cut_setup (void)
+{
+    tmp_dir = g_build_filename(cuttest_get_base_dir(), "tmp", NULL);
+    cut_remove_path(tmp_dir, NULL);
+    history_dir = g_build_filename(tmp_dir, "history", NULL);
+    history = NULL;
+    tests = NULL;
+    test = NULL;
+}
+
+void
+cut_teardown (void)
+{
+    if (history)
+        cut_run_history_free(history);
+    g_list_foreach(tests, (GFunc)cut_run_history_test_free, NULL);
+    g_list_free(tests);
+    if (test)
+        cut_run_history_test_free(test);
+
+    cut_remove_path(tmp_dir, NULL);
+    g_free(history_dir);
+    g_free(tmp_dir);
+}
+
+static void
+open_history (void)
+{
+    GError *error = NULL;
+
+    if (history)
+        cut_run_history_free(history);
+    history = cut_run_history_new(history_dir);
+    cut_run_history_load(history, &error);
+    gcut_assert_error(error);
+}
+
+static void
+append_run (gint64 time)
+{
+    GError *error = NULL;
+
+    cut_run_history_append_run(history, time, &error);
+    gcut_assert_error(error);
+}
+
+static void
+query (const gchar *pattern)
+{
+    GError *error = NULL;
+
+    g_list_foreach(tests, (GFunc)cut_run_history_test_free, NULL);
+    g_list_free(tests);
+    tests = cut_run_history_query(history, pattern, &error);
+    gcut_assert_error(error);
+}
+
+static CutRunHistoryEntry *
+get_entry (CutRunHistoryTest *history_test, guint i)
+{
+    return &g_array_index(history_test->entries, CutRunHistoryEntry, i);
+}
+
+void
+test_build_directory (void)
+{
+    cut_assert_equal_string(
+        cut_take_string(g_build_filename("cache", "history",
+                                         "_home_user_test.history",
+                                         NULL)),
+        cut_take_string(cut_run_history_build_directory("cache",
+                                                        "/home/user/test")));
+}
+
+void
+test_empty (void)
+{
+    open_history();
+    cut_assert_equal_uint(0, cut_run_history_get_n_runs(history));
+    query("test_a");
+    cut_assert_null(tests);
+}
+
+void
+test_append_run (void)
+{
+    CutRunHistoryTest *history_test;
+
+    open_history();
+    cut_run_history_record(history, "test_case", "test_a",
+                           CUT_TEST_RESULT_SUCCESS, 0.5);
+    cut_run_history_record(history, "test_case", "test_b",
+                           CUT_TEST_RESULT_FAILURE, 0.25);
+    append_run(100);
+    cut_run_history_record(history, "test_case", "test_a",
+                           CUT_TEST_RESULT_ERROR, 1.5);
+    append_run(200);
+
+    open_history();
+    cut_assert_equal_uint(2, cut_run_history_get_n_runs(history));
+    query("test_a");
+    cut_assert_equal_uint(1, g_list_length(tests));
+    history_test = tests->data;
+    cut_assert_equal_string("test_case", history_test->test_case_name);
+    cut_assert_equal_string("test_a", history_test->test_name);
+    cut_assert_equal_uint(2, history_test->entries->len);
+
+    cut_assert_equal_uint(0, get_entry(history_test, 0)->run);
+    cut_assert_equal_int(100, get_entry(history_test, 0)->time);
+    cut_assert_equal_int(CUT_TEST_RESULT_SUCCESS,
+                         get_entry(history_test, 0)->status);
+    cut_assert_equal_double(0.5, 0.001, get_entry(history_test, 0)->elapsed);
+
+    cut_assert_equal_uint(1, get_entry(history_test, 1)->run);
+    cut_assert_equal_int(200, get_entry(history_test, 1)->time);
+    cut_assert_equal_int(CUT_TEST_RESULT_ERROR,
+                         get_entry(history_test, 1)->status);
+    cut_assert_equal_double(1.5, 0.001, get_entry(history_test, 1)->elapsed);
+}
+
+void
+test_worst_status (void)
+{
+    CutRunHistoryTest *history_test;
+
+    open_history();
+    cut_run_history_record(history, "test_case", "test_a",
+                           CUT_TEST_RESULT_NOTIFICATION, 0.5);
+    cut_run_history_record(history, "test_case", "test_a",
+                           CUT_TEST_RESULT_FAILURE, 0.25);
+    cut_run_history_record(history, "test_case", "test_a",
+                           CUT_TEST_RESULT_SUCCESS, 0.75);
+    append_run(100);
+
+    query("test_a");
+    cut_assert_equal_uint(1, g_list_length(tests));
+    history_test = tests->data;
+    cut_assert_equal_uint(1, history_test->entries->len);
+    cut_assert_equal_int(CUT_TEST_RESULT_FAILURE,
+                         get_entry(history_test, 0)->status);
+    cut_assert_equal_double(0.75, 0.001, get_entry(history_test, 0)->elapsed);
+}
+
+void
+test_regex_pattern (void)
+{
+    open_history();
+    cut_run_history_record(history, "test_case", "test_parse_a",
+                           CUT_TEST_RESULT_SUCCESS, 0.1);
+    cut_run_history_record(history, "test_case", "test_parse_b",
+                           CUT_TEST_RESULT_SUCCESS, 0.1);
+    cut_run_history_record(history, "test_case", "test_write",
+                           CUT_TEST_RESULT_SUCCESS, 0.1);
+    append_run(100);
+
+    query("/^test_parse/");
+    cut_assert_equal_uint(2, g_list_length(tests));
+    cut_assert_equal_string("test_parse_a",
+                            ((CutRunHistoryTest *)tests->data)->test_name);
+    cut_assert_equal_string(
+        "test_parse_b",
+        ((CutRunHistoryTest *)g_list_nth_data(tests, 1))->test_name);
+}
+
+void
+test_uncommitted_run (void)
+{
+    CutRunHistoryTest *history_test;
+    gchar *name_ids_path;
+    FILE *name_ids;
+
+    open_history();
+    cut_run_history_record(history, "test_case", "test_a",
+                           CUT_TEST_RESULT_SUCCESS, 0.1);
+    append_run(100);
+
+    /* A run that is interrupted before its "runs" record. */
+    name_ids_path = cut_take_string(g_build_filename(history_dir, "name-ids",
+                                                     NULL));
+    name_ids = fopen(name_ids_path, "ab");
+    cut_assert_not_null(name_ids);
+    fwrite("\xff\xff\xff\xff", 1, 4, name_ids);
+    fclose(name_ids);
+
+    open_history();
+    query("test_a");
+    history_test = tests->data;
+    cut_assert_equal_uint(1, history_test->entries->len);
+
+    cut_run_history_record(history, "test_case", "test_a",
+                           CUT_TEST_RESULT_FAILURE, 0.2);
+    append_run(200);
+
+    open_history();
+    query("test_a");
+    history_test = tests->data;
+    cut_assert_equal_uint(2, history_test->entries->len);
+    cut_assert_equal_int(CUT_TEST_RESULT_FAILURE,
+                         get_entry(history_test, 1)->status);
+}
+
+static void
+setup_test (const CutTestResultStatus *statuses, const gdouble *elapsed,
+            guint n_entries)
+{
+    guint i;
+
+    test = g_new0(CutRunHistoryTest, 1);
+    test->test_case_name = g_strdup("test_case");
+    test->test_name = g_strdup("test_a");
+    test->entries = g_array_new(FALSE, FALSE, sizeof(CutRunHistoryEntry));
+    for (i = 0; i < n_entries; i++) {
+        CutRunHistoryEntry entry;
+
+        entry.run = i;
+        entry.time = i * 100;
+        entry.status = statuses ? statuses[i] : CUT_TEST_RESULT_SUCCESS;
+        entry.elapsed = elapsed ? elapsed[i] : 0.1;
+        g_array_append_val(test->entries, entry);
+    }
+}
+
+void
+test_failing_since (void)
+{
+    const CutTestResultStatus statuses[] = {
+        CUT_TEST_RESULT_SUCCESS,
+        CUT_TEST_RESULT_FAILURE,
+        CUT_TEST_RESULT_SUCCESS,
+        CUT_TEST_RESULT_ERROR,
+        CUT_TEST_RESULT_FAILURE,
+    };
+
+    setup_test(statuses, NULL, G_N_ELEMENTS(statuses));
+    cut_assert_equal_int(3, cut_run_history_test_get_failing_since(test));
+}
+
+void
+test_not_failing (void)
+{
+    const CutTestResultStatus statuses[] = {
+        CUT_TEST_RESULT_FAILURE,
+        CUT_TEST_RESULT_PENDING,
+    };
+
+    setup_test(statuses, NULL, G_N_ELEMENTS(statuses));
+    cut_assert_equal_int(-1, cut_run_history_test_get_failing_since(test));
+}
+
+void
+test_slower_since (void)
+{
+    const gdouble elapsed[] = {0.1, 0.12, 0.1, 0.5, 0.48, 0.5};
+
+    setup_test(NULL, elapsed, G_N_ELEMENTS(elapsed));
+    cut_assert_equal_int(3,
+                         cut_run_history_test_get_slower_since(test, 20.0));
+}
+
+void
+test_not_slower (void)
+{
+    const gdouble elapsed[] = {0.1, 0.11, 0.1, 0.105, 0.1};
+
+    setup_test(NULL, elapsed, G_N_ELEMENTS(elapsed));
+    cut_assert_equal_int(-1,
+                         cut_run_history_test_get_slower_since(test, 20.0));
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
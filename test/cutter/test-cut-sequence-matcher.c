@@ -39,6 +39,9 @@ void test_get_grouped_operations(void);
 void test_get_ratio_for_string_sequence(void);
 void test_get_ratio_for_char_sequence(void);
 void test_set_context_size(void);
+void test_get_matches_by_myers_for_string_sequence(void);
+void test_get_matches_by_myers_for_char_sequence(void);
+void test_algorithm_for_large_sequence(void);
 
 static CutSequenceMatcher *matcher;
 static GList *expected_indexes;
@@ -1101,6 +1104,90 @@ test_set_context_size (void)
                                   inspect_string_matcher(alnum, alnum_garbage));
 }
 
+static CutSequenceMatcher *
+myers_matcher_new (CutSequenceMatcher *sequence_matcher)
+{
+    cut_sequence_matcher_set_algorithm(sequence_matcher,
+                                       CUT_SEQUENCE_MATCH_ALGORITHM_MYERS);
+    return sequence_matcher;
+}
+
+void
+test_get_matches_by_myers_for_string_sequence (void)
+{
+    gchar *abxcd[] = {"a", "b", "x", "c", "d", NULL};
+    gchar *abcd[] = {"a", "b", "c", "d", NULL};
+    gchar *qabxcd[] = {"q", "a", "b", "x", "c", "d", NULL};
+    gchar *abycdf[] = {"a", "b", "y", "c", "d", "f", NULL};
+    gchar *efg[] = {"e", "f", "g", NULL};
+    gchar *eg[] = {"e", "g", NULL};
+
+    expected_matches = append_match_info(NULL, 0, 0, 2);
+    expected_matches = append_match_info(expected_matches, 3, 2, 2);
+    cut_assert_matches(expected_matches,
+                       myers_matcher_new(string_matcher_new(abxcd, abcd)),
+                       inspect_string_matcher(abxcd, abcd));
+    free_matches(expected_matches);
+
+    expected_matches = append_match_info(NULL, 1, 0, 2);
+    expected_matches = append_match_info(expected_matches, 4, 3, 2);
+    cut_assert_matches(expected_matches,
+                       myers_matcher_new(string_matcher_new(qabxcd, abycdf)),
+                       inspect_string_matcher(qabxcd, abycdf));
+    free_matches(expected_matches);
+
+    expected_matches = append_match_info(NULL, 0, 0, 1);
+    expected_matches = append_match_info(expected_matches, 2, 1, 1);
+    cut_assert_matches(expected_matches,
+                       myers_matcher_new(string_matcher_new(efg, eg)),
+                       inspect_string_matcher(efg, eg));
+}
+
+void
+test_get_matches_by_myers_for_char_sequence (void)
+{
+    expected_matches = append_match_info(NULL, 0, 0, 2);
+    expected_matches = append_match_info(expected_matches, 3, 2, 2);
+    cut_assert_matches(expected_matches,
+                       myers_matcher_new(char_matcher_new("abxcd", "abcd")),
+                       inspect_char_matcher("abxcd", "abcd"));
+    free_matches(expected_matches);
+
+    expected_matches = NULL;
+    cut_assert_matches(expected_matches,
+                       myers_matcher_new(char_matcher_new("abc", "xyz")),
+                       inspect_char_matcher("abc", "xyz"));
+}
+
+void
+test_algorithm_for_large_sequence (void)
+{
+    GString *from, *to;
+    const gchar *large_from, *large_to;
+    gint i;
+
+    from = g_string_new(NULL);
+    to = g_string_new(NULL);
+    for (i = 0; i < CUT_SEQUENCE_MATCHER_MYERS_THRESHOLD; i++) {
+        g_string_append_c(from, 'a' + i % 26);
+        g_string_append_c(to, 'a' + (i + 1) % 26);
+    }
+    large_from = cut_take_string(g_string_free(from, FALSE));
+    large_to = cut_take_string(g_string_free(to, FALSE));
+
+    matcher = cut_sequence_matcher_char_new("abc", "abd");
+    cut_assert_equal_int(CUT_SEQUENCE_MATCH_ALGORITHM_LONGEST_MATCH,
+                         cut_sequence_matcher_get_algorithm(matcher));
+    g_object_unref(matcher);
+    matcher = NULL;
+
+    matcher = cut_sequence_matcher_char_new(large_from, large_to);
+    cut_assert_equal_int(CUT_SEQUENCE_MATCH_ALGORITHM_MYERS,
+                         cut_sequence_matcher_get_algorithm(matcher));
+    cut_assert_equal_double(1.0, 0.01,
+                            cut_sequence_matcher_get_ratio(matcher));
+}
+
 /*
 vi:ts=4:nowrap:ai:expandtab:sw=4
 */
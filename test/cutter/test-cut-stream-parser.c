@@ -20,6 +20,7 @@
 #include <gcutter.h>
 #include <cutter/cut-stream-parser.h>
 #include <cutter/cut-backtrace-entry.h>
+#include <cutter/cut-benchmark-result.h>
 #include "../lib/cuttest-event-receiver.h"
 
 void test_start_run (void);
@@ -38,6 +39,7 @@ void test_result_test_iterator (void);
 void test_result_test_case (void);
 void test_pass_assertion_test (void);
 void test_pass_assertion_iterated_test (void);
+void test_pass_assertions_test (void);
 void test_fail_assertion_test (void);
 void test_complete_iterated_test (void);
 void test_complete_test (void);
@@ -48,9 +50,11 @@ void test_complete_run_without_success_tag (void);
 void test_complete_run_with_success_true (void);
 void test_complete_run_with_success_false (void);
 void test_crash_test (void);
+void test_benchmark_test (void);
 
 static CutStreamParser *parser;
 static CutTestResult *result;
+static CutBenchmarkResult *benchmark_result;
 static CutRunContext *run_context;
 static CuttestEventReceiver *receiver;
 
@@ -61,6 +65,7 @@ cut_setup (void)
     receiver = CUTTEST_EVENT_RECEIVER(run_context);
     parser = cut_stream_parser_new(run_context);
     result = NULL;
+    benchmark_result = NULL;
 }
 
 void
@@ -71,6 +76,8 @@ cut_teardown (void)
 
     if (result)
         g_object_unref(result);
+    if (benchmark_result)
+        g_object_unref(benchmark_result);
 }
 
 #define cut_assert_parse(string) do                             \
@@ -1187,6 +1194,36 @@ test_pass_assertion_iterated_test (void)
     cut_assert_false(cut_test_context_is_failed(test_context));
 }
 
+void
+test_pass_assertions_test (void)
+{
+    const gchar xml[] =
+        "<stream>\n"
+        "  <pass-assertions>\n"
+        "    <test>\n"
+        "      <name>test_error_signal</name>\n"
+        "      <elapsed>0.000039</elapsed>\n"
+        "    </test>\n"
+        "    <test-context>\n"
+        "      <test-case>\n"
+        "        <name>test_cut_test</name>\n"
+        "        <elapsed>0.000062</elapsed>\n"
+        "      </test-case>\n"
+        "      <test>\n"
+        "        <name>test_error_signal</name>\n"
+        "        <elapsed>0.000077</elapsed>\n"
+        "      </test>\n"
+        "      <failed>FALSE</failed>\n"
+        "    </test-context>\n"
+        "    <n-assertions>5</n-assertions>\n"
+        "  </pass-assertions>\n";
+
+    cut_assert_equal_uint(0, cut_run_context_get_n_assertions(run_context));
+    cut_assert_parse(xml);
+    cut_assert_null(receiver->pass_assertions);
+    cut_assert_equal_uint(5, cut_run_context_get_n_assertions(run_context));
+}
+
 void
 test_fail_assertion_test (void)
 {
@@ -2074,6 +2111,69 @@ test_crash_test (void)
                          cut_test_result_get_status(result));
 }
 
+static void
+cb_benchmark_test (CutRunContext *run_context, CutTest *test,
+                   CutTestContext *test_context, CutBenchmarkResult *result,
+                   gpointer user_data)
+{
+    cut_assert_equal_string("bench_append", cut_test_get_name(test));
+    benchmark_result = g_object_ref(result);
+}
+
+void
+test_benchmark_test (void)
+{
+    gchar xml[] =
+        "<stream>\n"
+        "  <benchmark-test>\n"
+        "    <test>\n"
+        "      <name>bench_append</name>\n"
+        "    </test>\n"
+        "    <test-context>\n"
+        "      <test-case>\n"
+        "        <name>stub test case</name>\n"
+        "      </test-case>\n"
+        "      <test>\n"
+        "        <name>bench_append</name>\n"
+        "      </test>\n"
+        "      <failed>FALSE</failed>\n"
+        "    </test-context>\n"
+        "    <benchmark-result>\n"
+        "      <n-iterations>1024</n-iterations>\n"
+        "      <n-samples>10</n-samples>\n"
+        "      <mean>2.5e-06</mean>\n"
+        "      <median>2.25e-06</median>\n"
+        "      <standard-deviation>5e-07</standard-deviation>\n"
+        "      <minimum>2e-06</minimum>\n"
+        "      <maximum>4e-06</maximum>\n"
+        "      <operations-per-second>400000</operations-per-second>\n"
+        "    </benchmark-result>\n"
+        "  </benchmark-test>\n";
+
+    g_signal_connect(run_context, "benchmark-test",
+                     G_CALLBACK(cb_benchmark_test), NULL);
+    cut_assert_parse(xml);
+    g_signal_handlers_disconnect_by_func(run_context,
+                                         G_CALLBACK(cb_benchmark_test),
+                                         NULL);
+
+    cut_assert_not_null(benchmark_result);
+    cut_assert_equal_uint(1024,
+                          cut_benchmark_result_get_n_iterations(benchmark_result));
+    cut_assert_equal_uint(10,
+                          cut_benchmark_result_get_n_samples(benchmark_result));
+    cut_assert_equal_double(2.5e-06, 1e-12,
+                            cut_benchmark_result_get_mean(benchmark_result));
+    cut_assert_equal_double(2.25e-06, 1e-12,
+                            cut_benchmark_result_get_median(benchmark_result));
+    cut_assert_equal_double(5e-07, 1e-12,
+                            cut_benchmark_result_get_standard_deviation(benchmark_result));
+    cut_assert_equal_double(2e-06, 1e-12,
+                            cut_benchmark_result_get_minimum(benchmark_result));
+    cut_assert_equal_double(4e-06, 1e-12,
+                            cut_benchmark_result_get_maximum(benchmark_result));
+}
+
 /*
 vi:ts=4:nowrap:ai:expandtab:sw=4
 */
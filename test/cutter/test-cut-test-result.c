@@ -16,8 +16,12 @@ void test_status_is_critical(void);
 void test_get_test_suite(void);
 void test_get_diff(void);
 void test_set_diff(void);
+void test_get_diff_for_large_values(void);
+void test_get_explicit_values(void);
 void test_to_xml_empty(void);
 void test_to_xml_empty_failure(void);
+void test_to_xml_performance_counters(void);
+void test_to_xml_memory_usage(void);
 void test_new_from_xml(void);
 void test_new_from_xml_with_invalid_top_level_tag_name(void);
 void test_new_from_xml_with_invalid_line(void);
@@ -28,15 +32,21 @@ void test_new_from_xml_without_option_value(void);
 void test_new_from_xml_with_multiple_option_names(void);
 void test_new_from_xml_with_invalid_status(void);
 void test_new_from_xml_with_invalid_elapsed(void);
+void test_new_from_xml_with_performance_counters(void);
+void test_new_from_xml_with_invalid_performance_counter(void);
+void test_new_from_xml_with_memory_usage(void);
+void test_new_from_xml_with_invalid_memory_usage(void);
 
 static CutTestResult *result;
 static CutTestSuite *suite;
 static GError *error;
 static GList *backtrace;
+static gsize max_diff_target_size;
 
 void
 cut_setup (void)
 {
+    max_diff_target_size = cut_test_result_get_max_diff_target_size();
     result = NULL;
     suite = NULL;
     error = NULL;
@@ -51,6 +61,7 @@ cut_setup (void)
 void
 cut_teardown (void)
 {
+    cut_test_result_set_max_diff_target_size(max_diff_target_size);
     if (result)
         g_object_unref(result);
     if (suite)
@@ -389,6 +400,51 @@ test_set_diff (void)
     cut_assert_equal_string(NULL, cut_test_result_get_folded_diff(result));
 }
 
+void
+test_get_diff_for_large_values (void)
+{
+    cut_test_result_set_max_diff_target_size(5);
+
+    result = cut_test_result_new_empty();
+    cut_test_result_set_expected(result, "aaaa\nabcdef\nccc");
+    cut_test_result_set_actual(result, "aaaa\nabXdef\nccc");
+    cut_assert_equal_string("first difference at line 2, column 3\n"
+                            "- abcdef\n"
+                            "+ abXdef",
+                            cut_test_result_get_diff(result));
+    cut_assert_equal_string(NULL, cut_test_result_get_folded_diff(result));
+
+    cut_test_result_set_max_diff_target_size(0);
+    cut_test_result_set_actual(result, "aaaa\nabXdef\nccc");
+    cut_assert_equal_string("  aaaa\n"
+                            "- abcdef\n"
+                            "?   ^\n"
+                            "+ abXdef\n"
+                            "?   ^\n"
+                            "  ccc",
+                            cut_test_result_get_diff(result));
+}
+
+void
+test_get_explicit_values (void)
+{
+    result = cut_test_result_new_empty();
+    cut_test_result_set_expected(result, "a\nb\nc");
+    cut_test_result_set_actual(result, "a\nB\nc");
+    cut_assert_not_null(cut_test_result_get_message(result));
+    cut_assert_not_null(cut_test_result_get_diff(result));
+    cut_assert_equal_string(NULL, cut_test_result_get_explicit_message(result));
+    cut_assert_equal_string(NULL, cut_test_result_get_explicit_diff(result));
+    cut_assert_equal_string(NULL,
+                            cut_test_result_get_explicit_folded_diff(result));
+
+    cut_test_result_set_message(result, "message");
+    cut_test_result_set_diff(result, "diff");
+    cut_assert_equal_string("message",
+                            cut_test_result_get_explicit_message(result));
+    cut_assert_equal_string("diff", cut_test_result_get_explicit_diff(result));
+}
+
 void
 test_to_xml_empty (void)
 {
@@ -418,6 +474,62 @@ test_to_xml_empty_failure (void)
     cut_assert_equal_string_with_free(expected, cut_test_result_to_xml(result));
 }
 
+void
+test_to_xml_performance_counters (void)
+{
+    gchar expected[] =
+        "<result>\n"
+        "  <status>success</status>\n"
+        "  <start-time>1970-01-01T00:00:00Z</start-time>\n"
+        "  <elapsed>0.000000</elapsed>\n"
+        "  <performance-counters>\n"
+        "    <instructions>12345678901</instructions>\n"
+        "    <page-faults>0</page-faults>\n"
+        "  </performance-counters>\n"
+        "</result>\n";
+
+    result = cut_test_result_new_empty();
+    cut_assert_false(cut_test_result_has_performance_counters(result));
+    cut_test_result_set_performance_counter(result,
+                                            CUT_PERFORMANCE_COUNTER_INSTRUCTIONS,
+                                            G_GINT64_CONSTANT(12345678901));
+    cut_test_result_set_performance_counter(result,
+                                            CUT_PERFORMANCE_COUNTER_PAGE_FAULTS,
+                                            0);
+    cut_assert_true(cut_test_result_has_performance_counters(result));
+    cut_assert_equal_string_with_free(expected, cut_test_result_to_xml(result));
+}
+
+void
+test_to_xml_memory_usage (void)
+{
+    gchar expected[] =
+        "<result>\n"
+        "  <status>success</status>\n"
+        "  <start-time>1970-01-01T00:00:00Z</start-time>\n"
+        "  <elapsed>0.000000</elapsed>\n"
+        "  <memory-usage>\n"
+        "    <allocations>3</allocations>\n"
+        "    <allocated-bytes>4096</allocated-bytes>\n"
+        "    <peak-heap-growth>0</peak-heap-growth>\n"
+        "  </memory-usage>\n"
+        "</result>\n";
+
+    result = cut_test_result_new_empty();
+    cut_assert_false(cut_test_result_has_memory_usage(result));
+    cut_test_result_set_memory_usage(result,
+                                     CUT_MEMORY_USAGE_ALLOCATIONS,
+                                     3);
+    cut_test_result_set_memory_usage(result,
+                                     CUT_MEMORY_USAGE_ALLOCATED_BYTES,
+                                     4096);
+    cut_test_result_set_memory_usage(result,
+                                     CUT_MEMORY_USAGE_PEAK_HEAP_GROWTH,
+                                     0);
+    cut_assert_true(cut_test_result_has_memory_usage(result));
+    cut_assert_equal_string_with_free(expected, cut_test_result_to_xml(result));
+}
+
 void
 test_new_from_xml (void)
 {
@@ -654,6 +766,88 @@ test_new_from_xml_with_invalid_elapsed (void)
                                   xml);
 }
 
+void
+test_new_from_xml_with_performance_counters (void)
+{
+    const gchar xml[] =
+        "<result>\n"
+        "  <status>success</status>\n"
+        "  <performance-counters>\n"
+        "    <cycles>100</cycles>\n"
+        "    <branch-misses>3</branch-misses>\n"
+        "  </performance-counters>\n"
+        "</result>\n";
+
+    result = cut_test_result_new_from_xml(xml, -1, &error);
+    gcut_assert_error(error);
+    cut_assert_equal_int(100,
+                         cut_test_result_get_performance_counter(
+                             result, CUT_PERFORMANCE_COUNTER_CYCLES));
+    cut_assert_equal_int(3,
+                         cut_test_result_get_performance_counter(
+                             result, CUT_PERFORMANCE_COUNTER_BRANCH_MISSES));
+    cut_assert_equal_int(-1,
+                         cut_test_result_get_performance_counter(
+                             result, CUT_PERFORMANCE_COUNTER_CACHE_MISSES));
+}
+
+void
+test_new_from_xml_with_invalid_performance_counter (void)
+{
+    const gchar xml[] =
+        "<result>\n"
+        "  <performance-counters>\n"
+        "    <cycles>XXX</cycles>\n"
+        "  </performance-counters>\n"
+        "</result>\n";
+
+    cut_assert_new_from_xml_error("Error on line 3 char 17: "
+                                  "/result/performance-counters/cycles: "
+                                  "invalid cycles value: XXX",
+                                  xml);
+}
+
+void
+test_new_from_xml_with_memory_usage (void)
+{
+    const gchar xml[] =
+        "<result>\n"
+        "  <status>success</status>\n"
+        "  <memory-usage>\n"
+        "    <allocations>10</allocations>\n"
+        "    <peak-heap-growth>2048</peak-heap-growth>\n"
+        "  </memory-usage>\n"
+        "</result>\n";
+
+    result = cut_test_result_new_from_xml(xml, -1, &error);
+    gcut_assert_error(error);
+    cut_assert_equal_int(10,
+                         cut_test_result_get_memory_usage(
+                             result, CUT_MEMORY_USAGE_ALLOCATIONS));
+    cut_assert_equal_int(2048,
+                         cut_test_result_get_memory_usage(
+                             result, CUT_MEMORY_USAGE_PEAK_HEAP_GROWTH));
+    cut_assert_equal_int(-1,
+                         cut_test_result_get_memory_usage(
+                             result, CUT_MEMORY_USAGE_ALLOCATED_BYTES));
+}
+
+void
+test_new_from_xml_with_invalid_memory_usage (void)
+{
+    const gchar xml[] =
+        "<result>\n"
+        "  <memory-usage>\n"
+        "    <allocations>XXX</allocations>\n"
+        "  </memory-usage>\n"
+        "</result>\n";
+
+    cut_assert_new_from_xml_error("Error on line 3 char 22: "
+                                  "/result/memory-usage/allocations: "
+                                  "invalid allocations value: XXX",
+                                  xml);
+}
+
 /*
 vi:ts=4:nowrap:ai:expandtab:sw=4
 */
@@ -10,6 +10,7 @@ void test_get_source_directory (void);
 void test_build_source_filename (void);
 void test_order (void);
 void test_ready_signal (void);
+void test_result_retention (void);
 
 static CutRunContext *run_context;
 static CutTestCase *test_case;
@@ -184,6 +185,40 @@ test_n_ (void)
     test_case = NULL;
 }
  
+void
+test_result_retention (void)
+{
+    const GList *node;
+
+    cut_assert_equal_int(CUT_RESULT_RETENTION_ALL,
+                         cut_run_context_get_result_retention(run_context));
+    cut_run_context_set_result_retention(run_context,
+                                         CUT_RESULT_RETENTION_NON_SUCCESS);
+    cut_assert_equal_int(CUT_RESULT_RETENTION_NON_SUCCESS,
+                         cut_run_context_get_result_retention(run_context));
+
+    test_case = cut_test_case_new("stub test case",
+                                  NULL, NULL, NULL, NULL);
+    cuttest_add_test(test_case, "test_1", stub_success_function);
+    cuttest_add_test(test_case, "test_2", stub_failure_function);
+    cuttest_add_test(test_case, "test_3", stub_error_function);
+
+    cut_assert_false(cut_test_runner_run_test_case(CUT_TEST_RUNNER(run_context),
+                                                   test_case));
+
+    cut_assert_equal_int(1, cut_run_context_get_n_successes(run_context));
+    cut_assert_equal_int(3, cut_run_context_get_n_tests(run_context));
+    cut_assert_equal_int(2,
+                         g_list_length((GList *)cut_run_context_get_results(run_context)));
+    for (node = cut_run_context_get_results(run_context);
+         node;
+         node = g_list_next(node)) {
+        CutTestResult *result = node->data;
+        cut_assert_not_equal_int(CUT_TEST_RESULT_SUCCESS,
+                                 cut_test_result_get_status(result));
+    }
+}
+
 void
 test_get_test_directory (void)
 {
@@ -0,0 +1,146 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gcutter.h>
+#include <cutter/cut-test-scheduler.h>
+#include <cutter/cut-glib-compatible.h>
+
+void test_order (void);
+void test_steal (void);
+void test_wait (void);
+
+static CutTestScheduler *scheduler;
+static GString *job_log;
+static GMutex *log_mutex;
+static volatile gint n_pending_jobs;
+
+void
+cut_setup (void)
+{
+    scheduler = NULL;
+    job_log = g_string_new(NULL);
+    log_mutex = g_mutex_new();
+    n_pending_jobs = 0;
+}
+
+void
+cut_teardown (void)
+{
+    if (scheduler)
+        cut_test_scheduler_free(scheduler);
+    g_string_free(job_log, TRUE);
+    g_mutex_free(log_mutex);
+}
+
+static void
+append_log (const gchar *name)
+{
+    g_mutex_lock(log_mutex);
+    if (job_log->len > 0)
+        g_string_append_c(job_log, ' ');
+    g_string_append(job_log, name);
+    g_mutex_unlock(log_mutex);
+}
+
+static void
+log_job (gpointer data)
+{
+    append_log(data);
+}
+
+static void
+log_group_job (gpointer data)
+{
+    append_log(data);
+    g_atomic_int_add(&n_pending_jobs, -1);
+}
+
+static void
+push_children_job (gpointer data)
+{
+    append_log(data);
+    /* Pushed in reverse order because the owner pops the last one. */
+    cut_test_scheduler_push(scheduler, log_job, "A2");
+    cut_test_scheduler_push(scheduler, log_job, "A1");
+}
+
+void
+test_order (void)
+{
+    scheduler = cut_test_scheduler_new(1);
+    cut_test_scheduler_push(scheduler, push_children_job, "A");
+    cut_test_scheduler_push(scheduler, log_job, "B");
+    cut_test_scheduler_push(scheduler, log_job, "C");
+    cut_test_scheduler_run(scheduler);
+
+    cut_assert_equal_string("A A1 A2 B C", job_log->str);
+}
+
+static void
+block_until_stolen_job (gpointer data)
+{
+    gint i;
+
+    g_atomic_int_add(&n_pending_jobs, 2);
+    cut_test_scheduler_push(scheduler, log_group_job, "X1");
+    cut_test_scheduler_push(scheduler, log_group_job, "X2");
+
+    /* We don't take our jobs. So another worker steals them from
+     * the oldest one. */
+    for (i = 0; i < 1000 && g_atomic_int_get(&n_pending_jobs) > 0; i++)
+        g_usleep(10 * 1000);
+}
+
+void
+test_steal (void)
+{
+    scheduler = cut_test_scheduler_new(2);
+    cut_test_scheduler_push(scheduler, block_until_stolen_job, NULL);
+    cut_test_scheduler_run(scheduler);
+
+    cut_assert_equal_string("X1 X2", job_log->str);
+}
+
+static void
+wait_group_job (gpointer data)
+{
+    append_log(data);
+    g_atomic_int_add(&n_pending_jobs, 2);
+    cut_test_scheduler_push_to_group(scheduler, &n_pending_jobs,
+                                     log_group_job, "G1");
+    cut_test_scheduler_push_to_group(scheduler, &n_pending_jobs,
+                                     log_group_job, "G2");
+    cut_test_scheduler_wait(scheduler, &n_pending_jobs);
+    append_log("P-end");
+}
+
+void
+test_wait (void)
+{
+    scheduler = cut_test_scheduler_new(1);
+    cut_test_scheduler_push(scheduler, wait_group_job, "P");
+    cut_test_scheduler_push(scheduler, log_job, "U");
+    cut_test_scheduler_run(scheduler);
+
+    cut_assert_equal_string("P G2 G1 P-end U", job_log->str);
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
@@ -20,6 +20,7 @@ void test_run_test_in_test_case_with_regex (void);
 void test_run_test_with_regex_in_test_case_with_regex (void);
 void test_run_test_in_test_case_with_null (void);
 void test_run_test_with_filter_with_null (void);
+void test_run_split_test_cases (void);
 
 static CutRunContext *run_context;
 static CutTestSuite *test_object;
@@ -176,6 +177,21 @@ test_run (void)
     cut_assert_equal_int(1, n_run_stock_run_test_function);
 }
 
+void
+test_run_split_test_cases (void)
+{
+    cut_run_context_set_multi_thread(run_context, TRUE);
+    cut_run_context_set_split_test_cases(run_context, TRUE);
+
+    cut_assert(cut_test_suite_run(test_object, run_context));
+    cut_assert_equal_int(1, n_run_stub_test_function1);
+    cut_assert_equal_int(1, n_run_stub_test_function2);
+    cut_assert_equal_int(1, n_run_stub_run_test_function);
+    cut_assert_equal_int(1, n_run_stock_test_function1);
+    cut_assert_equal_int(1, n_run_stock_test_function2);
+    cut_assert_equal_int(1, n_run_stock_run_test_function);
+}
+
 void
 test_run_test_case (void)
 {
@@ -14,6 +14,8 @@ void test_start_signal(void);
 void test_complete_signal(void);
 void test_error_signal(void);
 void test_pass_assertion_signal(void);
+void test_pass_assertions_signal(void);
+void test_pass_assertion_signal_with_holder(void);
 void test_failure_signal(void);
 void test_pending_signal(void);
 void test_notification_signal(void);
@@ -22,6 +24,8 @@ void test_crash_signal (void);
 void test_test_function(void);
 void test_set_elapsed(void);
 void test_start_time(void);
+void test_get_timeout(void);
+void test_timeout(void);
 
 static CutRunContext *run_context;
 static CutTest *test;
@@ -33,6 +37,8 @@ static gint n_failure_signal = 0;
 static gint n_error_signal = 0;
 static gint n_pending_signal = 0;
 static gint n_pass_assertion_signal = 0;
+static gint n_pass_assertions_signal = 0;
+static guint n_passed_assertions = 0;
 static gint n_notification_signal = 0;
 static gint n_omission_signal = 0;
 static gint n_crash_signal = 0;
@@ -88,6 +94,8 @@ cut_setup (void)
     n_pending_signal = 0;
     n_notification_signal = 0;
     n_pass_assertion_signal = 0;
+    n_pass_assertions_signal = 0;
+    n_passed_assertions = 0;
     n_omission_signal = 0;
     n_crash_signal = 0;
 
@@ -148,6 +156,14 @@ cb_pass_assertion_signal (CutTest *test, gpointer data)
     n_pass_assertion_signal++;
 }
 
+static void
+cb_pass_assertions_signal (CutTest *test, CutTestContext *test_context,
+                           guint n_assertions, gpointer data)
+{
+    n_pass_assertions_signal++;
+    n_passed_assertions += n_assertions;
+}
+
 static void
 cb_omission_signal (CutTest *test, gpointer data)
 {
@@ -358,6 +374,51 @@ test_pass_assertion_signal (void)
     cut_assert_equal_uint(3, n_pass_assertion_signal);
 }
 
+void
+test_pass_assertions_signal (void)
+{
+    test = cut_test_new("stub-test", stub_test_function);
+    cut_run_context_set_batch_pass_assertions(run_context, TRUE);
+
+    g_signal_connect(test, "pass_assertion",
+                     G_CALLBACK(cb_pass_assertion_signal), NULL);
+    g_signal_connect(test, "pass_assertions",
+                     G_CALLBACK(cb_pass_assertions_signal), NULL);
+    cut_assert_true(run());
+    g_signal_handlers_disconnect_by_func(test,
+                                         G_CALLBACK(cb_pass_assertion_signal),
+                                         NULL);
+    g_signal_handlers_disconnect_by_func(test,
+                                         G_CALLBACK(cb_pass_assertions_signal),
+                                         NULL);
+    cut_assert_equal_uint(0, n_pass_assertion_signal);
+    cut_assert_equal_uint(1, n_pass_assertions_signal);
+    cut_assert_equal_uint(3, n_passed_assertions);
+}
+
+void
+test_pass_assertion_signal_with_holder (void)
+{
+    test = cut_test_new("stub-test", stub_test_function);
+    cut_run_context_set_batch_pass_assertions(run_context, TRUE);
+    cut_run_context_hold_pass_assertion_events(run_context);
+
+    g_signal_connect(test, "pass_assertion",
+                     G_CALLBACK(cb_pass_assertion_signal), NULL);
+    g_signal_connect(test, "pass_assertions",
+                     G_CALLBACK(cb_pass_assertions_signal), NULL);
+    cut_assert_true(run());
+    g_signal_handlers_disconnect_by_func(test,
+                                         G_CALLBACK(cb_pass_assertion_signal),
+                                         NULL);
+    g_signal_handlers_disconnect_by_func(test,
+                                         G_CALLBACK(cb_pass_assertions_signal),
+                                         NULL);
+    cut_run_context_release_pass_assertion_events(run_context);
+    cut_assert_equal_uint(3, n_pass_assertion_signal);
+    cut_assert_equal_uint(0, n_pass_assertions_signal);
+}
+
 void
 test_set_elapsed (void)
 {
@@ -397,6 +458,42 @@ test_start_time (void)
     gcut_assert_equal_time_val(&expected, &actual);
 }
 
+void
+test_get_timeout (void)
+{
+    test = cut_test_new("stub-test", stub_test_function);
+
+    cut_assert_equal_double(-1.0, 0.001, cut_test_get_timeout(test));
+    cut_test_set_attribute(test, "timeout", "0.5");
+    cut_assert_equal_double(0.5, 0.001, cut_test_get_timeout(test));
+    cut_test_set_attribute(test, "timeout", "0");
+    cut_assert_equal_double(0.0, 0.001, cut_test_get_timeout(test));
+    cut_test_set_attribute(test, "timeout", "invalid");
+    cut_assert_equal_double(-1.0, 0.001, cut_test_get_timeout(test));
+}
+
+static void
+stub_slow_function (void)
+{
+    g_usleep(G_USEC_PER_SEC * 3 / 10);
+    run_test_flag = TRUE;
+}
+
+void
+test_timeout (void)
+{
+    test = cut_test_new("stub-slow-test", stub_slow_function);
+    cut_test_set_attribute(test, "timeout", "0.1");
+
+    g_signal_connect(test, "error", G_CALLBACK(cb_error_signal), NULL);
+    cut_assert_false(run());
+    g_signal_handlers_disconnect_by_func(test,
+                                         G_CALLBACK(cb_error_signal),
+                                         NULL);
+    cut_assert_equal_uint(1, n_error_signal);
+    /* A timed out test isn't interrupted. */
+    cut_assert_true(run_test_flag);
+}
 
 /*
 vi:ts=4:nowrap:ai:expandtab:sw=4
@@ -0,0 +1,185 @@
+/* -*- Mode: C; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+/*
+ *  Copyright (C) 2026  Sutou Kouhei <kou@clear-code.com>
+ *
+ *  This library is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <gcutter.h>
+#include <cutter/cut-timing-history.h>
+#include <cutter/cut-run-context.h>
+#include <cutter/cut-test-runner.h>
+#include "../lib/cuttest-utils.h"
+
+void test_build_filename (void);
+void test_unknown (void);
+void test_record (void);
+void test_save_and_load (void);
+void test_sort_test_cases_by_duration (void);
+
+static gchar *tmp_dir;
+static CutTimingHistory *history;
+static CutRunContext *run_context;
+static GList *test_cases;
+
+void
+cut_setup (void)
+{
+    tmp_dir = g_build_filename(cuttest_get_base_dir(), "tmp", NULL);
+    cut_remove_path(tmp_dir, NULL);
+    history = NULL;
+    run_context = NULL;
+    test_cases = NULL;
+}
+
+void
+cut_teardown (void)
+{
+    if (history)
+        cut_timing_history_free(history);
+    if (run_context)
+        g_object_unref(run_context);
+    g_list_foreach(test_cases, (GFunc)g_object_unref, NULL);
+    g_list_free(test_cases);
+
+    cut_remove_path(tmp_dir, NULL);
+    g_free(tmp_dir);
+}
+
+void
+test_build_filename (void)
+{
+    cut_assert_equal_string(
+        cut_take_string(g_build_filename("cache", "timing",
+                                         "_home_user_test.timing",
+                                         NULL)),
+        cut_take_string(cut_timing_history_build_filename("cache",
+                                                          "/home/user/test")));
+}
+
+void
+test_unknown (void)
+{
+    history = cut_timing_history_new("history.timing");
+    cut_assert_true(cut_timing_history_get_test_case_elapsed(history,
+                                                             "test_case") < 0.0);
+    cut_assert_true(cut_timing_history_get_test_elapsed(history,
+                                                        "test_case",
+                                                        "test_1") < 0.0);
+}
+
+void
+test_record (void)
+{
+    history = cut_timing_history_new("history.timing");
+
+    cut_timing_history_record_test_case(history, "test_case", 2.0);
+    cut_assert_equal_double(2.0, 0.001,
+                            cut_timing_history_get_test_case_elapsed(history,
+                                                                     "test_case"));
+    cut_timing_history_record_test_case(history, "test_case", 4.0);
+    cut_assert_equal_double(3.0, 0.001,
+                            cut_timing_history_get_test_case_elapsed(history,
+                                                                     "test_case"));
+
+    cut_timing_history_record_test(history, "test_case", "test_1", 0.5);
+    cut_assert_equal_double(0.5, 0.001,
+                            cut_timing_history_get_test_elapsed(history,
+                                                                "test_case",
+                                                                "test_1"));
+}
+
+void
+test_save_and_load (void)
+{
+    gchar *filename;
+    GError *error = NULL;
+
+    filename = g_build_filename(tmp_dir, "timing", "history.timing", NULL);
+    cut_take_string(filename);
+
+    history = cut_timing_history_new(filename);
+    cut_timing_history_record_test_case(history, "test_case", 1.5);
+    cut_timing_history_record_test(history, "test_case", "test_1", 0.25);
+    cut_timing_history_save(history, &error);
+    gcut_assert_error(error);
+    cut_timing_history_free(history);
+
+    history = cut_timing_history_new(filename);
+    cut_timing_history_load(history, &error);
+    gcut_assert_error(error);
+    cut_assert_equal_double(1.5, 0.001,
+                            cut_timing_history_get_test_case_elapsed(history,
+                                                                     "test_case"));
+    cut_assert_equal_double(0.25, 0.001,
+                            cut_timing_history_get_test_elapsed(history,
+                                                                "test_case",
+                                                                "test_1"));
+}
+
+static void
+add_test_case (const gchar *name)
+{
+    test_cases = g_list_append(test_cases,
+                               cut_test_case_new(name,
+                                                 NULL, NULL, NULL, NULL));
+}
+
+void
+test_sort_test_cases_by_duration (void)
+{
+    const gchar *test_directory = "/home/user/test";
+    const gchar *expected_names[] = {
+        "test_unknown", "test_slow", "test_medium", "test_fast", NULL
+    };
+    const gchar **actual_names;
+    GList *node;
+    gint i;
+    GError *error = NULL;
+
+    history =
+        cut_timing_history_new(cut_take_string(
+                                   cut_timing_history_build_filename(
+                                       tmp_dir, test_directory)));
+    cut_timing_history_record_test_case(history, "test_fast", 0.1);
+    cut_timing_history_record_test_case(history, "test_slow", 3.0);
+    cut_timing_history_record_test_case(history, "test_medium", 1.0);
+    cut_timing_history_save(history, &error);
+    gcut_assert_error(error);
+
+    run_context = CUT_RUN_CONTEXT(cut_test_runner_new());
+    cut_run_context_set_symbol_cache_directory(run_context, tmp_dir);
+    cut_run_context_set_test_directory(run_context, test_directory);
+    cut_run_context_set_test_case_order(run_context,
+                                        CUT_ORDER_DURATION_DESCENDING);
+
+    add_test_case("test_fast");
+    add_test_case("test_medium");
+    add_test_case("test_unknown");
+    add_test_case("test_slow");
+    test_cases = cut_run_context_sort_test_cases(run_context, test_cases);
+
+    actual_names = g_new0(const gchar *, g_list_length(test_cases) + 1);
+    cut_take_memory(actual_names);
+    for (node = test_cases, i = 0; node; node = g_list_next(node), i++) {
+        actual_names[i] = cut_test_get_name(CUT_TEST(node->data));
+    }
+    cut_assert_equal_string_array((gchar **)expected_names,
+                                  (gchar **)actual_names);
+}
+
+/*
+vi:ts=4:nowrap:ai:expandtab:sw=4
+*/
@@ -44,6 +44,7 @@
 void test_inspect_memory (void);
 void test_inspect_memory_with_printable (void);
 void test_inspect_memory_huge_data (void);
+void test_hexdump_around (void);
 void test_compare_string_array (void);
 void test_inspect_string_array (void);
 void test_inspect_string (void);
@@ -128,6 +129,35 @@ test_inspect_memory_with_printable (void)
         cut_utils_inspect_memory(binary, sizeof(binary) - 2));
 }
 
+void
+test_hexdump_around (void)
+{
+    gchar binary[100];
+    gint i;
+
+    for (i = 0; i < (gint)sizeof(binary); i++) {
+        binary[i] = 0x30 + i;
+    }
+
+    cut_assert_equal_string_with_free("(empty)",
+                                      cut_utils_hexdump_around(NULL, 0, 0));
+    cut_assert_equal_string_with_free(
+        ">00000000  30 31 32                                          |012|",
+        cut_utils_hexdump_around(binary, 3, 10));
+    cut_assert_equal_string_with_free(
+        " 00000010  40 41 42 43 44 45 46 47  48 49 4a 4b 4c 4d 4e 4f  "
+        "|@ABCDEFGHIJKLMNO|\n"
+        " 00000020  50 51 52 53 54 55 56 57  58 59 5a 5b 5c 5d 5e 5f  "
+        "|PQRSTUVWXYZ[\\]^_|\n"
+        ">00000030  60 61 62 63 64 65 66 67  68 69 6a 6b 6c 6d 6e 6f  "
+        "|`abcdefghijklmno|\n"
+        " 00000040  70 71 72 73 74 75 76 77  78 79 7a 7b 7c 7d 7e 7f  "
+        "|pqrstuvwxyz{|}~.|\n"
+        " 00000050  80 81 82 83 84 85 86 87  88 89 8a 8b 8c 8d 8e 8f  "
+        "|................|",
+        cut_utils_hexdump_around(binary, sizeof(binary), 50));
+}
+
 void
 test_inspect_memory_huge_data (void)
 {
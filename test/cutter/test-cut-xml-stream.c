@@ -31,6 +31,13 @@
 void attributes_stream (void);
 void data_stream (void);
 void test_stream (gconstpointer data);
+void attributes_async_stream (void);
+void data_async_stream (void);
+void test_async_stream (gconstpointer data);
+void attributes_drop_on_overflow (void);
+void test_drop_on_overflow (void);
+void attributes_detach_async_in_forked_process (void);
+void test_detach_async_in_forked_process (void);
 
 static CutStream *stream;
 static CutRunContext *run_context;
@@ -42,6 +49,7 @@ static CutTestSuite *test_suite;
 static CutTestContext *test_context;
 
 static GString *xml;
+static volatile gint writer_blocked;
 
 static void
 stub_success_test (void)
@@ -152,6 +160,16 @@ stream_to_string (const gchar *message, GError **error, gpointer user_data)
     return TRUE;
 }
 
+static gboolean
+stream_to_string_after_unblocked (const gchar *message, GError **error,
+                                  gpointer user_data)
+{
+    while (g_atomic_int_get(&writer_blocked))
+        g_usleep(1000);
+
+    return stream_to_string(message, error, user_data);
+}
+
 typedef void (*TestSetupFunction) (void);
 
 typedef struct _StreamTestData
@@ -213,10 +231,9 @@ data_stream (void)
 		 NULL);
 }
 
-void
-test_stream (gconstpointer data)
+static void
+assert_stream (const StreamTestData *test_data, gboolean async)
 {
-    const StreamTestData *test_data = data;
     const gchar *expected;
 
     test_data->test_setup();
@@ -225,6 +242,7 @@ test_stream (gconstpointer data)
     stream = cut_stream_new("xml",
                             "stream-function", stream_to_string,
                             "stream-function-user-data", xml,
+                            "async", async,
                             NULL);
     cut_listener_attach_to_run_context(CUT_LISTENER(stream), run_context);
     cut_assert(run());
@@ -234,6 +252,106 @@ test_stream (gconstpointer data)
     cut_assert_equal_string(expected, normalize_xml(xml->str));
 }
 
+void
+test_stream (gconstpointer data)
+{
+    cut_trace(assert_stream(data, FALSE));
+}
+
+void
+attributes_async_stream (void)
+{
+    cut_set_attributes("multi-thread", "false", NULL);
+}
+
+void
+data_async_stream (void)
+{
+    data_stream();
+}
+
+void
+test_async_stream (gconstpointer data)
+{
+    cut_trace(assert_stream(data, TRUE));
+}
+
+void
+attributes_drop_on_overflow (void)
+{
+    cut_set_attributes("multi-thread", "false", NULL);
+}
+
+void
+test_drop_on_overflow (void)
+{
+    guint n_dropped_events;
+
+    setup_success_test();
+
+    xml = g_string_new(NULL);
+    stream = cut_stream_new("xml",
+                            "stream-function",
+                            stream_to_string_after_unblocked,
+                            "stream-function-user-data", xml,
+                            "async", TRUE,
+                            "buffer-size", 1,
+                            "drop-on-overflow", TRUE,
+                            NULL);
+    cut_listener_attach_to_run_context(CUT_LISTENER(stream), run_context);
+    g_atomic_int_set(&writer_blocked, TRUE);
+    cut_assert(run());
+    g_atomic_int_set(&writer_blocked, FALSE);
+    cut_listener_detach_from_run_context(CUT_LISTENER(stream), run_context);
+
+    g_object_get(stream, "n-dropped-events", &n_dropped_events, NULL);
+    cut_assert_operator_uint(n_dropped_events, >, 0);
+    cut_assert_match("\\A  <ready-test-suite>\n(?s:.*)"
+                     "  </ready-test-suite>\n\\z",
+                     xml->str);
+}
+
+void
+attributes_detach_async_in_forked_process (void)
+{
+    cut_set_attributes("multi-thread", "false", NULL);
+}
+
+void
+test_detach_async_in_forked_process (void)
+{
+    int pid;
+
+#ifdef G_OS_WIN32
+    cut_omit("fork() isn't available on Windows.");
+#endif
+
+    setup_success_test();
+
+    xml = g_string_new(NULL);
+    stream = cut_stream_new("xml",
+                            "stream-function", stream_to_string,
+                            "stream-function-user-data", xml,
+                            "async", TRUE,
+                            NULL);
+    cut_listener_attach_to_run_context(CUT_LISTENER(stream), run_context);
+
+    /* The forked process doesn't have the writer thread. It must
+     * not wait for it. */
+    pid = cut_fork();
+    cut_assert_errno();
+    if (pid == 0) {
+        cut_listener_detach_from_run_context(CUT_LISTENER(stream),
+                                             run_context);
+        _exit(EXIT_SUCCESS);
+    }
+    cut_assert_equal_int(EXIT_SUCCESS, cut_wait_process(pid, 1000));
+
+    cut_assert(run());
+    cut_listener_detach_from_run_context(CUT_LISTENER(stream), run_context);
+    cut_assert_match("\\A  <ready-test-suite>\n", xml->str);
+}
+
 /*
 vi:ts=4:nowrap:ai:expandtab:sw=4
 */
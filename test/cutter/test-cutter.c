@@ -54,6 +54,7 @@ void test_invalid_order_option (void);
 void test_invalid_verbose_option (void);
 void test_no_option (void);
 void test_get_test_directory (void);
+void test_keep_no_results_with_console_ui (void);
 
 static gchar *stdout_string = NULL;
 static gchar *stderr_string = NULL;
@@ -120,15 +121,34 @@ cut_setup (void)
         "  -n, --name=TEST_NAME                              Specify tests" LINE_FEED_CODE
         "  -t, --test-case=TEST_CASE_NAME                    Specify test cases" LINE_FEED_CODE
         "  -m, --multi-thread                                Run test cases and iterated tests with multi-thread" LINE_FEED_CODE
+        "  --split-test-cases                                Run tests in a test case concurrently with --multi-thread" LINE_FEED_CODE
         "  --max-threads=MAX_THREADS                         Run test cases and iterated tests with MAX_THREADS threads concurrently at a maximum (default: 10; -1 is no limit)" LINE_FEED_CODE
+        "  --processes=N                                     Run test cases on N worker processes. A crashed worker process loses only the running test (default: 0; 0 is no worker process)" LINE_FEED_CODE
+        "  --shard-listen=[HOST:]PORT                        Accept workers started with --shard-connect on [HOST:]PORT and run test cases on them and --processes, longest first, as one run" LINE_FEED_CODE
+        "  --shard-connect=HOST:PORT                         Run test cases for the coordinator started with --shard-listen on HOST:PORT" LINE_FEED_CODE
         "  --disable-signal-handling                         Disable signal handling" LINE_FEED_CODE
-        "  --test-case-order=[none|name|name-desc]           Sort test case by. Default is 'none'." LINE_FEED_CODE
+        "  --test-case-order=ORDER                           Sort test case by ORDER: none, name, name-desc or duration (longest first). Default is 'none'." LINE_FEED_CODE
         "  --exclude-file=FILE                               Skip files" LINE_FEED_CODE
         "  --exclude-directory=DIRECTORY                     Skip directories" LINE_FEED_CODE
         "  --fatal-failures                                  Treat failures as fatal problem" LINE_FEED_CODE
         "  --keep-opening-modules                            Keep opening loaded modules to resolve symbols for debugging" LINE_FEED_CODE
         "  --enable-convenience-attribute-definition         Enable convenience but danger '#{ATTRIBUTE_NAME}_#{TEST_NAME - 'test_' PREFIX}' attribute set function" LINE_FEED_CODE
         "  --stop-before-test                                Set breakpoints at each line which invokes test. You can step into a test function with your debugger easily." LINE_FEED_CODE
+        "  --symbol-cache-directory=DIRECTORY                Cache symbols of test modules in DIRECTORY (default: $XDG_CACHE_HOME/cutter; empty string disables the cache)" LINE_FEED_CODE
+        "  --batch-assertions                                Report passed assertions of a test at once instead of one by one" LINE_FEED_CODE
+        "  --keep-results=[all|non-success|none]             Keep test results after reporting them. Default is 'all'." LINE_FEED_CODE
+        "  --disable-timing-history-update                   Don't record elapsed times into timing history" LINE_FEED_CODE
+        "  --history=PATTERN                                 Show when tests whose name is PATTERN or is matched with /PATTERN/ started failing or getting slower instead of running tests" LINE_FEED_CODE
+        "  --timeout=SECONDS                                 Treat a test that doesn't finish in SECONDS as an error (default: 0; 0 disables the timeout)" LINE_FEED_CODE
+        "  --benchmark-time=SECONDS                          Measure a benchmark for SECONDS (default: 1; 0 runs a benchmark only once)" LINE_FEED_CODE
+        "  --save-baseline=FILE                              Save elapsed times of tests and benchmarks to FILE" LINE_FEED_CODE
+        "  --compare-baseline=FILE                           Report tests and benchmarks that are slower than FILE" LINE_FEED_CODE
+        "  --regression-threshold=PERCENT                    Report a test that is slower than the baseline by more than PERCENT (default: 20)" LINE_FEED_CODE
+        "  --fail-on-regression                              Report a regression as a failure instead of a notification" LINE_FEED_CODE
+        "  --performance-counters                            Measure CPU cycles, instructions, cache misses, branch misses and page faults of each test (Linux only)" LINE_FEED_CODE
+        "  --memory-usage                                    Measure allocations, allocated bytes and peak heap growth of each test (glibc only)" LINE_FEED_CODE
+        "  --allocation-failures=N                           Rerun each passed test in forked processes failing each of its first N allocations one by one, and report a crash or a leak on them (default: 0; 0 disables it; glibc only)" LINE_FEED_CODE
+        "  --max-diff-size=BYTES                             Show only the first difference instead of a diff for values larger than BYTES (default: 8092; 0 disables the limit)" LINE_FEED_CODE
       "" LINE_FEED_CODE;
     help_message = cut_take_printf(format,
                                    g_get_prgname(),
@@ -248,6 +268,7 @@ test_help_all (void)
         "  --help-stream                                     Show stream options" LINE_FEED_CODE
         "  --help-report                                     Show report options" LINE_FEED_CODE
         "  --help-ui                                         Show UI options" LINE_FEED_CODE
+        "  --help-xml-stream                                 Show XML stream options" LINE_FEED_CODE
         "  --help-console-ui                                 Show console UI options" LINE_FEED_CODE
 #ifdef HAVE_GTK
         "  --help-gtk                                        Show GTK+ Options" LINE_FEED_CODE
@@ -271,6 +292,11 @@ test_help_all (void)
 #else
         "  -u, --ui=[console]                                Specify UI" LINE_FEED_CODE
 #endif
+        "" LINE_FEED_CODE
+        "XML Stream Options" LINE_FEED_CODE
+        "  --xml-stream-async=[yes|true|no|false]            Stream events by a writer thread" LINE_FEED_CODE
+        "  --xml-stream-buffer-size=BYTES                    Queue at most BYTES of events in async mode (default: 1048576)" LINE_FEED_CODE
+        "  --xml-stream-overflow=[block|drop]                Block or drop an event when the buffer is full (default: block)" LINE_FEED_CODE
         "" LINE_FEED_CODE
         "Console UI Options" LINE_FEED_CODE
         "  -v, --verbose=[s|silent|n|normal|v|verbose]       Set verbose level" LINE_FEED_CODE
@@ -315,15 +341,34 @@ test_help_all (void)
         "  -n, --name=TEST_NAME                              Specify tests" LINE_FEED_CODE
         "  -t, --test-case=TEST_CASE_NAME                    Specify test cases" LINE_FEED_CODE
         "  -m, --multi-thread                                Run test cases and iterated tests with multi-thread" LINE_FEED_CODE
+        "  --split-test-cases                                Run tests in a test case concurrently with --multi-thread" LINE_FEED_CODE
         "  --max-threads=MAX_THREADS                         Run test cases and iterated tests with MAX_THREADS threads concurrently at a maximum (default: 10; -1 is no limit)" LINE_FEED_CODE
+        "  --processes=N                                     Run test cases on N worker processes. A crashed worker process loses only the running test (default: 0; 0 is no worker process)" LINE_FEED_CODE
+        "  --shard-listen=[HOST:]PORT                        Accept workers started with --shard-connect on [HOST:]PORT and run test cases on them and --processes, longest first, as one run" LINE_FEED_CODE
+        "  --shard-connect=HOST:PORT                         Run test cases for the coordinator started with --shard-listen on HOST:PORT" LINE_FEED_CODE
         "  --disable-signal-handling                         Disable signal handling" LINE_FEED_CODE
-        "  --test-case-order=[none|name|name-desc]           Sort test case by. Default is 'none'." LINE_FEED_CODE
+        "  --test-case-order=ORDER                           Sort test case by ORDER: none, name, name-desc or duration (longest first). Default is 'none'." LINE_FEED_CODE
         "  --exclude-file=FILE                               Skip files" LINE_FEED_CODE
         "  --exclude-directory=DIRECTORY                     Skip directories" LINE_FEED_CODE
         "  --fatal-failures                                  Treat failures as fatal problem" LINE_FEED_CODE
         "  --keep-opening-modules                            Keep opening loaded modules to resolve symbols for debugging" LINE_FEED_CODE
         "  --enable-convenience-attribute-definition         Enable convenience but danger '#{ATTRIBUTE_NAME}_#{TEST_NAME - 'test_' PREFIX}' attribute set function" LINE_FEED_CODE
         "  --stop-before-test                                Set breakpoints at each line which invokes test. You can step into a test function with your debugger easily." LINE_FEED_CODE
+        "  --symbol-cache-directory=DIRECTORY                Cache symbols of test modules in DIRECTORY (default: $XDG_CACHE_HOME/cutter; empty string disables the cache)" LINE_FEED_CODE
+        "  --batch-assertions                                Report passed assertions of a test at once instead of one by one" LINE_FEED_CODE
+        "  --keep-results=[all|non-success|none]             Keep test results after reporting them. Default is 'all'." LINE_FEED_CODE
+        "  --disable-timing-history-update                   Don't record elapsed times into timing history" LINE_FEED_CODE
+        "  --history=PATTERN                                 Show when tests whose name is PATTERN or is matched with /PATTERN/ started failing or getting slower instead of running tests" LINE_FEED_CODE
+        "  --timeout=SECONDS                                 Treat a test that doesn't finish in SECONDS as an error (default: 0; 0 disables the timeout)" LINE_FEED_CODE
+        "  --benchmark-time=SECONDS                          Measure a benchmark for SECONDS (default: 1; 0 runs a benchmark only once)" LINE_FEED_CODE
+        "  --save-baseline=FILE                              Save elapsed times of tests and benchmarks to FILE" LINE_FEED_CODE
+        "  --compare-baseline=FILE                           Report tests and benchmarks that are slower than FILE" LINE_FEED_CODE
+        "  --regression-threshold=PERCENT                    Report a test that is slower than the baseline by more than PERCENT (default: 20)" LINE_FEED_CODE
+        "  --fail-on-regression                              Report a regression as a failure instead of a notification" LINE_FEED_CODE
+        "  --performance-counters                            Measure CPU cycles, instructions, cache misses, branch misses and page faults of each test (Linux only)" LINE_FEED_CODE
+        "  --memory-usage                                    Measure allocations, allocated bytes and peak heap growth of each test (glibc only)" LINE_FEED_CODE
+        "  --allocation-failures=N                           Rerun each passed test in forked processes failing each of its first N allocations one by one, and report a crash or a leak on them (default: 0; 0 disables it; glibc only)" LINE_FEED_CODE
+        "  --max-diff-size=BYTES                             Show only the first difference instead of a diff for values larger than BYTES (default: 8092; 0 disables the limit)" LINE_FEED_CODE
 #ifdef HAVE_GTK
         "  --display=DISPLAY                                 X display to use" LINE_FEED_CODE
 #endif
@@ -387,6 +432,24 @@ test_get_test_directory (void)
     cut_assert_exit_success();
 }
 
+void
+test_keep_no_results_with_console_ui (void)
+{
+    const gchar *test_dir;
+    test_dir = cut_build_path(cuttest_get_base_dir(),
+                              "fixtures",
+                              "pipeline",
+                              "failure",
+                              NULL);
+    cut_assert(run_cutter(cut_take_printf("--notify=no --color=no "
+                                          "--keep-results=none %s",
+                                          test_dir)));
+    cut_assert_exit_failure();
+    cut_assert_match("\n1\\) Failure: test_failure\n"
+                     "Failed\\.\n",
+                     stdout_string);
+}
+
 
 /*
 vi:ts=4:nowrap:ai:expandtab:sw=4
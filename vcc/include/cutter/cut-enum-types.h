@@ -18,6 +18,8 @@ GType cut_pipeline_error_get_type (void);
 #define CUT_TYPE_PIPELINE_ERROR (cut_pipeline_error_get_type())
 GType cut_order_get_type (void);
 #define CUT_TYPE_ORDER (cut_order_get_type())
+GType cut_result_retention_get_type (void);
+#define CUT_TYPE_RESULT_RETENTION (cut_result_retention_get_type())
 GType cut_stream_reader_error_get_type (void);
 #define CUT_TYPE_STREAM_READER_ERROR (cut_stream_reader_error_get_type())
 GType cut_test_context_error_get_type (void);
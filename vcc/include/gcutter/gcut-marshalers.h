@@ -22,7 +22,15 @@ extern void _gcut_marshal_VOID__OBJECT_OBJECT_OBJECT (GClosure     *closure,
                                                       gpointer      invocation_hint,
                                                       gpointer      marshal_data);
 
-/* VOID:OBJECT,UINT (../gcutter/gcut-marshalers.list:3) */
+/* VOID:OBJECT,OBJECT,UINT (../gcutter/gcut-marshalers.list:3) */
+extern void _gcut_marshal_VOID__OBJECT_OBJECT_UINT (GClosure     *closure,
+                                                    GValue       *return_value,
+                                                    guint         n_param_values,
+                                                    const GValue *param_values,
+                                                    gpointer      invocation_hint,
+                                                    gpointer      marshal_data);
+
+/* VOID:OBJECT,UINT (../gcutter/gcut-marshalers.list:4) */
 extern void _gcut_marshal_VOID__OBJECT_UINT (GClosure     *closure,
                                              GValue       *return_value,
                                              guint         n_param_values,
@@ -30,7 +38,7 @@ extern void _gcut_marshal_VOID__OBJECT_UINT (GClosure     *closure,
                                              gpointer      invocation_hint,
                                              gpointer      marshal_data);
 
-/* VOID:OBJECT,UINT,UINT (../gcutter/gcut-marshalers.list:4) */
+/* VOID:OBJECT,UINT,UINT (../gcutter/gcut-marshalers.list:5) */
 extern void _gcut_marshal_VOID__OBJECT_UINT_UINT (GClosure     *closure,
                                                   GValue       *return_value,
                                                   guint         n_param_values,
@@ -38,7 +46,7 @@ extern void _gcut_marshal_VOID__OBJECT_UINT_UINT (GClosure     *closure,
                                                   gpointer      invocation_hint,
                                                   gpointer      marshal_data);
 
-/* VOID:UINT,UINT (../gcutter/gcut-marshalers.list:5) */
+/* VOID:UINT,UINT (../gcutter/gcut-marshalers.list:6) */
 extern void _gcut_marshal_VOID__UINT_UINT (GClosure     *closure,
                                            GValue       *return_value,
                                            guint         n_param_values,
@@ -46,7 +54,7 @@ extern void _gcut_marshal_VOID__UINT_UINT (GClosure     *closure,
                                            gpointer      invocation_hint,
                                            gpointer      marshal_data);
 
-/* VOID:STRING,STRING (../gcutter/gcut-marshalers.list:6) */
+/* VOID:STRING,STRING (../gcutter/gcut-marshalers.list:7) */
 extern void _gcut_marshal_VOID__STRING_STRING (GClosure     *closure,
                                                GValue       *return_value,
                                                guint         n_param_values,
@@ -54,7 +62,7 @@ extern void _gcut_marshal_VOID__STRING_STRING (GClosure     *closure,
                                                gpointer      invocation_hint,
                                                gpointer      marshal_data);
 
-/* VOID:STRING,UINT (../gcutter/gcut-marshalers.list:7) */
+/* VOID:STRING,UINT (../gcutter/gcut-marshalers.list:8) */
 extern void _gcut_marshal_VOID__STRING_UINT (GClosure     *closure,
                                              GValue       *return_value,
                                              guint         n_param_values,
@@ -62,7 +70,7 @@ extern void _gcut_marshal_VOID__STRING_UINT (GClosure     *closure,
                                              gpointer      invocation_hint,
                                              gpointer      marshal_data);
 
-/* VOID:STRING,UINT64 (../gcutter/gcut-marshalers.list:8) */
+/* VOID:STRING,UINT64 (../gcutter/gcut-marshalers.list:9) */
 extern void _gcut_marshal_VOID__STRING_UINT64 (GClosure     *closure,
                                                GValue       *return_value,
                                                guint         n_param_values,
@@ -70,7 +78,7 @@ extern void _gcut_marshal_VOID__STRING_UINT64 (GClosure     *closure,
                                                gpointer      invocation_hint,
                                                gpointer      marshal_data);
 
-/* VOID:OBJECT,BOOLEAN (../gcutter/gcut-marshalers.list:9) */
+/* VOID:OBJECT,BOOLEAN (../gcutter/gcut-marshalers.list:10) */
 extern void _gcut_marshal_VOID__OBJECT_BOOLEAN (GClosure     *closure,
                                                 GValue       *return_value,
                                                 guint         n_param_values,
@@ -78,7 +86,7 @@ extern void _gcut_marshal_VOID__OBJECT_BOOLEAN (GClosure     *closure,
                                                 gpointer      invocation_hint,
                                                 gpointer      marshal_data);
 
-/* VOID:OBJECT,OBJECT,BOOLEAN (../gcutter/gcut-marshalers.list:10) */
+/* VOID:OBJECT,OBJECT,BOOLEAN (../gcutter/gcut-marshalers.list:11) */
 extern void _gcut_marshal_VOID__OBJECT_OBJECT_BOOLEAN (GClosure     *closure,
                                                        GValue       *return_value,
                                                        guint         n_param_values,
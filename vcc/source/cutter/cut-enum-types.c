@@ -136,6 +136,7 @@ cut_order_get_type (void)
       { CUT_ORDER_NONE_SPECIFIED, "CUT_ORDER_NONE_SPECIFIED", "none-specified" },
       { CUT_ORDER_NAME_ASCENDING, "CUT_ORDER_NAME_ASCENDING", "name-ascending" },
       { CUT_ORDER_NAME_DESCENDING, "CUT_ORDER_NAME_DESCENDING", "name-descending" },
+      { CUT_ORDER_DURATION_DESCENDING, "CUT_ORDER_DURATION_DESCENDING", "duration-descending" },
       { 0, NULL, NULL }
     };
     etype = g_enum_register_static ("CutOrder", values);
@@ -143,6 +144,21 @@ cut_order_get_type (void)
   return etype;
 }
 GType
+cut_result_retention_get_type (void)
+{
+  static GType etype = 0;
+  if (etype == 0) {
+    static const GEnumValue values[] = {
+      { CUT_RESULT_RETENTION_ALL, "CUT_RESULT_RETENTION_ALL", "all" },
+      { CUT_RESULT_RETENTION_NON_SUCCESS, "CUT_RESULT_RETENTION_NON_SUCCESS", "non-success" },
+      { CUT_RESULT_RETENTION_NONE, "CUT_RESULT_RETENTION_NONE", "none" },
+      { 0, NULL, NULL }
+    };
+    etype = g_enum_register_static ("CutResultRetention", values);
+  }
+  return etype;
+}
+GType
 cut_stream_reader_error_get_type (void)
 {
   static GType etype = 0;
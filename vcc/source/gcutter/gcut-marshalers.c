@@ -139,7 +139,52 @@ _gcut_marshal_VOID__OBJECT_OBJECT_OBJECT (GClosure     *closure,
             data2);
 }
 
-/* VOID:OBJECT,UINT (../gcutter/gcut-marshalers.list:3) */
+/* VOID:OBJECT,OBJECT,UINT (../gcutter/gcut-marshalers.list:3) */
+extern void _gcut_marshal_VOID__OBJECT_OBJECT_UINT (GClosure     *closure,
+                                                    GValue       *return_value,
+                                                    guint         n_param_values,
+                                                    const GValue *param_values,
+                                                    gpointer      invocation_hint,
+                                                    gpointer      marshal_data);
+void
+_gcut_marshal_VOID__OBJECT_OBJECT_UINT (GClosure     *closure,
+                                        GValue       *return_value G_GNUC_UNUSED,
+                                        guint         n_param_values,
+                                        const GValue *param_values,
+                                        gpointer      invocation_hint G_GNUC_UNUSED,
+                                        gpointer      marshal_data)
+{
+  typedef void (*GMarshalFunc_VOID__OBJECT_OBJECT_UINT) (gpointer     data1,
+                                                         gpointer     arg_1,
+                                                         gpointer     arg_2,
+                                                         guint        arg_3,
+                                                         gpointer     data2);
+  register GMarshalFunc_VOID__OBJECT_OBJECT_UINT callback;
+  register GCClosure *cc = (GCClosure*) closure;
+  register gpointer data1, data2;
+
+  g_return_if_fail (n_param_values == 4);
+
+  if (G_CCLOSURE_SWAP_DATA (closure))
+    {
+      data1 = closure->data;
+      data2 = g_value_peek_pointer (param_values + 0);
+    }
+  else
+    {
+      data1 = g_value_peek_pointer (param_values + 0);
+      data2 = closure->data;
+    }
+  callback = (GMarshalFunc_VOID__OBJECT_OBJECT_UINT) (marshal_data ? marshal_data : cc->callback);
+
+  callback (data1,
+            g_marshal_value_peek_object (param_values + 1),
+            g_marshal_value_peek_object (param_values + 2),
+            g_marshal_value_peek_uint (param_values + 3),
+            data2);
+}
+
+/* VOID:OBJECT,UINT (../gcutter/gcut-marshalers.list:4) */
 extern void _gcut_marshal_VOID__OBJECT_UINT (GClosure     *closure,
                                              GValue       *return_value,
                                              guint         n_param_values,
@@ -182,7 +227,7 @@ _gcut_marshal_VOID__OBJECT_UINT (GClosure     *closure,
             data2);
 }
 
-/* VOID:OBJECT,UINT,UINT (../gcutter/gcut-marshalers.list:4) */
+/* VOID:OBJECT,UINT,UINT (../gcutter/gcut-marshalers.list:5) */
 extern void _gcut_marshal_VOID__OBJECT_UINT_UINT (GClosure     *closure,
                                                   GValue       *return_value,
                                                   guint         n_param_values,
@@ -227,7 +272,7 @@ _gcut_marshal_VOID__OBJECT_UINT_UINT (GClosure     *closure,
             data2);
 }
 
-/* VOID:UINT,UINT (../gcutter/gcut-marshalers.list:5) */
+/* VOID:UINT,UINT (../gcutter/gcut-marshalers.list:6) */
 extern void _gcut_marshal_VOID__UINT_UINT (GClosure     *closure,
                                            GValue       *return_value,
                                            guint         n_param_values,
@@ -270,7 +315,7 @@ _gcut_marshal_VOID__UINT_UINT (GClosure     *closure,
             data2);
 }
 
-/* VOID:STRING,STRING (../gcutter/gcut-marshalers.list:6) */
+/* VOID:STRING,STRING (../gcutter/gcut-marshalers.list:7) */
 extern void _gcut_marshal_VOID__STRING_STRING (GClosure     *closure,
                                                GValue       *return_value,
                                                guint         n_param_values,
@@ -313,7 +358,7 @@ _gcut_marshal_VOID__STRING_STRING (GClosure     *closure,
             data2);
 }
 
-/* VOID:STRING,UINT (../gcutter/gcut-marshalers.list:7) */
+/* VOID:STRING,UINT (../gcutter/gcut-marshalers.list:8) */
 extern void _gcut_marshal_VOID__STRING_UINT (GClosure     *closure,
                                              GValue       *return_value,
                                              guint         n_param_values,
@@ -356,7 +401,7 @@ _gcut_marshal_VOID__STRING_UINT (GClosure     *closure,
             data2);
 }
 
-/* VOID:STRING,UINT64 (../gcutter/gcut-marshalers.list:8) */
+/* VOID:STRING,UINT64 (../gcutter/gcut-marshalers.list:9) */
 extern void _gcut_marshal_VOID__STRING_UINT64 (GClosure     *closure,
                                                GValue       *return_value,
                                                guint         n_param_values,
@@ -399,7 +444,7 @@ _gcut_marshal_VOID__STRING_UINT64 (GClosure     *closure,
             data2);
 }
 
-/* VOID:OBJECT,BOOLEAN (../gcutter/gcut-marshalers.list:9) */
+/* VOID:OBJECT,BOOLEAN (../gcutter/gcut-marshalers.list:10) */
 extern void _gcut_marshal_VOID__OBJECT_BOOLEAN (GClosure     *closure,
                                                 GValue       *return_value,
                                                 guint         n_param_values,
@@ -442,7 +487,7 @@ _gcut_marshal_VOID__OBJECT_BOOLEAN (GClosure     *closure,
             data2);
 }
 
-/* VOID:OBJECT,OBJECT,BOOLEAN (../gcutter/gcut-marshalers.list:10) */
+/* VOID:OBJECT,OBJECT,BOOLEAN (../gcutter/gcut-marshalers.list:11) */
 extern void _gcut_marshal_VOID__OBJECT_OBJECT_BOOLEAN (GClosure     *closure,
                                                        GValue       *return_value,
                                                        guint         n_param_values,